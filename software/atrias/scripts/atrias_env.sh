@@ -14,4 +14,8 @@ export XENOMAI_ROOT_DIR=/usr/xenomai
 export PATH="$PATH:/usr/xenomai/bin/"
 export LD_LIBRARY_PATH="$LD_LIBRARY_PATH:/usr/xenomai/lib/"
 
+# Flight recorder: record RT Ops's and the controllers' logs into mmap'd files
+# in this directory instead of over ROS. Convert them with flight2bag.py.
+#export ATRIAS_FLIGHT_RECORDER_DIR=/home/drl/atrias/software/atrias/bagfiles
+
 exec "$@"
@@ -0,0 +1,96 @@
+#!/usr/bin/env python2
+
+# Converts flight recorder files (see atrias_shared/FlightRecorder.h) into a
+# bag file, and optionally a .mat file.
+#
+# Records are stored in ROS's wire encoding along with each topic's datatype,
+# md5sum and message definition, so this doesn't need the message packages.
+
+import rosbag
+import genpy.rostime
+import struct
+import sys
+
+if (len(sys.argv) < 3):
+	print("Usage: " + sys.argv[0] + " [outfile.bag] [infile.flight]... [-m outfile.mat]")
+	exit()
+
+args    = sys.argv[1:]
+matfile = None
+if '-m' in args:
+	i       = args.index('-m')
+	matfile = args[i + 1]
+	del args[i:i + 2]
+
+bagfile = args[0]
+flights = args[1:]
+
+# Must match FlightRecorderFileHeader and FlightRecorderTopic
+HEADER_FORMAT = '<8sIIIIQQQ'
+HEADER_SIZE   = struct.calcsize(HEADER_FORMAT)
+TOPIC_FORMAT  = '<128s128s40sII'
+TOPIC_SIZE    = struct.calcsize(TOPIC_FORMAT)
+MAGIC         = 'ATRFLT01'
+VERSION       = 2
+
+def cstr(s):
+	return s.split('\0', 1)[0]
+
+# Stands in for the generated message class when writing raw messages.
+def makePyType(datatype, md5sum, definition):
+	return type(str(datatype.replace('/', '__')), (object,),
+	            {'_type': datatype, '_md5sum': md5sum, '_full_text': definition})
+
+def readFlight(filename):
+	data = open(filename, 'rb').read()
+	(magic, version, headerSize, recordSize, topicCount, capacity,
+	 writeCount, dropCount) = struct.unpack_from(HEADER_FORMAT, data)
+
+	if magic != MAGIC:
+		sys.exit(filename + " is not a flight recorder file.")
+	if version != VERSION:
+		sys.exit(filename + " is version %d; this reads version %d." % (version, VERSION))
+
+	topics = []
+	for i in xrange(topicCount):
+		(topic, datatype, md5sum, definitionOffset,
+		 definitionSize) = struct.unpack_from(TOPIC_FORMAT, data, HEADER_SIZE + i * TOPIC_SIZE)
+		topic      = cstr(topic)
+		datatype   = cstr(datatype)
+		md5sum     = cstr(md5sum)
+		definition = data[definitionOffset:definitionOffset + definitionSize]
+		topics.append((topic, datatype, md5sum, makePyType(datatype, md5sum, definition)))
+
+	# Only the last capacity records survive once the ring wraps.
+	first = max(0, writeCount - capacity)
+	print("%s: %s, %d records, %d lost to wrapping, %d dropped" %
+	      (filename, ', '.join(t[0] for t in topics), writeCount - first, first, dropCount))
+
+	for n in xrange(first, writeCount):
+		offset        = headerSize + (n % capacity) * recordSize
+		length, index = struct.unpack_from('<II', data, offset)
+		raw           = data[offset + 8:offset + 8 + length]
+		topic, datatype, md5sum, pytype = topics[index]
+
+		# All our logged messages start with a Header; stamp them with it.
+		seq, sec, nsec = struct.unpack_from('<III', raw)
+		yield topic, (datatype, raw, md5sum, pytype), genpy.rostime.Time(sec, nsec)
+
+# Merge the files in time order so the bag reads sequentially.
+messages = []
+for filename in flights:
+	messages.extend(readFlight(filename))
+messages.sort(key=lambda m: m[2])
+
+with rosbag.Bag(bagfile, 'w') as outbag:
+	for topic, raw, t in messages:
+		outbag.write(topic, raw, t, raw=True)
+
+print("Wrote " + bagfile)
+
+if matfile:
+	from load_bag import BagLoader
+	BagLoader(bagfile).save_mat(matfile)
+	print("Wrote " + matfile)
+
+# vim: noexpandtab
@@ -19,6 +19,8 @@ ToSubstituteClassName::ToSubstituteClassName(AtriasController *parent, string na
 }
 
 double ToSubstituteClassName::operator()() {
+	ProfileScope scope(this);
+
 	// Transmit the log data
 	log_out.send();
 
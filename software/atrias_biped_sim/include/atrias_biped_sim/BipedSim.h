@@ -0,0 +1,192 @@
+#ifndef BIPEDSIM_H
+#define BIPEDSIM_H
+
+/** @file
+  * @brief A reduced-order simulation of the planar ATRIAS biped, fast enough
+  * to run controllers many times faster than realtime without Gazebo.
+  *
+  * The body is a planar rigid body on the hip. Each leg half is a motor
+  * driving its leg segment through the series spring; the segments form the
+  * four-bar leg, and its toe touches a compliant ground with Coulomb
+  * friction. The boom may hold the body's pitch, or its pitch and horizontal
+  * position, as the Gazebo hopping and walking constraints do. Everything is
+  * integrated with fixed-step semi-implicit Euler, several steps per
+  * controller cycle.
+  *
+  * Angles follow the robot state's conventions: the segments' angles are
+  * relative to the body, and added to the body pitch give their angles in
+  * the world, as in atrias_control_lib's LegKinematics. Internally the
+  * motors and segments are integrated in the world frame.
+  *
+  * This library has no Orocos dependency, so it can be stepped directly
+  * (see src/biped_sim_bench.cpp) as well as through CSimConn.
+  */
+
+#include <stdint.h>
+
+#include <atrias_msgs/robot_state.h>
+#include <atrias_msgs/controller_output.h>
+
+namespace atrias {
+
+namespace bipedSim {
+
+/** @brief The type for \a BoomMode.
+  */
+typedef uint8_t BoomMode_t;
+
+/** @brief What the boom holds fixed.
+  */
+enum class BoomMode: BoomMode_t {
+	HOPPING = 0, // Pitch and horizontal position, like hopping_constraint.cpp
+	WALKING,     // Pitch, like walking_constraint.cpp
+	FREE         // Nothing; the body pitches freely
+};
+
+/** @brief The sim's physical parameters. The defaults are ATRIAS's.
+  */
+struct BipedSimParams {
+	/** @brief Sets the defaults.
+	  */
+	BipedSimParams();
+
+	/** @brief The body's mass (kg) and pitch inertia (kg*m^2).
+	  */
+	double   bodyMass;
+	double   bodyInertia;
+
+	/** @brief The inertia of each motor as seen at the gearbox output
+	  * (kg*m^2), and its Coulomb friction (N*m).
+	  */
+	double   motorInertia;
+	double   motorFriction;
+
+	/** @brief Each leg segment's inertia about the hip (kg*m^2).
+	  */
+	double   segmentInertia;
+
+	/** @brief The series springs' stiffness (N*m/rad) and damping (N*m*s/rad).
+	  */
+	double   springStiffness;
+	double   springDamping;
+
+	/** @brief The ground's stiffness (N/m) and damping (N*s/m), vertically
+	  * and horizontally, and its friction coefficient.
+	  */
+	double   groundStiffness;
+	double   groundDamping;
+	double   groundFriction;
+
+	/** @brief The hip's starting height (m) and horizontal speed (m/s).
+	  */
+	double   initialHeight;
+	double   initialVelocity;
+
+	/** @brief Below this hip height (m) the robot is counted as fallen.
+	  */
+	double   fallHeight;
+
+	/** @brief What the boom holds fixed.
+	  */
+	BoomMode boomMode;
+
+	/** @brief Integration steps per controller cycle. With the default
+	  * ground stiffness, fewer than about 5 lets the contact go unstable.
+	  */
+	int      substeps;
+};
+
+class BipedSim {
+	public:
+		/** @brief Creates the sim, in its initial state.
+		  * @param params The physical parameters.
+		  */
+		BipedSim(const BipedSimParams &params = BipedSimParams());
+
+		/** @brief Puts the robot back in its initial state: standing straight,
+		  * motors and springs at rest, its toes above the ground.
+		  */
+		void reset();
+
+		/** @brief Returns the parameters. Changes take effect at the next step,
+		  * except for the initial conditions, which take effect at the next reset.
+		  */
+		BipedSimParams& getParams();
+
+		/** @brief Simulates one controller cycle with the given motor currents.
+		  * @param output The controller output; its leg currents are applied.
+		  */
+		void step(const atrias_msgs::controller_output &output);
+
+		/** @brief Fills in the robot state's legs and position. The header,
+		  * RT Ops state and other bookkeeping are left to the caller.
+		  */
+		void getState(atrias_msgs::robot_state &state) const;
+
+		/** @brief The hip's position (m).
+		  */
+		double getBodyX() const;
+		double getBodyZ() const;
+
+		/** @brief The number of times a toe has touched down.
+		  */
+		int getTouchdowns() const;
+
+		/** @brief Whether the hip has ever dropped below \a fallHeight.
+		  */
+		bool hasFallen() const;
+
+	private:
+		/** @brief The leg halves: left A, left B, right A, right B.
+		  */
+		static const int HALVES = 4;
+
+		BipedSimParams params;
+
+		/** @brief The body's position and pitch, and their velocities.
+		  */
+		double x, z, pitch;
+		double dx, dz, dpitch;
+
+		/** @brief Each half's motor and segment angles in the world frame,
+		  * and their velocities.
+		  */
+		double motor[HALVES], dmotor[HALVES];
+		double segment[HALVES], dsegment[HALVES];
+
+		/** @brief Each half's segment length; A is the distal length, as in
+		  * LegKinematics.
+		  */
+		double length[HALVES];
+
+		/** @brief Whether each toe is on the ground, and where its friction
+		  * spring is anchored.
+		  */
+		bool   onGround[2];
+		double anchor[2];
+
+		int    touchdowns;
+		bool   fallen;
+
+		/** @brief Runs one integration step of \a h seconds.
+		  * @param current Each half's motor current.
+		  */
+		void integrate(const double current[HALVES], double h);
+
+		/** @brief Computes the ground's force on one toe, updating its contact.
+		  * @param leg Which leg.
+		  * @param sn  The sines of the leg's halves' world angles.
+		  * @param cs  Their cosines.
+		  * @param fx  Set to the horizontal force.
+		  * @param fz  Set to the vertical force.
+		  */
+		void contactForce(int leg, const double sn[2], const double cs[2], double &fx, double &fz);
+};
+
+}
+
+}
+
+#endif // BIPEDSIM_H
+
+// vim: noexpandtab
@@ -0,0 +1,231 @@
+#include "atrias_biped_sim/BipedSim.h"
+
+#include <math.h>
+
+#include <algorithm>
+
+#include <atrias_shared/globals.h>
+#include <robot_invariant_defs.h>
+
+// Leg geometry, spring stiffness, motor constants, mass and gravity.
+// Included last, as it defines some short macro names.
+#include <atrias_shared/atrias_parameters.h>
+
+namespace atrias {
+
+namespace bipedSim {
+
+/** @brief The same current CSimConn takes to start a motor moving (amps).
+  */
+#define BIPED_SIM_FRICTION_AMPS 5.0
+
+/** @brief The boom angle reported to controllers, as the Gazebo biped does.
+  */
+#define BIPED_SIM_BOOM_ANGLE 3.05
+
+BipedSimParams::BipedSimParams() {
+	bodyMass        = M;
+	bodyInertia     = 2.2;
+	motorInertia    = KT * KG / ACCEL_PER_AMP;
+	motorFriction   = BIPED_SIM_FRICTION_AMPS * KT * KG;
+	segmentInertia  = 0.1;
+	springStiffness = KS;
+	springDamping   = 1.0;
+	groundStiffness = 1e5;
+	groundDamping   = 1500.0;
+	groundFriction  = 1.0;
+	initialHeight   = 0.9;
+	initialVelocity = 0.0;
+	fallHeight      = 0.3;
+	boomMode        = BoomMode::WALKING;
+	substeps        = 10;
+}
+
+BipedSim::BipedSim(const BipedSimParams &params) :
+          params(params)
+{
+	// A is the distal segment (L2) and B the proximal (L1), as in LegKinematics
+	length[0] = length[2] = L2;
+	length[1] = length[3] = L1;
+
+	reset();
+}
+
+void BipedSim::reset() {
+	x      = 0.0;
+	z      = params.initialHeight;
+	pitch  = 1.5 * M_PI;
+	dx     = (params.boomMode == BoomMode::HOPPING) ? 0.0 : params.initialVelocity;
+	dz     = 0.0;
+	dpitch = 0.0;
+
+	for (int i = 0; i < HALVES; i++) {
+		segment[i]  = motor[i] = pitch + ((i % 2) ? .75 * M_PI : .25 * M_PI);
+		dsegment[i] = dmotor[i] = 0.0;
+	}
+
+	for (int leg = 0; leg < 2; leg++) {
+		onGround[leg] = false;
+		anchor[leg]   = 0.0;
+	}
+
+	touchdowns = 0;
+	fallen     = false;
+}
+
+BipedSimParams& BipedSim::getParams() {
+	return params;
+}
+
+void BipedSim::contactForce(int leg, const double sn[2], const double cs[2], double &fx, double &fz) {
+	const double* l  = &length[2 * leg];
+	const double* dq = &dsegment[2 * leg];
+
+	// The toe, relative to the hip, is at -(l_A sin A + l_B sin B, l_A cos A + l_B cos B).
+	double px = x - l[0] * sn[0] - l[1] * sn[1];
+	double pz = z - l[0] * cs[0] - l[1] * cs[1];
+
+	fx = fz = 0.0;
+	if (pz > 0.0) {
+		onGround[leg] = false;
+		return;
+	}
+
+	if (!onGround[leg]) {
+		onGround[leg] = true;
+		anchor[leg]   = px;
+		touchdowns++;
+	}
+
+	double vx = dx - l[0] * cs[0] * dq[0] - l[1] * cs[1] * dq[1];
+	double vz = dz + l[0] * sn[0] * dq[0] + l[1] * sn[1] * dq[1];
+
+	// The ground pushes but doesn't pull.
+	fz = std::max(0.0, -params.groundStiffness * pz - params.groundDamping * vz);
+
+	// Friction holds the toe to where it landed, until it would take more
+	// than the friction cone allows; then the toe slides, dragging the anchor.
+	fx = -params.groundStiffness * (px - anchor[leg]) - params.groundDamping * vx;
+	double maxFx = params.groundFriction * fz;
+	if (fabs(fx) > maxFx) {
+		fx          = copysign(maxFx, fx);
+		anchor[leg] = px + (fx + params.groundDamping * vx) / params.groundStiffness;
+	}
+}
+
+void BipedSim::integrate(const double current[HALVES], double h) {
+	double sn[HALVES], cs[HALVES];
+	for (int i = 0; i < HALVES; i++)
+		sincos(segment[i], &sn[i], &cs[i]);
+
+	double fx[2], fz[2];
+	for (int leg = 0; leg < 2; leg++)
+		contactForce(leg, &sn[2 * leg], &cs[2 * leg], fx[leg], fz[leg]);
+
+	double bodyTorque = 0.0;
+	for (int i = 0; i < HALVES; i++) {
+		int    leg    = i / 2;
+		double spring = params.springStiffness * (motor[i] - segment[i]) +
+		                params.springDamping   * (dmotor[i] - dsegment[i]);
+		double drive  = KT * KG * current[i];
+
+		// Friction acts on the motor's speed relative to the body; take just
+		// enough of it, up to its limit, to stop the motor this step.
+		double relVel   = dmotor[i] - dpitch + h * (drive - spring) / params.motorInertia;
+		double friction = -std::max(-params.motorFriction,
+		                  std::min(params.motorFriction, params.motorInertia * relVel / h));
+
+		// The ground pushes the toe along the segment's Jacobian.
+		double toeTorque = length[i] * (sn[i] * fz[leg] - cs[i] * fx[leg]);
+
+		dmotor[i]   += h * (drive + friction - spring) / params.motorInertia;
+		dsegment[i] += h * (spring + toeTorque)        / params.segmentInertia;
+		bodyTorque  -= drive + friction;
+	}
+
+	dx += h * (fx[0] + fx[1]) / params.bodyMass;
+	dz += h * ((fz[0] + fz[1]) / params.bodyMass - G);
+	if (params.boomMode == BoomMode::FREE)
+		dpitch += h * bodyTorque / params.bodyInertia;
+	else
+		dpitch  = 0.0;
+	if (params.boomMode == BoomMode::HOPPING)
+		dx      = 0.0;
+
+	// Semi-implicit: the positions move with the new velocities.
+	x     += h * dx;
+	z     += h * dz;
+	pitch += h * dpitch;
+	for (int i = 0; i < HALVES; i++) {
+		motor[i]   += h * dmotor[i];
+		segment[i] += h * dsegment[i];
+	}
+}
+
+void BipedSim::step(const atrias_msgs::controller_output &output) {
+	double current[HALVES] = {
+		output.lLeg.motorCurrentA, output.lLeg.motorCurrentB,
+		output.rLeg.motorCurrentA, output.rLeg.motorCurrentB
+	};
+
+	int    substeps = std::max(1, params.substeps);
+	double h        = ((double) CONTROLLER_LOOP_PERIOD_NS) / ((double) SECOND_IN_NANOSECONDS) / substeps;
+	for (int i = 0; i < substeps; i++)
+		integrate(current, h);
+
+	if (z < params.fallHeight)
+		fallen = true;
+}
+
+void BipedSim::getState(atrias_msgs::robot_state &state) const {
+	atrias_msgs::robot_state_leg* legs[2] = {&state.lLeg, &state.rLeg};
+	for (int leg = 0; leg < 2; leg++) {
+		atrias_msgs::robot_state_legHalf* halves[2] = {&legs[leg]->halfA, &legs[leg]->halfB};
+		for (int side = 0; side < 2; side++) {
+			int i = 2 * leg + side;
+			halves[side]->legAngle      = segment[i]  - pitch;
+			halves[side]->legVelocity   = dsegment[i] - dpitch;
+			halves[side]->motorAngle    = motor[i]    - pitch;
+			halves[side]->motorVelocity = dmotor[i]   - dpitch;
+			halves[side]->rotorAngle    = halves[side]->motorAngle;
+			halves[side]->rotorVelocity = halves[side]->motorVelocity;
+		}
+
+		// The sim is planar; the hips stay vertical.
+		legs[leg]->hip.legBodyAngle    = 1.5 * M_PI;
+		legs[leg]->hip.legBodyVelocity = 0.0;
+
+		legs[leg]->onGround  = onGround[leg];
+		legs[leg]->toeSwitch = onGround[leg] ? 1 : 0;
+	}
+
+	state.position.xPosition         = x;
+	state.position.zPosition         = z;
+	state.position.xVelocity         = dx;
+	state.position.zVelocity         = dz;
+	state.position.bodyPitch         = pitch;
+	state.position.bodyPitchVelocity = dpitch;
+	state.position.boomAngle         = BIPED_SIM_BOOM_ANGLE;
+}
+
+double BipedSim::getBodyX() const {
+	return x;
+}
+
+double BipedSim::getBodyZ() const {
+	return z;
+}
+
+int BipedSim::getTouchdowns() const {
+	return touchdowns;
+}
+
+bool BipedSim::hasFallen() const {
+	return fallen;
+}
+
+}
+
+}
+
+// vim: noexpandtab
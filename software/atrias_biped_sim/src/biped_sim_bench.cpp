@@ -0,0 +1,174 @@
+/** @file
+  * @brief Drops the biped onto the ground under a simple leg controller, in
+  * each boom mode, checks where it comes to rest, and reports how much faster
+  * than realtime the sim ran.
+  *
+  * The controller holds each motor at its starting angle with a PD loop, as a
+  * leg position controller would. With the boom holding its pitch, the robot
+  * should land, bounce, and settle standing on both legs with its springs
+  * taking its weight: its height and spring deflections, averaged over the
+  * last second, must be near the static solution, and it mustn't have
+  * fallen. With the boom off nothing balances the body's pitch, so it must
+  * fall over.
+  *
+  * Exits with a nonzero status if a check fails.
+  */
+
+#include <stdio.h>
+#include <time.h>
+#include <math.h>
+
+#include <algorithm>
+
+#include "atrias_biped_sim/BipedSim.h"
+
+// Leg lengths, motor constants and gravity. Included last, as it defines
+// some short macro names.
+#include <atrias_shared/atrias_parameters.h>
+
+using namespace atrias::bipedSim;
+
+#define BENCH_CYCLES   20000  // 20 seconds; the body's bounce is lightly damped
+#define BENCH_SETTLED  1000   // The last second, averaged
+#define BENCH_KP       500.0  // amps per radian
+#define BENCH_KD       20.0   // amps per radian per second
+#define BENCH_MAX_AMPS 60.0
+
+// How far the settled robot may be from the static solution. The motors'
+// friction may hold them about 0.01 rad from where the PD loop alone would.
+#define BENCH_Z_TOL          0.005 // m
+#define BENCH_DEFLECTION_TOL 0.01  // rad
+#define BENCH_MAX_DZ         0.05  // m/s, over the last second
+
+static double now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static double pd(const atrias_msgs::robot_state_legHalf &half, double target) {
+	double current = BENCH_KP * (target - half.motorAngle) - BENCH_KD * half.motorVelocity;
+	return std::max(-BENCH_MAX_AMPS, std::min(BENCH_MAX_AMPS, current));
+}
+
+/** @brief Solves for the robot standing still on both legs, each taking half
+  * its weight, with each motor where the PD loop's current balances its
+  * spring. Motor and toe friction are ignored.
+  * @param params     The sim's parameters.
+  * @param pitch      The body pitch.
+  * @param target     The PD loop's motor angles, A and B.
+  * @param z          Set to the hip's height.
+  * @param deflection Set to each half's spring deflection (leg less motor angle).
+  */
+static void standing(const BipedSimParams &params, double pitch, const double target[2],
+                     double &z, double deflection[2])
+{
+	// As in BipedSim: A is the distal segment, and the toe force acts on
+	// each segment through its length and world angle.
+	const double length[2] = {L2, L1};
+	double fz = params.bodyMass * G / 2.0;
+	double segment[2] = {target[0], target[1]};
+	for (int i = 0; i < 100; i++) {
+		for (int half = 0; half < 2; half++) {
+			deflection[half] = length[half] * sin(segment[half] + pitch) * fz / params.springStiffness;
+			double motor = target[half] + params.springStiffness * deflection[half] / (KT * KG * BENCH_KP);
+			segment[half] = motor + deflection[half];
+		}
+	}
+
+	z = length[0] * cos(segment[0] + pitch) + length[1] * cos(segment[1] + pitch) - fz / params.groundStiffness;
+}
+
+/** @brief Runs the sim in one boom mode and checks the result.
+  * @return The number of failed checks.
+  */
+static int run(const char* name, BoomMode mode) {
+	BipedSimParams params;
+	params.boomMode = mode;
+
+	BipedSim                       sim(params);
+	atrias_msgs::robot_state       state;
+	atrias_msgs::controller_output output;
+
+	sim.getState(state);
+	double target[2] = {state.lLeg.halfA.motorAngle, state.lLeg.halfB.motorAngle};
+	double pitch     = state.position.bodyPitch;
+
+	double z = 0.0, deflection[2] = {0.0, 0.0}, maxDz = 0.0;
+	double start = now();
+	for (int cycle = 0; cycle < BENCH_CYCLES; cycle++) {
+		output.lLeg.motorCurrentA = pd(state.lLeg.halfA, target[0]);
+		output.lLeg.motorCurrentB = pd(state.lLeg.halfB, target[1]);
+		output.rLeg.motorCurrentA = pd(state.rLeg.halfA, target[0]);
+		output.rLeg.motorCurrentB = pd(state.rLeg.halfB, target[1]);
+		sim.step(output);
+		sim.getState(state);
+
+		if (cycle >= BENCH_CYCLES - BENCH_SETTLED) {
+			z             += sim.getBodyZ() / BENCH_SETTLED;
+			deflection[0] += (state.lLeg.halfA.legAngle - state.lLeg.halfA.motorAngle) / BENCH_SETTLED;
+			deflection[1] += (state.lLeg.halfB.legAngle - state.lLeg.halfB.motorAngle) / BENCH_SETTLED;
+			maxDz          = std::max(maxDz, fabs(state.position.zVelocity));
+		}
+	}
+	double elapsed = now() - start;
+
+	printf("%-8s z = %.4f m, x = %+.4f m, pitch = %.4f, deflection A = %+.4f B = %+.4f rad, "
+	       "%d touchdowns%s, %.0fx realtime\n",
+	       name, z, sim.getBodyX(), state.position.bodyPitch, deflection[0], deflection[1],
+	       sim.getTouchdowns(), sim.hasFallen() ? ", fell" : "",
+	       BENCH_CYCLES * 0.001 / elapsed);
+
+	int failures = 0;
+	if (mode == BoomMode::FREE) {
+		if (!sim.hasFallen()) {
+			printf("FAIL: %s: didn't fall with nothing balancing its pitch\n", name);
+			failures++;
+		}
+		return failures;
+	}
+
+	double expectedZ, expectedDeflection[2];
+	standing(params, pitch, target, expectedZ, expectedDeflection);
+	printf("%-8s expected z = %.4f m, deflection A = %+.4f B = %+.4f rad\n",
+	       "", expectedZ, expectedDeflection[0], expectedDeflection[1]);
+
+	if (sim.hasFallen()) {
+		printf("FAIL: %s: fell\n", name);
+		failures++;
+	}
+	if (fabs(z - expectedZ) > BENCH_Z_TOL) {
+		printf("FAIL: %s: settled at %.4f m, not %.4f m\n", name, z, expectedZ);
+		failures++;
+	}
+	for (int half = 0; half < 2; half++) {
+		if (fabs(deflection[half] - expectedDeflection[half]) > BENCH_DEFLECTION_TOL) {
+			printf("FAIL: %s: half %c deflected %.4f rad, not %.4f rad\n",
+			       name, half ? 'B' : 'A', deflection[half], expectedDeflection[half]);
+			failures++;
+		}
+	}
+	if (maxDz > BENCH_MAX_DZ) {
+		printf("FAIL: %s: still moving at %.4f m/s\n", name, maxDz);
+		failures++;
+	}
+
+	return failures;
+}
+
+int main() {
+	int failures = 0;
+	failures += run("hopping", BoomMode::HOPPING);
+	failures += run("walking", BoomMode::WALKING);
+	failures += run("free",    BoomMode::FREE);
+
+	if (failures) {
+		printf("%d failures\n", failures);
+		return 1;
+	}
+
+	printf("All passed\n");
+	return 0;
+}
+
+// vim: noexpandtab
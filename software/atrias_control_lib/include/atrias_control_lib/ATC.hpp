@@ -16,8 +16,12 @@
 #include <rtt/OutputPort.hpp>      // So we can send data.
 #include <rtt/TaskContext.hpp>     // We're a component aka TaskContext
 
+// Standard library
+#include <vector>
+
 // Robot state and controller output
 #include <atrias_msgs/controller_output.h>
+#include <atrias_msgs/controller_profile.h>
 #include <atrias_msgs/robot_state.h>
 #include <atrias_msgs/unused.h>
 
@@ -34,6 +38,10 @@
 
 // We subclass this, so let's include it
 #include "atrias_control_lib/AtriasController.hpp"
+// The leg kinematics, computed once per cycle for everyone
+#include "atrias_control_lib/LegKinematics.hpp"
+// Lower-rate work, off the control thread
+#include "atrias_control_lib/SlowTask.hpp"
 
 // Our namespaces
 namespace atrias {
@@ -74,8 +82,7 @@ class ATC : public RTT::TaskContext, public AtriasController {
 		  * @brief Returns a ROS header with the current timestamp.
 		  * @return A ROS header for logging purposes.
 		  */
-		//const std_msgs::Header_<RTT::os::rt_allocator<uint8_t>>& getROSHeader() const;
-		const std_msgs::Header& getROSHeader() const;
+		const std_msgs::Header_<MsgAllocator>& getROSHeader() const;
 
 		/**
 		  * @brief This returns the TaskContext
@@ -114,18 +121,27 @@ class ATC : public RTT::TaskContext, public AtriasController {
 		  */
 		bool isStarting() const;
 
+		/**
+		  * @brief Registers a task to run alongside this controller, at its
+		  * own rate on its own thread. It's started and stopped with this
+		  * component. Call this from the constructor.
+		  * @param task The task.
+		  */
+		void addSlowTask(SlowTask &task);
+
 		// These member variables should be set/read from by
 		// the controllers themselves.
-		/*logType<RTT::os::rt_allocator<uint8_t>>    logOut;
-		guiInType<RTT::os::rt_allocator<uint8_t>>  guiIn;
-		guiOutType<RTT::os::rt_allocator<uint8_t>> guiOut;*/
-		logType<std::allocator<void>>    logOut;
-		guiInType<std::allocator<void>>  guiIn;
-		guiOutType<std::allocator<void>> guiOut;
+		logType<MsgAllocator>    logOut;
+		guiInType<MsgAllocator>  guiIn;
+		guiOutType<MsgAllocator> guiOut;
 
 		// Here is the robot state
 		atrias_msgs::robot_state rs;
 
+		// And the legs' kinematics, updated from it every cycle. Pass
+		// this to subcontrollers rather than having them recompute it.
+		LegKinematics<> legKinematics;
+
 		// And the controller output
 		atrias_msgs::controller_output co;
 
@@ -150,21 +166,17 @@ class ATC : public RTT::TaskContext, public AtriasController {
 		//RTT::TaskContext& getTaskContext() const;
 
 		// Port for input data from the GUI
-		//RTT::InputPort<guiInType<RTT::os::rt_allocator<uint8_t>>>   guiInPort;
-		RTT::InputPort<guiInType<std::allocator<void>>>   guiInPort;
+		RTT::InputPort<guiInType<MsgAllocator>>   guiInPort;
 
 		// Port to send data to the GUI
-		//RTT::OutputPort<guiOutType<RTT::os::rt_allocator<uint8_t>>> guiOutPort;
-		RTT::OutputPort<guiOutType<std::allocator<void>>> guiOutPort;
+		RTT::OutputPort<guiOutType<MsgAllocator>> guiOutPort;
 
 		// Temporary header copy, so getROSHeader() can return a reference
 		// In the new event system, everything will be RT-safe, so this won't be necessary
-		//std_msgs::Header_<RTT::os::rt_allocator<uint8_t>> header;
-		std_msgs::Header header;
+		std_msgs::Header_<MsgAllocator> header;
 
 		// Port for logging controller data
-		//RTT::OutputPort<logType<RTT::os::rt_allocator<uint8_t>>>    logOutPort;
-		RTT::OutputPort<logType<std::allocator<void>>>    logOutPort;
+		RTT::OutputPort<logType<MsgAllocator>>    logOutPort;
 
 		/**
 		  * @brief This callback is executed when data is received from the GUI
@@ -180,11 +192,29 @@ class ATC : public RTT::TaskContext, public AtriasController {
 		  * @param robotState The new robot state
 		  * @return           The new controller output.
 		  */
-		atrias_msgs::controller_output& runController(atrias_msgs::robot_state& robotState);
+		atrias_msgs::controller_output& runController(const atrias_msgs::robot_state& robotState);
 
 		// This lets us send RT Ops events
 		RTT::OperationCaller<void(rtOps::RtOpsEvent, rtOps::RtOpsEventMetadata_t)> sendEventOp;
 
+		// Port for the profiler's summaries
+		RTT::OutputPort<atrias_msgs::controller_profile> profileOutPort;
+
+		// The profiler summary being published
+		atrias_msgs::controller_profile profileMsg;
+
+		// Times the publishing of the profiler summary
+		atrias::shared::GuiPublishTimer profilePublishTimer;
+
+		// Lets us run publishProfile() outside the RT thread
+		RTT::OperationCaller<void(void)> publishProfileCaller;
+
+		/**
+		  * @brief Publishes the profiler's summary.
+		  * Runs in this component's own (non-realtime) thread.
+		  */
+		void publishProfile();
+
 		/**
 		  * @brief This is the state enum for the startup/shutdown state machine.
 		  */
@@ -211,6 +241,22 @@ class ATC : public RTT::TaskContext, public AtriasController {
 		  * @brief This connects to RT Ops, so it can call this controller.
 		  */
 		bool configureHook();
+
+		// The tasks from addSlowTask()
+		std::vector<SlowTask*> slowTasks;
+
+		// If nonzero, the CPUs (a bitmask) for the slow tasks
+		unsigned int slowTaskCpuAffinity;
+
+		/**
+		  * @brief Starts the slow tasks.
+		  */
+		bool startHook();
+
+		/**
+		  * @brief Stops the slow tasks, waiting for each to finish its step.
+		  */
+		void stopHook();
 };
 
 template <template <class> class logType,
@@ -220,7 +266,8 @@ ATC<logType, guiInType, guiOutType>::ATC(const std::string &name) :
 	RTT::TaskContext(name),
 	AtriasController(name),
 	publishTimer(50), // The parameter is the transmit period in ms
-	sendEventOp("sendEvent")
+	sendEventOp("sendEvent"),
+	profilePublishTimer(PROFILE_PUBLISH_PERIOD_MS)
 {
 	// We initialize to run mode
 	this->mode = State::RUN;
@@ -228,6 +275,10 @@ ATC<logType, guiInType, guiOutType>::ATC(const std::string &name) :
 	// By default, the startup controller is disabled
 	this->startupEnabled = false;
 
+	this->slowTaskCpuAffinity = 0;
+	this->addProperty("slowTaskCpuAffinity", this->slowTaskCpuAffinity)
+		.doc("If nonzero, the CPUs (a bitmask) for the slow tasks.");
+
 	// Register the operation runController()
 	this->provides("atc")
 		->addOperation("runController", &ATC<logType, guiInType, guiOutType>::runController, this, RTT::ClientThread)
@@ -236,13 +287,46 @@ ATC<logType, guiInType, guiOutType>::ATC(const std::string &name) :
 	// Connect with the sendEvent operation
 	this->requires("rtOps")->addOperationCaller(this->sendEventOp);
 
+	// Let the profiler be driven from the deployer
+	ControllerProfiler &profiler = this->getProfiler();
+	this->provides("profiler")
+		->addOperation("setProfiling", &ControllerProfiler::setEnabled, &profiler, RTT::ClientThread)
+		.doc("Enable or disable timing of this controller and its subcontrollers.");
+	this->provides("profiler")
+		->addOperation("getProfile", &ControllerProfiler::summary, &profiler, RTT::ClientThread)
+		.doc("Returns a table of the time used by each subcontroller.");
+	this->provides("profiler")
+		->addOperation("resetProfile", &ControllerProfiler::reset, &profiler, RTT::ClientThread)
+		.doc("Clear the profiling statistics.");
+	this->provides("profiler")
+		->addOperation("dumpProfile", &ControllerProfiler::dumpFolded, &profiler, RTT::ClientThread)
+		.doc("Write each subcontroller's total time to a file, in flamegraph.pl's folded format.");
+
+	// Building the summary allocates, so it's published from our own thread.
+	this->addOperation("publishProfile", &ATC<logType, guiInType, guiOutType>::publishProfile, this, RTT::OwnThread)
+		.doc("Publish the profiler's summary.");
+	this->publishProfileCaller = this->getOperation("publishProfile");
+
+	this->addPort("profile", profileOutPort);
+	{
+		// Only the latest summary matters.
+		RTT::ConnPolicy policy = RTT::ConnPolicy();
+
+		// 3 == ROS transport
+		policy.transport = 3;
+		policy.name_id = "/" + this->AtriasController::getName() + "_profile";
+		this->profileOutPort.createStream(policy);
+	}
+
 	// Set up the event port for incoming GUI data (if there is incoming GUI data)
 	if (notUnused<guiInType>()) {
 		log(RTT::Info) << "[" << this->AtriasController::getName()
 		               << "] Setting up GUI input port." << RTT::endlog();
 
+#ifdef ATRIAS_RT_ALLOCATOR
 		// Add typekits for this message type
-		//shared::RtMsgTypekits::registerType<guiInType>(this->AtriasController::getName() + "_input");
+		shared::RtMsgTypekits::registerType<guiInType>(this->AtriasController::getName() + "_input");
+#endif
 
 		this->addEventPort("guiInput", guiInPort, boost::bind(&ATC<logType, guiInType, guiOutType>::guiInCallback, this, _1));
 
@@ -265,8 +349,10 @@ ATC<logType, guiInType, guiOutType>::ATC(const std::string &name) :
 		log(RTT::Info) << "/" << this->AtriasController::getName()
 		               << "] Setting up GUI output port." << RTT::endlog();
 
+#ifdef ATRIAS_RT_ALLOCATOR
 		// Add typekits for this message type
-		//shared::RtMsgTypekits::registerType<guiOutType>(this->AtriasController::getName() + "_status");
+		shared::RtMsgTypekits::registerType<guiOutType>(this->AtriasController::getName() + "_status");
+#endif
 
 		this->addPort("guiOutput", guiOutPort);
 
@@ -291,9 +377,11 @@ ATC<logType, guiInType, guiOutType>::ATC(const std::string &name) :
 		log(RTT::Info) << "/" << this->AtriasController::getName()
 		               << "] Setting up logging port." << RTT::endlog();
 
+#ifdef ATRIAS_RT_ALLOCATOR
 		// Add typekits for this message type
-		//shared::RtMsgTypekits::registerType<logType>(this->AtriasController::getName() + "_log");
-		
+		shared::RtMsgTypekits::registerType<logType>(this->AtriasController::getName() + "_log");
+#endif
+
 		this->addPort("log", logOutPort);
 
 		// Let's connect this port to ROS
@@ -316,8 +404,7 @@ ATC<logType, guiInType, guiOutType>::ATC(const std::string &name) :
 template <template <class> class logType,
           template <class> class guiInType,
           template <class> class guiOutType>
-//const std_msgs::Header_<RTT::os::rt_allocator<uint8_t>>& ATC<logType, guiInType, guiOutType>::getROSHeader() const {
-const std_msgs::Header& ATC<logType, guiInType, guiOutType>::getROSHeader() const {
+const std_msgs::Header_<MsgAllocator>& ATC<logType, guiInType, guiOutType>::getROSHeader() const {
 	return this->header;
 }
 
@@ -370,7 +457,7 @@ void ATC<logType, guiInType, guiOutType>::guiInCallback(RTT::base::PortInterface
 template <template <class> class logType,
           template <class> class guiInType,
           template <class> class guiOutType>
-atrias_msgs::controller_output& ATC<logType, guiInType, guiOutType>::runController(atrias_msgs::robot_state &robotState) {
+atrias_msgs::controller_output& ATC<logType, guiInType, guiOutType>::runController(const atrias_msgs::robot_state &robotState) {
 	// Check for change in state (to trigger the change to startup mode).
 	if (this->startupEnabled                         &&
 	    this->rs.rtOpsState != robotState.rtOpsState &&
@@ -383,6 +470,7 @@ atrias_msgs::controller_output& ATC<logType, guiInType, guiOutType>::runControll
 
 	// Save the robot state so the controller (and this class) can access it.
 	this->rs = robotState;
+	this->legKinematics.update(this->rs);
 
 	// And update header timestamp.
 	this->header.stamp = rs.header.stamp;
@@ -400,8 +488,14 @@ atrias_msgs::controller_output& ATC<logType, guiInType, guiOutType>::runControll
 	co.rLeg.motorCurrentB   = 0.0;
 	co.rLeg.motorCurrentHip = 0.0;
 
-	// Run the controller
-	this->controller();
+	// Run the controller, timing it if we're profiling
+	{
+		ProfileScope scope(this);
+		this->controller();
+	}
+	this->getProfiler().endCycle();
+	if (this->getProfiler().isEnabled() && this->profilePublishTimer.readyToSend())
+		this->publishProfileCaller.send();
 
 	// Transmit the status to the GUI, if it's time.
 	if (notUnused<guiOutType>()) {
@@ -431,6 +525,18 @@ atrias_msgs::controller_output& ATC<logType, guiInType, guiOutType>::runControll
 	return this->co;
 }
 
+template <template <class> class logType,
+          template <class> class guiInType,
+          template <class> class guiOutType>
+void ATC<logType, guiInType, guiOutType>::publishProfile() {
+	RTT::os::TimeService::nsecs now = RTT::os::TimeService::Instance()->getNSecs();
+	this->profileMsg.header.stamp.sec  = now / SECOND_IN_NANOSECONDS;
+	this->profileMsg.header.stamp.nsec = now % SECOND_IN_NANOSECONDS;
+
+	this->getProfiler().fillMessage(this->profileMsg);
+	this->profileOutPort.write(this->profileMsg);
+}
+
 template <template <class> class logType,
           template <class> class guiInType,
           template <class> class guiOutType>
@@ -475,6 +581,13 @@ bool ATC<logType, guiInType, guiOutType>::isStarting() const {
 	return (this->mode == State::STARTUP);
 }
 
+template <template <class> class logType,
+          template <class> class guiInType,
+          template <class> class guiOutType>
+void ATC<logType, guiInType, guiOutType>::addSlowTask(SlowTask &task) {
+	this->slowTasks.push_back(&task);
+}
+
 template <template <class> class logType,
           template <class> class guiInType,
           template <class> class guiOutType>
@@ -484,6 +597,39 @@ bool ATC<logType, guiInType, guiOutType>::configureHook() {
 	return true;
 }
 
+template <template <class> class logType,
+          template <class> class guiInType,
+          template <class> class guiOutType>
+bool ATC<logType, guiInType, guiOutType>::startHook() {
+	for (size_t i = 0; i < this->slowTasks.size(); i++) {
+		if (this->slowTaskCpuAffinity)
+			this->slowTasks[i]->setCpuAffinity(this->slowTaskCpuAffinity);
+
+		if (!this->slowTasks[i]->start()) {
+			log(RTT::Error) << "[" << this->AtriasController::getName()
+			                << "] Failed to start slow task " << i << RTT::endlog();
+
+			// The component won't run, so neither should the others.
+			while (i-- > 0)
+				this->slowTasks[i]->stop();
+			return false;
+		}
+	}
+	return true;
+}
+
+template <template <class> class logType,
+          template <class> class guiInType,
+          template <class> class guiOutType>
+void ATC<logType, guiInType, guiOutType>::stopHook() {
+	for (size_t i = 0; i < this->slowTasks.size(); i++) {
+		this->slowTasks[i]->stop();
+		log(RTT::Info) << "[" << this->AtriasController::getName()
+		               << "] Slow task " << i << " overran its period "
+		               << this->slowTasks[i]->getOverruns() << " times." << RTT::endlog();
+	}
+}
+
 }
 }
 
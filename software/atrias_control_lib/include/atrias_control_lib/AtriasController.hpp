@@ -14,11 +14,15 @@
 
 // Orocos
 #include <rtt/TaskContext.hpp>      // We're not a TaskContext, but we need to reference one.
-#include <rtt/os/oro_allocator.hpp> // For accessing realtime messages.
 
 // ROS
 #include <std_msgs/Header.h> // So we can pass around ROS headers for logging.
 
+// Times each controller in the tree
+#include "atrias_control_lib/ControllerProfiler.hpp"
+// The allocator for our messages
+#include "atrias_control_lib/MsgAllocator.hpp"
+
 // Our namespaces
 namespace atrias {
 namespace controller {
@@ -41,6 +45,24 @@ class AtriasController {
 		  */
 		AtriasController(const std::string &name);
 
+		/**
+		  * @brief Frees the profiler, if this is the top-level controller.
+		  */
+		virtual ~AtriasController();
+
+		/**
+		  * @brief Times a call to this controller while in scope, for the profiler.
+		  * Put one at the top of each of a controller's entry points:
+		  *     ProfileScope scope(this);
+		  * This costs almost nothing while profiling is disabled.
+		  */
+		class ProfileScope : public ControllerProfiler::Scope {
+			public:
+				ProfileScope(const AtriasController * const controller) :
+					ControllerProfiler::Scope(controller->getProfiler(), controller->profileId)
+				{}
+		};
+
 		/**
 		  * @brief This returns the value num clamped between a and b.
 		  * @param num The number to be clamped
@@ -63,8 +85,7 @@ class AtriasController {
 		  * @brief Returns a ROS header with the current timestamp.
 		  * @return A ROS header for logging purposes.
 		  */
-		//virtual const std_msgs::Header_<RTT::os::rt_allocator<uint8_t>>& getROSHeader() const;
-		virtual const std_msgs::Header& getROSHeader() const;
+		virtual const std_msgs::Header_<MsgAllocator>& getROSHeader() const;
 
 		/**
 		  * @brief This returns the TaskContext
@@ -79,12 +100,24 @@ class AtriasController {
 		  */
 		AtriasController &getTLC() const;
 
+		/**
+		  * @brief Returns the profiler shared by this controller's tree.
+		  * @return A reference to the top-level controller's profiler.
+		  */
+		ControllerProfiler& getProfiler() const;
+
 	private:
 		// This controller's (full) name
 		std::string name;
 
 		// A reference to the top-level controller as an AtriasController
 		AtriasController &tlc;
+
+		// The tree's profiler; owned by the top-level controller
+		ControllerProfiler* profiler;
+
+		// This controller's ID in the profiler
+		int profileId;
 };
 
 }
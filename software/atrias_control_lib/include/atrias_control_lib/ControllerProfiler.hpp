@@ -0,0 +1,176 @@
+#ifndef CONTROLLERPROFILER_HPP
+#define CONTROLLERPROFILER_HPP
+
+/**
+  * @file ControllerProfiler.hpp
+  * @brief Measures how much of the cycle each controller in a top-level
+  * controller's tree uses.
+  * Each controller's entry points are timed by a Scope. Time spent in a
+  * nested scope is counted as the inner controller's, so each controller
+  * has both an inclusive time and a "self" time.
+  */
+
+// Standard library
+#include <stdint.h>
+#include <atomic>
+#include <string>
+#include <vector>
+
+// Orocos
+#include <rtt/os/TimeService.hpp> // Our clock
+
+// The summary message
+#include <atrias_msgs/controller_profile.h>
+
+// Our namespaces
+namespace atrias {
+namespace controller {
+
+/**
+  * @brief How often a top-level controller publishes its profile (milliseconds).
+  */
+#define PROFILE_PUBLISH_PERIOD_MS 1000
+
+class ControllerProfiler {
+	public:
+		/**
+		  * @brief Times one call to a controller while in scope.
+		  * Realtime safe. Does nothing if profiling is disabled.
+		  */
+		class Scope {
+			public:
+				/**
+				  * @brief Starts timing a call.
+				  * @param profiler The profiler in which to record the call.
+				  * @param id       The controller's ID (from addController()).
+				  */
+				Scope(ControllerProfiler &profiler, int id);
+
+				/**
+				  * @brief Stops timing the call and records it.
+				  */
+				~Scope();
+
+			private:
+				// Our profiler, or NULL if we're not timing this call
+				ControllerProfiler*         profiler;
+
+				// The controller being timed
+				int                         id;
+
+				// The scope that was active when we started
+				Scope*                      outer;
+
+				// When this call started
+				RTT::os::TimeService::nsecs start;
+
+				// Time spent in nested scopes
+				RTT::os::TimeService::nsecs childTime;
+		};
+
+		/**
+		  * @brief Initializes an empty, disabled profiler.
+		  */
+		ControllerProfiler();
+
+		/**
+		  * @brief Adds a controller to the tree. Not realtime safe.
+		  * @param name   The controller's (full) name.
+		  * @param parent The parent controller's ID, or -1 for the top-level controller.
+		  * @return The new controller's ID.
+		  */
+		int addController(const std::string &name, int parent);
+
+		/**
+		  * @brief Enables or disables profiling.
+		  * @param enable Whether to profile.
+		  */
+		void setEnabled(bool enable);
+
+		/**
+		  * @brief Returns whether profiling is enabled.
+		  */
+		bool isEnabled() const;
+
+		/**
+		  * @brief Clears the statistics at the end of the current cycle.
+		  */
+		void reset();
+
+		/**
+		  * @brief Ends a cycle, folding its times into the statistics.
+		  * Realtime safe; call once per cycle, after the top-level controller
+		  * has run.
+		  */
+		void endCycle();
+
+		/**
+		  * @brief Formats the statistics as a table, one controller per line.
+		  * @return The table.
+		  */
+		std::string summary() const;
+
+		/**
+		  * @brief Fills in a summary message.
+		  * @param msg The message to fill. Its header is not set.
+		  */
+		void fillMessage(atrias_msgs::controller_profile &msg) const;
+
+		/**
+		  * @brief Writes each controller's total self time in the "folded
+		  * stacks" format read by flamegraph.pl.
+		  * @param filename The file to write.
+		  * @return True if successful, false otherwise.
+		  */
+		bool dumpFolded(const std::string &filename) const;
+
+	private:
+		// The statistics for one controller
+		struct Profile {
+			std::string                 name;
+			int                         parent;
+
+			// This cycle's times. Only touched by the RT thread.
+			RTT::os::TimeService::nsecs cycleTime;
+			RTT::os::TimeService::nsecs cycleSelfTime;
+
+			// How many of this controller's scopes are open, so recursive
+			// calls aren't counted twice.
+			int                         depth;
+
+			// Accumulated over all profiled cycles
+			uint64_t                    calls;
+			RTT::os::TimeService::nsecs totalTime;
+			RTT::os::TimeService::nsecs totalSelfTime;
+			RTT::os::TimeService::nsecs maxTime;
+		};
+
+		// Every controller in the tree, indexed by ID. A parent always
+		// comes before its children.
+		std::vector<Profile> profiles;
+
+		// The innermost open scope, or NULL
+		Scope*               current;
+
+		// The number of cycles profiled
+		uint64_t             cycles;
+
+		// Whether we're profiling
+		std::atomic<bool>    enabled;
+
+		// Set by reset(); the statistics are cleared by the RT thread at the end of the cycle
+		std::atomic<bool>    resetRequested;
+
+		/**
+		  * @brief Returns a controller's name relative to its parent.
+		  * @param id The controller's ID.
+		  */
+		std::string shortName(int id) const;
+};
+
+}
+}
+
+#endif // CONTROLLERPROFILER_HPP
+
+// vim: noexpandtab
@@ -0,0 +1,248 @@
+#ifndef LEGKINEMATICS_HPP
+#define LEGKINEMATICS_HPP
+
+/**
+  * @file LegKinematics.hpp
+  * @brief The legs' kinematics, computed once per cycle and shared.
+  * A top-level controller calls update() with the robot state at the start
+  * of its cycle. Every leg half's spring torque, segment angle sines and
+  * cosines, leg length, and leg force are then computed together, in one
+  * pass over the four halves, and its subcontrollers read them from here
+  * rather than each recomputing them.
+  *
+  * The arrays are indexed by leg half: LEFT_A, LEFT_B, RIGHT_A, RIGHT_B.
+  * Per-leg values are indexed by leg: LEFT_LEG, RIGHT_LEG.
+  */
+
+// Standard library
+#include <math.h>
+
+// The robot state
+#include <atrias_msgs/robot_state.h>
+
+// Datatypes
+#include <atrias_shared/controller_structs.h>
+#include <atrias_shared/atrias_parameters.h>
+
+// Our namespaces
+namespace atrias {
+namespace controller {
+
+/**
+  * @brief The parameters of ATRIAS's legs. Substitute another struct with
+  * the same members to use LegKinematics with different legs.
+  */
+struct AtriasLegParameters {
+	// The lengths of the segments driven by motors A and B
+	static constexpr double l1 = L1;
+	static constexpr double l2 = L2;
+
+	// The series spring stiffness (N*m/rad)
+	static constexpr double ks = KS;
+};
+
+/**
+  * @brief Computes a sine and cosine together.
+  */
+inline void legSinCos(double x, double &s, double &c) {
+	// GCC emits a single sincos() call for this.
+	s = sin(x);
+	c = cos(x);
+}
+
+// The scalar conversions, shared with ASCCommonToolkit. Leg lengths are
+// normalized to L1 + L2, as everywhere else.
+
+/**
+  * @brief Converts leg half angles to leg length. The angle is their mean.
+  */
+inline double legLength(double qA, double qB) {
+	return cos((qA - qB)/2.0);
+}
+
+/**
+  * @brief Converts a leg length to the half angle between the leg halves.
+  */
+inline double legHalfSpread(double r) {
+	return acos(r);
+}
+
+/**
+  * @brief Converts leg half velocities to leg length velocity.
+  */
+inline double legLengthVelocity(double qA, double qB, double dqA, double dqB) {
+	return -(sin((qA - qB)/2.0)*(dqA - dqB))/2.0;
+}
+
+/**
+  * @brief Converts leg length velocity to the rate of change of the half
+  * angle between the leg halves.
+  */
+inline double legHalfSpreadVelocity(double r, double dr) {
+	return dr/sqrt(1.0 - r*r);
+}
+
+enum LegHalf {
+	LEFT_A = 0,
+	LEFT_B,
+	RIGHT_A,
+	RIGHT_B,
+	LEG_HALVES
+};
+
+enum Leg {
+	LEFT_LEG = 0,
+	RIGHT_LEG,
+	LEGS
+};
+
+template <class Params = AtriasLegParameters>
+class LegKinematics {
+	public:
+		// Inputs, from the robot state
+		double legAngle[LEG_HALVES];
+		double legVelocity[LEG_HALVES];
+		double motorAngle[LEG_HALVES];
+		double motorVelocity[LEG_HALVES];
+		double bodyPitch;
+		double bodyPitchVelocity;
+
+		// The sine and cosine of each half's segment angle (leg angle plus
+		// body pitch), and that angle's velocity
+		double segmentSin[LEG_HALVES];
+		double segmentCos[LEG_HALVES];
+		double segmentVelocity[LEG_HALVES];
+
+		// Each half's spring torque and its derivative
+		double springTorque[LEG_HALVES];
+		double dSpringTorque[LEG_HALVES];
+
+		// Each leg's angle and (normalized) length, and their velocities
+		double q[LEGS], r[LEGS];
+		double dq[LEGS], dr[LEGS];
+
+		// Each leg's force on the ground, from its spring torques
+		LegForce force[LEGS];
+
+		/**
+		  * @brief Computes everything for both legs. Realtime safe.
+		  * @param rs The robot state.
+		  */
+		void update(const atrias_msgs::robot_state &rs) {
+			load(LEFT_LEG, rs.lLeg);
+			load(RIGHT_LEG, rs.rLeg);
+			bodyPitch = rs.position.bodyPitch;
+			bodyPitchVelocity = rs.position.bodyPitchVelocity;
+
+			computeHalves(0, LEG_HALVES);
+			computeLeg(LEFT_LEG);
+			computeLeg(RIGHT_LEG);
+		}
+
+		/**
+		  * @brief Computes everything for one leg. Realtime safe.
+		  * @param leg      Which leg.
+		  * @param legState The leg's state.
+		  * @param position The robot's position, for the body pitch.
+		  */
+		void updateLeg(Leg leg, const atrias_msgs::robot_state_leg &legState, const atrias_msgs::robot_state_location &position) {
+			load(leg, legState);
+			bodyPitch = position.bodyPitch;
+			bodyPitchVelocity = position.bodyPitchVelocity;
+
+			computeHalves(2*leg, 2*leg + 2);
+			computeLeg(leg);
+		}
+
+		/**
+		  * @brief Computes the spring torques needed to exert a force with a
+		  * leg, using the Jacobian transpose. Realtime safe.
+		  * @param leg    Which leg.
+		  * @param f      The desired force and its derivative.
+		  * @param taus   Set to the spring torques, for halves A and B.
+		  * @param dtaus  Set to the spring torques' derivatives.
+		  */
+		void jacobianTranspose(Leg leg, const LegForce &f, double taus[2], double dtaus[2]) const {
+			const double l[2] = {Params::l2, Params::l1};
+			for (int i = 0; i < 2; i++) {
+				int h = 2*leg + i;
+				taus[i] = l[i]*(f.fz*segmentSin[h] - f.fx*segmentCos[h]);
+				dtaus[i] = l[i]*((f.fx*segmentSin[h] + f.fz*segmentCos[h])*segmentVelocity[h] +
+				                 f.dfz*segmentSin[h] - f.dfx*segmentCos[h]);
+			}
+		}
+
+	private:
+		/**
+		  * @brief Copies one leg's state into the arrays.
+		  */
+		void load(Leg leg, const atrias_msgs::robot_state_leg &legState) {
+			int a = 2*leg;
+			legAngle[a]          = legState.halfA.legAngle;
+			legAngle[a + 1]      = legState.halfB.legAngle;
+			legVelocity[a]       = legState.halfA.legVelocity;
+			legVelocity[a + 1]   = legState.halfB.legVelocity;
+			motorAngle[a]        = legState.halfA.motorAngle;
+			motorAngle[a + 1]    = legState.halfB.motorAngle;
+			motorVelocity[a]     = legState.halfA.motorVelocity;
+			motorVelocity[a + 1] = legState.halfB.motorVelocity;
+		}
+
+		/**
+		  * @brief The per-half pass: segment angles and spring torques.
+		  * Each iteration is independent, so this vectorizes.
+		  * @param begin The first half.
+		  * @param end   One past the last half.
+		  */
+		void computeHalves(int begin, int end) {
+			for (int h = begin; h < end; h++) {
+				legSinCos(legAngle[h] + bodyPitch, segmentSin[h], segmentCos[h]);
+				segmentVelocity[h] = legVelocity[h] + bodyPitchVelocity;
+				springTorque[h] = Params::ks*(motorAngle[h] - legAngle[h]);
+				dSpringTorque[h] = Params::ks*(motorVelocity[h] - legVelocity[h]);
+			}
+		}
+
+		/**
+		  * @brief Computes one leg's polar state and force from its halves.
+		  * The angle-difference terms come from the segment sines and
+		  * cosines, so no more transcendentals are needed.
+		  */
+		void computeLeg(Leg leg) {
+			int a = 2*leg, b = a + 1;
+
+			double halfSpreadSin, halfSpreadCos;
+			legSinCos((legAngle[a] - legAngle[b])/2.0, halfSpreadSin, halfSpreadCos);
+			q[leg] = (legAngle[a] + legAngle[b])/2.0;
+			r[leg] = halfSpreadCos;
+			dq[leg] = (legVelocity[a] + legVelocity[b])/2.0;
+			dr[leg] = -halfSpreadSin*(legVelocity[a] - legVelocity[b])/2.0;
+
+			// sin(qlA - qlB) and cos(qlA - qlB); body pitch cancels
+			double spreadSin = segmentSin[a]*segmentCos[b] - segmentCos[a]*segmentSin[b];
+			double spreadCos = segmentCos[a]*segmentCos[b] + segmentSin[a]*segmentSin[b];
+			double dSpread = legVelocity[a] - legVelocity[b];
+
+			// The forward force map and its derivative
+			double den = Params::l1*Params::l2*spreadSin;
+			double sx = Params::l2*springTorque[b]*segmentSin[a] - Params::l1*springTorque[a]*segmentSin[b];
+			double sz = Params::l2*springTorque[b]*segmentCos[a] - Params::l1*springTorque[a]*segmentCos[b];
+			double dsx = Params::l2*(dSpringTorque[b]*segmentSin[a] + springTorque[b]*segmentCos[a]*segmentVelocity[a]) -
+			             Params::l1*(dSpringTorque[a]*segmentSin[b] + springTorque[a]*segmentCos[b]*segmentVelocity[b]);
+			double dsz = Params::l2*(dSpringTorque[b]*segmentCos[a] - springTorque[b]*segmentSin[a]*segmentVelocity[a]) -
+			             Params::l1*(dSpringTorque[a]*segmentCos[b] - springTorque[a]*segmentSin[b]*segmentVelocity[b]);
+			double dDen = spreadCos/spreadSin*dSpread;
+
+			force[leg].fx = -sx/den;
+			force[leg].fz = -sz/den;
+			force[leg].dfx = (-dsx + sx*dDen)/den;
+			force[leg].dfz = (-dsz + sz*dDen)/den;
+		}
+};
+
+}
+}
+
+#endif // LEGKINEMATICS_HPP
+
+// vim: noexpandtab
@@ -0,0 +1,175 @@
+#ifndef LOGAGGREGATOR_HPP
+#define LOGAGGREGATOR_HPP
+
+/**
+  * @file LogAggregator.hpp
+  * @brief Publishes the controllers' log data from a low-priority thread.
+  * Each LogPort queues its data in a ring from the control thread; this
+  * empties every ring into its port periodically, so no ports are written
+  * (and no ROS calls made) from the control thread.
+  * When the flight recorder is enabled, the rings are emptied into one
+  * recorder file shared by every LogPort in the process instead.
+  * There's one aggregator per process, so logging can be turned off for
+  * processes running many controllers at once (see LOG_DISABLE_ENV).
+  */
+
+// Standard library
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// Orocos
+#include <rtt/Activity.hpp>    // Our thread
+#include <rtt/Logger.hpp>      // Warns about messages too large to record
+#include <rtt/os/Mutex.hpp>    // Protects our list of sources
+#include <rtt/os/MutexLock.hpp>
+
+// ATRIAS
+#include <atrias_shared/FlightRecorder.h> // Records the data to disk, when enabled
+
+// Our namespaces
+namespace atrias {
+namespace controller {
+
+/**
+  * @brief How often the rings are emptied (seconds).
+  */
+#define LOG_AGGREGATOR_PERIOD 0.01
+
+/**
+  * @brief The default number of messages each LogPort's ring holds.
+  * This is a little over 0.25 seconds of data at 1 kHz.
+  */
+#define LOG_RING_SIZE 256
+
+/**
+  * @brief The largest log message (bytes) the shared flight recorder holds.
+  * The controllers' log messages are well under this.
+  */
+#define LOG_RECORDER_MAX_LENGTH 248
+
+/**
+  * @brief How many records the shared flight recorder holds. This keeps as
+  * much of each of four ports' data as a file per port used to.
+  */
+#define LOG_RECORDER_CAPACITY (4 * FLIGHT_RECORDER_CAPACITY)
+
+/**
+  * @brief If this environment variable is set, LogPorts neither publish nor
+  * record anything. sweep_runner sets it, as one aggregator can't keep up
+  * with dozens of controllers running faster than realtime.
+  */
+#define LOG_DISABLE_ENV "ATRIAS_NO_CONTROLLER_LOGS"
+
+class LogAggregator : public RTT::Activity {
+	public:
+		/**
+		  * @brief Something with queued data to publish; a LogPort.
+		  */
+		class Source {
+			public:
+				/**
+				  * @brief Publishes all the queued data.
+				  * Called from the aggregator's thread.
+				  */
+				virtual void drain() = 0;
+
+				virtual ~Source() {}
+		};
+
+		/**
+		  * @brief Returns the process's aggregator.
+		  */
+		static LogAggregator& instance();
+
+		/**
+		  * @brief Returns false if LOG_DISABLE_ENV is set.
+		  */
+		static bool isEnabled();
+
+		/**
+		  * @brief Adds a source to be drained, starting our thread if needed.
+		  * Not realtime safe.
+		  * @param source The source.
+		  */
+		void addSource(Source* source);
+
+		/**
+		  * @brief Stops draining a source. Not realtime safe.
+		  * Its remaining data is published first.
+		  * @param source The source.
+		  */
+		void removeSource(Source* source);
+
+		/**
+		  * @brief Adds a topic to the shared flight recorder, opening it if
+		  * this is the first. Not realtime safe.
+		  * @param topic  The topic the data would have been published on.
+		  * @param sample A message as large as any that will be recorded.
+		  * @return The topic's index, or -1 if the data won't be recorded.
+		  */
+		template <class MsgType>
+		int recordTopic(const std::string &topic, const MsgType &sample);
+
+		/**
+		  * @brief Returns the shared flight recorder. Only sources may write
+		  * to it, from drain().
+		  */
+		shared::FlightRecorder& getRecorder();
+
+		/**
+		  * @brief Drains every source. Run periodically by our thread.
+		  */
+		void step();
+
+	private:
+		/**
+		  * @brief Initializes the aggregator; its thread starts with the first source.
+		  */
+		LogAggregator();
+
+		// Everything being drained
+		std::vector<Source*> sources;
+
+		// Protects sources, and serializes writes to the recorder. Never
+		// taken by the control thread.
+		RTT::os::Mutex       sourcesLock;
+
+		// Records every source's data, when the flight recorder is enabled.
+		shared::FlightRecorder recorder;
+
+		// Protects opening the recorder.
+		RTT::os::Mutex       recorderLock;
+};
+
+template <class MsgType>
+int LogAggregator::recordTopic(const std::string &topic, const MsgType &sample) {
+	const char* dir = shared::FlightRecorder::getDirectory();
+	if (!dir)
+		return -1;
+
+	{
+		RTT::os::MutexLock lock(this->recorderLock);
+		if (!this->recorder.isOpen() &&
+		    !this->recorder.open(shared::FlightRecorder::makePath(dir, "controllers"),
+		                         LOG_RECORDER_MAX_LENGTH, LOG_RECORDER_CAPACITY))
+		{
+			return -1;
+		}
+	}
+
+	if (ros::serialization::serializationLength(sample) > this->recorder.getMaxLength()) {
+		RTT::log(RTT::Warning) << "[LogAggregator] " << topic << " is too large to record; publishing it instead."
+		                       << RTT::endlog();
+		return -1;
+	}
+
+	return this->recorder.addTopicForMessage<MsgType>(topic);
+}
+
+}
+}
+
+#endif // LOGAGGREGATOR_HPP
+
+// vim: noexpandtab
@@ -7,61 +7,123 @@
   * @brief This class allows subcontrollers to log data.
   * This may also be utilized by top-level controllers
   * for additional log ports.
+  * send() only copies the data into a preallocated ring; the LogAggregator's
+  * low-priority thread writes it to the port (and so to ROS), or to the
+  * shared flight recorder when that's enabled. If logging is disabled (see
+  * LOG_DISABLE_ENV), send() does nothing.
   */
 
+// Standard library
+#include <atomic>
+
 // Orocos includes
 #include <rtt/ConnPolicy.hpp>       // Allows for connecting the output port to ROS
+#include <rtt/Logger.hpp>           // Warns about dropped data
 #include <rtt/OutputPort.hpp>       // This allows the creation of an output port
-#include <rtt/os/oro_allocator.hpp> // Lets us send messages in HRT
 
 // ATRIAS
 #include <atrias_shared/RtMsgTypekits.hpp>         // Lets us register a typekit for this message.
+#include <atrias_shared/SpscRing.h>                // Hands the data to the aggregator's thread
 #include "atrias_control_lib/AtriasController.hpp" // This allows us to access the name and TaskContext
+#include "atrias_control_lib/LogAggregator.hpp"    // Publishes our data outside the control thread
+#include "atrias_control_lib/MsgAllocator.hpp"     // Lets us send messages in HRT
 
 namespace atrias {
 namespace controller {
 
 template <template <class> class logType>
-class LogPort {
+class LogPort : public LogAggregator::Source {
 	public:
 		/**
 		  * @brief The constructor for this logging port.
 		  * @param controller A reference to this controller
 		  * @param name       The name for this log port.
+		  * @param decimation Only every decimation'th send() is logged.
+		  * @param ringSize   How many messages may wait for the aggregator.
+		  */
+		LogPort(const AtriasController* const controller, const std::string name = "log",
+		        unsigned int decimation = 1, size_t ringSize = LOG_RING_SIZE);
+
+		/**
+		  * @brief Publishes any remaining data and stops publishing.
 		  */
-		LogPort(const AtriasController* const controller, const std::string name = "log");
+		~LogPort();
 
 		/**
 		  * @brief This allows controllers to access the data to be logged.
 		  */
-		//logType<RTT::os::rt_allocator<uint8_t>> data;
-		logType<std::allocator<void>> data;
+		logType<MsgAllocator> data;
 
 		/**
 		  * @brief This transmits the data for logging.
-		  * This will not alter the data itself.
+		  * This will not alter the data itself. Realtime safe; if the
+		  * aggregator has fallen behind, the data is dropped.
 		  */
 		void send();
+
+		/**
+		  * @brief Changes how many send()s it takes to log once.
+		  * @param decimation Only every decimation'th send() is logged.
+		  */
+		void setDecimation(unsigned int decimation);
+
+		/**
+		  * @brief Writes the queued data to the port or the flight recorder.
+		  * Called from the aggregator's thread.
+		  */
+		void drain();
 	
 	private:
 		// Our output port
-		//RTT::OutputPort<logType<RTT::os::rt_allocator<uint8_t>>> port;
-		RTT::OutputPort<logType<std::allocator<void>>> port;
+		RTT::OutputPort<logType<MsgAllocator>> port;
+
+		// Whether we log at all
+		bool enabled;
+
+		// Our topic in the aggregator's flight recorder, or -1 if we publish
+		// over ROS.
+		int topic;
+
+		// Data waiting for the aggregator
+		shared::SpscRing<logType<MsgAllocator>> ring;
+
+		// Log once every this many send()s
+		unsigned int decimation;
+
+		// send()s since we last logged
+		unsigned int skipped;
+
+		// Messages dropped because the ring was full, and how many of those
+		// we've warned about. The latter is only used by the aggregator.
+		std::atomic<uint32_t> dropped;
+		uint32_t              droppedReported;
 
 		// Allows us to access the top-level controller.
 		const AtriasController &tlc;
 };
 
 template <template <class> class logType>
-LogPort<logType>::LogPort(const AtriasController* const controller, const std::string name) :
+LogPort<logType>::LogPort(const AtriasController* const controller, const std::string name,
+                          unsigned int decimation, size_t ringSize) :
 	port(controller->getName() + "_" + name),
+	enabled(LogAggregator::isEnabled()),
+	topic(-1),
+	ring(ringSize),
+	decimation(decimation),
+	skipped(0),
+	dropped(0),
+	droppedReported(0),
 	tlc(controller->getTLC())
 {
+#ifdef ATRIAS_RT_ALLOCATOR
 	// Register typekit
-	//shared::RtMsgTypekits::registerType<logType>(controller->getName() + "_" + name);
+	shared::RtMsgTypekits::registerType<logType>(controller->getName() + "_" + name);
+#endif
 
 	// Setup our port
 	this->tlc.getTaskContext().addPort(this->port);
+	if (!this->enabled)
+		return;
 
 	RTT::ConnPolicy policy = RTT::ConnPolicy::buffer(10000);
 	// Transport 3 is ROS
@@ -70,15 +132,63 @@ LogPort<logType>::LogPort(const AtriasController* const controller, const std::s
 	policy.name_id = "/" + controller->getName() + "_" + name;
 	// And actually initiate the connection
 	this->port.createStream(policy);
+
+	// Record to disk instead, if requested.
+	this->topic = LogAggregator::instance().recordTopic(policy.name_id, this->data);
+
+	// Either way, the aggregator does it for us.
+	LogAggregator::instance().addSource(this);
+}
+
+template <template <class> class logType>
+LogPort<logType>::~LogPort() {
+	if (this->enabled)
+		LogAggregator::instance().removeSource(this);
 }
 
 template <template <class> class logType>
 void LogPort<logType>::send() {
+	if (!this->enabled)
+		return;
+
+	if (++this->skipped < this->decimation)
+		return;
+	this->skipped = 0;
+
 	// Set the timestamp
-	this->data.header = this->tlc.getROSHeader();
+	this->data.header.stamp = this->tlc.getROSHeader().stamp;
+
+	logType<MsgAllocator>* slot = this->ring.writeSlot();
+	if (!slot) {
+		this->dropped.store(this->dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		return;
+	}
+	*slot = this->data;
+	this->ring.commit();
+}
 
-	// Send the data
-	this->port.write(this->data);
+template <template <class> class logType>
+void LogPort<logType>::setDecimation(unsigned int decimation) {
+	this->decimation = decimation;
+}
+
+template <template <class> class logType>
+void LogPort<logType>::drain() {
+	logType<MsgAllocator>* slot;
+	while ((slot = this->ring.readSlot())) {
+		if (this->topic >= 0)
+			LogAggregator::instance().getRecorder().record(*slot, this->topic);
+		else
+			this->port.write(*slot);
+		this->ring.release();
+	}
+
+	uint32_t dropped = this->dropped.load(std::memory_order_relaxed);
+	if (dropped != this->droppedReported) {
+		RTT::log(RTT::Warning) << "[" << this->port.getName() << "] Dropped " << dropped - this->droppedReported
+		                       << " log messages; the log aggregator fell behind." << RTT::endlog();
+		this->droppedReported = dropped;
+	}
 }
 
 }
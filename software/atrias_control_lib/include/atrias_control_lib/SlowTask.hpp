@@ -0,0 +1,75 @@
+#ifndef SLOWTASK_HPP
+#define SLOWTASK_HPP
+
+/**
+  * @file SlowTask.hpp
+  * @brief Runs part of a controller, such as a planner, on its own thread at
+  * a lower rate than the control loop.
+  * The task and the controller should only share data through lock-free
+  * mailboxes (see atrias_shared/Mailbox.h): the controller posts the latest
+  * state, the task reads it and posts its results, and the controller uses
+  * the latest results on its next cycle. That way a slow plan delays only
+  * itself, never the control loop.
+  *
+  * Register the task with ATC::addSlowTask(), which starts and stops it
+  * with the component. Declare it after every member its function uses, so
+  * it's stopped before they're destroyed.
+  */
+
+// Standard library
+#include <string>
+
+// Boost
+#include <boost/function.hpp>
+
+// Orocos
+#include <rtt/Activity.hpp>
+
+// Our namespaces
+namespace atrias {
+namespace controller {
+
+class SlowTask : public RTT::Activity {
+	public:
+		/**
+		  * @brief Creates the task. It isn't started until its ATC is.
+		  * @param name      The thread's name.
+		  * @param period    How often to run the function (seconds).
+		  * @param function  The function to run.
+		  * @param scheduler ORO_SCHED_OTHER or ORO_SCHED_RT. If realtime, the
+		  *                  priority must be below the control loop's.
+		  * @param priority  The thread's priority.
+		  */
+		SlowTask(const std::string &name, double period, boost::function<void()> function,
+		         int scheduler = ORO_SCHED_OTHER, int priority = 0);
+
+		/**
+		  * @brief Stops the task, waiting for its function to return.
+		  */
+		~SlowTask();
+
+		/**
+		  * @brief Runs the function. Called periodically by our thread.
+		  */
+		void step();
+
+		/**
+		  * @brief Returns how many times the function has taken longer than
+		  * the period.
+		  */
+		unsigned int getOverruns() const;
+
+	private:
+		// What we run
+		boost::function<void()> function;
+
+		// Times the function exceeded the period
+		unsigned int            overruns;
+};
+
+}
+}
+
+#endif // SLOWTASK_HPP
+
+// vim: noexpandtab
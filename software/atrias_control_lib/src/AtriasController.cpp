@@ -6,16 +6,23 @@ namespace controller {
 AtriasController::AtriasController(const AtriasController * const parent,
                                    const std::string              &name) :
 	name(std::string(parent->getName()) + "_" + name),
-	tlc(parent->getTLC())
+	tlc(parent->getTLC()),
+	profiler(parent->profiler)
 {
-	// All the magic happens above.
+	this->profileId = this->profiler->addController(this->name, parent->profileId);
 }
 
 AtriasController::AtriasController(const std::string &name) :
 	name(name),
-	tlc(*this)
+	tlc(*this),
+	profiler(new ControllerProfiler())
 {
-	// This space intentionally left blank
+	this->profileId = this->profiler->addController(this->name, -1);
+}
+
+AtriasController::~AtriasController() {
+	if (&this->tlc == this)
+		delete this->profiler;
 }
 
 double AtriasController::clamp(double num, double a, double b) {
@@ -35,8 +42,7 @@ const std::string& AtriasController::getName() const {
 	return this->name;
 }
 
-//const std_msgs::Header_<RTT::os::rt_allocator<uint8_t>>& AtriasController::getROSHeader() const {
-const std_msgs::Header& AtriasController::getROSHeader() const {
+const std_msgs::Header_<MsgAllocator>& AtriasController::getROSHeader() const {
 	// This is overridden by the ATC class, preventing recursion.
 	return tlc.getROSHeader();
 }
@@ -51,6 +57,10 @@ AtriasController& AtriasController::getTLC() const {
 	return this->tlc;
 }
 
+ControllerProfiler& AtriasController::getProfiler() const {
+	return *this->profiler;
+}
+
 }
 }
 
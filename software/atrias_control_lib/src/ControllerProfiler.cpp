@@ -0,0 +1,187 @@
+#include "atrias_control_lib/ControllerProfiler.hpp"
+
+// Standard library
+#include <stdio.h>
+#include <algorithm>
+
+namespace atrias {
+namespace controller {
+
+ControllerProfiler::Scope::Scope(ControllerProfiler &profiler, int id) {
+	if (!profiler.isEnabled()) {
+		this->profiler = NULL;
+		return;
+	}
+
+	this->profiler  = &profiler;
+	this->id        = id;
+	this->outer     = profiler.current;
+	this->childTime = 0;
+	profiler.current = this;
+	profiler.profiles[id].depth++;
+
+	// Read the clock last, so our own setup isn't counted.
+	this->start = RTT::os::TimeService::Instance()->getNSecs();
+}
+
+ControllerProfiler::Scope::~Scope() {
+	if (!this->profiler)
+		return;
+
+	RTT::os::TimeService::nsecs elapsed = RTT::os::TimeService::Instance()->getNSecs() - this->start;
+
+	Profile &profile = this->profiler->profiles[this->id];
+	profile.calls++;
+	profile.cycleSelfTime += elapsed - this->childTime;
+	if (--profile.depth == 0)
+		profile.cycleTime += elapsed;
+
+	if (this->outer)
+		this->outer->childTime += elapsed;
+	this->profiler->current = this->outer;
+}
+
+ControllerProfiler::ControllerProfiler() :
+	current(NULL),
+	cycles(0),
+	enabled(false),
+	resetRequested(false)
+{
+	// Controllers are added as they're constructed.
+}
+
+int ControllerProfiler::addController(const std::string &name, int parent) {
+	Profile profile;
+	profile.name          = name;
+	profile.parent        = parent;
+	profile.cycleTime     = 0;
+	profile.cycleSelfTime = 0;
+	profile.depth         = 0;
+	profile.calls         = 0;
+	profile.totalTime     = 0;
+	profile.totalSelfTime = 0;
+	profile.maxTime       = 0;
+	this->profiles.push_back(profile);
+	return this->profiles.size() - 1;
+}
+
+void ControllerProfiler::setEnabled(bool enable) {
+	this->enabled = enable;
+}
+
+bool ControllerProfiler::isEnabled() const {
+	return this->enabled.load(std::memory_order_relaxed);
+}
+
+void ControllerProfiler::reset() {
+	this->resetRequested = true;
+}
+
+void ControllerProfiler::endCycle() {
+	if (this->resetRequested.exchange(false)) {
+		for (size_t i = 0; i < this->profiles.size(); i++) {
+			Profile &profile      = this->profiles[i];
+			profile.calls         = 0;
+			profile.totalTime     = 0;
+			profile.totalSelfTime = 0;
+			profile.maxTime       = 0;
+			profile.cycleTime     = 0;
+			profile.cycleSelfTime = 0;
+		}
+		this->cycles = 0;
+		return;
+	}
+
+	if (!this->isEnabled())
+		return;
+
+	for (size_t i = 0; i < this->profiles.size(); i++) {
+		Profile &profile       = this->profiles[i];
+		profile.totalTime     += profile.cycleTime;
+		profile.totalSelfTime += profile.cycleSelfTime;
+		profile.maxTime        = std::max(profile.maxTime, profile.cycleTime);
+		profile.cycleTime      = 0;
+		profile.cycleSelfTime  = 0;
+	}
+	this->cycles++;
+}
+
+std::string ControllerProfiler::shortName(int id) const {
+	const std::string &name = this->profiles[id].name;
+	int parent = this->profiles[id].parent;
+	if (parent < 0)
+		return name;
+
+	// Subcontrollers' names are their parent's name, "_", then their own.
+	const std::string &parentName = this->profiles[parent].name;
+	if (name.compare(0, parentName.size() + 1, parentName + "_") == 0)
+		return name.substr(parentName.size() + 1);
+	return name;
+}
+
+std::string ControllerProfiler::summary() const {
+	// These are read while the RT thread updates them; a line may be off
+	// by a cycle.
+	double cycles = std::max(this->cycles, (uint64_t) 1);
+	std::string out;
+	char line[256];
+
+	snprintf(line, sizeof(line), "%llu cycles profiled (all times in us per cycle)\n",
+	         (unsigned long long) this->cycles);
+	out += line;
+	snprintf(line, sizeof(line), "%-40s %10s %10s %10s %10s\n", "controller", "calls", "mean", "self", "max");
+	out += line;
+
+	for (size_t i = 0; i < this->profiles.size(); i++) {
+		const Profile &profile = this->profiles[i];
+
+		// Indent each controller under its parent.
+		std::string label = this->shortName(i);
+		for (int p = profile.parent; p >= 0; p = this->profiles[p].parent)
+			label = "  " + label;
+
+		snprintf(line, sizeof(line), "%-40s %10.2f %10.3f %10.3f %10.3f\n", label.c_str(),
+		         profile.calls / cycles, profile.totalTime / cycles / 1e3,
+		         profile.totalSelfTime / cycles / 1e3, profile.maxTime / 1e3);
+		out += line;
+	}
+	return out;
+}
+
+void ControllerProfiler::fillMessage(atrias_msgs::controller_profile &msg) const {
+	double cycles = std::max(this->cycles, (uint64_t) 1);
+	msg.cycles = this->cycles;
+	msg.controllers.resize(this->profiles.size());
+	for (size_t i = 0; i < this->profiles.size(); i++) {
+		const Profile &profile = this->profiles[i];
+		msg.controllers[i].name         = profile.name;
+		msg.controllers[i].parent       = profile.parent;
+		msg.controllers[i].calls        = profile.calls;
+		msg.controllers[i].meanTime     = profile.totalTime / cycles;
+		msg.controllers[i].meanSelfTime = profile.totalSelfTime / cycles;
+		msg.controllers[i].maxTime      = profile.maxTime;
+	}
+}
+
+bool ControllerProfiler::dumpFolded(const std::string &filename) const {
+	FILE* out = fopen(filename.c_str(), "w");
+	if (!out)
+		return false;
+
+	// One line per controller: its path from the top-level controller, then its self time.
+	for (size_t i = 0; i < this->profiles.size(); i++) {
+		std::string stack = this->shortName(i);
+		for (int p = this->profiles[i].parent; p >= 0; p = this->profiles[p].parent)
+			stack = this->shortName(p) + ";" + stack;
+
+		fprintf(out, "%s %lld\n", stack.c_str(), (long long) this->profiles[i].totalSelfTime);
+	}
+
+	fclose(out);
+	return true;
+}
+
+}
+}
+
+// vim: noexpandtab
@@ -0,0 +1,57 @@
+#include "atrias_control_lib/LogAggregator.hpp"
+
+// Standard library
+#include <stdlib.h>
+#include <algorithm>
+
+// Orocos
+#include <rtt/os/MutexLock.hpp>
+
+namespace atrias {
+namespace controller {
+
+LogAggregator::LogAggregator() :
+	RTT::Activity(ORO_SCHED_OTHER, 0, LOG_AGGREGATOR_PERIOD, 0, "LogAggregator")
+{
+	// The thread is started when the first LogPort is added.
+}
+
+LogAggregator& LogAggregator::instance() {
+	static LogAggregator aggregator;
+	return aggregator;
+}
+
+bool LogAggregator::isEnabled() {
+	return getenv(LOG_DISABLE_ENV) == NULL;
+}
+
+void LogAggregator::addSource(Source* source) {
+	{
+		RTT::os::MutexLock lock(this->sourcesLock);
+		this->sources.push_back(source);
+	}
+
+	if (!this->isActive())
+		this->start();
+}
+
+void LogAggregator::removeSource(Source* source) {
+	RTT::os::MutexLock lock(this->sourcesLock);
+	source->drain();
+	this->sources.erase(std::remove(this->sources.begin(), this->sources.end(), source), this->sources.end());
+}
+
+shared::FlightRecorder& LogAggregator::getRecorder() {
+	return this->recorder;
+}
+
+void LogAggregator::step() {
+	RTT::os::MutexLock lock(this->sourcesLock);
+	for (size_t i = 0; i < this->sources.size(); i++)
+		this->sources[i]->drain();
+}
+
+}
+}
+
+// vim: noexpandtab
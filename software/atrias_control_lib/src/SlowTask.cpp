@@ -0,0 +1,34 @@
+#include "atrias_control_lib/SlowTask.hpp"
+
+// Orocos
+#include <rtt/os/TimeService.hpp>
+
+namespace atrias {
+namespace controller {
+
+SlowTask::SlowTask(const std::string &name, double period, boost::function<void()> function,
+                   int scheduler, int priority) :
+	RTT::Activity(scheduler, priority, period, 0, name),
+	function(function),
+	overruns(0)
+{}
+
+SlowTask::~SlowTask() {
+	this->stop();
+}
+
+void SlowTask::step() {
+	RTT::os::TimeService::ticks start = RTT::os::TimeService::Instance()->getTicks();
+	this->function();
+	if (RTT::os::TimeService::Instance()->secondsSince(start) > this->getPeriod())
+		this->overruns++;
+}
+
+unsigned int SlowTask::getOverruns() const {
+	return this->overruns;
+}
+
+}
+}
+
+// vim: noexpandtab
@@ -0,0 +1,243 @@
+/** @file
+  * @brief Checks that, built with ATRIAS_RT_ALLOCATOR, a controller's cycle
+  * makes no glibc malloc() calls once it's running, even as its gui and log
+  * messages' variable-length fields change size.
+  *
+  * The controller here is an ATC with a log message, a gui output and a
+  * LogPort, all controller_profile messages: a header, and an array of
+  * entries with names. Each cycle it resizes the array and rewrites the
+  * names at a different length. Its runController() is called at 1 kHz, as
+  * RT Ops would, long enough for the 50 Hz gui output to be sent too. Its
+  * log and gui output ports are read from another thread, and the LogPort
+  * is drained by the LogAggregator's.
+  *
+  * Every malloc(), calloc() and realloc() made inside runController() is
+  * counted. With ATRIAS_RT_ALLOCATOR, none may be made after the first
+  * cycles, as the messages allocate from RTT's TLSF pool instead. Without
+  * it, the count is printed but not checked.
+  *
+  * Exits with a nonzero status if a check fails.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <atomic>
+
+// Orocos
+#include <rtt/InputPort.hpp>
+#include <rtt/OperationCaller.hpp>
+#include <rtt/os/startstop.h>
+
+// ATRIAS
+#include <atrias_msgs/controller_profile.h>
+#include <atrias_msgs/robot_state.h>
+#include "atrias_control_lib/ATC.hpp"
+#include "atrias_control_lib/LogPort.hpp"
+#include "atrias_control_lib/MsgAllocator.hpp"
+
+#ifdef ATRIAS_RT_ALLOCATOR
+#include <rtt/os/tlsf/tlsf.h> // To give the realtime allocator a pool
+#endif
+
+using namespace atrias;
+using namespace atrias::controller;
+
+// The cycles run, and how many at the start may allocate
+#define TEST_CYCLES   2000
+#define WARMUP_CYCLES 10
+
+// The most entries a message is given, and the range of their names' lengths
+#define MAX_ENTRIES     8
+#define MIN_NAME_LENGTH 16
+#define MAX_NAME_LENGTH 64
+
+// The size of the realtime allocator's pool
+#define RTALLOC_SIZE (16 * 1024 * 1024)
+
+/** @brief Whether allocations are being counted.
+  */
+static std::atomic<bool> counting(false);
+
+/** @brief The allocations counted.
+  */
+static std::atomic<long> allocations(0);
+
+/** @brief Whether this thread runs the controller.
+  */
+static __thread bool controlThread = false;
+
+static void countAllocation() {
+	if (controlThread && counting.load())
+		allocations++;
+}
+
+// Everything else in the process, Orocos included, allocates through these.
+extern "C" {
+
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void  __libc_free(void* ptr);
+
+void* malloc(size_t size) __THROW {
+	countAllocation();
+	return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) __THROW {
+	countAllocation();
+	return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) __THROW {
+	countAllocation();
+	return __libc_realloc(ptr, size);
+}
+
+void free(void* ptr) __THROW {
+	__libc_free(ptr);
+}
+
+}
+
+typedef atrias_msgs::controller_profile_<MsgAllocator> Profile;
+
+/** @brief Fills a profile message with a cycle's worth of entries, each
+  * name rewritten at a new length.
+  */
+static void fillProfile(Profile &profile, uint32_t cycle) {
+	static const char name[] =
+		"test_controller/with/a/name/long/enough/to/be/allocated/on/the/heap";
+
+	profile.cycles = cycle;
+	profile.controllers.resize(1 + cycle % MAX_ENTRIES);
+	for (size_t i = 0; i < profile.controllers.size(); i++) {
+		size_t length = MIN_NAME_LENGTH + (cycle + 7*i) % (MAX_NAME_LENGTH - MIN_NAME_LENGTH + 1);
+		profile.controllers[i].name.assign(name, length);
+		profile.controllers[i].parent = (int32_t) i - 1;
+		profile.controllers[i].calls  = cycle;
+	}
+}
+
+/** @brief A controller whose messages change size every cycle.
+  */
+class TestController : public ATC<atrias_msgs::controller_profile_, atrias_msgs::unused_, atrias_msgs::controller_profile_> {
+	public:
+		TestController(const std::string &name) :
+			ATC<atrias_msgs::controller_profile_, atrias_msgs::unused_, atrias_msgs::controller_profile_>(name),
+			debugLog(this, "debug")
+		{
+			cycle = 0;
+		}
+
+	private:
+		LogPort<atrias_msgs::controller_profile_> debugLog;
+		uint32_t                                  cycle;
+
+		void controller() {
+			fillProfile(logOut,        cycle);
+			fillProfile(guiOut,        cycle + 1);
+			fillProfile(debugLog.data, cycle + 2);
+			debugLog.send();
+			cycle++;
+		}
+};
+
+/** @brief Runs the cycles, counting each one's allocations.
+  * @return The number of cycles after the warmup that allocated.
+  */
+static int runCycles(TestController &controller) {
+	RTT::OperationCaller<atrias_msgs::controller_output&(const atrias_msgs::robot_state&)> runController =
+		controller.provides("atc")->getOperation("runController");
+
+	// Read the ports from another thread, as ROS would.
+	RTT::InputPort<Profile> logIn("log_in");
+	RTT::InputPort<Profile> guiIn("gui_in");
+	controller.ports()->getPort("log")->connectTo(&logIn, RTT::ConnPolicy::buffer(100));
+	controller.ports()->getPort("guiOutput")->connectTo(&guiIn, RTT::ConnPolicy::data());
+
+	atrias_msgs::robot_state state;
+	Profile                  received;
+	int                      allocatingCycles = 0;
+	long                     total            = 0;
+	struct timespec          next;
+	clock_gettime(CLOCK_MONOTONIC, &next);
+
+	controlThread = true;
+	for (int i = 0; i < TEST_CYCLES; i++) {
+		state.header.seq = i;
+
+		long before = allocations.load();
+		counting = true;
+		runController(state);
+		counting = false;
+		long made = allocations.load() - before;
+
+		if (i >= WARMUP_CYCLES && made) {
+			allocatingCycles++;
+			total += made;
+		}
+
+		// Not counted: the readers are on their own threads in the real system.
+		while (logIn.read(received) == RTT::NewData) {}
+		guiIn.read(received);
+
+		next.tv_nsec += CONTROLLER_LOOP_PERIOD_NS;
+		if (next.tv_nsec >= SECOND_IN_NANOSECONDS) {
+			next.tv_sec++;
+			next.tv_nsec -= SECOND_IN_NANOSECONDS;
+		}
+		clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+	}
+
+	logIn.disconnect();
+	guiIn.disconnect();
+
+	printf("%d cycles after the first %d; %d allocated, %ld allocations in all\n",
+	       TEST_CYCLES - WARMUP_CYCLES, WARMUP_CYCLES, allocatingCycles, total);
+	return allocatingCycles;
+}
+
+int main(int argc, char **argv) {
+	__os_init(argc, argv);
+
+#ifdef ATRIAS_RT_ALLOCATOR
+	// As the deployer's --rtalloc-mem-size does.
+	void* rtMem = malloc(RTALLOC_SIZE);
+	init_memory_pool(RTALLOC_SIZE, rtMem);
+#endif
+
+	int allocatingCycles;
+	{
+		TestController controller("msg_allocator_test");
+		allocatingCycles = runCycles(controller);
+	}
+
+#ifdef ATRIAS_RT_ALLOCATOR
+	destroy_memory_pool(rtMem);
+	free(rtMem);
+#endif
+	__os_exit();
+
+	int failures = 0;
+#ifdef ATRIAS_RT_ALLOCATOR
+	if (allocatingCycles) {
+		printf("FAIL: %d cycles called malloc() with ATRIAS_RT_ALLOCATOR\n", allocatingCycles);
+		failures++;
+	}
+#else
+	printf("ATRIAS_RT_ALLOCATOR is off, so the allocations weren't checked\n");
+#endif
+
+	if (failures) {
+		printf("%d failures\n", failures);
+		return 1;
+	}
+
+	printf("All passed\n");
+	return 0;
+}
+
+// vim: noexpandtab
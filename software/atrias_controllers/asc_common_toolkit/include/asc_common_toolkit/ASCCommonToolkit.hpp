@@ -13,6 +13,9 @@
 // And for the logging helper class
 #include <atrias_control_lib/LogPort.hpp>
 
+// The leg conversions, shared with LegKinematics
+#include <atrias_control_lib/LegKinematics.hpp>
+
 // Our log data
 #include "asc_common_toolkit/controller_log_data.h"
 
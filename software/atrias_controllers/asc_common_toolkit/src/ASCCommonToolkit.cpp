@@ -14,6 +14,7 @@ ASCCommonToolkit::ASCCommonToolkit(AtriasController *parent, string name) :
 
 
 std::tuple<double, double> ASCCommonToolkit::legForce(double r, double dr, double r0) {
+    ProfileScope scope(this);
 
     // Compute non-linear ATRIAS virtual leg length force
     fa = -(ks*(acos(r0) - acos(r))*(L1 + L2))/(2.0*L1*L2*sqrt(1 - pow(r, 2.0)));
@@ -26,10 +27,11 @@ std::tuple<double, double> ASCCommonToolkit::legForce(double r, double dr, doubl
 
 
 std::tuple<double, double> ASCCommonToolkit::motorPos2LegPos(double qmA, double qmB) {
+    ProfileScope scope(this);
 
     // Compute leg positions
     ql = ((qmA + qmB)/2.0);
-    rl = cos((qmA - qmB)/2.0);
+    rl = legLength(qmA, qmB);
 
     // Return leg position
     return std::make_tuple(ql, rl);
@@ -38,10 +40,12 @@ std::tuple<double, double> ASCCommonToolkit::motorPos2LegPos(double qmA, double
 
 
 std::tuple<double, double> ASCCommonToolkit::legPos2MotorPos(double ql, double rl) {
+    ProfileScope scope(this);
 
     // Compute motor positions
-    qmA = ql - acos(rl);
-    qmB = ql + acos(rl);
+    double spread = legHalfSpread(rl);
+    qmA = ql - spread;
+    qmB = ql + spread;
 
     // Return motor positions
     return std::make_tuple(qmA, qmB);
@@ -50,10 +54,11 @@ std::tuple<double, double> ASCCommonToolkit::legPos2MotorPos(double ql, double r
 
 
 std::tuple<double, double> ASCCommonToolkit::motorVel2LegVel(double qmA, double qmB, double dqmA, double dqmB) {
+    ProfileScope scope(this);
 
     // Compute leg velocities
     dql = (dqmA + dqmB)/2.0;
-    drl = -(sin((qmA - qmB)/2.0)*(dqmA - dqmB))/2.0;
+    drl = legLengthVelocity(qmA, qmB, dqmA, dqmB);
 
     // Return motor velocities
     return std::make_tuple(dql, drl);
@@ -62,10 +67,12 @@ std::tuple<double, double> ASCCommonToolkit::motorVel2LegVel(double qmA, double
 
 
 std::tuple<double, double> ASCCommonToolkit::legVel2MotorVel(double rl, double dql, double drl) {
+    ProfileScope scope(this);
 
     // Compute motor velocities
-    dqmA = dql + drl/sqrt(1.0 - pow(rl, 2));
-    dqmB = dql - drl/sqrt(1.0 - pow(rl, 2));
+    double dSpread = legHalfSpreadVelocity(rl, drl);
+    dqmA = dql + dSpread;
+    dqmB = dql - dSpread;
 
     // Return motor velocities
     return std::make_tuple(dqmA, dqmB);
@@ -74,6 +81,7 @@ std::tuple<double, double> ASCCommonToolkit::legVel2MotorVel(double rl, double d
 
 
 double ASCCommonToolkit::rad2Deg(double rad) {
+    ProfileScope scope(this);
 
     // Compute degrees
     deg = rad/PI*180.0;
@@ -85,6 +93,7 @@ double ASCCommonToolkit::rad2Deg(double rad) {
 
 
 double ASCCommonToolkit::deg2Rad(double deg) {
+    ProfileScope scope(this);
 
     // Compute radians
     rad = deg/180.0*PI;
@@ -96,6 +105,7 @@ double ASCCommonToolkit::deg2Rad(double deg) {
 
 
 std::tuple<double, double> ASCCommonToolkit::cartPos2PolPos(double x, double z) {
+    ProfileScope scope(this);
 
     // Compute polar coordinates
     q = atan2(z, x);
@@ -108,6 +118,7 @@ std::tuple<double, double> ASCCommonToolkit::cartPos2PolPos(double x, double z)
 
 
 std::tuple<double, double> ASCCommonToolkit::polPos2CartPos(double q, double r) {
+    ProfileScope scope(this);
 
     // Compute polar coordinates
     x = r*cos(q);
@@ -120,6 +131,7 @@ std::tuple<double, double> ASCCommonToolkit::polPos2CartPos(double q, double r)
 
 
 std::tuple<double, double> ASCCommonToolkit::cartVel2PolVel(double q, double r, double dx, double dz) {
+    ProfileScope scope(this);
 
     // Compute polar coordinates
     dq = (dz*cos(q) - dx*sin(q))/r;
@@ -132,6 +144,7 @@ std::tuple<double, double> ASCCommonToolkit::cartVel2PolVel(double q, double r,
 
 
 std::tuple<double, double> ASCCommonToolkit::polVel2CartVel(double q, double r, double dq, double dr) {
+    ProfileScope scope(this);
 
     // Compute polar coordinates
     dx = dr*cos(q) - r*dq*sin(q);
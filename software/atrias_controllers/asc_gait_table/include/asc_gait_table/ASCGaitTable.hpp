@@ -0,0 +1,127 @@
+#ifndef ASC_GAIT_TABLE_HPP
+#define ASC_GAIT_TABLE_HPP
+
+/**
+  * @file ASCGaitTable.hpp
+  * @brief Looks up equilibrium gaits in a precomputed table.
+  * The table is generated offline by gen_gait_table and memory-mapped, so
+  * a different gait library can be loaded without recompiling.
+  */
+
+// The include for the controller class
+#include <atrias_control_lib/AtriasController.hpp>
+
+// And for the logging helper class
+#include <atrias_control_lib/LogPort.hpp>
+
+// Our log data
+#include "asc_gait_table/controller_log_data.h"
+
+// The table format
+#include "asc_gait_table/GaitTable.h"
+
+// Datatypes
+#include <atrias_shared/atrias_parameters.h>
+
+// Standard library
+#include <atomic>
+#include <stddef.h>
+
+// Namespaces we're using
+using namespace std;
+
+// How far (relative) the SLIP model's stiffness and mass may be from the
+// table's before it's no longer used. 2% of k moves the angle by about
+// as much as the table's interpolation error.
+#define GAIT_TABLE_MODEL_TOLERANCE 0.02
+
+// Our namespaces
+namespace atrias {
+namespace controller {
+
+class ASCGaitTable : public AtriasController {
+	public:
+		/**
+		  * @brief The constructor for this subcontroller
+		  * @param parent The instantiating, "parent" controller.
+		  * @param name   The name for this controller.
+		  */
+		ASCGaitTable(AtriasController *parent, string name);
+
+		/**
+		  * @brief Unmaps any loaded tables.
+		  */
+		~ASCGaitTable();
+
+		/**
+		  * @brief Maps a gait table file and switches to it. Not realtime safe.
+		  * The previously loaded table stays mapped until the next load, so
+		  * lookups in progress may finish with it.
+		  * @param filename The table to load.
+		  * @return True if successful, false otherwise (the current table is kept).
+		  */
+		bool load(const string &filename);
+
+		/**
+		  * @brief Returns whether a table has been loaded.
+		  */
+		bool isLoaded();
+
+		/**
+		  * @brief Returns whether a table has been loaded, and it was generated
+		  * for this SLIP model (within GAIT_TABLE_MODEL_TOLERANCE).
+		  * @param k The SLIP model's stiffness.
+		  * @param m The SLIP model's mass.
+		  */
+		bool matches(double k, double m);
+
+		/**
+		  * @brief Returns the largest interpolation error the generator
+		  * found for the loaded table (radians).
+		  */
+		double maxError();
+
+		/**
+		  * @brief Looks up the touchdown leg angle giving an equilibrium gait.
+		  * Realtime safe. Returns a vertical leg if no table is loaded or
+		  * an input isn't finite.
+		  * @param dx The horizontal velocity at touchdown.
+		  * @param dz The vertical velocity at touchdown.
+		  * @param r  The leg length at touchdown.
+		  * @param dr The leg length rate.
+		  * @return The leg angle, in the same convention as SlipState, and
+		  * its rate while falling ballistically toward touchdown.
+		  */
+		std::tuple<double, double> equilibriumAngle(double dx, double dz, double r, double dr);
+
+	private:
+		// A mapped table file
+		struct Mapping {
+			void*                  addr;
+			size_t                 length;
+			const GaitTableHeader* header;
+			const float*           values;
+		};
+
+		// The current table and the one before it
+		Mapping          mappings[2];
+
+		// Which mapping is in use, or -1 if none
+		std::atomic<int> current;
+
+		/**
+		  * @brief Unmaps a mapping, if it's mapped.
+		  * @param mapping The mapping.
+		  */
+		void unmap(Mapping &mapping);
+
+		// Logging
+		LogPort<asc_gait_table::controller_log_data_> log_out;
+};
+
+}
+}
+
+#endif // ASC_GAIT_TABLE_HPP
+
+// vim: noexpandtab
@@ -0,0 +1,142 @@
+#ifndef GAIT_TABLE_H
+#define GAIT_TABLE_H
+
+/**
+  * @file GaitTable.h
+  * @brief The gait table file format, and its lookup.
+  * A gait table holds the equilibrium touchdown leg angle over a regular
+  * grid of touchdown horizontal velocity, vertical velocity, and leg
+  * length. It's written by gen_gait_table and memory-mapped by
+  * ASCGaitTable, so the lookup reads the file in place.
+  *
+  * The file is a GaitTableHeader followed by nDx*nDz*nR floats, indexed
+  * [dx][dz][r], so the 8 corners of a cell are 4 adjacent pairs.
+  */
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Identifies gait table files
+#define GAIT_TABLE_MAGIC   "ATRGAIT"
+#define GAIT_TABLE_VERSION 1
+
+// Our namespaces
+namespace atrias {
+namespace controller {
+
+struct GaitTableHeader {
+	char     magic[8];
+	uint32_t version;
+
+	// The number of grid points along each axis (each at least 2)
+	uint32_t nDx, nDz, nR;
+
+	// Each axis's first grid point and grid spacing
+	double   dxMin, dxStep;
+	double   dzMin, dzStep;
+	double   rMin,  rStep;
+
+	// The SLIP model the table was generated from. ASCGaitTable is only
+	// used while the controller's model matches it.
+	double   k, m;
+
+	// The largest interpolation error found by the generator (radians)
+	double   maxError;
+};
+
+/**
+  * @brief Returns the number of table entries following the header.
+  */
+inline size_t gaitTableSize(const GaitTableHeader &header) {
+	return (size_t) header.nDx * header.nDz * header.nR;
+}
+
+/**
+  * @brief Converts a value to grid coordinates along one axis.
+  * @param x       The value. Clamped to the axis.
+  * @param min     The axis's first grid point.
+  * @param step    The grid spacing.
+  * @param n       The number of grid points.
+  * @param i       Set to the index of the cell's lower grid point.
+  * @param clamped Set to whether x was off the end of the axis.
+  * @return The fraction of the way across the cell.
+  */
+inline double gaitTableCell(double x, double min, double step, uint32_t n, uint32_t &i, bool &clamped) {
+	double f = (x - min)/step;
+	if (f <= 0.0) {
+		i = 0;
+		clamped = f < 0.0;
+		return 0.0;
+	}
+	if (f >= n - 1) {
+		i = n - 2;
+		clamped = f > n - 1;
+		return 1.0;
+	}
+	i = (uint32_t) f;
+	clamped = false;
+	return f - i;
+}
+
+/**
+  * @brief Trilinearly interpolates a gait table. Realtime safe.
+  * Points outside the table are clamped to its edges; the angle doesn't
+  * change along a clamped axis, so its derivative there is zero.
+  * @param header The table's header.
+  * @param values The table's entries.
+  * @param dx     The touchdown horizontal velocity.
+  * @param dz     The touchdown vertical velocity.
+  * @param r      The leg length.
+  * @param q      Set to the touchdown leg angle.
+  * @param dqdz   Set to the leg angle's derivative with respect to dz.
+  * @param dqdr   Set to the leg angle's derivative with respect to r.
+  * @return False, leaving the outputs unset, if an input isn't finite.
+  */
+inline bool gaitTableLookup(const GaitTableHeader &header, const float* values, double dx, double dz, double r,
+                            double &q, double &dqdz, double &dqdr)
+{
+	if (!isfinite(dx) || !isfinite(dz) || !isfinite(r))
+		return false;
+
+	uint32_t ix, iz, ir;
+	bool     clampedX, clampedZ, clampedR;
+	double tx = gaitTableCell(dx, header.dxMin, header.dxStep, header.nDx, ix, clampedX);
+	double tz = gaitTableCell(dz, header.dzMin, header.dzStep, header.nDz, iz, clampedZ);
+	double tr = gaitTableCell(r,  header.rMin,  header.rStep,  header.nR,  ir, clampedR);
+
+	// The cell's corners
+	const float* c0 = values + (ix*header.nDz + iz)*header.nR + ir;
+	const float* c1 = c0 + header.nDz*header.nR;
+	double c000 = c0[0], c001 = c0[1], c010 = c0[header.nR], c011 = c0[header.nR + 1];
+	double c100 = c1[0], c101 = c1[1], c110 = c1[header.nR], c111 = c1[header.nR + 1];
+
+	// Interpolate along r, then dz, then dx
+	double c00 = c000 + (c001 - c000)*tr;
+	double c01 = c010 + (c011 - c010)*tr;
+	double c10 = c100 + (c101 - c100)*tr;
+	double c11 = c110 + (c111 - c110)*tr;
+	double cx0 = c00 + (c01 - c00)*tz;
+	double cx1 = c10 + (c11 - c10)*tz;
+	q = cx0 + (cx1 - cx0)*tx;
+
+	// And the slopes within this cell
+	dqdz = ((c01 - c00)*(1.0 - tx) + (c11 - c10)*tx)/header.dzStep;
+	double d0 = (c001 - c000) + ((c011 - c010) - (c001 - c000))*tz;
+	double d1 = (c101 - c100) + ((c111 - c110) - (c101 - c100))*tz;
+	dqdr = (d0 + (d1 - d0)*tx)/header.rStep;
+
+	if (clampedZ)
+		dqdz = 0.0;
+	if (clampedR)
+		dqdr = 0.0;
+
+	return true;
+}
+
+}
+}
+
+#endif // GAIT_TABLE_H
+
+// vim: noexpandtab
@@ -0,0 +1,151 @@
+#include "asc_gait_table/ASCGaitTable.hpp"
+
+// Standard library
+#include <fcntl.h>
+#include <math.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Orocos
+#include <rtt/Logger.hpp>
+
+// The namespaces this controller resides in
+namespace atrias {
+namespace controller {
+
+ASCGaitTable::ASCGaitTable(AtriasController *parent, string name) :
+	AtriasController(parent, name),
+	current(-1),
+	log_out(this)
+{
+	for (int i = 0; i < 2; i++) {
+		mappings[i].addr = NULL;
+		mappings[i].length = 0;
+		mappings[i].header = NULL;
+		mappings[i].values = NULL;
+	}
+}
+
+ASCGaitTable::~ASCGaitTable() {
+	unmap(mappings[0]);
+	unmap(mappings[1]);
+}
+
+void ASCGaitTable::unmap(Mapping &mapping) {
+	if (mapping.addr)
+		munmap(mapping.addr, mapping.length);
+
+	mapping.addr = NULL;
+	mapping.length = 0;
+	mapping.header = NULL;
+	mapping.values = NULL;
+}
+
+bool ASCGaitTable::load(const string &filename) {
+	int fd = open(filename.c_str(), O_RDONLY);
+	if (fd < 0) {
+		RTT::log(RTT::Error) << "Could not open gait table " << filename << RTT::endlog();
+		return false;
+	}
+
+	struct stat st;
+	if (fstat(fd, &st) < 0 || (size_t) st.st_size < sizeof(GaitTableHeader)) {
+		RTT::log(RTT::Error) << "Gait table " << filename << " is truncated" << RTT::endlog();
+		close(fd);
+		return false;
+	}
+
+	// Map the whole table and fault it in now, rather than in the control loop
+	void* addr = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+	close(fd);
+	if (addr == MAP_FAILED) {
+		RTT::log(RTT::Error) << "Could not map gait table " << filename << RTT::endlog();
+		return false;
+	}
+
+	// The header's dimensions come from the file, so check they fit in it
+	// by dividing, rather than multiplying them out, which could overflow.
+	const GaitTableHeader* header = (const GaitTableHeader*) addr;
+	size_t room = (st.st_size - sizeof(GaitTableHeader)) / sizeof(float);
+	bool valid = strncmp(header->magic, GAIT_TABLE_MAGIC, sizeof(header->magic)) == 0 &&
+	             header->version == GAIT_TABLE_VERSION &&
+	             header->nDx >= 2 && header->nDz >= 2 && header->nR >= 2 &&
+	             header->dxStep > 0.0 && header->dzStep > 0.0 && header->rStep > 0.0 &&
+	             header->k > 0.0 && header->m > 0.0 &&
+	             header->nDx <= room / header->nDz / header->nR;
+	if (!valid) {
+		RTT::log(RTT::Error) << filename << " is not a valid gait table" << RTT::endlog();
+		munmap(addr, st.st_size);
+		return false;
+	}
+
+	// Replace whichever table isn't in use, then switch to it
+	int next = (current.load() == 0) ? 1 : 0;
+	unmap(mappings[next]);
+	mappings[next].addr = addr;
+	mappings[next].length = st.st_size;
+	mappings[next].header = header;
+	mappings[next].values = (const float*) (header + 1);
+	current.store(next);
+
+	RTT::log(RTT::Info) << "Loaded gait table " << filename << " (" << header->nDx << "x" << header->nDz
+	               << "x" << header->nR << ", k " << header->k << ", m " << header->m << ", max error "
+	               << header->maxError << " rad)" << RTT::endlog();
+	return true;
+}
+
+bool ASCGaitTable::isLoaded() {
+	return current.load() >= 0;
+}
+
+bool ASCGaitTable::matches(double k, double m) {
+	int i = current.load();
+	if (i < 0)
+		return false;
+
+	const GaitTableHeader* header = mappings[i].header;
+	return fabs(k - header->k) <= GAIT_TABLE_MODEL_TOLERANCE*header->k &&
+	       fabs(m - header->m) <= GAIT_TABLE_MODEL_TOLERANCE*header->m;
+}
+
+double ASCGaitTable::maxError() {
+	int i = current.load();
+	if (i < 0)
+		return INFINITY;
+
+	return mappings[i].header->maxError;
+}
+
+std::tuple<double, double> ASCGaitTable::equilibriumAngle(double dx, double dz, double r, double dr) {
+	ProfileScope scope(this);
+
+	double q = PI/2.0;
+	double dq = 0.0;
+
+	int i = current.load(std::memory_order_acquire);
+	if (i >= 0) {
+		const Mapping &mapping = mappings[i];
+		double dqdz, dqdr;
+		if (gaitTableLookup(*mapping.header, mapping.values, dx, dz, r, q, dqdz, dqdr)) {
+			// While falling, dz changes at -g
+			dq = -G*dqdz + dqdr*dr;
+		}
+	}
+
+	// Set the log data
+	log_out.data.q = q;
+	log_out.data.dq = dq;
+
+	// Transmit the log data
+	log_out.send();
+
+	// Return the leg angle and its rate
+	return std::make_tuple(q, dq);
+}
+
+}
+}
+
+// vim: noexpandtab
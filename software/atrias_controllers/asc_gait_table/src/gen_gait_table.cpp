@@ -0,0 +1,157 @@
+/**
+  * @file gen_gait_table.cpp
+  * @brief Generates a gait table for ASCGaitTable.
+  * Solves for the equilibrium touchdown angle at every grid point with
+  * asc_slip_model's SlipPredictor, then checks the interpolated table
+  * against the solver at the center of every cell.
+  *
+  * Fast, shallow touchdowns (high dx with dz near 0) have no equilibrium
+  * within the solver's search range, and the table is discontinuous there,
+  * so the default grid stops at dz = -1.
+  *
+  * Usage: gen_gait_table out.gait [k=28000] [m=<M>] [dx=min:max:n] [dz=min:max:n] [r=min:max:n]
+  */
+
+// Standard library
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+// The table format
+#include "asc_gait_table/GaitTable.h"
+
+// The solver
+#include "asc_slip_model/SlipPredictor.hpp"
+
+using namespace atrias::controller;
+
+// One grid axis
+struct Axis {
+	double   min, max;
+	uint32_t n;
+};
+
+// Parses "min:max:n" into an axis. Returns false if malformed.
+static bool parseAxis(const char* value, Axis &axis) {
+	if (sscanf(value, "%lf:%lf:%u", &axis.min, &axis.max, &axis.n) != 3)
+		return false;
+
+	return axis.n >= 2 && axis.max > axis.min;
+}
+
+static void usage(const char* name) {
+	fprintf(stderr, "Usage: %s out.gait [k=28000] [m=%g] [dx=min:max:n] [dz=min:max:n] [r=min:max:n]\n", name, M);
+}
+
+int main(int argc, char** argv) {
+	if (argc < 2) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	SlipPredictor predictor;
+	Axis dxAxis = { 0.0,  4.0, 41};
+	Axis dzAxis = {-3.0, -1.0, 11};
+	Axis rAxis  = { 0.7, 0.95, 11};
+
+	for (int i = 2; i < argc; i++) {
+		bool ok;
+		if (strncmp(argv[i], "k=", 2) == 0)
+			ok = (predictor.k = atof(argv[i] + 2)) > 0.0;
+		else if (strncmp(argv[i], "m=", 2) == 0)
+			ok = (predictor.m = atof(argv[i] + 2)) > 0.0;
+		else if (strncmp(argv[i], "dx=", 3) == 0)
+			ok = parseAxis(argv[i] + 3, dxAxis);
+		else if (strncmp(argv[i], "dz=", 3) == 0)
+			ok = parseAxis(argv[i] + 3, dzAxis);
+		else if (strncmp(argv[i], "r=", 2) == 0)
+			ok = parseAxis(argv[i] + 2, rAxis);
+		else
+			ok = false;
+
+		if (!ok) {
+			fprintf(stderr, "Bad argument: %s\n", argv[i]);
+			usage(argv[0]);
+			return 1;
+		}
+	}
+
+	GaitTableHeader header;
+	memset(&header, 0, sizeof(header));
+	strncpy(header.magic, GAIT_TABLE_MAGIC, sizeof(header.magic));
+	header.version = GAIT_TABLE_VERSION;
+	header.nDx = dxAxis.n;
+	header.nDz = dzAxis.n;
+	header.nR = rAxis.n;
+	header.dxMin = dxAxis.min;
+	header.dxStep = (dxAxis.max - dxAxis.min)/(dxAxis.n - 1);
+	header.dzMin = dzAxis.min;
+	header.dzStep = (dzAxis.max - dzAxis.min)/(dzAxis.n - 1);
+	header.rMin = rAxis.min;
+	header.rStep = (rAxis.max - rAxis.min)/(rAxis.n - 1);
+	header.k = predictor.k;
+	header.m = predictor.m;
+
+	// The touchdown leg length is the leg's rest length for that stance
+	std::vector<float> values(gaitTableSize(header));
+	for (uint32_t ix = 0; ix < header.nDx; ix++) {
+		for (uint32_t iz = 0; iz < header.nDz; iz++) {
+			for (uint32_t ir = 0; ir < header.nR; ir++) {
+				predictor.r0 = header.rMin + ir*header.rStep;
+				values[(ix*header.nDz + iz)*header.nR + ir] =
+					predictor.equilibriumAngle(header.dxMin + ix*header.dxStep, header.dzMin + iz*header.dzStep);
+			}
+		}
+	}
+
+	// The error is largest farthest from the grid points, at the cell centers
+	double maxError = 0.0, sumSquares = 0.0;
+	double worstDx = 0.0, worstDz = 0.0, worstR = 0.0;
+	uint32_t cells = 0;
+	for (uint32_t ix = 0; ix + 1 < header.nDx; ix++) {
+		for (uint32_t iz = 0; iz + 1 < header.nDz; iz++) {
+			for (uint32_t ir = 0; ir + 1 < header.nR; ir++) {
+				double dx = header.dxMin + (ix + 0.5)*header.dxStep;
+				double dz = header.dzMin + (iz + 0.5)*header.dzStep;
+				double r = header.rMin + (ir + 0.5)*header.rStep;
+
+				double q = 0.0, dqdz, dqdr;
+				gaitTableLookup(header, &values[0], dx, dz, r, q, dqdz, dqdr);
+				predictor.r0 = r;
+				double error = fabs(q - predictor.equilibriumAngle(dx, dz));
+
+				if (error > maxError) {
+					maxError = error;
+					worstDx = dx;
+					worstDz = dz;
+					worstR = r;
+				}
+				sumSquares += error*error;
+				cells++;
+			}
+		}
+	}
+	header.maxError = maxError;
+
+	FILE* out = fopen(argv[1], "wb");
+	if (!out) {
+		perror(argv[1]);
+		return 1;
+	}
+	bool written = fwrite(&header, sizeof(header), 1, out) == 1 &&
+	               fwrite(&values[0], sizeof(float), values.size(), out) == values.size();
+	if (fclose(out) != 0 || !written) {
+		fprintf(stderr, "Could not write %s\n", argv[1]);
+		return 1;
+	}
+
+	printf("Wrote %s: %ux%ux%u points, %zu bytes\n", argv[1], header.nDx, header.nDz, header.nR,
+	       sizeof(header) + values.size()*sizeof(float));
+	printf("Interpolation error over %u cells: max %g rad, rms %g rad\n", cells, maxError, sqrt(sumSquares/cells));
+	printf("Largest error at dx = %g, dz = %g, r = %g\n", worstDx, worstDz, worstR);
+	return 0;
+}
+
+// vim: noexpandtab
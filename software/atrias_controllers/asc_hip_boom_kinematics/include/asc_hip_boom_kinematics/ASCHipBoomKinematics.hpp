@@ -16,15 +16,15 @@
 // Our log data
 #include "asc_hip_boom_kinematics/controller_log_data.h"
 
+// The hip solve itself
+#include "asc_hip_boom_kinematics/HipSolver.hpp"
+
 // Datatypes
 #include <atrias_shared/controller_structs.h>
 #include <atrias_shared/atrias_parameters.h>
 #include <atrias_msgs/robot_state.h>
 #include <robot_invariant_defs.h>
 
-// Cpp
-#include <complex.h>
-
 // Namespaces we're using
 using namespace std;
 using namespace atrias_msgs;
@@ -48,6 +48,7 @@ class ASCHipBoomKinematics : public AtriasController {
 
 		        /**
 		          * @brief The inverse kinematics function.
+		          * Also computes the hip velocities, into hipVelocity.
 		          * @param toePosition
 		          * @param lLeg
 		          * @param rLeg
@@ -56,17 +57,17 @@ class ASCHipBoomKinematics : public AtriasController {
 		          */
 				std::tuple<double, double> iKine(LeftRight toePosition, atrias_msgs::robot_state_leg lLeg, atrias_msgs::robot_state_leg rLeg, atrias_msgs::robot_state_location position);
 
-				// Imaginary number
-			   	complex<double> i;
-			   	
-			   	// Hip angles
-				complex<double> complexHipAngleLeft, complexHipAngleRight;
-	
 				// Desired position
 				double lLeftLeg, lRightLeg, qLeftLeg, qRightLeg;
+
+				// Leg velocities
+				double dlLeftLeg, dlRightLeg, dqLeftLeg, dqRightLeg;
 	
 				// Hip angles
 				LeftRight hipAngle;
+
+				// Hip velocities. Zero while the hip angle is at its limit.
+				LeftRight hipVelocity;
 			
 	   
         private:
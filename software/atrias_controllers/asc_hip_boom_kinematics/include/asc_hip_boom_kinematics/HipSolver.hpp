@@ -0,0 +1,40 @@
+#ifndef HIP_SOLVER_HPP
+#define HIP_SOLVER_HPP
+
+/**
+  * @file HipSolver.hpp
+  * @brief Solves for one hip's angle and velocity from the leg and boom.
+  * This holds no controller state, so it may also be used outside a
+  * controller (such as by offline tools).
+  */
+
+// Standard library
+#include <tuple>
+
+// Our namespaces
+namespace atrias {
+namespace controller {
+
+/**
+  * @brief Solves for one hip's angle and velocity.
+  * The toe lies in the leg's plane, which is offset lHip from
+  * the hip axis, so the toe's distance from the boom pivot
+  * gives a cos(phi) + b sin(phi) = c for the hip angle phi.
+  * @param lHip        The leg plane's offset from the hip axis.
+  * @param qBodyOffset The angle between the boom and the body.
+  * @param toePosition The toe's distance from the boom pivot.
+  * @param l, q        The leg length and angle.
+  * @param dl, dq      Their velocities.
+  * @param hipRadius   The hip axis's distance from the boom pivot.
+  * @param dHipRadius  Its velocity.
+  * @param boomAngle   The boom angle.
+  * @param dBoomAngle  The boom angle velocity.
+  * @param side        1 for the left hip, -1 for the right.
+  * @return The hip angle and velocity, before wrapping and limiting.
+  */
+std::tuple<double, double> solveHip(double lHip, double qBodyOffset, double toePosition, double l, double q, double dl, double dq, double hipRadius, double dHipRadius, double boomAngle, double dBoomAngle, double side);
+
+}
+}
+
+#endif // HIP_SOLVER_HPP
@@ -24,9 +24,7 @@ ASCHipBoomKinematics::ASCHipBoomKinematics(AtriasController *parent, string name
 
 
 std::tuple<double, double> ASCHipBoomKinematics::iKine(LeftRight toePosition, atrias_msgs::robot_state_leg lLeg, atrias_msgs::robot_state_leg rLeg, atrias_msgs::robot_state_location position) {
-
-    // Define imaginary number i
-    i = complex<double>(0.0, 1.0);
+    ProfileScope scope(this);
 
 	// Get leg lengths and angles // TODO switch to ascCommonToolkit equations
     lLeftLeg = (L1 + L2)*cos((lLeg.halfB.legAngle - lLeg.halfA.legAngle)/2.0);
@@ -34,24 +32,37 @@ std::tuple<double, double> ASCHipBoomKinematics::iKine(LeftRight toePosition, at
     qLeftLeg = (lLeg.halfA.legAngle + lLeg.halfB.legAngle)/2.0;
     qRightLeg = (rLeg.halfA.legAngle + rLeg.halfB.legAngle)/2.0;
 
-	// Compute inverse kinematics
-	complexHipAngleLeft = - position.boomAngle - qBodyOffset - log((- sqrt(pow(lLeftLeg, 2) - 2.0*pow(lLeftLeg, 2)*exp(qLeftLeg*2.0*i) + pow(lLeftLeg, 2)*exp(qLeftLeg*4.0*i) + 4.0*pow(toePosition.left, 2)*exp(qLeftLeg*2.0*i) - 4.0*pow(lHip, 2)*exp(qLeftLeg*2.0*i) + 4.0*pow(lBoom, 2)*exp(qLeftLeg*2.0*i)*pow(cos(position.boomAngle), 2) - 4.0*pow(lLeftLeg, 2)*exp(qLeftLeg*2.0*i)*pow(cos(qLeftLeg), 2) + 4.0*pow(lBody, 2)*exp(qLeftLeg*2.0*i)*pow(cos(position.boomAngle), 2)*pow(cos(qBodyOffset), 2) + 4.0*pow(lBody, 2)*exp(qLeftLeg*2.0*i)*pow(sin(position.boomAngle), 2)*pow(sin(qBodyOffset), 2) + 8.0*lBoom*exp(qLeftLeg*2.0*i)*cos(position.boomAngle)*sqrt(toePosition.left + lLeftLeg*cos(qLeftLeg))*sqrt(toePosition.left - lLeftLeg*cos(qLeftLeg)) + 8.0*lBoom*lBody*exp(qLeftLeg*2.0*i)*pow(cos(position.boomAngle), 2)*cos(qBodyOffset) - 8.0*lBoom*lBody*exp(qLeftLeg*2.0*i)*cos(position.boomAngle)*sin(position.boomAngle)*sin(qBodyOffset) + 8.0*lBody*exp(qLeftLeg*2.0*i)*cos(position.boomAngle)*cos(qBodyOffset)*sqrt(toePosition.left + lLeftLeg*cos(qLeftLeg))*sqrt(toePosition.left - lLeftLeg*cos(qLeftLeg)) - 8.0*lBody*exp(qLeftLeg*2.0*i)*sin(position.boomAngle)*sin(qBodyOffset)*sqrt(toePosition.left + lLeftLeg*cos(qLeftLeg))*sqrt(toePosition.left - lLeftLeg*cos(qLeftLeg)) - 8.0*pow(lBody, 2)*exp(qLeftLeg*2.0*i)*cos(position.boomAngle)*cos(qBodyOffset)*sin(position.boomAngle)*sin(qBodyOffset)) + 2.0*lBoom*cos(position.boomAngle)*(cos(qLeftLeg) + sin(qLeftLeg)*i) + 2.0*exp(qLeftLeg*i)*sqrt(toePosition.left + lLeftLeg*cos(qLeftLeg))*sqrt(toePosition.left - lLeftLeg*cos(qLeftLeg)) + 2.0*lBody*cos(position.boomAngle + qBodyOffset)*(cos(qLeftLeg) + sin(qLeftLeg)*i))/(lLeftLeg + 2.0*lHip*exp(qLeftLeg*i) - lLeftLeg*exp(qLeftLeg*2.0*i)))*i;
+	// And their velocities
+    dlLeftLeg = -(L1 + L2)*sin((lLeg.halfB.legAngle - lLeg.halfA.legAngle)/2.0)*(lLeg.halfB.legVelocity - lLeg.halfA.legVelocity)/2.0;
+    dlRightLeg = -(L1 + L2)*sin((rLeg.halfB.legAngle - rLeg.halfA.legAngle)/2.0)*(rLeg.halfB.legVelocity - rLeg.halfA.legVelocity)/2.0;
+    dqLeftLeg = (lLeg.halfA.legVelocity + lLeg.halfB.legVelocity)/2.0;
+    dqRightLeg = (rLeg.halfA.legVelocity + rLeg.halfB.legVelocity)/2.0;
 
-    complexHipAngleRight = - position.boomAngle - qBodyOffset - log(-(- sqrt(2.0*pow(lBody, 2)*exp(qRightLeg*2.0*i) - 4.0*pow(lHip, 2)*exp(qRightLeg*2.0*i) - 2.0*pow(lRightLeg, 2)*exp(qRightLeg*2.0*i) + pow(lRightLeg, 2)*exp(qRightLeg*4.0*i) + 4.0*pow(toePosition.right, 2)*exp(qRightLeg*2.0*i) + pow(lRightLeg, 2) + 4.0*pow(lBoom, 2)*exp(qRightLeg*2.0*i)*pow(cos(position.boomAngle), 2) - 4.0*pow(lRightLeg, 2)*exp(qRightLeg*2.0*i)*pow(cos(qRightLeg), 2) + 2.0*pow(lBody, 2)*cos(2.0*position.boomAngle + 2.0*qBodyOffset)*exp(qRightLeg*2.0*i) + 4.0*lBoom*lBody*exp(qRightLeg*2.0*i)*cos(qBodyOffset) + 4.0*lBoom*lBody*cos(2.0*position.boomAngle + qBodyOffset)*exp(qRightLeg*2.0*i) + 8.0*lBody*exp(qRightLeg*2.0*i)*cos(position.boomAngle + qBodyOffset)*sqrt(toePosition.right + lRightLeg*cos(qRightLeg))*sqrt(toePosition.right - lRightLeg*cos(qRightLeg)) + 8.0*lBoom*exp(qRightLeg*2.0*i)*cos(position.boomAngle)*sqrt(toePosition.right + lRightLeg*cos(qRightLeg))*sqrt(toePosition.right - lRightLeg*cos(qRightLeg))) + 2.0*exp(qRightLeg*i)*sqrt(toePosition.right + lRightLeg*cos(qRightLeg))*sqrt(toePosition.right - lRightLeg*cos(qRightLeg)) + 2.0*lBody*exp(qRightLeg*i)*cos(position.boomAngle + qBodyOffset) + 2.0*lBoom*exp(qRightLeg*i)*cos(position.boomAngle))/(- lRightLeg + 2.0*lHip*exp(qRightLeg*i) + lRightLeg*exp(qRightLeg*2.0*i)))*i;
+	// The hip axis's distance from the boom pivot, in the boom's vertical plane
+	double hipRadius = lBoom*cos(position.boomAngle) + lBody*cos(position.boomAngle + qBodyOffset);
+	double dHipRadius = -(lBoom*sin(position.boomAngle) + lBody*sin(position.boomAngle + qBodyOffset))*position.boomAngleVelocity;
 
-	// TODO - Add velocity terms
+	// Compute inverse kinematics
+	std::tie(hipAngle.left, hipVelocity.left) = solveHip(lHip, qBodyOffset, toePosition.left, lLeftLeg, qLeftLeg, dlLeftLeg, dqLeftLeg, hipRadius, dHipRadius, position.boomAngle, position.boomAngleVelocity, 1.0);
+	std::tie(hipAngle.right, hipVelocity.right) = solveHip(lHip, qBodyOffset, toePosition.right, lRightLeg, qRightLeg, dlRightLeg, dqRightLeg, hipRadius, dHipRadius, position.boomAngle, position.boomAngleVelocity, -1.0);
 
-	// We only care about the real part, the imaginary part should be zero
-	hipAngle.left = fmod(real(complexHipAngleLeft) + 4.0*PI, 2.0*PI);
-	hipAngle.right = fmod(real(complexHipAngleRight) + 4.0*PI, 2.0*PI);
+	// Wrap the hip angles into [0, 2*pi)
+	hipAngle.left = fmod(hipAngle.left + 4.0*PI, 2.0*PI);
+	hipAngle.right = fmod(hipAngle.right + 4.0*PI, 2.0*PI);
 
 	// Clamp hip angles to physical limits
+	if (hipAngle.left <= LEFT_HIP_MOTOR_MIN_LOC || hipAngle.left >= LEFT_HIP_MOTOR_MAX_LOC)
+		hipVelocity.left = 0.0;
+	if (hipAngle.right <= RIGHT_HIP_MOTOR_MIN_LOC || hipAngle.right >= RIGHT_HIP_MOTOR_MAX_LOC)
+		hipVelocity.right = 0.0;
 	hipAngle.left = clamp(hipAngle.left, LEFT_HIP_MOTOR_MIN_LOC, LEFT_HIP_MOTOR_MAX_LOC);
 	hipAngle.right = clamp(hipAngle.right, RIGHT_HIP_MOTOR_MIN_LOC, RIGHT_HIP_MOTOR_MAX_LOC);
 	
 	// Set the log data
     log_out.data.leftHipAngle = hipAngle.left;
     log_out.data.rightHipAngle = hipAngle.right;
+    log_out.data.leftHipVelocity = hipVelocity.left;
+    log_out.data.rightHipVelocity = hipVelocity.right;
 
     // Transmit the log data
     log_out.send();
@@ -0,0 +1,78 @@
+#include "asc_hip_boom_kinematics/HipSolver.hpp"
+
+// Standard library
+#include <math.h>
+
+// Datatypes
+#include <atrias_shared/atrias_parameters.h>
+
+// The namespaces this controller resides in
+namespace atrias {
+namespace controller {
+
+std::tuple<double, double> solveHip(double lHip, double qBodyOffset, double toePosition, double l, double q, double dl, double dq, double hipRadius, double dHipRadius, double boomAngle, double dBoomAngle, double side) {
+
+	// The leg's projection onto the boom's vertical plane, and the toe's
+	// offset from the hip axis in that plane
+	double a = l*sin(q);
+	double da = dl*sin(q) + l*cos(q)*dq;
+	double rho2 = lHip*lHip + a*a;
+	double rho = sqrt(rho2);
+
+	// The toe's distance from the boom pivot within that plane. The leg's
+	// other component is tangent to the boom's circle.
+	double lSagittal = l*cos(q);
+	double dlSagittal = dl*cos(q) - l*sin(q)*dq;
+	// If the toe is nearer the pivot than the leg reaches (only with bad
+	// inputs), take the toe to be in line with the pivot.
+	double toeRadius2 = toePosition*toePosition - lSagittal*lSagittal;
+	double toeRadius = 0.0;
+	double dToeRadius = 0.0;
+	if (toeRadius2 > 0.0) {
+		toeRadius = sqrt(toeRadius2);
+		dToeRadius = -lSagittal*dlSagittal/toeRadius;
+	}
+
+	// The hip axis's distance from the boom pivot, plus the toe's
+	// FIXME This is the original derivation's geometry, but it puts c well
+	// beyond rho everywhere in the workspace, so the toe is never in reach
+	// and the hip angle doesn't depend on toePosition. Check the sign of
+	// toeRadius against the robot.
+	double c = hipRadius + toeRadius;
+	double dc = dHipRadius + dToeRadius;
+
+	// The hip angle relative to the body, psi, satisfies
+	// side*lHip*cos(psi) + a*sin(psi) = c. Here phi is psi less the
+	// angle of (lHip, a). If the toe is out of reach, this gives the
+	// closest hip angle.
+	double u = c/rho;
+	double du = (dc - u*a*da/rho)/rho;
+	double phi, dphi;
+	if (u >= 1.0) {
+		phi = 0.0;
+		dphi = 0.0;
+	} else if (u <= -1.0) {
+		phi = PI;
+		dphi = 0.0;
+	} else {
+		phi = acos(u);
+		dphi = -du/sqrt(1.0 - u*u);
+	}
+
+	// The left and right hips turn in opposite directions
+	double hip = -boomAngle - qBodyOffset + phi;
+	double dHip = -dBoomAngle + dphi;
+	if (side > 0.0) {
+		hip += atan2(a, lHip);
+		dHip += lHip*da/rho2;
+	} else {
+		hip += PI - atan2(a, lHip);
+		dHip -= lHip*da/rho2;
+	}
+
+	return std::make_tuple(hip, dHip);
+
+}
+
+}
+}
@@ -0,0 +1,268 @@
+/** @file
+  * @brief Checks solveHip() against the complex-valued expressions
+  * ASCHipBoomKinematics::iKine() used before it, over random states across
+  * the joint range, and times both.
+  *
+  * The old expressions only gave the hip angles. solveHip()'s angles must
+  * match theirs, both as iKine() wraps and limits them and before, and its
+  * velocities must match central differences of its angles.
+  *
+  * With the robot's geometry the toe is never in reach (see the FIXME in
+  * HipSolver.cpp), so every state takes the out-of-reach branch. The same
+  * checks are run with the boom mirrored to the far side of the hip, which
+  * puts the toe in reach, so the acos() branch is compared too.
+  *
+  * Exits with a nonzero status if a check fails.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#include <algorithm>
+#include <complex>
+
+#include <atrias_shared/atrias_parameters.h>
+#include <robot_invariant_defs.h>
+
+#include "asc_hip_boom_kinematics/HipSolver.hpp"
+
+using namespace atrias::controller;
+using std::complex;
+
+// ASCHipBoomKinematics's geometry. lBoom and lBody vary by test geometry.
+static const double lHip = 0.18;
+static const double qBodyOffset = PI/2.0 - 0.126;
+
+/**
+  * @brief A boom geometry the states are checked with.
+  */
+struct Geometry {
+	const char* name;
+	double      lBoom, lBody;
+	bool        inReach; // Whether most states should have the toe in reach
+};
+
+static const Geometry geometries[] = {
+	{"robot",     2.04, 0.35, false},
+	{"mirrored", -2.04, 0.35, true},
+};
+
+// The states checked
+#define TEST_STATES      200000
+#define TEST_L_MIN       0.5
+#define TEST_L_MAX       0.97
+#define TEST_Q_MIN       0.8
+#define TEST_Q_MAX       2.4
+#define TEST_TOE_MIN     1.9
+#define TEST_TOE_MAX     2.6
+#define TEST_BOOM_MIN   -0.3
+#define TEST_BOOM_MAX    0.4
+#define TEST_SPEED       5.0 // Largest leg and boom rates (/s)
+
+// How far solveHip() may be from the old expressions (radians)
+#define ANGLE_TOLERANCE  1e-6
+
+// The least fraction of states that must have the toe in reach, for a
+// geometry where it should be
+#define MIN_IN_REACH     0.5
+
+// How close to 1 the solver's cos(phi) may be for the velocity to be checked.
+// At 1 the velocity is singular, and the differences straddle it.
+#define VELOCITY_MAX_COS 0.999
+
+// The step its velocities are checked over (s), and how far they may be
+// from the differences, relative to the larger of 1 and the difference
+#define VELOCITY_STEP      1e-6
+#define VELOCITY_TOLERANCE 1e-4
+
+// How many calls each is timed over
+#define BENCH_CALLS 1000000
+
+/**
+  * @brief The old iKine()'s expressions, unchanged. Only the real parts of
+  * the results were used.
+  */
+static void oldHipAngles(const Geometry &geometry, double toeLeft, double toeRight, double lLeftLeg, double qLeftLeg,
+                         double lRightLeg, double qRightLeg, double boomAngle,
+                         double &hipLeft, double &hipRight)
+{
+	const complex<double> i(0.0, 1.0);
+	const double lBoom = geometry.lBoom;
+	const double lBody = geometry.lBody;
+	struct { double left, right; } toePosition = {toeLeft, toeRight};
+	struct { double boomAngle; } position = {boomAngle};
+
+	complex<double> left = - position.boomAngle - qBodyOffset - log((- sqrt(pow(lLeftLeg, 2) - 2.0*pow(lLeftLeg, 2)*exp(qLeftLeg*2.0*i) + pow(lLeftLeg, 2)*exp(qLeftLeg*4.0*i) + 4.0*pow(toePosition.left, 2)*exp(qLeftLeg*2.0*i) - 4.0*pow(lHip, 2)*exp(qLeftLeg*2.0*i) + 4.0*pow(lBoom, 2)*exp(qLeftLeg*2.0*i)*pow(cos(position.boomAngle), 2) - 4.0*pow(lLeftLeg, 2)*exp(qLeftLeg*2.0*i)*pow(cos(qLeftLeg), 2) + 4.0*pow(lBody, 2)*exp(qLeftLeg*2.0*i)*pow(cos(position.boomAngle), 2)*pow(cos(qBodyOffset), 2) + 4.0*pow(lBody, 2)*exp(qLeftLeg*2.0*i)*pow(sin(position.boomAngle), 2)*pow(sin(qBodyOffset), 2) + 8.0*lBoom*exp(qLeftLeg*2.0*i)*cos(position.boomAngle)*sqrt(toePosition.left + lLeftLeg*cos(qLeftLeg))*sqrt(toePosition.left - lLeftLeg*cos(qLeftLeg)) + 8.0*lBoom*lBody*exp(qLeftLeg*2.0*i)*pow(cos(position.boomAngle), 2)*cos(qBodyOffset) - 8.0*lBoom*lBody*exp(qLeftLeg*2.0*i)*cos(position.boomAngle)*sin(position.boomAngle)*sin(qBodyOffset) + 8.0*lBody*exp(qLeftLeg*2.0*i)*cos(position.boomAngle)*cos(qBodyOffset)*sqrt(toePosition.left + lLeftLeg*cos(qLeftLeg))*sqrt(toePosition.left - lLeftLeg*cos(qLeftLeg)) - 8.0*lBody*exp(qLeftLeg*2.0*i)*sin(position.boomAngle)*sin(qBodyOffset)*sqrt(toePosition.left + lLeftLeg*cos(qLeftLeg))*sqrt(toePosition.left - lLeftLeg*cos(qLeftLeg)) - 8.0*pow(lBody, 2)*exp(qLeftLeg*2.0*i)*cos(position.boomAngle)*cos(qBodyOffset)*sin(position.boomAngle)*sin(qBodyOffset)) + 2.0*lBoom*cos(position.boomAngle)*(cos(qLeftLeg) + sin(qLeftLeg)*i) + 2.0*exp(qLeftLeg*i)*sqrt(toePosition.left + lLeftLeg*cos(qLeftLeg))*sqrt(toePosition.left - lLeftLeg*cos(qLeftLeg)) + 2.0*lBody*cos(position.boomAngle + qBodyOffset)*(cos(qLeftLeg) + sin(qLeftLeg)*i))/(lLeftLeg + 2.0*lHip*exp(qLeftLeg*i) - lLeftLeg*exp(qLeftLeg*2.0*i)))*i;
+	complex<double> right = - position.boomAngle - qBodyOffset - log(-(- sqrt(2.0*pow(lBody, 2)*exp(qRightLeg*2.0*i) - 4.0*pow(lHip, 2)*exp(qRightLeg*2.0*i) - 2.0*pow(lRightLeg, 2)*exp(qRightLeg*2.0*i) + pow(lRightLeg, 2)*exp(qRightLeg*4.0*i) + 4.0*pow(toePosition.right, 2)*exp(qRightLeg*2.0*i) + pow(lRightLeg, 2) + 4.0*pow(lBoom, 2)*exp(qRightLeg*2.0*i)*pow(cos(position.boomAngle), 2) - 4.0*pow(lRightLeg, 2)*exp(qRightLeg*2.0*i)*pow(cos(qRightLeg), 2) + 2.0*pow(lBody, 2)*cos(2.0*position.boomAngle + 2.0*qBodyOffset)*exp(qRightLeg*2.0*i) + 4.0*lBoom*lBody*exp(qRightLeg*2.0*i)*cos(qBodyOffset) + 4.0*lBoom*lBody*cos(2.0*position.boomAngle + qBodyOffset)*exp(qRightLeg*2.0*i) + 8.0*lBody*exp(qRightLeg*2.0*i)*cos(position.boomAngle + qBodyOffset)*sqrt(toePosition.right + lRightLeg*cos(qRightLeg))*sqrt(toePosition.right - lRightLeg*cos(qRightLeg)) + 8.0*lBoom*exp(qRightLeg*2.0*i)*cos(position.boomAngle)*sqrt(toePosition.right + lRightLeg*cos(qRightLeg))*sqrt(toePosition.right - lRightLeg*cos(qRightLeg))) + 2.0*exp(qRightLeg*i)*sqrt(toePosition.right + lRightLeg*cos(qRightLeg))*sqrt(toePosition.right - lRightLeg*cos(qRightLeg)) + 2.0*lBody*exp(qRightLeg*i)*cos(position.boomAngle + qBodyOffset) + 2.0*lBoom*exp(qRightLeg*i)*cos(position.boomAngle))/(- lRightLeg + 2.0*lHip*exp(qRightLeg*i) + lRightLeg*exp(qRightLeg*2.0*i)))*i;
+
+	hipLeft = real(left);
+	hipRight = real(right);
+}
+
+// The hip axis's distance from the boom pivot, as iKine() computes it
+static double hipRadius(const Geometry &geometry, double boomAngle) {
+	return geometry.lBoom*cos(boomAngle) + geometry.lBody*cos(boomAngle + qBodyOffset);
+}
+
+static double dHipRadius(const Geometry &geometry, double boomAngle, double dBoomAngle) {
+	return -(geometry.lBoom*sin(boomAngle) + geometry.lBody*sin(boomAngle + qBodyOffset))*dBoomAngle;
+}
+
+// The cosine solveHip() takes the arc cosine of; the toe is in reach when
+// it's within -1..1
+static double hipCos(const Geometry &geometry, double toe, double l, double q, double boomAngle) {
+	double a = l*sin(q);
+	double lSagittal = l*cos(q);
+	return (hipRadius(geometry, boomAngle) + sqrt(toe*toe - lSagittal*lSagittal))/sqrt(lHip*lHip + a*a);
+}
+
+// Wraps and limits a hip angle as iKine() does
+static double limitHip(double hip, double min, double max) {
+	hip = fmod(hip + 4.0*PI, 2.0*PI);
+	return std::min(std::max(hip, std::min(min, max)), std::max(min, max));
+}
+
+static double uniform(double min, double max) {
+	return min + (max - min)*drand48();
+}
+
+static double now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+  * @brief Checks solveHip() over random states with one geometry.
+  * @return The number of failures.
+  */
+static int checkGeometry(const Geometry &geometry) {
+	int failures = 0;
+	int inReach = 0;
+	double maxLimitedError = 0.0;
+	double maxAngleError = 0.0;
+	double maxVelocityError = 0.0;
+
+	srand48(1);
+	for (int n = 0; n < TEST_STATES; n++) {
+		double l[2], q[2], dl[2], dq[2], toe[2];
+		for (int side = 0; side < 2; side++) {
+			l[side] = uniform(TEST_L_MIN, TEST_L_MAX);
+			q[side] = uniform(TEST_Q_MIN, TEST_Q_MAX);
+			dl[side] = uniform(-TEST_SPEED, TEST_SPEED);
+			dq[side] = uniform(-TEST_SPEED, TEST_SPEED);
+			toe[side] = uniform(TEST_TOE_MIN, TEST_TOE_MAX);
+		}
+		double boom = uniform(TEST_BOOM_MIN, TEST_BOOM_MAX);
+		double dBoom = uniform(-TEST_SPEED, TEST_SPEED);
+
+		double old[2];
+		oldHipAngles(geometry, toe[0], toe[1], l[0], q[0], l[1], q[1], boom, old[0], old[1]);
+
+		for (int side = 0; side < 2; side++) {
+			double sign = side ? -1.0 : 1.0;
+			double hip, dHip;
+			std::tie(hip, dHip) = solveHip(lHip, qBodyOffset, toe[side], l[side], q[side], dl[side], dq[side],
+			                               hipRadius(geometry, boom), dHipRadius(geometry, boom, dBoom), boom, dBoom, sign);
+
+			double u = hipCos(geometry, toe[side], l[side], q[side], boom);
+			if (fabs(u) < 1.0)
+				inReach++;
+
+			// The angles, as iKine() returns them and before
+			double min = side ? RIGHT_HIP_MOTOR_MIN_LOC : LEFT_HIP_MOTOR_MIN_LOC;
+			double max = side ? RIGHT_HIP_MOTOR_MAX_LOC : LEFT_HIP_MOTOR_MAX_LOC;
+			double limitedError = fabs(limitHip(hip, min, max) - limitHip(old[side], min, max));
+			double angleError = fabs(remainder(hip - old[side], 2.0*PI));
+			maxLimitedError = std::max(maxLimitedError, limitedError);
+			maxAngleError = std::max(maxAngleError, angleError);
+			if (limitedError > ANGLE_TOLERANCE || angleError > ANGLE_TOLERANCE) {
+				printf("FAIL: %s geometry, %s hip, l = %g, q = %g, toe = %g, boom = %g: %.9f, old %.9f\n",
+				       geometry.name, side ? "right" : "left", l[side], q[side], toe[side], boom, hip, old[side]);
+				failures++;
+			}
+
+			// The velocity, against the angles a step either side
+			if (fabs(u) > VELOCITY_MAX_COS && fabs(u) < 1.0)
+				continue;
+			double t = VELOCITY_STEP;
+			double ahead, behind, unused;
+			std::tie(ahead, unused) = solveHip(lHip, qBodyOffset, toe[side], l[side] + dl[side]*t, q[side] + dq[side]*t,
+			                                   dl[side], dq[side], hipRadius(geometry, boom + dBoom*t), 0.0, boom + dBoom*t, dBoom, sign);
+			std::tie(behind, unused) = solveHip(lHip, qBodyOffset, toe[side], l[side] - dl[side]*t, q[side] - dq[side]*t,
+			                                    dl[side], dq[side], hipRadius(geometry, boom - dBoom*t), 0.0, boom - dBoom*t, dBoom, sign);
+			double difference = (ahead - behind)/(2.0*t);
+			double velocityError = fabs(dHip - difference)/std::max(1.0, fabs(difference));
+			maxVelocityError = std::max(maxVelocityError, velocityError);
+			if (velocityError > VELOCITY_TOLERANCE) {
+				printf("FAIL: %s geometry, %s hip, l = %g, q = %g, toe = %g, boom = %g: velocity %.9f, difference %.9f\n",
+				       geometry.name, side ? "right" : "left", l[side], q[side], toe[side], boom, dHip, difference);
+				failures++;
+			}
+		}
+	}
+
+	printf("Over %d states with the %s geometry (toe in reach for %d hips):\n", TEST_STATES, geometry.name, inReach);
+	printf("  largest angle difference from the old expressions: %.2e rad (%.2e as limited)\n",
+	       maxAngleError, maxLimitedError);
+	printf("  largest velocity difference from central differences: %.2e\n", maxVelocityError);
+
+	if (geometry.inReach && inReach < MIN_IN_REACH*2*TEST_STATES) {
+		printf("FAIL: %s geometry: only %d of %d hips had the toe in reach\n", geometry.name, inReach, 2*TEST_STATES);
+		failures++;
+	}
+
+	return failures;
+}
+
+int main() {
+	int failures = 0;
+	for (size_t i = 0; i < sizeof(geometries)/sizeof(geometries[0]); i++)
+		failures += checkGeometry(geometries[i]);
+
+	// Out of reach of the boom entirely, the solution mustn't be NaN
+	double hip, dHip;
+	std::tie(hip, dHip) = solveHip(lHip, qBodyOffset, 0.1, 0.9, 0.3, 0.1, 0.2, hipRadius(geometries[0], 0.1),
+	                               dHipRadius(geometries[0], 0.1, 0.05), 0.1, 0.05, 1.0);
+	if (!isfinite(hip) || !isfinite(dHip)) {
+		printf("FAIL: toe nearer the boom pivot than the leg reaches: %g, %g\n", hip, dHip);
+		failures++;
+	}
+
+	// Time both over the same states, one of which changes each call so
+	// nothing is hoisted out of the loop
+	volatile double sink = 0.0;
+	double start = now();
+	for (int n = 0; n < BENCH_CALLS; n++) {
+		double left, dLeft, right, dRight;
+		double toe = 2.15 + 1e-9*n;
+		std::tie(left, dLeft) = solveHip(lHip, qBodyOffset, toe, 0.9, 1.55, 0.1, 0.2, hipRadius(geometries[0], 0.1), dHipRadius(geometries[0], 0.1, 0.05), 0.1, 0.05, 1.0);
+		std::tie(right, dRight) = solveHip(lHip, qBodyOffset, 2.45, 0.9, 1.55, 0.1, 0.2, hipRadius(geometries[0], 0.1), dHipRadius(geometries[0], 0.1, 0.05), 0.1, 0.05, -1.0);
+		sink = sink + left + right + dLeft + dRight;
+	}
+	double newTime = (now() - start)/BENCH_CALLS;
+
+	start = now();
+	for (int n = 0; n < BENCH_CALLS; n++) {
+		double left, right;
+		oldHipAngles(geometries[0], 2.15 + 1e-9*n, 2.45, 0.9, 1.55, 0.9, 1.55, 0.1, left, right);
+		sink = sink + left + right;
+	}
+	double oldTime = (now() - start)/BENCH_CALLS;
+
+	printf("Both hips, per call:\n");
+	printf("  solveHip(), with velocities: %.1f ns\n", newTime*1e9);
+	printf("  old expressions:             %.1f ns\n", oldTime*1e9);
+
+	if (failures) {
+		printf("%d failures\n", failures);
+		return 1;
+	}
+
+	printf("All passed\n");
+	return 0;
+}
+
+// vim: noexpandtab
@@ -22,6 +22,8 @@ ASCHipForce::ASCHipForce(AtriasController *parent, string name) :
 }
 
 double ASCHipForce::operator()(const atrias_msgs::robot_state_leg &leg) {
+	ProfileScope scope(this);
+
 	double output;
 
 	// Set toe decoding gains.
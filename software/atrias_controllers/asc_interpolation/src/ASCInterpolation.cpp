@@ -12,6 +12,7 @@ ASCInterpolation::ASCInterpolation(AtriasController *parent, string name) :
 }
 
 std::tuple<double, double> ASCInterpolation::linear(double x1, double x2, double y1, double y2, double x, double dx) {
+	ProfileScope scope(this);
 
 	// Limit range since curve fit is only valid within range
 	 x = clamp(x, x1, x2);
@@ -34,6 +35,7 @@ std::tuple<double, double> ASCInterpolation::linear(double x1, double x2, double
 
 
 double ASCInterpolation::bilinear(double x1, double x2, double y1, double y2, double z11, double z21, double z12, double z22, double x, double y) {
+	ProfileScope scope(this);
 
 	// Limit range since curve fit is only valid within range
 	 x = clamp(x, x1, x2);
@@ -54,6 +56,7 @@ double ASCInterpolation::bilinear(double x1, double x2, double y1, double y2, do
 }
 
 std::tuple<double, double> ASCInterpolation::cosine(double x1, double x2, double y1, double y2, double x, double dx) {
+	ProfileScope scope(this);
 
 	// Limit range since curve fit is only valid within range
 	 x = clamp(x, x1, x2);
@@ -78,6 +81,7 @@ std::tuple<double, double> ASCInterpolation::cosine(double x1, double x2, double
 
 
 std::tuple<double, double> ASCInterpolation::cubic(double x1, double x2, double y1, double y2, double dy1, double dy2, double x, double dx) {
+	ProfileScope scope(this);
 
 	// Limit range since curve fit is only valid within range
 	 x = clamp(x, x1, x2);
@@ -13,6 +13,9 @@
 // And for the logging helper class
 #include <atrias_control_lib/LogPort.hpp>
 
+// The shared leg kinematics
+#include <atrias_control_lib/LegKinematics.hpp>
+
 // Our log data
 #include "asc_leg_force/controller_log_data.h"
 
@@ -39,12 +42,6 @@ class ASCLegForce : public AtriasController {
 		  */                  
 		ASCLegForce(AtriasController *parent, string name);
 		
-		// Angular positions
-		double qlA, qlB, qmA, qmB, qb;
-
-		// Angular velocities
-		double dqlA, dqlB, dqmA, dqmB, dqb;
-
 		// Spring torques
 		double tausA, tausB, dtausA, dtausB;
 		
@@ -57,6 +54,16 @@ class ASCLegForce : public AtriasController {
 		  */
 		std::tuple<double, double> control(LegForce legForce, atrias_msgs::robot_state_leg leg, atrias_msgs::robot_state_location position);
 
+		/**
+		  * @brief The leg force control function, using kinematics already
+		  * computed this cycle (such as an ATC's legKinematics).
+		  * @param legForce
+		  * @param kinematics
+		  * @param leg Which leg to control.
+		  * @return motorCurrent The computed motor current.
+		  */
+		std::tuple<double, double> control(LegForce legForce, const LegKinematics<> &kinematics, Leg leg);
+
 		// Gains
 		double kp, ki, kd;
 		
@@ -78,13 +85,25 @@ class ASCLegForce : public AtriasController {
 		  * @param position
 		  * @return legForce The computed leg forces.
 		  */
-		LegForce compute(atrias_msgs::robot_state_leg leg, atrias_msgs::robot_state_location position);		
+		LegForce compute(atrias_msgs::robot_state_leg leg, atrias_msgs::robot_state_location position);
+
+		/**
+		  * @brief The leg force function, using kinematics already computed
+		  * this cycle (such as an ATC's legKinematics).
+		  * @param kinematics
+		  * @param leg Which leg.
+		  * @return legForce The computed leg forces.
+		  */
+		LegForce compute(const LegKinematics<> &kinematics, Leg leg);
 		
 		// Leg forces
 		LegForce legForce;
 
 
     private:
+		// Kinematics for callers passing a leg's state
+		LegKinematics<> kinematics;
+
 		/** 
 		  * @brief This is our logging port.
 		  * You may have as many of these as you'd like of various types.
@@ -23,41 +23,41 @@ ASCLegForce::ASCLegForce(AtriasController *parent, string name) :
 
 
 std::tuple<double, double> ASCLegForce::control(LegForce legForce, atrias_msgs::robot_state_leg leg, atrias_msgs::robot_state_location position) {
+    // Only this leg's kinematics are needed
+    kinematics.updateLeg(LEFT_LEG, leg, position);
+    return control(legForce, kinematics, LEFT_LEG);
+}
+
+
+std::tuple<double, double> ASCLegForce::control(LegForce legForce, const LegKinematics<> &kinematics, Leg leg) {
+    ProfileScope scope(this);
+    int a = 2*leg, b = a + 1;
+
     // Unpack parameters
     fx = legForce.fx;
     fz = legForce.fz;
     dfx = legForce.dfx;
     dfz = legForce.dfz;
-    qlA = leg.halfA.legAngle;
-    qlB = leg.halfB.legAngle;
-    qmA = leg.halfA.motorAngle;
-    qmB = leg.halfB.motorAngle;
-    qb = position.bodyPitch;
-    dqlA = leg.halfA.legVelocity;
-    dqlB = leg.halfB.legVelocity;
-    dqmA = leg.halfA.motorVelocity;
-    dqmB = leg.halfB.motorVelocity;
-    dqb = position.bodyPitchVelocity;
-
-    // Compute required joint torque from desired end effector forces using Jacobian
-    tausA = -fx*L2*cos(qlA + qb) + fz*L2*sin(qlA + qb);
-    tausB = -fx*L1*cos(qlB + qb) + fz*L1*sin(qlB + qb);
-
-    // Compute required differential joint torque
-    dtausA = fx*L2*sin(qlA + qb)*(dqlA + dqb) + dfz*L2*sin(qlA + qb) - dfx*L2*cos(qlA + qb) + fz*L2*cos(qlA + qb)*(dqlA + dqb);
-    dtausB = fx*L1*sin(qlB + qb)*(dqlB + dqb) + dfz*L1*sin(qlB + qb) - dfx*L1*cos(qlB + qb) + fz*L1*cos(qlB + qb)*(dqlB + dqb);
+
+    // Compute required joint torque and its derivative from desired end effector forces using Jacobian
+    double taus[2], dtaus[2];
+    kinematics.jacobianTranspose(leg, legForce, taus, dtaus);
+    tausA = taus[0];
+    tausB = taus[1];
+    dtausA = dtaus[0];
+    dtausB = dtaus[1];
 
     // Compute proportional error terms
-    epA = tausA/KS - (qmA - qlA);
-    epB = tausB/KS - (qmB - qlB);
+    epA = (tausA - kinematics.springTorque[a])/KS;
+    epB = (tausB - kinematics.springTorque[b])/KS;
 
     // Compute integral error terms using clamping anti-windup method
     eiA = clamp(eiA + (epA*0.001), -antiWindup, antiWindup);
     eiB = clamp(eiB + (epB*0.001), -antiWindup, antiWindup);
 
     // Compute derivative error terms
-    edA = dtausA/KS - (dqmA - dqlA);
-    edB = dtausB/KS - (dqmB - dqlB);
+    edA = (dtausA - kinematics.dSpringTorque[a])/KS;
+    edB = (dtausB - kinematics.dSpringTorque[b])/KS;
 
     // Compute required motor current using PD terms on spring deflection with feed forward term
     curA = (tausA/KG + kp*epA + ki*eiA + kd*edA)/KT;
@@ -84,33 +84,22 @@ std::tuple<double, double> ASCLegForce::control(LegForce legForce, atrias_msgs::
 
 
 LegForce ASCLegForce::compute(atrias_msgs::robot_state_leg leg, atrias_msgs::robot_state_location position) {
-    // Unpack the parameters
-    qlA = leg.halfA.legAngle;
-    qlB = leg.halfB.legAngle;
-    qmA = leg.halfA.motorAngle;
-    qmB = leg.halfB.motorAngle;
-    qb = position.bodyPitch;
-    dqlA = leg.halfA.legVelocity;
-    dqlB = leg.halfB.legVelocity;
-    dqmA = leg.halfA.motorVelocity;
-    dqmB = leg.halfB.motorVelocity;
-    dqb = position.bodyPitchVelocity;
-
-    // Compute the spring torques
-    tausA = KS*(qmA - qlA);
-    tausB = KS*(qmB - qlB);
-
-    // Compute the spring torques derivative
-    dtausA = KS*(dqmA - dqlA);
-    dtausB = KS*(dqmB - dqlB);
-
-    // Compute the leg forces
-    legForce.fx = -(L2*tausB*sin(qb + qlA) - L1*tausA*sin(qb + qlB))/(L1*L2*sin(qlA - qlB));
-    legForce.fz = -(L2*tausB*cos(qb + qlA) - L1*tausA*cos(qb + qlB))/(L1*L2*sin(qlA - qlB));
-
-    // Compute the leg forces derivative
-    legForce.dfx = -(L2*dtausB*sin(qb + qlA) - L1*dtausA*sin(qb + qlB) + L2*tausB*cos(qb + qlA)*(dqb + dqlA) - L1*tausA*cos(qb + qlB)*(dqb + dqlB))/(L1*L2*sin(qlA - qlB)) + (cos(qlA - qlB)/pow(sin(qlA - qlB), 2.0)*(L2*tausB*sin(qb + qlA) - L1*tausA*sin(qb + qlB))*(dqlA - dqlB))/(L1*L2);
-    legForce.dfz = -(L2*dtausB*cos(qb + qlA) - L1*dtausA*cos(qb + qlB) - L2*tausB*sin(qb + qlA)*(dqb + dqlA) + L1*tausA*sin(qb + qlB)*(dqb + dqlB))/(L1*L2*sin(qlA - qlB)) + (cos(qlA - qlB)/pow(sin(qlA - qlB), 2.0)*(L2*tausB*cos(qb + qlA) - L1*tausA*cos(qb + qlB))*(dqlA - dqlB))/(L1*L2);
+    // Only this leg's kinematics are needed
+    kinematics.updateLeg(LEFT_LEG, leg, position);
+    return compute(kinematics, LEFT_LEG);
+}
+
+
+LegForce ASCLegForce::compute(const LegKinematics<> &kinematics, Leg leg) {
+    ProfileScope scope(this);
+    int a = 2*leg, b = a + 1;
+
+    // The spring torques and leg forces were computed with the rest of the kinematics
+    tausA = kinematics.springTorque[a];
+    tausB = kinematics.springTorque[b];
+    dtausA = kinematics.dSpringTorque[a];
+    dtausB = kinematics.dSpringTorque[b];
+    legForce = kinematics.force[leg];
 
     // Set the log data
     log_out.data.compute_tausA = tausA;
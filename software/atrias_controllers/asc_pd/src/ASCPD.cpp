@@ -20,6 +20,8 @@ ASCPD::ASCPD(AtriasController *parent, string name) :
 }
 
 double ASCPD::operator()(double desPos, double curPos, double desVel, double curVel) {
+	ProfileScope scope(this);
+
 	// Log our input data
 	log_out.data.P          = P;
 	log_out.data.D          = D;
@@ -21,6 +21,7 @@ double ASCRateLimit::operator()(double tgt, double rate) {
 
 
 double ASCRateLimit::operator()(double tgt, double posRate, double negRate) {
+	ProfileScope scope(this);
 
 	// Log our input
 	log_out.data.tgt = tgt;
@@ -43,6 +44,7 @@ double ASCRateLimit::operator()(double tgt, double posRate, double negRate) {
 
 
 double ASCRateLimit::reset(double new_value) {
+	ProfileScope scope(this);
 
 	return log_out.data.out = new_value;
 	
@@ -16,6 +16,9 @@
 // Our log data
 #include "asc_slip_model/controller_log_data.h"
 
+// The lookahead
+#include "asc_slip_model/SlipPredictor.hpp"
+
 // Datatypes
 #include <atrias_shared/globals.h>
 #include <robot_invariant_defs.h>
@@ -47,20 +50,21 @@ class ASCSlipModel : public AtriasController {
 		/**
 		  * @brief Advances the RK4 fixed timestep numerical integrator.
 		  * @param slipState The current state-space parameters.
+		  * @param steps The number of timesteps to advance. Stops early at liftoff.
 		  * @return slipState The computed next step state-space parameters.
 		  */
-		SlipState advanceRK4(SlipState slipState);
+		SlipState advanceRK4(SlipState slipState, int steps = 1);
 
 		// State-space
 		double r, dr, q, dq;
-		double rNew, drNew, qNew, dqNew;
 				
 		/**
 		  * @brief Advances the RK5 fixed timestep numerical integrator.
 		  * @param slipState The current state-space parameters.
+		  * @param steps The number of timesteps to advance. Stops early at liftoff.
 		  * @return slipState The computed next step state-space parameters.
 		  */
-		SlipState advanceRK5(SlipState slipState);
+		SlipState advanceRK5(SlipState slipState, int steps = 1);
 						
 		/**
 		  * @brief Computes the leg force.
@@ -72,6 +76,52 @@ class ASCSlipModel : public AtriasController {
 		// Leg forces
 		LegForce legForce;
 
+		/**
+		  * @brief Integrates a batch of stance states to liftoff, and
+		  * finds the following flight apex for each.
+		  * Uses the current k, r0, and m. Realtime safe.
+		  * @param batch The candidates. The results are written back into it.
+		  */
+		void predictLiftoff(SlipBatch &batch);
+
+		/**
+		  * @brief Solves for the touchdown leg angle giving an equilibrium gait.
+		  * Uses the current k, r0, and m. Realtime safe.
+		  * @param dx The horizontal velocity at touchdown.
+		  * @param dz The vertical velocity at touchdown.
+		  * @return The touchdown leg angle, in the same convention as SlipState.
+		  */
+		double equilibriumAngle(double dx, double dz);
+
+		/**
+		  * @brief Solves for the equilibrium gait touchdown leg angle, and its
+		  * derivatives in dz and r0. Uses the current k, r0, and m.
+		  * Realtime safe, but costs five equilibriumAngle() solves.
+		  * @param dx   The horizontal velocity at touchdown.
+		  * @param dz   The vertical velocity at touchdown.
+		  * @param q    Set to the touchdown leg angle, in the same convention as SlipState.
+		  * @param dqdz Set to the angle's derivative in dz.
+		  * @param dqdr Set to the angle's derivative in r0.
+		  */
+		void equilibriumGait(double dx, double dz, double &q, double &dqdz, double &dqdr);
+
+		/**
+		  * @brief Estimates the equilibrium gait touchdown leg angle in closed
+		  * form, with the toe at the neutral point: half a stance's travel
+		  * ahead of the body, taking a stance to last half the spring's period.
+		  * Uses the current k, r0, and m. Realtime safe, and far cheaper
+		  * than equilibriumGait(), but ignores dz.
+		  * @param dx   The horizontal velocity at touchdown.
+		  * @param q    Set to the touchdown leg angle, in the same convention as SlipState.
+		  * @param dqdz Set to the angle's derivative in dz (zero).
+		  * @param dqdr Set to the angle's derivative in r0.
+		  */
+		void neutralGait(double dx, double &q, double &dqdz, double &dqdr);
+
+		// Does the lookahead for predictLiftoff() and equilibriumAngle().
+		// Its step size and time limit may be set directly.
+		SlipPredictor predictor;
+
 
 	private:
 		/** 
@@ -0,0 +1,53 @@
+#ifndef SLIP_BATCH_HPP
+#define SLIP_BATCH_HPP
+
+/**
+  * @file SlipBatch.hpp
+  * @brief A batch of candidate SLIP stance states, for ASCSlipModel's lookahead.
+  * Each field is an array indexed by candidate, so the integrator can step
+  * every candidate in one vectorizable loop.
+  */
+
+// The most candidates in one batch
+#define SLIP_BATCH_MAX 64
+
+// Our namespaces
+namespace atrias {
+namespace controller {
+
+struct SlipBatch {
+	// The number of candidates
+	int n;
+
+	// Inputs: each candidate's stance state (at touchdown, or anywhere in stance)
+	double r[SLIP_BATCH_MAX];
+	double dr[SLIP_BATCH_MAX];
+	double q[SLIP_BATCH_MAX];
+	double dq[SLIP_BATCH_MAX];
+
+	// Outputs. Only meaningful if valid is set; a candidate is invalid if
+	// it falls, or doesn't lift off and reach an apex in time.
+	bool   valid[SLIP_BATCH_MAX];
+
+	// The time from the input state until liftoff (s)
+	double tLiftoff[SLIP_BATCH_MAX];
+
+	// The state at liftoff. qLiftoff is also set for candidates that lift
+	// off without reaching an apex, and is NAN for those that don't lift off.
+	double qLiftoff[SLIP_BATCH_MAX];
+	double dxLiftoff[SLIP_BATCH_MAX];
+	double dzLiftoff[SLIP_BATCH_MAX];
+
+	// The time from the input state until the following flight apex (s)
+	double tApex[SLIP_BATCH_MAX];
+
+	// The state at the apex; the hip height above the ground, and the
+	// horizontal velocity (the vertical velocity is zero).
+	double zApex[SLIP_BATCH_MAX];
+	double dxApex[SLIP_BATCH_MAX];
+};
+
+}
+}
+
+#endif // SLIP_BATCH_HPP
@@ -0,0 +1,115 @@
+#ifndef SLIP_PREDICTOR_HPP
+#define SLIP_PREDICTOR_HPP
+
+/**
+  * @file SlipPredictor.hpp
+  * @brief Predicts SLIP stance phases ahead of time, many candidates at once.
+  * This holds no controller state, so it may also be used outside a
+  * controller (such as by offline tools).
+  */
+
+// Candidate states
+#include "asc_slip_model/SlipBatch.hpp"
+
+// Datatypes
+#include <atrias_shared/atrias_parameters.h>
+
+// The number of candidates equilibriumAngle() tries per pass
+#define SLIP_EQUILIBRIUM_CANDIDATES 8
+
+// How far from vertical equilibriumAngle() searches (radians)
+#define SLIP_EQUILIBRIUM_RANGE 0.7
+
+// The steps equilibriumGait() differences the solve over, in the vertical
+// velocity (m/s) and the leg length (m)
+#define SLIP_EQUILIBRIUM_DZ_STEP 0.05
+#define SLIP_EQUILIBRIUM_R_STEP  0.01
+
+// Our namespaces
+namespace atrias {
+namespace controller {
+
+class SlipPredictor {
+	public:
+		/**
+		  * @brief Initializes the predictor with ASCSlipModel's default parameters.
+		  */
+		SlipPredictor();
+
+		// SLIP model parameters
+		double k, r0, m, g;
+
+		// The step size predictLiftoff() integrates with (s). This may be
+		// much coarser than the control period.
+		double predictionStep;
+
+		// The longest stance predictLiftoff() will integrate (s)
+		double maxStanceTime;
+
+		/**
+		  * @brief Integrates a batch of stance states to liftoff, and
+		  * finds the following flight apex for each.
+		  * Uses RK4. Realtime safe.
+		  * @param batch The candidates. The results are written back into it.
+		  */
+		void predictLiftoff(SlipBatch &batch);
+
+		/**
+		  * @brief Solves for the touchdown leg angle giving an equilibrium
+		  * gait, where stance is symmetric, so the liftoff velocity mirrors
+		  * the touchdown velocity. Realtime safe.
+		  * @param dx The horizontal velocity at touchdown.
+		  * @param dz The vertical velocity at touchdown.
+		  * @return The touchdown leg angle, in the same convention as SlipState.
+		  */
+		double equilibriumAngle(double dx, double dz);
+
+		/**
+		  * @brief Solves equilibriumAngle(), along with how the angle changes
+		  * with the touchdown velocity and leg length, by central differences.
+		  * This is five solves. Realtime safe.
+		  * @param dx   The horizontal velocity at touchdown.
+		  * @param dz   The vertical velocity at touchdown.
+		  * @param q    Set to the touchdown leg angle, as equilibriumAngle().
+		  * @param dqdz Set to the angle's derivative in dz.
+		  * @param dqdr Set to the angle's derivative in r0.
+		  */
+		void equilibriumGait(double dx, double dz, double &q, double &dqdz, double &dqdr);
+
+	private:
+		// The candidates still in stance while predicting. predictLiftoff()
+		// keeps these packed at the front, so each step is one dense loop.
+		double stanceR[SLIP_BATCH_MAX];
+		double stanceDr[SLIP_BATCH_MAX];
+		double stanceQ[SLIP_BATCH_MAX];
+		double stanceDq[SLIP_BATCH_MAX];
+		int    stanceIndex[SLIP_BATCH_MAX];
+
+		// The candidates for equilibriumAngle()
+		SlipBatch equilibriumBatch;
+
+		/**
+		  * @brief Fills equilibriumBatch with touchdown states spread over a
+		  * range of leg angles, then predicts their liftoffs.
+		  * @param dx   The horizontal velocity at touchdown.
+		  * @param dz   The vertical velocity at touchdown.
+		  * @param qMin The smallest leg angle.
+		  * @param qMax The largest leg angle.
+		  */
+		void predictTouchdownAngles(double dx, double dz, double qMin, double qMax);
+
+		/**
+		  * @brief Returns how far a candidate in equilibriumBatch is from an
+		  * equilibrium gait: how far its liftoff angle is from the mirror
+		  * image of its touchdown angle.
+		  * @param i The candidate.
+		  */
+		double equilibriumError(int i);
+};
+
+}
+}
+
+#endif // SLIP_PREDICTOR_HPP
+
+// vim: noexpandtab
@@ -0,0 +1,207 @@
+#!/usr/bin/env python2
+
+# Generates SlipIntegrators.h, the explicit Runge-Kutta integrators for the
+# SLIP stance dynamics used by ASCSlipModel.
+#
+# The stance dynamics, with the leg length r and leg angle q, are
+#
+#   ddr = dq^2 r - g sin(q) - k/m (r - r0)
+#   ddq = -(2 dq dr + g cos(q)) / r
+#
+# Each method is given below by its Butcher tableau. For each one, this
+# writes an inline function that takes any number of steps, stage by stage:
+# each stage's state is built from the earlier stages' derivatives, and
+# each stage evaluates sin(q), cos(q), and 1/r once. This replaces the
+# fully-expanded symbolic expressions, which recomputed the earlier stages
+# (and their trig functions) inside every later one. Each method also gets
+# a batch version stepping many states at once, for the lookahead.
+#
+# Only RK4 is generated. ASCSlipModel's RK5 stays hand-expanded: it isn't
+# Nystrom's method (its one-step error shrinks only as about h^2), and
+# replacing it with Nystrom's changed its steps by about 2e-5 rad without
+# making them faster.
+
+import os
+import sys
+from fractions import Fraction as F
+
+if (len(sys.argv) != 2):
+	print("Usage: " + sys.argv[0] + " [output file]")
+	exit(1)
+
+outFile = sys.argv[1]
+
+# name -> (description, a (lower triangular), b)
+methods = [
+	('RK4', "Runge's classic 4th order method", [
+		[],
+		[F(1, 2)],
+		[F(0), F(1, 2)],
+		[F(0), F(0), F(1)],
+	], [F(1, 6), F(1, 3), F(1, 3), F(1, 6)]),
+]
+
+# The state variables and, for each, the variable holding its derivative
+# at a given stage.
+state = [
+	('r',  'dr%d'),
+	('dr', 'ddr%d'),
+	('q',  'dq%d'),
+	('dq', 'ddq%d'),
+]
+
+# Formats a coefficient as a C++ double expression.
+def coefficient(c):
+	if c.denominator == 1:
+		return '%d.0' % c.numerator
+	return '(%d.0/%d.0)' % (c.numerator, c.denominator)
+
+# Formats sum(coefficients[j] * deriv % (j + 1)), skipping zero terms.
+def weightedSum(coefficients, deriv):
+	terms = []
+	for j, c in enumerate(coefficients):
+		if c == 0:
+			continue
+		term = deriv % (j + 1)
+		if c != 1:
+			term = coefficient(abs(c)) + '*' + term
+		if not terms:
+			terms.append(('-' if c < 0 else '') + term)
+		else:
+			terms.append(('- ' if c < 0 else '+ ') + term)
+	return ' '.join(terms)
+
+def checkTableau(name, a, b):
+	if sum(b) != 1:
+		sys.stderr.write(name + ": the weights don't sum to 1\n")
+		exit(1)
+	for i, row in enumerate(a):
+		if len(row) != i:
+			sys.stderr.write(name + ": row %d of the tableau has the wrong length\n" % (i + 1))
+			exit(1)
+
+# Writes one step's stages, each line indented by indent. base formats a
+# state variable's value at the start of the step (a scalar or an array
+# element).
+def genStep(a, b, indent, base):
+	lines = []
+	for i in range(len(a)):
+		s = i + 1
+		lines.append(indent + '// Stage %d' % s)
+		if i == 0:
+			for var, deriv in state:
+				lines.append(indent + 'const double %s%d = %s;' % (var, s, base % var))
+		else:
+			for var, deriv in state:
+				lines.append(indent + 'const double %s%d = %s + h*(%s);' % (var, s, base % var, weightedSum(a[i], deriv)))
+		lines += [
+			indent + 'const double sin%d = sin(q%d);' % (s, s),
+			indent + 'const double cos%d = cos(q%d);' % (s, s),
+			indent + 'const double ddr%d = dq%d*dq%d*r%d - g*sin%d - kOverM*(r%d - r0);' % (s, s, s, s, s, s),
+			indent + 'const double ddq%d = -(2.0*dq%d*dr%d + g*cos%d)/r%d;' % (s, s, s, s, s),
+			'',
+		]
+
+	lines.append(indent + '// Combine the stages')
+	for var, deriv in state:
+		lines.append(indent + '%s += h*(%s);' % (base % var, weightedSum(b, deriv)))
+	return lines
+
+def genMethod(name, description, a, b):
+	checkTableau(name, a, b)
+
+	lines = [
+		'/** @brief Advances the SLIP stance dynamics using ' + description + '.',
+		'  * Stops early if the leg extends past its rest length (liftoff).',
+		'  * @param r     The leg length. Updated in place.',
+		'  * @param dr    The leg length rate. Updated in place.',
+		'  * @param q     The leg angle. Updated in place.',
+		'  * @param dq    The leg angle rate. Updated in place.',
+		'  * @param h     The step size (seconds).',
+		'  * @param k     The leg stiffness.',
+		'  * @param r0    The leg rest length.',
+		'  * @param m     The mass.',
+		'  * @param g     The acceleration of gravity.',
+		'  * @param steps The number of steps to take.',
+		'  * @return The number of steps taken.',
+		'  */',
+		'inline int slip%s(double &r, double &dr, double &q, double &dq, double h,' % name,
+		'               %s double k, double r0, double m, double g, int steps)' % (' ' * len(name)),
+		'{',
+		'\tconst double kOverM = k / m;',
+		'',
+		'\tint step;',
+		'\tfor (step = 0; step < steps && r <= r0; step++) {',
+	]
+	lines += genStep(a, b, '\t\t', '%s')
+	lines += [
+		'\t}',
+		'',
+		'\treturn step;',
+		'}',
+		'',
+	]
+	return lines
+
+# The same step for an array of states. The loop has no branches, so the
+# compiler can vectorize it; checking for liftoff is left to the caller.
+def genBatchMethod(name, description, a, b):
+	lines = [
+		'/** @brief Advances each of a batch of SLIP stance states by one step of',
+		'  * ' + description + '.',
+		'  * The states are stored as separate arrays. Liftoff isn\'t checked.',
+		'  * @param n  The number of states.',
+		'  * @param r  The leg lengths. Updated in place.',
+		'  * @param dr The leg length rates. Updated in place.',
+		'  * @param q  The leg angles. Updated in place.',
+		'  * @param dq The leg angle rates. Updated in place.',
+		'  * @param h  The step size (seconds).',
+		'  * @param k  The leg stiffness.',
+		'  * @param r0 The leg rest length.',
+		'  * @param m  The mass.',
+		'  * @param g  The acceleration of gravity.',
+		'  */',
+		'inline void slip%sBatch(int n, double* __restrict__ r, double* __restrict__ dr,' % name,
+		'                     %s double* __restrict__ q, double* __restrict__ dq, double h,' % (' ' * len(name)),
+		'                     %s double k, double r0, double m, double g)' % (' ' * len(name)),
+		'{',
+		'\tconst double kOverM = k / m;',
+		'',
+		'\tfor (int i = 0; i < n; i++) {',
+	]
+	lines += genStep(a, b, '\t\t', '%s[i]')
+	lines += [
+		'\t}',
+		'}',
+		'',
+	]
+	return lines
+
+lines = [
+	'// Generated by gen_slip_integrators.py. Do not edit.',
+	'',
+	'#ifndef SLIPINTEGRATORS_H',
+	'#define SLIPINTEGRATORS_H',
+	'',
+	'#include <math.h>',
+	'',
+	'namespace atrias {',
+	'namespace controller {',
+	'',
+]
+for method in methods:
+	lines += genMethod(*method)
+	lines += genBatchMethod(*method)
+lines += [
+	'}',
+	'}',
+	'',
+	'#endif // SLIPINTEGRATORS_H',
+	'',
+]
+
+if not os.path.isdir(os.path.dirname(outFile)):
+	os.makedirs(os.path.dirname(outFile))
+open(outFile, 'w').write("\n".join(lines))
+
+# vim: noexpandtab
@@ -1,5 +1,8 @@
 #include "asc_slip_model/ASCSlipModel.hpp"
 
+// The integrators, generated by scripts/gen_slip_integrators.py
+#include "asc_slip_model/SlipIntegrators.h"
+
 // The namespaces this controller resides in
 namespace atrias {
 namespace controller {
@@ -21,7 +24,8 @@ ASCSlipModel::ASCSlipModel(AtriasController *parent, string name) :
 }
 
 
-SlipState ASCSlipModel::advanceRK4(SlipState slipState) {
+SlipState ASCSlipModel::advanceRK4(SlipState slipState, int steps) {
+	ProfileScope scope(this);
 
 	// Our delta time
 	h = ((double) CONTROLLER_LOOP_PERIOD_NS) / ((double) SECOND_IN_NANOSECONDS);
@@ -43,21 +47,8 @@ SlipState ASCSlipModel::advanceRK4(SlipState slipState) {
 		slipState.isFlight = false;
 		slipState.isStance = true;
 		
-		// Runges's 4th order Runge-Kutta numerical method
-		rNew = r+dr*h*(1.0/6.0)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/2.0))*(1.0/3.0)+h*(dr-h*(G*sin(q+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(1.0/2.0))-pow(dq-(h*(G*cos(q+dq*h*(1.0/2.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)))*(1.0/2.0))/(r+dr*h*(1.0/2.0)),2.0)*(r+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/2.0))*(1.0/2.0))+(k*(r-r0+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/2.0))*(1.0/2.0)))/m))*(1.0/6.0)+h*(dr-h*(G*sin(q+dq*h*(1.0/2.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r,2.0)*(r+dr*h*(1.0/2.0))+(k*(r-r0+dr*h*(1.0/2.0)))/m)*(1.0/2.0))*(1.0/3.0);
-
-		drNew = dr-h*(-pow(dq-(h*(G*cos(q+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(1.0/2.0))+(dq-(h*(G*cos(q+dq*h*(1.0/2.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)))*(1.0/2.0))/(r+dr*h*(1.0/2.0)))*(dr*2.0-h*(G*sin(q+dq*h*(1.0/2.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r,2.0)*(r+dr*h*(1.0/2.0))+(k*(r-r0+dr*h*(1.0/2.0)))/m))))/(r+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/2.0))*(1.0/2.0)),2.0)*(r+h*(dr-h*(G*sin(q+dq*h*(1.0/2.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r,2.0)*(r+dr*h*(1.0/2.0))+(k*(r-r0+dr*h*(1.0/2.0)))/m)*(1.0/2.0)))+G*sin(q+h*(dq-(h*(G*cos(q+dq*h*(1.0/2.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)))*(1.0/2.0))/(r+dr*h*(1.0/2.0))))+(k*(r-r0+h*(dr-h*(G*sin(q+dq*h*(1.0/2.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r,2.0)*(r+dr*h*(1.0/2.0))+(k*(r-r0+dr*h*(1.0/2.0)))/m)*(1.0/2.0))))/m)*(1.0/6.0)-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/6.0)-h*(G*sin(q+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(1.0/2.0))-pow(dq-(h*(G*cos(q+dq*h*(1.0/2.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)))*(1.0/2.0))/(r+dr*h*(1.0/2.0)),2.0)*(r+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/2.0))*(1.0/2.0))+(k*(r-r0+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/2.0))*(1.0/2.0)))/m)*(1.0/3.0)-h*(G*sin(q+dq*h*(1.0/2.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r,2.0)*(r+dr*h*(1.0/2.0))+(k*(r-r0+dr*h*(1.0/2.0)))/m)*(1.0/3.0);
-
-		qNew = q+dq*h*(1.0/6.0)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(1.0/3.0)+h*(dq-(h*(G*cos(q+dq*h*(1.0/2.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)))*(1.0/2.0))/(r+dr*h*(1.0/2.0)))*(1.0/3.0)+h*(dq-(h*(G*cos(q+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(1.0/2.0))+(dq-(h*(G*cos(q+dq*h*(1.0/2.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)))*(1.0/2.0))/(r+dr*h*(1.0/2.0)))*(dr*2.0-h*(G*sin(q+dq*h*(1.0/2.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r,2.0)*(r+dr*h*(1.0/2.0))+(k*(r-r0+dr*h*(1.0/2.0)))/m))))/(r+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/2.0))*(1.0/2.0)))*(1.0/6.0);
-
-		dqNew = dq-(h*(G*cos(q+dq*h*(1.0/2.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)))*(1.0/3.0))/(r+dr*h*(1.0/2.0))-(h*(G*cos(q+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(1.0/2.0))+(dq-(h*(G*cos(q+dq*h*(1.0/2.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)))*(1.0/2.0))/(r+dr*h*(1.0/2.0)))*(dr*2.0-h*(G*sin(q+dq*h*(1.0/2.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r,2.0)*(r+dr*h*(1.0/2.0))+(k*(r-r0+dr*h*(1.0/2.0)))/m)))*(1.0/3.0))/(r+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/2.0))*(1.0/2.0))-(h*(dq*dr*2.0+G*cos(q))*(1.0/6.0))/r-(h*((dq-(h*(G*cos(q+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(1.0/2.0))+(dq-(h*(G*cos(q+dq*h*(1.0/2.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)))*(1.0/2.0))/(r+dr*h*(1.0/2.0)))*(dr*2.0-h*(G*sin(q+dq*h*(1.0/2.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r,2.0)*(r+dr*h*(1.0/2.0))+(k*(r-r0+dr*h*(1.0/2.0)))/m))))/(r+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/2.0))*(1.0/2.0)))*(dr*2.0-h*(G*sin(q+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(1.0/2.0))-pow(dq-(h*(G*cos(q+dq*h*(1.0/2.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)))*(1.0/2.0))/(r+dr*h*(1.0/2.0)),2.0)*(r+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/2.0))*(1.0/2.0))+(k*(r-r0+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/2.0))*(1.0/2.0)))/m)*2.0)+G*cos(q+h*(dq-(h*(G*cos(q+dq*h*(1.0/2.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)))*(1.0/2.0))/(r+dr*h*(1.0/2.0)))))*(1.0/6.0))/(r+h*(dr-h*(G*sin(q+dq*h*(1.0/2.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r,2.0)*(r+dr*h*(1.0/2.0))+(k*(r-r0+dr*h*(1.0/2.0)))/m)*(1.0/2.0)));
-
-	// Advance time step, replace old with new
-        slipState.r = rNew;
-        slipState.dr = drNew;
-        slipState.q = qNew;
-        slipState.dq = dqNew;
-
+		// Runge's 4th order Runge-Kutta method
+		slipRK4(slipState.r, slipState.dr, slipState.q, slipState.dq, h, k, r0, m, G, steps);
 	}
 
 	// Set the log data
@@ -75,7 +66,8 @@ SlipState ASCSlipModel::advanceRK4(SlipState slipState) {
 }
 
 
-SlipState ASCSlipModel::advanceRK5(SlipState slipState) {
+SlipState ASCSlipModel::advanceRK5(SlipState slipState, int steps) {
+	ProfileScope scope(this);
 
 	// Our delta time
 	h = ((double) CONTROLLER_LOOP_PERIOD_NS) / ((double) SECOND_IN_NANOSECONDS);
@@ -97,21 +89,28 @@ SlipState ASCSlipModel::advanceRK5(SlipState slipState) {
 		slipState.isFlight = false;
 		slipState.isStance = true;
 		
-		// Runges's 5th order Runge-Kutta numerical method
-		rNew = r+dr*h*(2.3E1/1.92E2)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(1.25E2/1.92E2)-h*(-dr+h*(-(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r,2.0)+G*sin(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1))+(k*(r-r0+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1)))/m)*(2.0/1.5E1)-h*(-G*sin(q+dq*h*(1.0/4.0)-h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*3.0-h*(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(1.5E1/4.0))+pow(dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*3.0)/(r+dr*h*(1.0/3.0))-(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(1.5E1/4.0))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))-(h*(dq*dr*2.0+G*cos(q))*(1.0/4.0))/r,2.0)*(r+dr*h*(1.0/4.0)-h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*3.0-h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(1.5E1/4.0))+(k*(-r+r0-dr*h*(1.0/4.0)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*3.0+h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(1.5E1/4.0)))/m)*(8.0/7.5E1)+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))*(1.25E2/1.92E2)-h*(dr+h*(-(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r,2.0)+G*sin(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1))+(k*(r-r0+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1)))/m)*(5.0E1/8.1E1)+h*(-G*sin(q+dq*h*(1.0/4.0)-h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*3.0-h*(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(1.5E1/4.0))+pow(dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*3.0)/(r+dr*h*(1.0/3.0))-(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(1.5E1/4.0))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))-(h*(dq*dr*2.0+G*cos(q))*(1.0/4.0))/r,2.0)*(r+dr*h*(1.0/4.0)-h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*3.0-h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(1.5E1/4.0))+(k*(-r+r0-dr*h*(1.0/4.0)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*3.0+h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(1.5E1/4.0)))/m)*(8.0/8.1E1)-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/2.7E1)-h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.0E1/9.0))*(2.7E1/6.4E1);
+		// Runge's 5th order Runge-Kutta method, expanded. This isn't
+		// generated with RK4: it matches no standard tableau, and changing
+		// it would change ATCSlipRunning's predictions.
+		for (int step = 0; step < steps && r <= r0; step++) {
+			const double rNew = r+dr*h*(2.3E1/1.92E2)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(1.25E2/1.92E2)-h*(-dr+h*(-(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r,2.0)+G*sin(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1))+(k*(r-r0+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1)))/m)*(2.0/1.5E1)-h*(-G*sin(q+dq*h*(1.0/4.0)-h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*3.0-h*(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(1.5E1/4.0))+pow(dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*3.0)/(r+dr*h*(1.0/3.0))-(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(1.5E1/4.0))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))-(h*(dq*dr*2.0+G*cos(q))*(1.0/4.0))/r,2.0)*(r+dr*h*(1.0/4.0)-h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*3.0-h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(1.5E1/4.0))+(k*(-r+r0-dr*h*(1.0/4.0)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*3.0+h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(1.5E1/4.0)))/m)*(8.0/7.5E1)+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))*(1.25E2/1.92E2)-h*(dr+h*(-(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r,2.0)+G*sin(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1))+(k*(r-r0+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1)))/m)*(5.0E1/8.1E1)+h*(-G*sin(q+dq*h*(1.0/4.0)-h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*3.0-h*(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(1.5E1/4.0))+pow(dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*3.0)/(r+dr*h*(1.0/3.0))-(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(1.5E1/4.0))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))-(h*(dq*dr*2.0+G*cos(q))*(1.0/4.0))/r,2.0)*(r+dr*h*(1.0/4.0)-h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*3.0-h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(1.5E1/4.0))+(k*(-r+r0-dr*h*(1.0/4.0)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*3.0+h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(1.5E1/4.0)))/m)*(8.0/8.1E1)-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/2.7E1)-h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.0E1/9.0))*(2.7E1/6.4E1);
 
-		drNew = dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.3E1/1.92E2)-h*(G*sin(q+dq*h*(2.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(1.2E1/2.5E1)-h*(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(2.0/1.5E1)+h*(dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*3.0)/(r+dr*h*(1.0/3.0))-(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(1.5E1/4.0))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))-(h*(dq*dr*2.0+G*cos(q))*(1.0/4.0))/r)*(8.0/7.5E1))-(r+dr*h*(2.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(1.2E1/2.5E1)+h*(dr-h*(-(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r,2.0)+G*sin(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1))+(k*(r-r0+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1)))/m)*(1.5E1/4.0)-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/4.0)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*3.0)*(8.0/7.5E1)-h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(2.0/1.5E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/4.0)-h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*3.0-h*(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(1.5E1/4.0))+(dr*2.0-h*(-(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r,2.0)+G*sin(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1))+(k*(r-r0+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1)))/m)*(1.5E1/2.0)-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/2.0)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*6.0)*(dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*3.0)/(r+dr*h*(1.0/3.0))-(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(1.5E1/4.0))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))-(h*(dq*dr*2.0+G*cos(q))*(1.0/4.0))/r))*(8.0/7.5E1))/(r+dr*h*(1.0/4.0)-h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*3.0-h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(1.5E1/4.0))+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(1.2E1/2.5E1))/(r+dr*h*(1.0/3.0))+(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(2.0/1.5E1))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))+(h*(dq*dr*2.0+G*cos(q))*(2.0/2.5E1))/r,2.0)+(k*(r-r0+dr*h*(2.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(1.2E1/2.5E1)+h*(dr-h*(-(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r,2.0)+G*sin(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1))+(k*(r-r0+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1)))/m)*(1.5E1/4.0)-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/4.0)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*3.0)*(8.0/7.5E1)-h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(2.0/1.5E1)))/m)*(1.25E2/1.92E2)+h*(G*sin(q+dq*h*(2.0/2.7E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(1.0E1/9.0)+h*(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(5.0E1/8.1E1)+h*(dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*3.0)/(r+dr*h*(1.0/3.0))-(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(1.5E1/4.0))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))-(h*(dq*dr*2.0+G*cos(q))*(1.0/4.0))/r)*(8.0/8.1E1))-(r+dr*h*(2.0/2.7E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(1.0E1/9.0)+h*(dr-h*(-(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r,2.0)+G*sin(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1))+(k*(r-r0+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1)))/m)*(1.5E1/4.0)-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/4.0)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*3.0)*(8.0/8.1E1)+h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(5.0E1/8.1E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/4.0)-h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*3.0-h*(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(1.5E1/4.0))+(dr*2.0-h*(-(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r,2.0)+G*sin(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1))+(k*(r-r0+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1)))/m)*(1.5E1/2.0)-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/2.0)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*6.0)*(dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*3.0)/(r+dr*h*(1.0/3.0))-(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(1.5E1/4.0))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))-(h*(dq*dr*2.0+G*cos(q))*(1.0/4.0))/r))*(8.0/8.1E1))/(r+dr*h*(1.0/4.0)-h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*3.0-h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(1.5E1/4.0))+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(1.0E1/9.0))/(r+dr*h*(1.0/3.0))-(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(5.0E1/8.1E1))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))+(h*(dq*dr*2.0+G*cos(q))*(2.0/2.7E1))/r,2.0)+(k*(r-r0+dr*h*(2.0/2.7E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(1.0E1/9.0)+h*(dr-h*(-(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r,2.0)+G*sin(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1))+(k*(r-r0+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1)))/m)*(1.5E1/4.0)-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/4.0)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*3.0)*(8.0/8.1E1)+h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(5.0E1/8.1E1)))/m)*(2.7E1/6.4E1)-h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.25E2/1.92E2);
+			const double drNew = dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.3E1/1.92E2)-h*(G*sin(q+dq*h*(2.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(1.2E1/2.5E1)-h*(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(2.0/1.5E1)+h*(dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*3.0)/(r+dr*h*(1.0/3.0))-(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(1.5E1/4.0))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))-(h*(dq*dr*2.0+G*cos(q))*(1.0/4.0))/r)*(8.0/7.5E1))-(r+dr*h*(2.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(1.2E1/2.5E1)+h*(dr-h*(-(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r,2.0)+G*sin(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1))+(k*(r-r0+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1)))/m)*(1.5E1/4.0)-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/4.0)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*3.0)*(8.0/7.5E1)-h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(2.0/1.5E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/4.0)-h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*3.0-h*(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(1.5E1/4.0))+(dr*2.0-h*(-(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r,2.0)+G*sin(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1))+(k*(r-r0+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1)))/m)*(1.5E1/2.0)-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/2.0)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*6.0)*(dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*3.0)/(r+dr*h*(1.0/3.0))-(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(1.5E1/4.0))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))-(h*(dq*dr*2.0+G*cos(q))*(1.0/4.0))/r))*(8.0/7.5E1))/(r+dr*h*(1.0/4.0)-h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*3.0-h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(1.5E1/4.0))+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(1.2E1/2.5E1))/(r+dr*h*(1.0/3.0))+(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(2.0/1.5E1))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))+(h*(dq*dr*2.0+G*cos(q))*(2.0/2.5E1))/r,2.0)+(k*(r-r0+dr*h*(2.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(1.2E1/2.5E1)+h*(dr-h*(-(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r,2.0)+G*sin(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1))+(k*(r-r0+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1)))/m)*(1.5E1/4.0)-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/4.0)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*3.0)*(8.0/7.5E1)-h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(2.0/1.5E1)))/m)*(1.25E2/1.92E2)+h*(G*sin(q+dq*h*(2.0/2.7E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(1.0E1/9.0)+h*(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(5.0E1/8.1E1)+h*(dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*3.0)/(r+dr*h*(1.0/3.0))-(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(1.5E1/4.0))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))-(h*(dq*dr*2.0+G*cos(q))*(1.0/4.0))/r)*(8.0/8.1E1))-(r+dr*h*(2.0/2.7E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(1.0E1/9.0)+h*(dr-h*(-(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r,2.0)+G*sin(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1))+(k*(r-r0+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1)))/m)*(1.5E1/4.0)-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/4.0)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*3.0)*(8.0/8.1E1)+h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(5.0E1/8.1E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/4.0)-h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*3.0-h*(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(1.5E1/4.0))+(dr*2.0-h*(-(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r,2.0)+G*sin(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1))+(k*(r-r0+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1)))/m)*(1.5E1/2.0)-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/2.0)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*6.0)*(dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*3.0)/(r+dr*h*(1.0/3.0))-(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(1.5E1/4.0))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))-(h*(dq*dr*2.0+G*cos(q))*(1.0/4.0))/r))*(8.0/8.1E1))/(r+dr*h*(1.0/4.0)-h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*3.0-h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(1.5E1/4.0))+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(1.0E1/9.0))/(r+dr*h*(1.0/3.0))-(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(5.0E1/8.1E1))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))+(h*(dq*dr*2.0+G*cos(q))*(2.0/2.7E1))/r,2.0)+(k*(r-r0+dr*h*(2.0/2.7E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(1.0E1/9.0)+h*(dr-h*(-(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r,2.0)+G*sin(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1))+(k*(r-r0+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1)))/m)*(1.5E1/4.0)-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/4.0)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*3.0)*(8.0/8.1E1)+h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(5.0E1/8.1E1)))/m)*(2.7E1/6.4E1)-h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.25E2/1.92E2);
 
-		qNew = q+dq*h*(2.3E1/1.92E2)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(1.25E2/1.92E2)-h*(-dq+(h*(G*cos(q+dq*h*(1.0/4.0)-h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*3.0-h*(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(1.5E1/4.0))+(dr*2.0-h*(-(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r,2.0)+G*sin(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1))+(k*(r-r0+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1)))/m)*(1.5E1/2.0)-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/2.0)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*6.0)*(dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*3.0)/(r+dr*h*(1.0/3.0))-(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(1.5E1/4.0))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))-(h*(dq*dr*2.0+G*cos(q))*(1.0/4.0))/r))*(8.0/7.5E1))/(r+dr*h*(1.0/4.0)-h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*3.0-h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(1.5E1/4.0))+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(1.2E1/2.5E1))/(r+dr*h*(1.0/3.0))+(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(2.0/1.5E1))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))+(h*(dq*dr*2.0+G*cos(q))*(2.0/2.5E1))/r)*(1.25E2/1.92E2)+h*(-dq+(h*(G*cos(q+dq*h*(1.0/4.0)-h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*3.0-h*(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(1.5E1/4.0))+(dr*2.0-h*(-(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r,2.0)+G*sin(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1))+(k*(r-r0+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1)))/m)*(1.5E1/2.0)-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/2.0)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*6.0)*(dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*3.0)/(r+dr*h*(1.0/3.0))-(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(1.5E1/4.0))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))-(h*(dq*dr*2.0+G*cos(q))*(1.0/4.0))/r))*(8.0/8.1E1))/(r+dr*h*(1.0/4.0)-h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*3.0-h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(1.5E1/4.0))+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(1.0E1/9.0))/(r+dr*h*(1.0/3.0))-(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(5.0E1/8.1E1))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))+(h*(dq*dr*2.0+G*cos(q))*(2.0/2.7E1))/r)*(2.7E1/6.4E1);
+			const double qNew = q+dq*h*(2.3E1/1.92E2)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(1.25E2/1.92E2)-h*(-dq+(h*(G*cos(q+dq*h*(1.0/4.0)-h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*3.0-h*(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(1.5E1/4.0))+(dr*2.0-h*(-(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r,2.0)+G*sin(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1))+(k*(r-r0+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1)))/m)*(1.5E1/2.0)-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/2.0)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*6.0)*(dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*3.0)/(r+dr*h*(1.0/3.0))-(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(1.5E1/4.0))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))-(h*(dq*dr*2.0+G*cos(q))*(1.0/4.0))/r))*(8.0/7.5E1))/(r+dr*h*(1.0/4.0)-h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*3.0-h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(1.5E1/4.0))+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(1.2E1/2.5E1))/(r+dr*h*(1.0/3.0))+(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(2.0/1.5E1))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))+(h*(dq*dr*2.0+G*cos(q))*(2.0/2.5E1))/r)*(1.25E2/1.92E2)+h*(-dq+(h*(G*cos(q+dq*h*(1.0/4.0)-h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*3.0-h*(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(1.5E1/4.0))+(dr*2.0-h*(-(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r,2.0)+G*sin(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1))+(k*(r-r0+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1)))/m)*(1.5E1/2.0)-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/2.0)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*6.0)*(dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*3.0)/(r+dr*h*(1.0/3.0))-(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(1.5E1/4.0))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))-(h*(dq*dr*2.0+G*cos(q))*(1.0/4.0))/r))*(8.0/8.1E1))/(r+dr*h*(1.0/4.0)-h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*3.0-h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(1.5E1/4.0))+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(1.0E1/9.0))/(r+dr*h*(1.0/3.0))-(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(5.0E1/8.1E1))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))+(h*(dq*dr*2.0+G*cos(q))*(2.0/2.7E1))/r)*(2.7E1/6.4E1);
 
-		dqNew = dq-(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(1.25E2/1.92E2))/(r+dr*h*(1.0/3.0))-(h*(G*cos(q+dq*h*(2.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(1.2E1/2.5E1)-h*(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(2.0/1.5E1)+h*(dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*3.0)/(r+dr*h*(1.0/3.0))-(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(1.5E1/4.0))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))-(h*(dq*dr*2.0+G*cos(q))*(1.0/4.0))/r)*(8.0/7.5E1))+(dr*-2.0+h*(-(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r,2.0)+G*sin(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1))+(k*(r-r0+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1)))/m)*(4.0/1.5E1)-h*(-G*sin(q+dq*h*(1.0/4.0)-h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*3.0-h*(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(1.5E1/4.0))+pow(dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*3.0)/(r+dr*h*(1.0/3.0))-(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(1.5E1/4.0))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))-(h*(dq*dr*2.0+G*cos(q))*(1.0/4.0))/r,2.0)*(r+dr*h*(1.0/4.0)-h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*3.0-h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(1.5E1/4.0))+(k*(-r+r0-dr*h*(1.0/4.0)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*3.0+h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(1.5E1/4.0)))/m)*(1.6E1/7.5E1)+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(2.4E1/2.5E1))*(-dq+(h*(G*cos(q+dq*h*(1.0/4.0)-h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*3.0-h*(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(1.5E1/4.0))+(dr*2.0-h*(-(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r,2.0)+G*sin(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1))+(k*(r-r0+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1)))/m)*(1.5E1/2.0)-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/2.0)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*6.0)*(dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*3.0)/(r+dr*h*(1.0/3.0))-(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(1.5E1/4.0))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))-(h*(dq*dr*2.0+G*cos(q))*(1.0/4.0))/r))*(8.0/7.5E1))/(r+dr*h*(1.0/4.0)-h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*3.0-h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(1.5E1/4.0))+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(1.2E1/2.5E1))/(r+dr*h*(1.0/3.0))+(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(2.0/1.5E1))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))+(h*(dq*dr*2.0+G*cos(q))*(2.0/2.5E1))/r))*(1.25E2/1.92E2))/(r+dr*h*(2.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(1.2E1/2.5E1)+h*(dr-h*(-(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r,2.0)+G*sin(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1))+(k*(r-r0+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1)))/m)*(1.5E1/4.0)-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/4.0)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*3.0)*(8.0/7.5E1)-h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(2.0/1.5E1))+(h*(G*cos(q+dq*h*(2.0/2.7E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(1.0E1/9.0)+h*(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(5.0E1/8.1E1)+h*(dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*3.0)/(r+dr*h*(1.0/3.0))-(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(1.5E1/4.0))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))-(h*(dq*dr*2.0+G*cos(q))*(1.0/4.0))/r)*(8.0/8.1E1))-(dr*2.0+h*(-(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r,2.0)+G*sin(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1))+(k*(r-r0+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1)))/m)*(1.0E2/8.1E1)+h*(-G*sin(q+dq*h*(1.0/4.0)-h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*3.0-h*(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(1.5E1/4.0))+pow(dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*3.0)/(r+dr*h*(1.0/3.0))-(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(1.5E1/4.0))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))-(h*(dq*dr*2.0+G*cos(q))*(1.0/4.0))/r,2.0)*(r+dr*h*(1.0/4.0)-h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*3.0-h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(1.5E1/4.0))+(k*(-r+r0-dr*h*(1.0/4.0)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*3.0+h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(1.5E1/4.0)))/m)*(1.6E1/8.1E1)-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.7E1)-h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(2.0E1/9.0))*(-dq+(h*(G*cos(q+dq*h*(1.0/4.0)-h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*3.0-h*(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(1.5E1/4.0))+(dr*2.0-h*(-(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r,2.0)+G*sin(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1))+(k*(r-r0+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1)))/m)*(1.5E1/2.0)-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/2.0)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*6.0)*(dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*3.0)/(r+dr*h*(1.0/3.0))-(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(1.5E1/4.0))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))-(h*(dq*dr*2.0+G*cos(q))*(1.0/4.0))/r))*(8.0/8.1E1))/(r+dr*h*(1.0/4.0)-h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*3.0-h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(1.5E1/4.0))+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(1.0E1/9.0))/(r+dr*h*(1.0/3.0))-(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(5.0E1/8.1E1))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))+(h*(dq*dr*2.0+G*cos(q))*(2.0/2.7E1))/r))*(2.7E1/6.4E1))/(r+dr*h*(2.0/2.7E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(1.0E1/9.0)+h*(dr-h*(-(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r,2.0)+G*sin(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1))+(k*(r-r0+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1)))/m)*(1.5E1/4.0)-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/4.0)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*3.0)*(8.0/8.1E1)+h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(5.0E1/8.1E1))-(h*(dq*dr*2.0+G*cos(q))*(2.3E1/1.92E2))/r;
-		
-	// Advance time step, replace old with new
-        slipState.r = rNew;
-        slipState.dr = drNew;
-        slipState.q = qNew;
-        slipState.dq = dqNew;
+			const double dqNew = dq-(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(1.25E2/1.92E2))/(r+dr*h*(1.0/3.0))-(h*(G*cos(q+dq*h*(2.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(1.2E1/2.5E1)-h*(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(2.0/1.5E1)+h*(dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*3.0)/(r+dr*h*(1.0/3.0))-(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(1.5E1/4.0))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))-(h*(dq*dr*2.0+G*cos(q))*(1.0/4.0))/r)*(8.0/7.5E1))+(dr*-2.0+h*(-(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r,2.0)+G*sin(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1))+(k*(r-r0+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1)))/m)*(4.0/1.5E1)-h*(-G*sin(q+dq*h*(1.0/4.0)-h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*3.0-h*(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(1.5E1/4.0))+pow(dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*3.0)/(r+dr*h*(1.0/3.0))-(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(1.5E1/4.0))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))-(h*(dq*dr*2.0+G*cos(q))*(1.0/4.0))/r,2.0)*(r+dr*h*(1.0/4.0)-h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*3.0-h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(1.5E1/4.0))+(k*(-r+r0-dr*h*(1.0/4.0)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*3.0+h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(1.5E1/4.0)))/m)*(1.6E1/7.5E1)+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(2.4E1/2.5E1))*(-dq+(h*(G*cos(q+dq*h*(1.0/4.0)-h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*3.0-h*(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(1.5E1/4.0))+(dr*2.0-h*(-(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r,2.0)+G*sin(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1))+(k*(r-r0+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1)))/m)*(1.5E1/2.0)-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/2.0)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*6.0)*(dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*3.0)/(r+dr*h*(1.0/3.0))-(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(1.5E1/4.0))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))-(h*(dq*dr*2.0+G*cos(q))*(1.0/4.0))/r))*(8.0/7.5E1))/(r+dr*h*(1.0/4.0)-h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*3.0-h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(1.5E1/4.0))+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(1.2E1/2.5E1))/(r+dr*h*(1.0/3.0))+(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(2.0/1.5E1))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))+(h*(dq*dr*2.0+G*cos(q))*(2.0/2.5E1))/r))*(1.25E2/1.92E2))/(r+dr*h*(2.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(1.2E1/2.5E1)+h*(dr-h*(-(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r,2.0)+G*sin(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1))+(k*(r-r0+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1)))/m)*(1.5E1/4.0)-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/4.0)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*3.0)*(8.0/7.5E1)-h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(2.0/1.5E1))+(h*(G*cos(q+dq*h*(2.0/2.7E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(1.0E1/9.0)+h*(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(5.0E1/8.1E1)+h*(dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*3.0)/(r+dr*h*(1.0/3.0))-(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(1.5E1/4.0))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))-(h*(dq*dr*2.0+G*cos(q))*(1.0/4.0))/r)*(8.0/8.1E1))-(dr*2.0+h*(-(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r,2.0)+G*sin(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1))+(k*(r-r0+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1)))/m)*(1.0E2/8.1E1)+h*(-G*sin(q+dq*h*(1.0/4.0)-h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*3.0-h*(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(1.5E1/4.0))+pow(dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*3.0)/(r+dr*h*(1.0/3.0))-(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(1.5E1/4.0))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))-(h*(dq*dr*2.0+G*cos(q))*(1.0/4.0))/r,2.0)*(r+dr*h*(1.0/4.0)-h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*3.0-h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(1.5E1/4.0))+(k*(-r+r0-dr*h*(1.0/4.0)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*3.0+h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(1.5E1/4.0)))/m)*(1.6E1/8.1E1)-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.7E1)-h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(2.0E1/9.0))*(-dq+(h*(G*cos(q+dq*h*(1.0/4.0)-h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*3.0-h*(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(1.5E1/4.0))+(dr*2.0-h*(-(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r,2.0)+G*sin(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1))+(k*(r-r0+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1)))/m)*(1.5E1/2.0)-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/2.0)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*6.0)*(dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*3.0)/(r+dr*h*(1.0/3.0))-(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(1.5E1/4.0))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))-(h*(dq*dr*2.0+G*cos(q))*(1.0/4.0))/r))*(8.0/8.1E1))/(r+dr*h*(1.0/4.0)-h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*3.0-h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(1.5E1/4.0))+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(1.0E1/9.0))/(r+dr*h*(1.0/3.0))-(h*((-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r)*(dr*-2.0+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(8.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(1.2E1/2.5E1))+G*cos(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1)))*(5.0E1/8.1E1))/(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))+(h*(dq*dr*2.0+G*cos(q))*(2.0/2.7E1))/r))*(2.7E1/6.4E1))/(r+dr*h*(2.0/2.7E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(1.0E1/9.0)+h*(dr-h*(-(r+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1))*pow(-dq+(h*(G*cos(q+dq*h*(1.0/3.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(2.0/3.0)))*(6.0/2.5E1))/(r+dr*h*(1.0/3.0))+(h*(dq*dr*2.0+G*cos(q))*(4.0/2.5E1))/r,2.0)+G*sin(q+dq*h*(4.0/2.5E1)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r)*(6.0/2.5E1))+(k*(r-r0+dr*h*(4.0/2.5E1)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/3.0))*(6.0/2.5E1)))/m)*(1.5E1/4.0)-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/4.0)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*3.0)*(8.0/8.1E1)+h*(-dr+h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(4.0/2.5E1)+h*(G*sin(q+dq*h*(1.0/3.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/3.0))/r,2.0)*(r+dr*h*(1.0/3.0))+(k*(r-r0+dr*h*(1.0/3.0)))/m)*(6.0/2.5E1))*(5.0E1/8.1E1))-(h*(dq*dr*2.0+G*cos(q))*(2.3E1/1.92E2))/r;
+
+			r  = rNew;
+			dr = drNew;
+			q  = qNew;
+			dq = dqNew;
+		}
 
+		slipState.r  = r;
+		slipState.dr = dr;
+		slipState.q  = q;
+		slipState.dq = dq;
 	}
 
 	// Set the log data
@@ -130,6 +129,7 @@ SlipState ASCSlipModel::advanceRK5(SlipState slipState) {
 
 
 LegForce ASCSlipModel::force(SlipState slipState) {
+	ProfileScope scope(this);
 
 	// Unpack parameters
 	r = slipState.r;
@@ -168,5 +168,61 @@ LegForce ASCSlipModel::force(SlipState slipState) {
 
 }
 
+
+void ASCSlipModel::predictLiftoff(SlipBatch &batch) {
+	ProfileScope scope(this);
+
+	// Predict with our current parameters
+	predictor.k = k;
+	predictor.r0 = r0;
+	predictor.m = m;
+	predictor.predictLiftoff(batch);
+
+}
+
+
+double ASCSlipModel::equilibriumAngle(double dx, double dz) {
+	ProfileScope scope(this);
+
+	// Predict with our current parameters
+	predictor.k = k;
+	predictor.r0 = r0;
+	predictor.m = m;
+	return predictor.equilibriumAngle(dx, dz);
+
+}
+
+
+void ASCSlipModel::equilibriumGait(double dx, double dz, double &q, double &dqdz, double &dqdr) {
+	ProfileScope scope(this);
+
+	// Predict with our current parameters
+	predictor.k = k;
+	predictor.r0 = r0;
+	predictor.m = m;
+	predictor.equilibriumGait(dx, dz, q, dqdz, dqdr);
+
+}
+
+
+void ASCSlipModel::neutralGait(double dx, double &q, double &dqdz, double &dqdr) {
+	ProfileScope scope(this);
+
+	// The body is at (r0*cos(q), r0*sin(q)) from the toe, so the toe is
+	// ahead of it when cos(q) = -ahead/r0.
+	double ahead = dx*PI*sqrt(m/k)/2.0;
+	double c = -ahead/r0;
+	q = acos(fmax(-1.0, fmin(1.0, c)));
+	dqdz = 0.0;
+	dqdr = (fabs(c) < 1.0) ? -(ahead/(r0*r0))/sqrt(1.0 - c*c) : 0.0;
+
+	// Stay within the angles the solver searches
+	if (fabs(q - PI/2.0) > SLIP_EQUILIBRIUM_RANGE) {
+		q = PI/2.0 + copysign(SLIP_EQUILIBRIUM_RANGE, q - PI/2.0);
+		dqdr = 0.0;
+	}
+
+}
+
 }
 }
@@ -0,0 +1,182 @@
+#include "asc_slip_model/SlipPredictor.hpp"
+
+// Standard library
+#include <algorithm>
+#include <math.h>
+
+// The integrators, generated by scripts/gen_slip_integrators.py
+#include "asc_slip_model/SlipIntegrators.h"
+
+// Our namespaces
+namespace atrias {
+namespace controller {
+
+SlipPredictor::SlipPredictor() {
+	// The same defaults as ASCSlipModel
+	k = 28000.0;
+	r0 = 0.85;
+	m = M;
+	g = G;
+
+	predictionStep = 0.01;
+	maxStanceTime = 1.0;
+}
+
+
+void SlipPredictor::predictLiftoff(SlipBatch &batch) {
+	// Copy the candidates in
+	int active = std::min(batch.n, SLIP_BATCH_MAX);
+	for (int i = 0; i < active; i++) {
+		stanceR[i] = batch.r[i];
+		stanceDr[i] = batch.dr[i];
+		stanceQ[i] = batch.q[i];
+		stanceDq[i] = batch.dq[i];
+		stanceIndex[i] = i;
+		batch.valid[i] = false;
+		batch.qLiftoff[i] = NAN;
+	}
+
+	// Step every candidate still in stance, retiring them as they lift off or fall
+	double t = 0.0;
+	while (active > 0 && t < maxStanceTime) {
+		slipRK4Batch(active, stanceR, stanceDr, stanceQ, stanceDq, predictionStep, k, r0, m, g);
+		t += predictionStep;
+
+		for (int j = 0; j < active; j++) {
+			bool liftoff = stanceR[j] >= r0 && stanceDr[j] > 0.0;
+			bool fallen = stanceR[j] < 0.5*r0 || stanceR[j]*sin(stanceQ[j]) <= 0.0;
+			if (!liftoff && !fallen)
+				continue;
+
+			if (liftoff) {
+				int i = stanceIndex[j];
+
+				// Back up to where the leg reached its rest length
+				double overshoot = (stanceR[j] - r0)/stanceDr[j];
+				double qLo = stanceQ[j] - stanceDq[j]*overshoot;
+
+				batch.tLiftoff[i] = t - overshoot;
+				batch.qLiftoff[i] = qLo;
+				batch.dxLiftoff[i] = stanceDr[j]*cos(qLo) - r0*stanceDq[j]*sin(qLo);
+				batch.dzLiftoff[i] = stanceDr[j]*sin(qLo) + r0*stanceDq[j]*cos(qLo);
+
+				// Ballistic flight to the apex
+				if (batch.dzLiftoff[i] > 0.0) {
+					batch.valid[i] = true;
+					batch.tApex[i] = batch.tLiftoff[i] + batch.dzLiftoff[i]/g;
+					batch.zApex[i] = r0*sin(qLo) + batch.dzLiftoff[i]*batch.dzLiftoff[i]/(2.0*g);
+					batch.dxApex[i] = batch.dxLiftoff[i];
+				}
+			}
+
+			// Move the last candidate still in stance into this one's place
+			active--;
+			stanceR[j] = stanceR[active];
+			stanceDr[j] = stanceDr[active];
+			stanceQ[j] = stanceQ[active];
+			stanceDq[j] = stanceDq[active];
+			stanceIndex[j] = stanceIndex[active];
+			j--;
+		}
+	}
+
+}
+
+
+void SlipPredictor::predictTouchdownAngles(double dx, double dz, double qMin, double qMax) {
+	SlipBatch &batch = equilibriumBatch;
+	batch.n = SLIP_EQUILIBRIUM_CANDIDATES;
+
+	for (int i = 0; i < batch.n; i++) {
+		batch.q[i] = qMin + (qMax - qMin)*i/(batch.n - 1);
+		batch.r[i] = r0;
+		batch.dr[i] = dx*cos(batch.q[i]) + dz*sin(batch.q[i]);
+		batch.dq[i] = (dz*cos(batch.q[i]) - dx*sin(batch.q[i]))/r0;
+	}
+
+	predictLiftoff(batch);
+
+}
+
+
+double SlipPredictor::equilibriumError(int i) {
+
+	return equilibriumBatch.qLiftoff[i] + equilibriumBatch.q[i] - PI;
+
+}
+
+
+double SlipPredictor::equilibriumAngle(double dx, double dz) {
+	// The leg leans into the direction of travel. The body is at
+	// (r*cos(q), r*sin(q)) from the toe, so moving forward means q > pi/2.
+	double qMin = PI/2.0;
+	double qMax = PI/2.0 + SLIP_EQUILIBRIUM_RANGE;
+	if (dx < 0.0) {
+		qMin = PI/2.0 - SLIP_EQUILIBRIUM_RANGE;
+		qMax = PI/2.0;
+	}
+
+	// Find the candidates that bracket the solution, then search again between
+	// them. A candidate needn't reach an apex to bracket it, only lift off;
+	// the one beside the solution may lift off downward.
+	SlipBatch &batch = equilibriumBatch;
+	int bracket = -1;
+	for (int pass = 0; pass < 2; pass++) {
+		predictTouchdownAngles(dx, dz, qMin, qMax);
+
+		bracket = -1;
+		for (int i = 1; i < batch.n; i++) {
+			if (!isnan(batch.qLiftoff[i - 1]) && !isnan(batch.qLiftoff[i]) &&
+			    (equilibriumError(i - 1) < 0.0) != (equilibriumError(i) < 0.0))
+			{
+				bracket = i;
+				break;
+			}
+		}
+
+		if (bracket < 0)
+			break;
+
+		qMin = batch.q[bracket - 1];
+		qMax = batch.q[bracket];
+	}
+
+	// Interpolate between the bracketing candidates
+	if (bracket > 0) {
+		double e1 = equilibriumError(bracket - 1);
+		double e2 = equilibriumError(bracket);
+		return batch.q[bracket - 1] + (batch.q[bracket] - batch.q[bracket - 1])*e1/(e1 - e2);
+	}
+
+	// No solution in range; use the closest candidate we have
+	double q = PI/2.0;
+	double bestError = INFINITY;
+	for (int i = 0; i < batch.n; i++) {
+		if (batch.valid[i] && fabs(equilibriumError(i)) < bestError) {
+			bestError = fabs(equilibriumError(i));
+			q = batch.q[i];
+		}
+	}
+	return q;
+
+}
+
+
+void SlipPredictor::equilibriumGait(double dx, double dz, double &q, double &dqdz, double &dqdr) {
+	q = equilibriumAngle(dx, dz);
+
+	dqdz = (equilibriumAngle(dx, dz + SLIP_EQUILIBRIUM_DZ_STEP) -
+	        equilibriumAngle(dx, dz - SLIP_EQUILIBRIUM_DZ_STEP)) / (2.0*SLIP_EQUILIBRIUM_DZ_STEP);
+
+	double leg = r0;
+	r0 = leg + SLIP_EQUILIBRIUM_R_STEP;
+	dqdr = equilibriumAngle(dx, dz);
+	r0 = leg - SLIP_EQUILIBRIUM_R_STEP;
+	dqdr = (dqdr - equilibriumAngle(dx, dz)) / (2.0*SLIP_EQUILIBRIUM_R_STEP);
+	r0 = leg;
+}
+
+}
+}
+
+// vim: noexpandtab
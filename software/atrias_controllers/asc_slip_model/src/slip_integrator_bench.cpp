@@ -0,0 +1,139 @@
+/** @file
+  * @brief Checks the generated SLIP RK4 integrator (SlipIntegrators.h)
+  * against the expanded expression ASCSlipModel used before, and times both.
+  *
+  * Exits with 1 if they don't match to rounding.
+  */
+
+#include <stdio.h>
+#include <time.h>
+#include <math.h>
+
+#include <algorithm>
+
+#include "asc_slip_model/SlipIntegrators.h"
+
+// Mass and gravity. Included last, as it defines some short macro names.
+#include <atrias_shared/atrias_parameters.h>
+
+using namespace atrias::controller;
+
+#define BENCH_H        0.001  // seconds, one controller cycle
+#define BENCH_K        28000.0
+#define BENCH_R0       0.85
+#define BENCH_STEPS    1000000
+#define BENCH_RK4_TOL  1e-12
+
+// The old RK4 expression, as it was in ASCSlipModel.cpp.
+struct OldSlip {
+	double k, r0, m, h;
+	double r, dr, q, dq;
+	double rNew, drNew, qNew, dqNew;
+
+	void advanceRK4() {
+		rNew = r+dr*h*(1.0/6.0)+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/2.0))*(1.0/3.0)+h*(dr-h*(G*sin(q+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(1.0/2.0))-pow(dq-(h*(G*cos(q+dq*h*(1.0/2.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)))*(1.0/2.0))/(r+dr*h*(1.0/2.0)),2.0)*(r+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/2.0))*(1.0/2.0))+(k*(r-r0+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/2.0))*(1.0/2.0)))/m))*(1.0/6.0)+h*(dr-h*(G*sin(q+dq*h*(1.0/2.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r,2.0)*(r+dr*h*(1.0/2.0))+(k*(r-r0+dr*h*(1.0/2.0)))/m)*(1.0/2.0))*(1.0/3.0);
+
+		drNew = dr-h*(-pow(dq-(h*(G*cos(q+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(1.0/2.0))+(dq-(h*(G*cos(q+dq*h*(1.0/2.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)))*(1.0/2.0))/(r+dr*h*(1.0/2.0)))*(dr*2.0-h*(G*sin(q+dq*h*(1.0/2.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r,2.0)*(r+dr*h*(1.0/2.0))+(k*(r-r0+dr*h*(1.0/2.0)))/m))))/(r+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/2.0))*(1.0/2.0)),2.0)*(r+h*(dr-h*(G*sin(q+dq*h*(1.0/2.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r,2.0)*(r+dr*h*(1.0/2.0))+(k*(r-r0+dr*h*(1.0/2.0)))/m)*(1.0/2.0)))+G*sin(q+h*(dq-(h*(G*cos(q+dq*h*(1.0/2.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)))*(1.0/2.0))/(r+dr*h*(1.0/2.0))))+(k*(r-r0+h*(dr-h*(G*sin(q+dq*h*(1.0/2.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r,2.0)*(r+dr*h*(1.0/2.0))+(k*(r-r0+dr*h*(1.0/2.0)))/m)*(1.0/2.0))))/m)*(1.0/6.0)-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/6.0)-h*(G*sin(q+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(1.0/2.0))-pow(dq-(h*(G*cos(q+dq*h*(1.0/2.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)))*(1.0/2.0))/(r+dr*h*(1.0/2.0)),2.0)*(r+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/2.0))*(1.0/2.0))+(k*(r-r0+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/2.0))*(1.0/2.0)))/m)*(1.0/3.0)-h*(G*sin(q+dq*h*(1.0/2.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r,2.0)*(r+dr*h*(1.0/2.0))+(k*(r-r0+dr*h*(1.0/2.0)))/m)*(1.0/3.0);
+
+		qNew = q+dq*h*(1.0/6.0)+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(1.0/3.0)+h*(dq-(h*(G*cos(q+dq*h*(1.0/2.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)))*(1.0/2.0))/(r+dr*h*(1.0/2.0)))*(1.0/3.0)+h*(dq-(h*(G*cos(q+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(1.0/2.0))+(dq-(h*(G*cos(q+dq*h*(1.0/2.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)))*(1.0/2.0))/(r+dr*h*(1.0/2.0)))*(dr*2.0-h*(G*sin(q+dq*h*(1.0/2.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r,2.0)*(r+dr*h*(1.0/2.0))+(k*(r-r0+dr*h*(1.0/2.0)))/m))))/(r+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/2.0))*(1.0/2.0)))*(1.0/6.0);
+
+		dqNew = dq-(h*(G*cos(q+dq*h*(1.0/2.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)))*(1.0/3.0))/(r+dr*h*(1.0/2.0))-(h*(G*cos(q+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(1.0/2.0))+(dq-(h*(G*cos(q+dq*h*(1.0/2.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)))*(1.0/2.0))/(r+dr*h*(1.0/2.0)))*(dr*2.0-h*(G*sin(q+dq*h*(1.0/2.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r,2.0)*(r+dr*h*(1.0/2.0))+(k*(r-r0+dr*h*(1.0/2.0)))/m)))*(1.0/3.0))/(r+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/2.0))*(1.0/2.0))-(h*(dq*dr*2.0+G*cos(q))*(1.0/6.0))/r-(h*((dq-(h*(G*cos(q+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(1.0/2.0))+(dq-(h*(G*cos(q+dq*h*(1.0/2.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)))*(1.0/2.0))/(r+dr*h*(1.0/2.0)))*(dr*2.0-h*(G*sin(q+dq*h*(1.0/2.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r,2.0)*(r+dr*h*(1.0/2.0))+(k*(r-r0+dr*h*(1.0/2.0)))/m))))/(r+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/2.0))*(1.0/2.0)))*(dr*2.0-h*(G*sin(q+h*(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(1.0/2.0))-pow(dq-(h*(G*cos(q+dq*h*(1.0/2.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)))*(1.0/2.0))/(r+dr*h*(1.0/2.0)),2.0)*(r+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/2.0))*(1.0/2.0))+(k*(r-r0+h*(dr-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)*(1.0/2.0))*(1.0/2.0)))/m)*2.0)+G*cos(q+h*(dq-(h*(G*cos(q+dq*h*(1.0/2.0))+(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r)*(dr*2.0-h*(-(dq*dq)*r+G*sin(q)+(k*(r-r0))/m)))*(1.0/2.0))/(r+dr*h*(1.0/2.0)))))*(1.0/6.0))/(r+h*(dr-h*(G*sin(q+dq*h*(1.0/2.0))-pow(dq-(h*(dq*dr*2.0+G*cos(q))*(1.0/2.0))/r,2.0)*(r+dr*h*(1.0/2.0))+(k*(r-r0+dr*h*(1.0/2.0)))/m)*(1.0/2.0)));
+
+		r = rNew; dr = drNew; q = qNew; dq = dqNew;
+	}
+};
+
+struct State {
+	double r, dr, q, dq;
+};
+
+// A spread of stance states, from touchdown to midstance.
+static const int GRID = 6;
+static State states[GRID * GRID * GRID * GRID];
+
+static void makeStates() {
+	int n = 0;
+	for (int a = 0; a < GRID; a++)
+	for (int b = 0; b < GRID; b++)
+	for (int c = 0; c < GRID; c++)
+	for (int d = 0; d < GRID; d++) {
+		states[n].r  = 0.6  + 0.24 * a / (GRID - 1);
+		states[n].dr = -1.5 + 3.0  * b / (GRID - 1);
+		states[n].q  = 1.2  + 0.7  * c / (GRID - 1);
+		states[n].dq = -3.0 + 6.0  * d / (GRID - 1);
+		n++;
+	}
+}
+
+static OldSlip oldSlip(const State &s, double h) {
+	OldSlip old;
+	old.k = BENCH_K; old.r0 = BENCH_R0; old.m = M; old.h = h;
+	old.r = s.r; old.dr = s.dr; old.q = s.q; old.dq = s.dq;
+	return old;
+}
+
+// The largest difference between two states, relative to the state's size.
+static double relDiff(const State &a, const State &b) {
+	double diff  = std::max(std::max(fabs(a.r - b.r), fabs(a.dr - b.dr)),
+	                        std::max(fabs(a.q - b.q), fabs(a.dq - b.dq)));
+	double scale = std::max(std::max(fabs(b.r), fabs(b.dr)), std::max(fabs(b.q), fabs(b.dq)));
+	return diff / scale;
+}
+
+static double now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main() {
+	int failed = 0;
+	makeStates();
+
+	// RK4 must match
+	double worstRK4 = 0.0;
+	for (int i = 0; i < GRID * GRID * GRID * GRID; i++) {
+		OldSlip old = oldSlip(states[i], BENCH_H);
+		old.advanceRK4();
+		State oldState = {old.r, old.dr, old.q, old.dq};
+		State newState = states[i];
+		slipRK4(newState.r, newState.dr, newState.q, newState.dq, BENCH_H, BENCH_K, BENCH_R0, M, G, 1);
+		worstRK4 = std::max(worstRK4, relDiff(newState, oldState));
+	}
+	printf("RK4: generated vs. old, worst relative difference: %.2g\n", worstRK4);
+	if (worstRK4 > BENCH_RK4_TOL) {
+		printf("  FAILED: more than %g\n", BENCH_RK4_TOL);
+		failed = 1;
+	}
+
+	// Time a trajectory of steps from one state, so each step depends on the last.
+	printf("Per step, at h = %g s:\n", BENCH_H);
+	State s0 = {0.8, -0.5, 1.6, 0.5};
+	double sink = 0.0;
+
+	OldSlip old = oldSlip(s0, BENCH_H);
+	double start = now();
+	for (int i = 0; i < BENCH_STEPS; i++) {
+		old.advanceRK4();
+		if (old.r > BENCH_R0) { old.r = s0.r; old.dr = s0.dr; old.q = s0.q; old.dq = s0.dq; }
+	}
+	printf("  old RK4:       %6.1f ns\n", (now() - start) / BENCH_STEPS * 1e9);
+	sink += old.r;
+
+	State s = s0;
+	start = now();
+	for (int i = 0; i < BENCH_STEPS; i++) {
+		if (!slipRK4(s.r, s.dr, s.q, s.dq, BENCH_H, BENCH_K, BENCH_R0, M, G, 1))
+			s = s0;
+	}
+	printf("  generated RK4: %6.1f ns\n", (now() - start) / BENCH_STEPS * 1e9);
+	sink += s.r;
+
+	// Keeps the loops from being optimized out
+	if (sink == 12345.0)
+		printf("\n");
+
+	return failed;
+}
+
+// vim: noexpandtab
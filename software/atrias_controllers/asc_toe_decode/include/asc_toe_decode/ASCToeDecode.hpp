@@ -12,6 +12,9 @@
 // And for the logging helper class
 #include <atrias_control_lib/LogPort.hpp>
 
+// Our filter
+#include <atrias_shared/Filters.h>
+
 // Our log data
 #include "asc_toe_decode/controller_log_data.h"
 
@@ -65,6 +68,12 @@ class ASCToeDecode : public AtriasController {
 		double threshold;
 
 	private:
+		/**
+		  * @brief Low-pass filters the force reading; a first-order section
+		  * with gain filter_gain.
+		  */
+		shared::Biquad filter;
+
 		/** 
 		  * @brief This is our logging port.
 		  */
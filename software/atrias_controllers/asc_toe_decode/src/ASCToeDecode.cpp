@@ -15,6 +15,8 @@ ASCToeDecode::ASCToeDecode(AtriasController *parent, string name) :
 }
 
 double ASCToeDecode::operator()(uint16_t force) {
+	ProfileScope scope(this);
+
 	// Log our input data
 	this->log_out.data.filter_gain = this->filter_gain;
 	this->log_out.data.threshold   = this->threshold;
@@ -27,7 +29,8 @@ double ASCToeDecode::operator()(uint16_t force) {
 		this->log_out.data.onGround = true;
 	}
 
-	this->log_out.data.filtered_val += this->filter_gain * (force - this->log_out.data.filtered_val);
+	this->filter.setFirstOrder(this->filter_gain);
+	this->log_out.data.filtered_val = this->filter(force);
 
 	// Transmit the log data
 	this->log_out.send();
@@ -35,6 +35,8 @@
 
 // This controller's common definitions
 #include "common.hpp"
+// Output evaluation
+#include "OutputEvaluator.hpp"
 
 
 // Namespaces we're using
@@ -52,7 +54,7 @@ namespace atrias {
 
   static const double A_OPT[N_OUTPUTS][N_PARAMS] = {
     {3.13058278616339,	3.38621285654106,	2.26312258300192,	3.72562917760651,	2.21768467271887,	3.00343594477559,	2.63518033870867},
-    {3.88033369474228,	3.81628375091666,	3.64791062079225,	3.54302625758800,	3.60125936599999	3.45364342671221	3.37022239691970},
+    {3.88033369474228,	3.81628375091666,	3.64791062079225,	3.54302625758800,	3.60125936599999,	3.45364342671221,	3.37022239691970},
     {2.63529972490620,	2.22706769173603,	3.56813326557356,	0.695310365268170,	2.91237158193484,	2.90041027511901,	3.13100976580989},
     {3.37031174388957,	3.27783500873126,	2.93958409614047,	3.48644831132767,	4.39294714621698,	3.93787692520441,	3.88009422366450}};
 
@@ -236,17 +238,11 @@ namespace atrias {
       double compute_dtau();
 
       /**
-       * @brief This is to compute the desired output 'y2d'
-       * @param tau The parameterized time
-       */
-      void compute_y2d(double tau);
-
-      /**
-       * @brief This is to compute the desired time derivative (velocity) of 'y2d'
+       * @brief This is to compute the desired output 'y2d' and its time derivative 'y2dDot'
        * @param tau The parameterized time
        * @param dtau The derivative of parameterized time
        */
-      void compute_y2dDot(double tau, double dtau);
+      void compute_y2d(double tau, double dtau);
 
       /**
        * @brief This is to convert the states from the current coordinate configuration to the old (Dr Grizzle's) configuration.
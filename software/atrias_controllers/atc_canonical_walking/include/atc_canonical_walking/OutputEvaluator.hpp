@@ -0,0 +1,123 @@
+#ifndef OUTPUTEVALUATOR_HPP
+#define OUTPUTEVALUATOR_HPP
+
+/**
+  * @file OutputEvaluator.hpp
+  * @brief Evaluates the desired outputs and their derivatives together.
+  * Every function here is sized at compile time, so the loops unroll
+  * completely; each evaluates the value and derivative of every output in
+  * one pass, sharing the transcendentals between them.
+  */
+
+// Standard library
+#include <math.h>
+
+// Our namespaces
+namespace atrias {
+namespace controller {
+
+/**
+  * @brief Evaluates Bezier polynomial outputs and their rates.
+  * @param a   Each output's DEGREE + 1 coefficients.
+  * @param da  Each output's DEGREE derivative coefficients.
+  * @param tau The parameterized time.
+  * @param dtau The derivative of tau.
+  * @param y   Set to the outputs.
+  * @param dy  Set to the outputs' time derivatives.
+  *
+  * The Bernstein basis depends only on tau, so it is computed once, without
+  * pow(), and shared by every output.
+  */
+template <int N_OUT, int DEGREE>
+inline void bezierOutputs(const double (&a)[N_OUT][DEGREE + 1], const double (&da)[N_OUT][DEGREE],
+                          double tau, double dtau, double (&y)[N_OUT], double (&dy)[N_OUT])
+{
+	// Powers of tau and (1 - tau)
+	double tp[DEGREE + 1], sp[DEGREE + 1];
+	tp[0] = sp[0] = 1.0;
+	for (int k = 1; k <= DEGREE; k++) {
+		tp[k] = tp[k - 1]*tau;
+		sp[k] = sp[k - 1]*(1.0 - tau);
+	}
+
+	// The bases for degrees DEGREE and DEGREE - 1, binomial coefficients included
+	double basis[DEGREE + 1], dBasis[DEGREE];
+	double binom = 1.0, dBinom = 1.0;
+	for (int k = 0; k <= DEGREE; k++) {
+		basis[k] = binom*tp[k]*sp[DEGREE - k];
+		binom = binom*(DEGREE - k)/(k + 1);
+		if (k < DEGREE) {
+			dBasis[k] = dBinom*tp[k]*sp[DEGREE - 1 - k]*dtau;
+			dBinom = dBinom*(DEGREE - 1 - k)/(k + 1);
+		}
+	}
+
+	for (int j = 0; j < N_OUT; j++) {
+		y[j]  = 0.0;
+		dy[j] = 0.0;
+		for (int k = 0; k <= DEGREE; k++)
+			y[j] += a[j][k]*basis[k];
+		for (int k = 0; k < DEGREE; k++)
+			dy[j] += da[j][k]*dBasis[k];
+	}
+}
+
+/**
+  * @brief Evaluates canonical walking function outputs and their rates.
+  * Each output is
+  *   y = exp(-a3*t)*(a0*cos(a1*t) + a2*sin(a1*t)) + a4*cos(a5*t)
+  *       + 2*a3*a4*a5/(a3^2 + a1^2 - a5^2)*sin(a5*t) + a6
+  * (zero-indexed parameters). The exponential and the two sine/cosine pairs
+  * are computed once per output and shared by the value and its derivative.
+  * @param a    Each output's 7 parameters.
+  * @param tau  The parameterized time.
+  * @param dtau The derivative of tau.
+  * @param y    Set to the outputs.
+  * @param dy   Set to the outputs' time derivatives.
+  */
+template <int N_OUT>
+inline void cwfOutputs(const double (&a)[N_OUT][7], double tau, double dtau,
+                       double (&y)[N_OUT], double (&dy)[N_OUT])
+{
+	for (int j = 0; j < N_OUT; j++) {
+		const double *p = a[j];
+
+		double decay = exp(-p[3]*tau);
+		// GCC turns each pair into a single sincos() call.
+		double s1 = sin(p[1]*tau), c1 = cos(p[1]*tau);
+		double s5 = sin(p[5]*tau), c5 = cos(p[5]*tau);
+		double k  = 2.0*p[3]*p[4]*p[5]/(p[3]*p[3] + p[1]*p[1] - p[5]*p[5]);
+
+		double osc  = p[0]*c1 + p[2]*s1;
+		double dOsc = p[1]*(p[2]*c1 - p[0]*s1);
+
+		y[j]  = decay*osc + p[4]*c5 + k*s5 + p[6];
+		dy[j] = (decay*(dOsc - p[3]*osc) + p[5]*(k*c5 - p[4]*s5))*dtau;
+	}
+}
+
+/**
+  * @brief Maps outputs and their rates back to states in one pass:
+  * x = M*y and dx = M*dy.
+  */
+template <int ROWS, int COLS>
+inline void outputsToStates(const double (&m)[ROWS][COLS], const double (&y)[COLS], const double (&dy)[COLS],
+                            double *x, double *dx)
+{
+	for (int i = 0; i < ROWS; i++) {
+		double xi = 0.0, dxi = 0.0;
+		for (int j = 0; j < COLS; j++) {
+			xi  += m[i][j]*y[j];
+			dxi += m[i][j]*dy[j];
+		}
+		x[i]  = xi;
+		dx[i] = dxi;
+	}
+}
+
+}
+}
+
+#endif // OUTPUTEVALUATOR_HPP
+
+// vim: noexpandtab
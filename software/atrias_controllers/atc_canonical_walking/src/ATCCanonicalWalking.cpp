@@ -171,8 +171,7 @@ namespace atrias {
       if(tau_d < -0.001)   tau_d = -0.001;
       //printf("tau: %f, dtau: %f", tau, dtau);
       // compute desired outputs
-      compute_y2d(tau_d);
-      compute_y2dDot(tau_d, dtau);
+      compute_y2d(tau_d, dtau);
       
       // compute desired motor angles through inverse kinematics
       phi_inverse_mat();
@@ -374,22 +373,12 @@ namespace atrias {
      * @brief This is to compute the inverse kinematics of the system.
      */
     void ATCCanonicalWalking::phi_inverse_mat(){
-      int i,j;
+      // The torso angle and velocity aren't commanded
+      xd[0] = 0;
+      xd[5] = 0;
 
-      // Clear xd
-      for (i = 0; i < N_STATES; ++i)
-      	xd[i] = 0;
-
-      // Calculate the new xd
-      for(i=0; i<N_OUTPUTS; i++)
-      {
-        for(j=0; j<N_OUTPUTS; j++ )
-        {
-          xd[i+1] += invT[i][j] * y2d[j];
-          xd[i+6] += invT[i][j] * y2dDot[j];
-        }
-      }
-      
+      // xd = invT * y2d, and likewise for the velocities
+      outputsToStates(invT, y2d, y2dDot, &xd[1], &xd[6]);
     }
     
     /**
@@ -454,60 +443,15 @@ namespace atrias {
     }
 
     /**
-     * @brief This is to compute the desired output 'y2d'
-     * @param tau The parameterized time
-     */
-    void ATCCanonicalWalking::compute_y2d(double tau){
-      // y2d = exp(-a4*t) * (a1*cos(a2*t)+a3*sin(a2*t)) + a5;
-      //
-      double *a;
-      for(int j=0; j<N_OUTPUTS; j++)
-      { 
-        /*
-          y2d[j] = exp(-param_mat[j][3]*tau) * 
-          (param_mat[j][0] * cos(param_mat[j][1]*tau) + 
-          param_mat[j][2] * sin(param_mat[j][1]*tau)) + 
-          param_mat[j][4] * cos(param_mat[j][5]*tau) + 
-          (2*param_mat[j][3]*param_mat[j][4]*param_mat[j][5])/
-          (pow(param_mat[j][3],2)+pow(param_mat[j][1],2)-
-          pow(param_mat[j][5],2)) * sin(param_mat[j][5]*tau) + 
-          param_mat[j][6];
-        */
-        a = param_mat[j];
-        y2d[j] = param_mat[j][0] * pow((1-tau),6) + 6*param_mat[j][1]*tau*pow(1-tau,5) + 
-          15*param_mat[j][2]*pow(tau,2)*pow(1-tau,4) + 20*param_mat[j][3]*pow(tau,3)*pow(1-tau,3) + 
-          15*param_mat[j][4]*pow(tau,4)*pow(1-tau,2) + 6*param_mat[j][5]*pow(tau,5)*(1-tau) + 
-          param_mat[j][6]*pow(tau,6);
-      }
-    }
-    
-    /**
-     * @brief This is to compute the desired time derivative (velocity) of 'y2d'
+     * @brief This is to compute the desired output 'y2d' and its time derivative 'y2dDot'
      * @param tau The parameterized time
      * @param dtau The derivative of parameterized time
      */
-    void ATCCanonicalWalking::compute_y2dDot(double tau, double dtau){
-      // 
-      for(int j=0; j<N_OUTPUTS; j++)
-      { 
-        /*
-          y2dDot[j] =	exp(-param_mat[j][3]*tau) * 
-          ( param_mat[j][1] * param_mat[j][2]*cos(param_mat[j][1]*tau)- 
-          param_mat[j][0] * param_mat[j][1]*sin(param_mat[j][1]*tau))
-          - param_mat[j][3] * exp(-param_mat[j][3]*tau) *
-          ( param_mat[j][0] * cos(param_mat[j][1]*tau) +
-          param_mat[j][2] * sin(param_mat[j][1]*tau)) - 
-          param_mat[j][4] * param_mat[j][5] * sin(param_mat[j][5]*tau) + 
-          (2*param_mat[j][3]*param_mat[j][4]*pow(param_mat[j][5],2))/
-          (pow(param_mat[j][3],2)+pow(param_mat[j][1],2)-
-          pow(param_mat[j][5],2)) * sin(param_mat[j][5]*tau);
-        */
-        y2dDot[j] = diff_param_mat[j][0] * pow((1-tau),5) + 5*diff_param_mat[j][1]*tau*pow(1-tau,4) + 
-          10*diff_param_mat[j][2]*pow(tau,2)*pow(1-tau,3) + 10*diff_param_mat[j][3]*pow(tau,3)*pow(1-tau,2) + 
-          5*diff_param_mat[j][4]*pow(tau,4)*(1-tau) +
-          diff_param_mat[j][5]*pow(tau,5);
-        y2dDot[j] *=  dtau;		//noted
-      }
+    void ATCCanonicalWalking::compute_y2d(double tau, double dtau){
+      // y2d is a 6th order Bezier polynomial in tau, and y2dDot its derivative
+      // (with its own coefficients) times dtau. To use canonical walking
+      // functions instead, call cwfOutputs(param_mat, tau, dtau, y2d, y2dDot).
+      bezierOutputs(param_mat, diff_param_mat, tau, dtau, y2d, y2dDot);
     }
     
     /**
@@ -0,0 +1,196 @@
+/** @file
+  * @brief Times ATCCanonicalWalking's desired output and state evaluation,
+  * as it was (compute_y2d(), compute_y2dDot() and phi_inverse_mat()) and as
+  * it is with OutputEvaluator.hpp, and checks they agree.
+  *
+  * Also times cwfOutputs(), the canonical walking function form, and checks
+  * its rates against central differences of its outputs.
+  *
+  * Exits with a nonzero status if a check fails.
+  */
+
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+
+#include <algorithm>
+
+#include "atc_canonical_walking/OutputEvaluator.hpp"
+
+using namespace atrias::controller;
+
+// ATCCanonicalWalking's sizes and parameters
+#define N_OUTPUTS 4
+#define N_STATES  10
+#define N_PARAMS  7
+
+static const double invT[N_OUTPUTS][N_OUTPUTS] = {
+	{1, 0, 0, 0},
+	{0, 1, 0, 0},
+	{0, 0, 1, 0},
+	{0, 0, 0, 1}};
+
+static const double A_OPT[N_OUTPUTS][N_PARAMS] = {
+	{3.13058278616339, 3.38621285654106, 2.26312258300192, 3.72562917760651, 2.21768467271887, 3.00343594477559, 2.63518033870867},
+	{3.88033369474228, 3.81628375091666, 3.64791062079225, 3.54302625758800, 3.60125936599999, 3.45364342671221, 3.37022239691970},
+	{2.63529972490620, 2.22706769173603, 3.56813326557356, 0.695310365268170, 2.91237158193484, 2.90041027511901, 3.13100976580989},
+	{3.37031174388957, 3.27783500873126, 2.93958409614047, 3.48644831132767, 4.39294714621698, 3.93787692520441, 3.88009422366450}};
+
+static const double D_OPT[N_OUTPUTS][N_PARAMS-1] = {
+	{ 1.53378042226602, -6.73854164123482, 8.77503956762755, -9.04766702932585, 4.71450763234033, -2.20953363640152},
+	{-0.384299662953726, -1.01023878074645, -0.629306179225527, 0.349398650471944, -0.885695635726687, -0.500526178755031},
+	{-2.44939219902102, 8.04639344302521, -17.2369374018324, 13.3023673000000, -0.0717678408949780, 1.38359694414531},
+	{-0.554860410949804, -2.02950547554476, 3.28118529112322, 5.43899300933585, -2.73042132607544, -0.346696209239457}};
+
+// The controller's working state
+static double param_mat[N_OUTPUTS][N_PARAMS];
+static double diff_param_mat[N_OUTPUTS][N_PARAMS-1];
+static double y2d[N_OUTPUTS], y2dDot[N_OUTPUTS], xd[N_STATES];
+
+// How far the two paths may differ
+#define PATH_TOLERANCE 1e-12
+
+// The step cwfOutputs()'s rates are checked over, and how far they may be
+// from the differences, relative to the larger of 1 and the rate
+#define CWF_STEP      1e-6
+#define CWF_TOLERANCE 1e-6
+
+// The cycles timed; tau runs across the step (and a little outside it,
+// as the controller allows) once per 1000 cycles
+#define BENCH_CYCLES 2000000
+#define TAU_STEPS    1000
+#define DTAU         1.7
+
+/** @brief The old compute_y2d(), compute_y2dDot() and phi_inverse_mat().
+  */
+__attribute__((noinline)) static void oldPath(double tau, double dtau) {
+	for (int j = 0; j < N_OUTPUTS; j++) {
+		y2d[j] = param_mat[j][0] * pow((1-tau),6) + 6*param_mat[j][1]*tau*pow(1-tau,5) +
+		  15*param_mat[j][2]*pow(tau,2)*pow(1-tau,4) + 20*param_mat[j][3]*pow(tau,3)*pow(1-tau,3) +
+		  15*param_mat[j][4]*pow(tau,4)*pow(1-tau,2) + 6*param_mat[j][5]*pow(tau,5)*(1-tau) +
+		  param_mat[j][6]*pow(tau,6);
+	}
+
+	for (int j = 0; j < N_OUTPUTS; j++) {
+		y2dDot[j] = diff_param_mat[j][0] * pow((1-tau),5) + 5*diff_param_mat[j][1]*tau*pow(1-tau,4) +
+		  10*diff_param_mat[j][2]*pow(tau,2)*pow(1-tau,3) + 10*diff_param_mat[j][3]*pow(tau,3)*pow(1-tau,2) +
+		  5*diff_param_mat[j][4]*pow(tau,4)*(1-tau) +
+		  diff_param_mat[j][5]*pow(tau,5);
+		y2dDot[j] *= dtau;
+	}
+
+	for (int i = 0; i < N_STATES; ++i)
+		xd[i] = 0;
+	for (int i = 0; i < N_OUTPUTS; i++) {
+		for (int j = 0; j < N_OUTPUTS; j++) {
+			xd[i+1] += invT[i][j] * y2d[j];
+			xd[i+6] += invT[i][j] * y2dDot[j];
+		}
+	}
+}
+
+/** @brief The current compute_y2d() and phi_inverse_mat().
+  */
+__attribute__((noinline)) static void newPath(double tau, double dtau) {
+	bezierOutputs(param_mat, diff_param_mat, tau, dtau, y2d, y2dDot);
+	xd[0] = 0;
+	xd[5] = 0;
+	outputsToStates(invT, y2d, y2dDot, &xd[1], &xd[6]);
+}
+
+static double stepTau(int i) {
+	return -0.001 + (i % (TAU_STEPS + 1))*1.001/TAU_STEPS;
+}
+
+static double now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main() {
+	for (int i = 0; i < N_OUTPUTS; i++) {
+		for (int j = 0; j < N_PARAMS; j++)
+			param_mat[i][j] = A_OPT[i][j];
+		for (int j = 0; j < N_PARAMS-1; j++)
+			diff_param_mat[i][j] = D_OPT[i][j];
+	}
+
+	int failures = 0;
+
+	// The two paths, across the step
+	double maxPathError = 0.0;
+	for (int i = 0; i <= TAU_STEPS; i++) {
+		double tau = stepTau(i);
+		double oldXd[N_STATES];
+		oldPath(tau, DTAU);
+		std::copy(xd, xd + N_STATES, oldXd);
+		newPath(tau, DTAU);
+		for (int k = 0; k < N_STATES; k++)
+			maxPathError = std::max(maxPathError, fabs(xd[k] - oldXd[k]));
+	}
+	if (maxPathError > PATH_TOLERANCE) {
+		printf("FAIL: the paths differ by %g\n", maxPathError);
+		failures++;
+	}
+
+	// The canonical walking function's rates, across the step
+	double maxCwfError = 0.0;
+	for (int i = 0; i <= TAU_STEPS; i++) {
+		double tau = stepTau(i);
+		double y[N_OUTPUTS], dy[N_OUTPUTS], ahead[N_OUTPUTS], behind[N_OUTPUTS], unused[N_OUTPUTS];
+		cwfOutputs(param_mat, tau, 1.0, y, dy);
+		cwfOutputs(param_mat, tau + CWF_STEP, 1.0, ahead, unused);
+		cwfOutputs(param_mat, tau - CWF_STEP, 1.0, behind, unused);
+		for (int j = 0; j < N_OUTPUTS; j++) {
+			double difference = (ahead[j] - behind[j])/(2.0*CWF_STEP);
+			maxCwfError = std::max(maxCwfError, fabs(dy[j] - difference)/std::max(1.0, fabs(dy[j])));
+		}
+	}
+	if (maxCwfError > CWF_TOLERANCE) {
+		printf("FAIL: cwfOutputs()'s rates differ from central differences by %g\n", maxCwfError);
+		failures++;
+	}
+
+	// Time each
+	volatile double sink = 0.0;
+	double start = now();
+	for (int i = 0; i < BENCH_CYCLES; i++) {
+		oldPath(stepTau(i), DTAU);
+		sink = sink + xd[3];
+	}
+	double oldTime = (now() - start)/BENCH_CYCLES;
+
+	start = now();
+	for (int i = 0; i < BENCH_CYCLES; i++) {
+		newPath(stepTau(i), DTAU);
+		sink = sink + xd[3];
+	}
+	double newTime = (now() - start)/BENCH_CYCLES;
+
+	start = now();
+	for (int i = 0; i < BENCH_CYCLES; i++) {
+		double y[N_OUTPUTS], dy[N_OUTPUTS];
+		cwfOutputs(param_mat, stepTau(i), DTAU, y, dy);
+		outputsToStates(invT, y, dy, &xd[1], &xd[6]);
+		sink = sink + xd[3];
+	}
+	double cwfTime = (now() - start)/BENCH_CYCLES;
+
+	printf("Largest difference between the paths: %.2e\n", maxPathError);
+	printf("Largest cwfOutputs() rate difference from central differences: %.2e\n", maxCwfError);
+	printf("Per cycle, for %d outputs:\n", N_OUTPUTS);
+	printf("  old path, with pow(): %.1f ns\n", oldTime*1e9);
+	printf("  bezierOutputs():      %.1f ns\n", newTime*1e9);
+	printf("  cwfOutputs():         %.1f ns\n", cwfTime*1e9);
+
+	if (failures) {
+		printf("%d failures\n", failures);
+		return 1;
+	}
+
+	printf("All passed\n");
+	return 0;
+}
+
+// vim: noexpandtab
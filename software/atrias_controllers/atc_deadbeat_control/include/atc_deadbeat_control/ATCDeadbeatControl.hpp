@@ -22,15 +22,12 @@
 #include <asc_rate_limit/ASCRateLimit.hpp>
 
 // Datatypes
-#include <deque>
 #include <robot_invariant_defs.h>
 #include <robot_variant_defs.h>
 #include <atrias_msgs/robot_state.h>
 #include <atrias_shared/controller_structs.h>
 #include <atrias_shared/atrias_parameters.h>
-
-// Functions
-#include <numeric>  // std::accumulate
+#include <atrias_shared/Filters.h>
 
 // Namespaces we're using
 using namespace std;
@@ -39,6 +36,9 @@ using namespace std;
 namespace atrias {
 namespace controller {
 
+// The toe switch history, newest first
+typedef shared::Ring<double, 120> ToeHistory;
+
 class ATCDeadbeatControl : public ATC<
 	atc_deadbeat_control::controller_log_data_,
 	atc_deadbeat_control::controller_input_,
@@ -68,12 +68,12 @@ class ATCDeadbeatControl : public ATC<
         void standingController();
         void shutdownController();
         void stanceController(atrias_msgs::robot_state_leg*, atrias_msgs::robot_state_leg*, atrias_msgs::controller_output_leg*, ASCLegForce*, ASCRateLimit*);
-        void singleSupportEvents(atrias_msgs::robot_state_leg*, atrias_msgs::robot_state_leg*, std::deque<double>*);
+        void singleSupportEvents(atrias_msgs::robot_state_leg*, atrias_msgs::robot_state_leg*, ToeHistory*);
         void legSwingController(atrias_msgs::robot_state_leg*, atrias_msgs::robot_state_leg*, atrias_msgs::controller_output_leg*, ASCPD*, ASCPD*);
         void doubleSupportEvents(atrias_msgs::robot_state_leg*, atrias_msgs::robot_state_leg*, ASCRateLimit*);
         void resetFlightLegParameters(atrias_msgs::robot_state_leg*, ASCRateLimit*);
-        bool detectStance(atrias_msgs::robot_state_leg*, std::deque<double>*);
-        void updateToeFilter(uint16_t, std::deque<double>*);
+        bool detectStance(atrias_msgs::robot_state_leg*, ToeHistory*);
+        void updateToeFilter(uint16_t, ToeHistory*);
 
         /**
          * @brief These are sub controllers used by the top level controller.
@@ -138,8 +138,8 @@ class ATCDeadbeatControl : public ATC<
         bool isForwardStep, isTrigger; // Logical preventing backstepping issues
 
         // Toe switch variables
-        deque<double> rFilteredToe;
-        deque<double> lFilteredToe;
+        ToeHistory rFilteredToe;
+        ToeHistory lFilteredToe;
 
         // Misc margins, ratelimiters and other debug values
         double legRateLimit, hipRateLimit, springRateLimit;
@@ -51,8 +51,8 @@ ATCDeadbeatControl::ATCDeadbeatControl(string name) :
     sPrev = 0.0;
 
     // Initialize toe filter
-    rFilteredToe.assign (120,5000.0);  // 120 doubles with a value of 5000
-    lFilteredToe.assign (120,5000.0);
+    rFilteredToe.fill(5000.0);  // 120 doubles with a value of 5000
+    lFilteredToe.fill(5000.0);
 
 
     PoincareSecUpdateFlag=0; // To check for the right angles
@@ -714,7 +714,7 @@ void ATCDeadbeatControl::legSwingController(atrias_msgs::robot_state_leg *rsSl,
  * This function computes logical conditionals and uses a decision tree
  * to determine if a single support event has been triggered and responds accordingly.
  */
-void ATCDeadbeatControl::singleSupportEvents(atrias_msgs::robot_state_leg *rsSl, atrias_msgs::robot_state_leg *rsFl, std::deque<double>* filteredToe) {
+void ATCDeadbeatControl::singleSupportEvents(atrias_msgs::robot_state_leg *rsSl, atrias_msgs::robot_state_leg *rsFl, ToeHistory* filteredToe) {
     // Compute current stance leg states
     std::tie(qSl, rSl) = ascCommonToolkit.motorPos2LegPos(rsSl->halfA.legAngle, rsSl->halfB.legAngle);
     std::tie(qFl, rFl) = ascCommonToolkit.motorPos2LegPos(rsFl->halfA.legAngle, rsFl->halfB.legAngle);
@@ -818,11 +818,11 @@ void ATCDeadbeatControl::resetFlightLegParameters(atrias_msgs::robot_state_leg *
     qeFm += qb - 3.0*M_PI/2.0;
 } // resetFlightLegParameters
 
-bool ATCDeadbeatControl::detectStance(atrias_msgs::robot_state_leg *rsFl, std::deque<double> *filteredToe)
+bool ATCDeadbeatControl::detectStance(atrias_msgs::robot_state_leg *rsFl, ToeHistory *filteredToe)
 {
     // Touchdown detection
     // Make a baseline by averaging previous values, ignoring the first 20
-    double baseline = accumulate(filteredToe->begin()+20.0, filteredToe->end(), 0.0)/(filteredToe->size()-20.0);
+    double baseline = filteredToe->sum(20, filteredToe->size()-20)/(filteredToe->size()-20.0);
 
     // The threshold for stance is 500 over the baseline reading
     double threshold = 500.0 + baseline;
@@ -836,7 +836,7 @@ bool ATCDeadbeatControl::detectStance(atrias_msgs::robot_state_leg *rsFl, std::d
     return false;
 } // detectStance
 
-void ATCDeadbeatControl::updateToeFilter(uint16_t newToe, std::deque<double> *filteredToe)
+void ATCDeadbeatControl::updateToeFilter(uint16_t newToe, ToeHistory *filteredToe)
 {
     // newToe: New toe measurement
     // filteredToe: A bunch of filtered measurements
@@ -844,25 +844,23 @@ void ATCDeadbeatControl::updateToeFilter(uint16_t newToe, std::deque<double> *fi
 
     // Filter to remove bad data
     // If the data is the maximum or minimum the ADC outputs, ignore it
-    double prevToe = filteredToe->front();
-    if ((newToe == 4095) || (newToe == 0)) {
+    double prevToe = filteredToe->newest();
+    if (shared::adcSaturated(newToe)) {
         toe = prevToe;
     }
 
     // If the data jumps by more than 1500 and we're not starting up, ignore it
-    if ((fabs(prevToe - toe) > 1500.0) && (filteredToe->back() != 5000.0)) {
+    if ((fabs(prevToe - toe) > 1500.0) && (filteredToe->oldest() != 5000.0)) {
         toe = prevToe;
     }
 
     // Rolling average
-    // Remove the oldest value
-    filteredToe->pop_back();
     // Calculate the average of the 3 most recent values
     int nSamples = 3;
-    double average = (accumulate(filteredToe->begin(), filteredToe->begin()+nSamples-1, 0.0) + toe)/((double)nSamples);
+    double average = (filteredToe->sum(0, nSamples-1) + toe)/((double)nSamples);
 
-    // Store it
-    filteredToe->push_front (average);
+    // Store it, dropping the oldest value
+    filteredToe->push(average);
 } // updateToeFilter
 
 ORO_CREATE_COMPONENT(ATCDeadbeatControl)
@@ -144,7 +144,7 @@ void ATCForceControlDemo::controller() {
 			legForce.dfz = 0.0;
 	
 			// Compute and set motor current values
-			std::tie(co.rLeg.motorCurrentA, co.rLeg.motorCurrentB) = ascLegForceR.control(legForce, rs.rLeg, rs.position);
+			std::tie(co.rLeg.motorCurrentA, co.rLeg.motorCurrentB) = ascLegForceR.control(legForce, legKinematics, RIGHT_LEG);
 			break;
 			
 		case 2: // Force control - sinewave
@@ -153,7 +153,7 @@ void ATCForceControlDemo::controller() {
 			std::tie(legForce.fz, legForce.dfz) = sinewave(tR, guiIn.right_offz, guiIn.right_ampz, guiIn.right_freqz);
 			
 			// Compute and set motor current values
-			std::tie(co.rLeg.motorCurrentA, co.rLeg.motorCurrentB) = ascLegForceR.control(legForce, rs.rLeg, rs.position);
+			std::tie(co.rLeg.motorCurrentA, co.rLeg.motorCurrentB) = ascLegForceR.control(legForce, legKinematics, RIGHT_LEG);
 			break;
 		
 		case 3: // Position control - automated stair step
@@ -190,7 +190,7 @@ void ATCForceControlDemo::controller() {
 			}
 				
 			// Compute and set motor current values
-			std::tie(co.rLeg.motorCurrentA, co.rLeg.motorCurrentB) = ascLegForceR.control(legForce, rs.rLeg, rs.position);
+			std::tie(co.rLeg.motorCurrentA, co.rLeg.motorCurrentB) = ascLegForceR.control(legForce, legKinematics, RIGHT_LEG);
 			break;		
 	}
 
@@ -248,8 +248,8 @@ void ATCForceControlDemo::updateState() {
 	k2_11 = k2_22 = k1_11*k1_11;
 
 	// Compute actual leg force from spring deflection
-	ascLegForceL.compute(rs.lLeg, rs.position);
-	ascLegForceR.compute(rs.rLeg, rs.position);
+	ascLegForceL.compute(legKinematics, LEFT_LEG);
+	ascLegForceR.compute(legKinematics, RIGHT_LEG);
 }
 
 
@@ -117,8 +117,8 @@ void ATCSlipHopping::updateController() {
 
     // Compute the leg component forces from current spring deflection and
     // leg configuration.
-    ascLegForceL.compute(rs.lLeg, rs.position);
-    ascLegForceR.compute(rs.rLeg, rs.position);
+    ascLegForceL.compute(legKinematics, LEFT_LEG);
+    ascLegForceR.compute(legKinematics, RIGHT_LEG);
 }
 
 
@@ -402,8 +402,8 @@ void ATCSlipHopping::stanceEvents() {
 
     // Compute the leg component forces from current spring deflection and
     // leg configuration
-    forceL = ascLegForceL.compute(rs.lLeg, rs.position);
-    forceR = ascLegForceR.compute(rs.rLeg, rs.position);
+    forceL = ascLegForceL.compute(legKinematics, LEFT_LEG);
+    forceR = ascLegForceR.compute(legKinematics, RIGHT_LEG);
 
     // Compute logical conditionals for event triggers
     isLeftLegTO = (forceL.fz >= -forceThresholdTO);
@@ -429,8 +429,8 @@ void ATCSlipHopping::ballisticEvents() {
 
     // Compute the leg component forces from current spring deflection and
     // leg configuration.
-    forceL = ascLegForceL.compute(rs.lLeg, rs.position);
-    forceR = ascLegForceR.compute(rs.rLeg, rs.position);
+    forceL = ascLegForceL.compute(legKinematics, LEFT_LEG);
+    forceR = ascLegForceR.compute(legKinematics, RIGHT_LEG);
 
     // Compute logical conditionals for event triggers
     isLeftLegTD = (forceL.fz <= -forceThresholdTD) && (rLl*sin(qLl) >= rs.position.zPosition - positionThresholdTD);
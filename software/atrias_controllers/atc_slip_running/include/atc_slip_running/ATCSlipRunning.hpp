@@ -27,6 +27,7 @@
 #include <asc_common_toolkit/ASCCommonToolkit.hpp>
 #include <asc_interpolation/ASCInterpolation.hpp>
 #include <asc_slip_model/ASCSlipModel.hpp>
+#include <asc_gait_table/ASCGaitTable.hpp>
 #include <asc_leg_force/ASCLegForce.hpp>
 #include <asc_hip_boom_kinematics/ASCHipBoomKinematics.hpp>
 #include <asc_pd/ASCPD.hpp>
@@ -36,6 +37,7 @@
 #include <atrias_msgs/robot_state.h>
 #include <atrias_shared/controller_structs.h>
 #include <atrias_shared/atrias_parameters.h>
+#include <atrias_shared/Mailbox.h>
 
 // Namespaces we're using
 using namespace std;
@@ -45,6 +47,34 @@ using namespace atc_slip_running;
 namespace atrias {
 namespace controller {
 
+// How often the online gait solve runs, when there's no gait table (seconds)
+#define GAIT_PLANNER_PERIOD 0.01
+
+// How far the flight state may be from the state an online gait solution
+// was solved for, and the solution still be used. Each cycle of falling
+// changes dz by about 0.01 m/s.
+#define GAIT_PLAN_MAX_DX 0.1  // m/s
+#define GAIT_PLAN_MAX_DZ 0.25 // m/s
+#define GAIT_PLAN_MAX_DR 0.02 // m
+
+/**
+  * @brief The state the online gait solve is run for.
+  */
+struct GaitRequest {
+	double dx, dz; // The velocity at touchdown
+	double r;      // The touchdown leg length
+	double k, m;   // The SLIP model's stiffness and mass
+};
+
+/**
+  * @brief An online gait solution.
+  */
+struct GaitPlan {
+	GaitRequest request;    // The state it solves
+	double      q;          // The equilibrium touchdown leg angle, as the SLIP model measures it
+	double      dqdz, dqdr; // Its derivatives in the vertical velocity and leg length
+};
+
 /* Our class definition. We subclass ATC for a top-level controller.
  * If we don't need a data type (such as the controller-to-gui message),
  * we simply leave that spot in the template blank. The following example
@@ -103,7 +133,17 @@ class ATCSlipRunning : public ATC<atc_slip_running::controller_log_data_, contro
 		void leftLegFlightFalling();
 		void leftLegStance();
 		void rightLegFlightRising();
-		double equilibriumGaitSolver(double vx, double va, double r);
+
+		/**
+		  * @brief Finds the equilibrium gait touchdown leg angle, in the
+		  * robot's convention, and its rate while falling toward touchdown.
+		  */
+		std::tuple<double, double> equilibriumGaitSolver(double dx, double dz, double r, double dr);
+
+		/**
+		  * @brief Solves the latest gait request. Runs in gaitPlanner's thread.
+		  */
+		void planGait();
 		
 
 		/**
@@ -112,6 +152,7 @@ class ATCSlipRunning : public ATC<atc_slip_running::controller_log_data_, contro
   		ASCCommonToolkit ascCommonToolkit;
   		ASCInterpolation ascInterpolation;
 		ASCSlipModel ascSlipModel;
+		ASCGaitTable ascGaitTable;
 		ASCLegForce ascLegForceLl;
 		ASCLegForce ascLegForceRl;
 		ASCHipBoomKinematics ascHipBoomKinematics;
@@ -154,11 +195,19 @@ class ATCSlipRunning : public ATC<atc_slip_running::controller_log_data_, contro
 		// Leg cartesian lengths for ground triggers
 		double xRl, zRl, xLl, zLl;
 		
-		// Equilibrium gait curve fit
-		double b[55];
+		// Equilibrium gait solution
 		double q, dq;
 				
 		double k, dk;
+
+		// The online gait solve, off the control thread: the flight
+		// controller posts requests, and uses the latest recent plan.
+		shared::Mailbox<GaitRequest> gaitRequests;
+		shared::Mailbox<GaitPlan> gaitPlans;
+		SlipPredictor gaitPredictor;
+
+		// Declared last, so it's stopped before anything it uses is destroyed
+		SlowTask gaitPlanner;
 };
 
 }
@@ -16,6 +16,7 @@ ATCSlipRunning::ATCSlipRunning(string name) :
 	ascCommonToolkit(this, "ascCommonToolkit"),
 	ascInterpolation(this, "ascInterpolation"),
 	ascSlipModel(this, "ascSlipModel"),
+	ascGaitTable(this, "ascGaitTable"),
 	ascLegForceLl(this, "ascLegForceLl"),
 	ascLegForceRl(this, "ascLegForceRl"),
 	ascHipBoomKinematics(this, "ascHipBoomKinematics"),
@@ -28,7 +29,8 @@ ATCSlipRunning::ATCSlipRunning(string name) :
 	ascRateLimitLmA(this, "ascRateLimitLmA"),
 	ascRateLimitLmB(this, "ascRateLimitLmB"),
 	ascRateLimitRmA(this, "ascRateLimitRmA"),
-	ascRateLimitRmB(this, "ascRateLimitRmB")
+	ascRateLimitRmB(this, "ascRateLimitRmB"),
+	gaitPlanner("gaitPlanner", GAIT_PLANNER_PERIOD, boost::bind(&ATCSlipRunning::planGait, this))
 {
 	// Set leg motor rate limit
 	legRateLimit = 1.0;
@@ -36,6 +38,14 @@ ATCSlipRunning::ATCSlipRunning(string name) :
 	// Set hip controller toe positions
 	toePosition.left = 2.15;
 	toePosition.right = 2.45;
+
+	// Let a precomputed gait table be loaded from the deployer
+	this->provides("gaitTable")
+		->addOperation("loadGaitTable", &ASCGaitTable::load, &ascGaitTable, RTT::ClientThread)
+		.doc("Map a gait table generated by gen_gait_table. Gaits are solved online until one is loaded, or while the SLIP model differs from the table's.");
+
+	// Without a table, gaits are solved by the planner
+	addSlowTask(gaitPlanner);
 }
 
 
@@ -103,7 +113,7 @@ void ATCSlipRunning::controller() {
 						std::tie(qRl1, rRl1) = ascCommonToolkit.motorPos2LegPos(rs.rLeg.halfA.legAngle, rs.rLeg.halfB.legAngle);
 						std::tie(dqLl1, drLl1) = ascCommonToolkit.motorVel2LegVel(rs.lLeg.halfA.legAngle, rs.lLeg.halfB.legAngle, rs.lLeg.halfA.legVelocity, rs.lLeg.halfB.legVelocity);
 						std::tie(dqRl1, drRl1) = ascCommonToolkit.motorVel2LegVel(rs.rLeg.halfA.legAngle, rs.rLeg.halfB.legAngle, rs.rLeg.halfA.legVelocity, rs.rLeg.halfB.legVelocity);											
-						qLl2 = equilibriumGaitSolver(rs.position,xVelocity, rs.position,zVelocity, rLl1);
+						qLl2 = std::get<0>(equilibriumGaitSolver(rs.position.xVelocity, rs.position.zVelocity, rLl1, 0.0));
 						dqLl2 = 0.0;
 						
 						rLl2 = 0.75;
@@ -262,8 +272,7 @@ void ATCSlipRunning::rightLegFlightFalling() {
 		rRl = clamp(rRl, 0.5, 0.95);
 	
 		// Compute leg angle to give equalibrium gait
-		qRl = equilibriumGaitSolver(rs.position.xVelocity, rs.position.zVelocity, rRl);
-		dqRl = 0.0; // TODO: need to add lookup value in gait solver for velocity.
+		std::tie(qRl, dqRl) = equilibriumGaitSolver(rs.position.xVelocity, rs.position.zVelocity, rRl, drRl);
 
 		// Set leg motor angles
 		std::tie(qRmA, qRmB) = ascCommonToolkit.legPos2MotorPos(qRl, rRl);
@@ -322,7 +331,7 @@ void ATCSlipRunning::rightLegStance() {
 			qRmB = rs.rLeg.halfB.legAngle;
 
 			// Compute and set motor currents
-			std::tie(co.rLeg.motorCurrentA, co.rLeg.motorCurrentB) = ascLegForceRl.control(legForce, rs.rLeg, rs.position);
+			std::tie(co.rLeg.motorCurrentA, co.rLeg.motorCurrentB) = ascLegForceRl.control(legForce, legKinematics, RIGHT_LEG);
 
 		}
 
@@ -416,75 +425,72 @@ void ATCSlipRunning::rightLegFlightRising() {
 }
 
 
-double ATCSlipRunnig::equilibriumGaitSolver(double dx, double dz, double r0) {
-
-	b[0] = -7.213440413060714;
-	b[1] = 3.468798283842735E1;
-	b[2] = -3.266444726973395E1;
-	b[3] = -2.702469175556414E1;
-	b[4] = 5.780176026187765E1;
-	b[5] = -2.403672244571941E1;
-	b[6] = -4.515544770572114;
-	b[7] = 2.791907849832265E1;
-	b[8] = -5.826582192003637E1;
-	b[9] = 5.116132452827277E1;
-	b[10] = -1.628190619067855E1;
-	b[11] = 1.004520907772565;
-	b[12] = -2.734630129003093;
-	b[13] = 2.439719593593622;
-	b[14] = -6.768833584634145E-1;
-	b[15] = 7.319350216643417E-2;
-	b[16] = -1.692287640834765E-1;
-	b[17] = 1.073350427329765E-1;
-	b[18] = -2.378847271765413E-3;
-	b[19] = 3.589351794506902E-3;
-	b[20] = 1.848047074272373E-5;
-	b[21] = 7.724980660436322;
-	b[22] = -3.439729952637526E1;
-	b[23] = 5.913089242725211E1;
-	b[24] = -4.47845055059484E1;
-	b[25] = 1.239865396732889E1;
-	b[26] = 8.280999797829944E-2;
-	b[27] = -1.063607081263741;
-	b[28] = 2.06342756269128;
-	b[29] = -1.060098804785176;
-	b[30] = -1.464456757236583E-1;
-	b[31] = 2.261792541244291E-1;
-	b[32] = -6.401309879432286E-2;
-	b[33] = -1.308951787975762E-2;
-	b[34] = 1.463995370269994E-2;
-	b[35] = -2.66004349934331E-5;
-	b[36] = -2.204247217557561E-1;
-	b[37] = 5.585818255173174E-1;
-	b[38] = -6.761674427762996E-1;
-	b[39] = 3.172038249573401E-1;
-	b[40] = -1.384541440998458E-2;
-	b[41] = -2.396643759197579E-2;
-	b[42] = 1.575640956987011E-2;
-	b[43] = 1.130596092328483E-3;
-	b[44] = -5.056850385043376E-3;
-	b[45] = -6.911746916972324E-5;
-	b[46] = 7.614291839129032E-3;
-	b[47] = -2.274979808651478E-3;
-	b[48] = -3.210690228678975E-3;
-	b[49] = 3.100649534001704E-3;
-	b[50] = -8.041932324654042E-4;
-	b[51] = 2.487263753304149E-4;
-	b[52] = -1.922449704847737E-4;
-	b[53] = 1.864365446186798E-4;
-	b[54] = -7.304085547540021E-5;
-	b[55] = -5.26651489998567E-6;
-  
-	// Curve fit of equilibrium gait solution for ATRIAS
-	q = b[1] + b[22]*dx + b[7]*dz + b[2]*r0 + b[37]*(dx*dx) + b[47]*(dx*dx*dx) + b[53]*(dx*dx*dx*dx) + b[56]*(dx*dx*dx*dx*dx) + b[12]*(dz*dz) + b[16]*(dz*dz*dz) + b[19]*(dz*dz*dz*dz) + b[21]*(dz*dz*dz*dz*dz) + b[3]*(r0*r0) + b[4]*(r0*r0*r0) + b[5]*(r0*r0*r0*r0) + b[6]*(r0*r0*r0*r0*r0) + b[44]*(dx*dx)*(dz*dz) + b[46]*(dx*dx)*(dz*dz*dz) + b[52]*(dx*dx*dx)*(dz*dz) + b[39]*(dx*dx)*(r0*r0) + b[40]*(dx*dx)*(r0*r0*r0) + b[49]*(dx*dx*dx)*(r0*r0) + b[14]*(dz*dz)*(r0*r0) + b[15]*(dz*dz)*(r0*r0*r0) + b[18]*(dz*dz*dz)*(r0*r0) + b[27]*dx*dz + b[23]*dx*r0 + b[8]*dz*r0 + b[31]*dx*(dz*dz) + b[34]*dx*(dz*dz*dz) + b[36]*dx*(dz*dz*dz*dz) + b[41]*(dx*dx)*dz + b[50]*(dx*dx*dx)*dz + b[55]*(dx*dx*dx*dx)*dz + b[24]*dx*(r0*r0) + b[25]*dx*(r0*r0*r0) + b[26]*dx*(r0*r0*r0*r0) + b[38]*(dx*dx)*r0 + b[48]*(dx*dx*dx)*r0 + b[54]*(dx*dx*dx*dx)*r0 + b[9]*dz*(r0*r0) + b[10]*dz*(r0*r0*r0) + b[11]*dz*(r0*r0*r0*r0) + b[13]*(dz*dz)*r0 + b[17]*(dz*dz*dz)*r0 + b[20]*(dz*dz*dz*dz)*r0 + b[29]*dx*dz*(r0*r0) + b[30]*dx*dz*(r0*r0*r0) + b[32]*dx*(dz*dz)*r0 + b[35]*dx*(dz*dz*dz)*r0 + b[42]*(dx*dx)*dz*r0 + b[51]*(dx*dx*dx)*dz*r0 + b[33]*dx*(dz*dz)*(r0*r0) + b[43]*(dx*dx)*dz*(r0*r0) + b[45]*(dx*dx)*(dz*dz)*r0 + b[28]*dx*dz*r0;
+std::tuple<double, double> ATCSlipRunning::equilibriumGaitSolver(double dx, double dz, double r, double dr) {
+
+	// Look the gait up if we have a table for this SLIP model
+	if (ascGaitTable.matches(ascSlipModel.k, ascSlipModel.m)) {
+		std::tie(q, dq) = ascGaitTable.equilibriumAngle(dx, dz, r, dr);
+	} else {
+		// Otherwise ask the planner to solve for the equilibrium gait touchdown
+		// angle at this state
+		GaitRequest &request = gaitRequests.writeSlot();
+		request.dx = dx;
+		request.dz = dz;
+		request.r  = r;
+		request.k  = ascSlipModel.k;
+		request.m  = ascSlipModel.m;
+		gaitRequests.publish();
+
+		// Use its latest solution if it was solved for a state near this one,
+		// corrected to this one with its derivatives. Plans are matched by
+		// state, not time, as the controller time is only kept on the robot.
+		// If there's no such plan (such as on the first cycles of a flight
+		// phase), estimate it here; a full solve takes too long for the
+		// control loop.
+		double dqdz, dqdr;
+		gaitPlans.update();
+		const GaitPlan &plan = gaitPlans.read();
+		if (gaitPlans.hasValue() &&
+		    plan.request.k == ascSlipModel.k && plan.request.m == ascSlipModel.m &&
+		    fabs(dx - plan.request.dx) <= GAIT_PLAN_MAX_DX &&
+		    fabs(dz - plan.request.dz) <= GAIT_PLAN_MAX_DZ &&
+		    fabs(r - plan.request.r) <= GAIT_PLAN_MAX_DR)
+		{
+			q    = plan.q + plan.dqdz*(dz - plan.request.dz) + plan.dqdr*(r - plan.request.r);
+			dqdz = plan.dqdz;
+			dqdr = plan.dqdr;
+		} else {
+			double slipLeg = ascSlipModel.r0;
+			ascSlipModel.r0 = r;
+			ascSlipModel.neutralGait(dx, q, dqdz, dqdr);
+			ascSlipModel.r0 = slipLeg;
+		}
+
+		// While falling, dz changes at -g
+		dq = -G*dqdz + dqdr*dr;
+	}
+
+	// Return our output command. The SLIP model measures the leg angle
+	// from the other side (robot = pi - simulation).
+	return std::make_tuple(PI - q, -dq);
+
+}
+
 
-	// TODO: Probably don't need immediately but velocity will increase tracking performance
-	dq = 0;
+void ATCSlipRunning::planGait() {
+	// Nothing to do unless the flight controller has asked
+	if (!gaitRequests.update())
+		return;
 
-	// Return our output command
-	// return std::make_tuple(q, dq);
-	return q;	// FIXME robot angles are defined differnetly than simulation (robot = pi - simulation)
+	const GaitRequest &request = gaitRequests.read();
+	gaitPredictor.k  = request.k;
+	gaitPredictor.m  = request.m;
+	gaitPredictor.r0 = request.r;
 
+	GaitPlan &plan = gaitPlans.writeSlot();
+	plan.request = request;
+	gaitPredictor.equilibriumGait(request.dx, request.dz, plan.q, plan.dqdz, plan.dqdr);
+	gaitPlans.publish();
 }
 
 
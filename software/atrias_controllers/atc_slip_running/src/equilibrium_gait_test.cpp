@@ -0,0 +1,153 @@
+/** @file
+  * @brief Checks the online equilibrium gait solve that
+  * ATCSlipRunning::equilibriumGaitSolver() falls back on when there's no gait
+  * table, against the curve fit it replaced.
+  *
+  * Both give the SLIP model's angle, which the solver converts to the
+  * robot's (robot = pi - simulation); the angles printed are the robot's.
+  * The angle's derivatives, which give the rate the solver commands while
+  * falling, are checked against differences over half the step.
+  *
+  * Exits with a nonzero status if a check fails.
+  */
+
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+
+#include "asc_slip_model/SlipPredictor.hpp"
+
+using namespace atrias::controller;
+
+// The states checked: touchdown velocities and leg lengths the fit covers
+#define TEST_DX_MIN   0.5
+#define TEST_DX_MAX   3.0
+#define TEST_DZ_MIN  -2.0
+#define TEST_DZ_MAX  -0.5
+#define TEST_R_MIN    0.8
+#define TEST_R_MAX    0.9
+#define TEST_STEPS    6
+
+// How far the solve may be from the fit (radians). They're within 0.08 up
+// to 1.5 m/s; faster, the fit leans the leg further forward.
+#define FIT_TOLERANCE 0.2
+
+// How far the derivatives may be from those over half the step
+#define DQDZ_TOLERANCE 0.01 // rad/(m/s)
+#define DQDR_TOLERANCE 0.05 // rad/m
+
+/**
+  * @brief The curve fit ATCSlipRunning used before the online solve. Like
+  * the solve, it gives the SLIP model's angle. Its coefficients were
+  * exported counting from 1, but ATCSlipRunning stored them from 0, so each
+  * term used its neighbour's (and b[56] was past the end). They're counted
+  * from 1 here.
+  */
+static double fitAngle(double dx, double dz, double r0) {
+	static const double b[57] = {0.0,
+		-7.213440413060714, 3.468798283842735E1, -3.266444726973395E1, -2.702469175556414E1,
+		5.780176026187765E1, -2.403672244571941E1, -4.515544770572114, 2.791907849832265E1,
+		-5.826582192003637E1, 5.116132452827277E1, -1.628190619067855E1, 1.004520907772565,
+		-2.734630129003093, 2.439719593593622, -6.768833584634145E-1, 7.319350216643417E-2,
+		-1.692287640834765E-1, 1.073350427329765E-1, -2.378847271765413E-3, 3.589351794506902E-3,
+		1.848047074272373E-5, 7.724980660436322, -3.439729952637526E1, 5.913089242725211E1,
+		-4.47845055059484E1, 1.239865396732889E1, 8.280999797829944E-2, -1.063607081263741,
+		2.06342756269128, -1.060098804785176, -1.464456757236583E-1, 2.261792541244291E-1,
+		-6.401309879432286E-2, -1.308951787975762E-2, 1.463995370269994E-2, -2.66004349934331E-5,
+		-2.204247217557561E-1, 5.585818255173174E-1, -6.761674427762996E-1, 3.172038249573401E-1,
+		-1.384541440998458E-2, -2.396643759197579E-2, 1.575640956987011E-2, 1.130596092328483E-3,
+		-5.056850385043376E-3, -6.911746916972324E-5, 7.614291839129032E-3, -2.274979808651478E-3,
+		-3.210690228678975E-3, 3.100649534001704E-3, -8.041932324654042E-4, 2.487263753304149E-4,
+		-1.922449704847737E-4, 1.864365446186798E-4, -7.304085547540021E-5, -5.26651489998567E-6};
+
+	return b[1] + b[22]*dx + b[7]*dz + b[2]*r0 + b[37]*(dx*dx) + b[47]*(dx*dx*dx) + b[53]*(dx*dx*dx*dx) + b[56]*(dx*dx*dx*dx*dx) + b[12]*(dz*dz) + b[16]*(dz*dz*dz) + b[19]*(dz*dz*dz*dz) + b[21]*(dz*dz*dz*dz*dz) + b[3]*(r0*r0) + b[4]*(r0*r0*r0) + b[5]*(r0*r0*r0*r0) + b[6]*(r0*r0*r0*r0*r0) + b[44]*(dx*dx)*(dz*dz) + b[46]*(dx*dx)*(dz*dz*dz) + b[52]*(dx*dx*dx)*(dz*dz) + b[39]*(dx*dx)*(r0*r0) + b[40]*(dx*dx)*(r0*r0*r0) + b[49]*(dx*dx*dx)*(r0*r0) + b[14]*(dz*dz)*(r0*r0) + b[15]*(dz*dz)*(r0*r0*r0) + b[18]*(dz*dz*dz)*(r0*r0) + b[27]*dx*dz + b[23]*dx*r0 + b[8]*dz*r0 + b[31]*dx*(dz*dz) + b[34]*dx*(dz*dz*dz) + b[36]*dx*(dz*dz*dz*dz) + b[41]*(dx*dx)*dz + b[50]*(dx*dx*dx)*dz + b[55]*(dx*dx*dx*dx)*dz + b[24]*dx*(r0*r0) + b[25]*dx*(r0*r0*r0) + b[26]*dx*(r0*r0*r0*r0) + b[38]*(dx*dx)*r0 + b[48]*(dx*dx*dx)*r0 + b[54]*(dx*dx*dx*dx)*r0 + b[9]*dz*(r0*r0) + b[10]*dz*(r0*r0*r0) + b[11]*dz*(r0*r0*r0*r0) + b[13]*(dz*dz)*r0 + b[17]*(dz*dz*dz)*r0 + b[20]*(dz*dz*dz*dz)*r0 + b[29]*dx*dz*(r0*r0) + b[30]*dx*dz*(r0*r0*r0) + b[32]*dx*(dz*dz)*r0 + b[35]*dx*(dz*dz*dz)*r0 + b[42]*(dx*dx)*dz*r0 + b[51]*(dx*dx*dx)*dz*r0 + b[33]*dx*(dz*dz)*(r0*r0) + b[43]*(dx*dx)*dz*(r0*r0) + b[45]*(dx*dx)*(dz*dz)*r0 + b[28]*dx*dz*r0;
+}
+
+static double now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main() {
+	SlipPredictor predictor;
+	int failures = 0;
+
+	// The point the fit was checked at by hand
+	predictor.r0 = 0.85;
+	printf("At dx = 1, dz = -1, r = 0.85: solve %.4f, fit %.4f\n",
+	       PI - predictor.equilibriumAngle(1.0, -1.0), PI - fitAngle(1.0, -1.0, 0.85));
+
+	double maxFitError = 0.0;
+	double maxDzError  = 0.0;
+	double maxRError   = 0.0;
+	double totalTime   = 0.0;
+	int    solves      = 0;
+	for (int ix = 0; ix < TEST_STEPS; ix++) {
+		for (int iz = 0; iz < TEST_STEPS; iz++) {
+			for (int ir = 0; ir < TEST_STEPS; ir++) {
+				double dx = TEST_DX_MIN + (TEST_DX_MAX - TEST_DX_MIN) * ix / (TEST_STEPS - 1);
+				double dz = TEST_DZ_MIN + (TEST_DZ_MAX - TEST_DZ_MIN) * iz / (TEST_STEPS - 1);
+				double r  = TEST_R_MIN  + (TEST_R_MAX  - TEST_R_MIN)  * ir / (TEST_STEPS - 1);
+
+				double q, dqdz, dqdr;
+				predictor.r0 = r;
+				double start = now();
+				predictor.equilibriumGait(dx, dz, q, dqdz, dqdr);
+				totalTime += now() - start;
+				solves++;
+
+				// Running forward, the robot's leg reaches forward of vertical
+				if (PI - q >= PI/2.0) {
+					printf("FAIL: dx = %g, dz = %g, r = %g: the leg leans back (%.4f)\n", dx, dz, r, PI - q);
+					failures++;
+				}
+
+				double fitError = fabs(q - fitAngle(dx, dz, r));
+				if (fitError > maxFitError)
+					maxFitError = fitError;
+				if (fitError > FIT_TOLERANCE) {
+					printf("FAIL: dx = %g, dz = %g, r = %g: solve %.4f, fit %.4f\n",
+					       dx, dz, r, PI - q, PI - fitAngle(dx, dz, r));
+					failures++;
+				}
+
+				// The same differences over half the step
+				double halfDqdz = (predictor.equilibriumAngle(dx, dz + SLIP_EQUILIBRIUM_DZ_STEP/2.0) -
+				                   predictor.equilibriumAngle(dx, dz - SLIP_EQUILIBRIUM_DZ_STEP/2.0)) / SLIP_EQUILIBRIUM_DZ_STEP;
+				predictor.r0 = r + SLIP_EQUILIBRIUM_R_STEP/2.0;
+				double halfDqdr = predictor.equilibriumAngle(dx, dz);
+				predictor.r0 = r - SLIP_EQUILIBRIUM_R_STEP/2.0;
+				halfDqdr = (halfDqdr - predictor.equilibriumAngle(dx, dz)) / SLIP_EQUILIBRIUM_R_STEP;
+
+				double dzError = fabs(dqdz - halfDqdz);
+				double rError  = fabs(dqdr - halfDqdr);
+				if (dzError > maxDzError)
+					maxDzError = dzError;
+				if (rError > maxRError)
+					maxRError = rError;
+				if (dzError > DQDZ_TOLERANCE || rError > DQDR_TOLERANCE) {
+					printf("FAIL: dx = %g, dz = %g, r = %g: dq/dz %.4f (%.4f over half the step), dq/dr %.4f (%.4f)\n",
+					       dx, dz, r, dqdz, halfDqdz, dqdr, halfDqdr);
+					failures++;
+				}
+			}
+		}
+	}
+
+	printf("Over %d states:\n", solves);
+	printf("  largest difference from the fit: %.4f rad\n", maxFitError);
+	printf("  largest dq/dz change over half the step: %.4f rad/(m/s)\n", maxDzError);
+	printf("  largest dq/dr change over half the step: %.4f rad/m\n", maxRError);
+	printf("  equilibriumGait(): %.1f us\n", totalTime / solves * 1e6);
+
+	if (failures) {
+		printf("%d failures\n", failures);
+		return 1;
+	}
+
+	printf("All passed\n");
+	return 0;
+}
+
+// vim: noexpandtab
@@ -29,15 +29,12 @@
 #include <asc_rate_limit/ASCRateLimit.hpp>
 
 // Datatypes
-#include <deque>
 #include <robot_invariant_defs.h>
 #include <robot_variant_defs.h>
 #include <atrias_msgs/robot_state.h>
 #include <atrias_shared/controller_structs.h>
 #include <atrias_shared/atrias_parameters.h>
-
-// Functions
-#include <numeric>  // std::accumulate
+#include <atrias_shared/Filters.h>
 
 // Namespaces we're using
 using namespace std;
@@ -46,6 +43,9 @@ using namespace std;
 namespace atrias {
 namespace controller {
 
+// The toe switch history, newest first
+typedef shared::Ring<double, 120> ToeHistory;
+
 class ATCSlipWalking : public ATC<
     atc_slip_walking::controller_log_data_,
     atc_slip_walking::controller_input_,
@@ -73,12 +73,12 @@ class ATCSlipWalking : public ATC<
         void standingController();
         void shutdownController();
         void stanceController(atrias_msgs::robot_state_leg*, atrias_msgs::controller_output_leg*, ASCLegForce*, ASCRateLimit*);
-        void singleSupportEvents(atrias_msgs::robot_state_leg*, atrias_msgs::robot_state_leg*, std::deque<double>*);
+        void singleSupportEvents(atrias_msgs::robot_state_leg*, atrias_msgs::robot_state_leg*, ToeHistory*);
         void legSwingController(atrias_msgs::robot_state_leg*, atrias_msgs::robot_state_leg*, atrias_msgs::controller_output_leg*, ASCPD*, ASCPD*);
         void doubleSupportEvents(atrias_msgs::robot_state_leg*, atrias_msgs::robot_state_leg*, ASCRateLimit*);
         void resetFlightLegParameters(atrias_msgs::robot_state_leg*, ASCRateLimit*);
-        bool detectStance(atrias_msgs::robot_state_leg*, std::deque<double>*);
-        void updateToeFilter(uint16_t, std::deque<double>*);
+        bool detectStance(atrias_msgs::robot_state_leg*, ToeHistory*);
+        void updateToeFilter(uint16_t, ToeHistory*);
         std::tuple<double, double> legForceControl(LegForce, atrias_msgs::robot_state_leg, atrias_msgs::robot_state_location);
 
         /**
@@ -140,8 +140,8 @@ class ATCSlipWalking : public ATC<
         bool isForwardStep, isTrigger; // Logical preventing backstepping issues
 
         // Toe switch variables
-        deque<double> rFilteredToe;
-        deque<double> lFilteredToe;
+        ToeHistory rFilteredToe;
+        ToeHistory lFilteredToe;
 
         // Misc margins, ratelimiters and other debug values
         double legRateLimit, hipRateLimit, springRateLimit;
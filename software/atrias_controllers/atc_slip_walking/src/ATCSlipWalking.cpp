@@ -49,8 +49,8 @@ ATCSlipWalking::ATCSlipWalking(string name) :
     sPrev = 0.0;
 
     // Initialize toe filter
-    rFilteredToe.assign (120,5000.0);  // 120 doubles with a value of 5000
-    lFilteredToe.assign (120,5000.0);
+    rFilteredToe.fill(5000.0);  // 120 doubles with a value of 5000
+    lFilteredToe.fill(5000.0);
 }
 
 /**
@@ -498,7 +498,7 @@ void ATCSlipWalking::legSwingController(atrias_msgs::robot_state_leg *rsSl, atri
  * This function computes logical conditionals and uses a decision tree
  * to determine if a single support event has been triggered and responds accordingly.
  */
-void ATCSlipWalking::singleSupportEvents(atrias_msgs::robot_state_leg *rsSl, atrias_msgs::robot_state_leg *rsFl, std::deque<double>* filteredToe) {
+void ATCSlipWalking::singleSupportEvents(atrias_msgs::robot_state_leg *rsSl, atrias_msgs::robot_state_leg *rsFl, ToeHistory* filteredToe) {
     // Compute current stance leg states
     std::tie(qSl, rSl) = ascCommonToolkit.motorPos2LegPos(rsSl->halfA.legAngle, rsSl->halfB.legAngle);
     std::tie(qFl, rFl) = ascCommonToolkit.motorPos2LegPos(rsFl->halfA.legAngle, rsFl->halfB.legAngle);
@@ -602,11 +602,11 @@ void ATCSlipWalking::resetFlightLegParameters(atrias_msgs::robot_state_leg *rsFl
     qeFm += qb - 3.0*M_PI/2.0;
 } // resetFlightLegParameters
 
-bool ATCSlipWalking::detectStance(atrias_msgs::robot_state_leg *rsFl, std::deque<double> *filteredToe)
+bool ATCSlipWalking::detectStance(atrias_msgs::robot_state_leg *rsFl, ToeHistory *filteredToe)
 {
     // Touchdown detection
     // Make a baseline by averaging previous values, ignoring the first 20
-    double baseline = accumulate(filteredToe->begin()+20.0, filteredToe->end(), 0.0)/(filteredToe->size()-20.0);
+    double baseline = filteredToe->sum(20, filteredToe->size()-20)/(filteredToe->size()-20.0);
 
     // The threshold for stance is 600 over the baseline reading
     double threshold = 600.0 + baseline;
@@ -620,7 +620,7 @@ bool ATCSlipWalking::detectStance(atrias_msgs::robot_state_leg *rsFl, std::deque
     return false;
 } // detectStance
 
-void ATCSlipWalking::updateToeFilter(uint16_t newToe, std::deque<double> *filteredToe)
+void ATCSlipWalking::updateToeFilter(uint16_t newToe, ToeHistory *filteredToe)
 {
     // newToe: New toe measurement
     // filteredToe: A bunch of filtered measurements
@@ -628,25 +628,23 @@ void ATCSlipWalking::updateToeFilter(uint16_t newToe, std::deque<double> *filter
 
     // Filter to remove bad data
     // If the data is the maximum or minimum the ADC outputs, ignore it
-    double prevToe = filteredToe->front();
-    if ((newToe == 4095) || (newToe == 0)) {
+    double prevToe = filteredToe->newest();
+    if (shared::adcSaturated(newToe)) {
         toe = prevToe;
     }
 
     // If the data jumps by more than 1500 and we're not starting up, ignore it
-    if ((fabs(prevToe - toe) > 1500.0) && (filteredToe->back() != 5000.0)) {
+    if ((fabs(prevToe - toe) > 1500.0) && (filteredToe->oldest() != 5000.0)) {
         toe = prevToe;
     }
 
     // Rolling average
-    // Remove the oldest value
-    filteredToe->pop_back();
     // Calculate the average of the 3 most recent values
     int nSamples = 3;
-    double average = (accumulate(filteredToe->begin(), filteredToe->begin()+nSamples-1, 0.0) + toe)/((double)nSamples);
+    double average = (filteredToe->sum(0, nSamples-1) + toe)/((double)nSamples);
 
-    // Store it
-    filteredToe->push_front (average);
+    // Store it, dropping the oldest value
+    filteredToe->push(average);
 } // updateToeFilter
 
 std::tuple<double, double> ATCSlipWalking::legForceControl(LegForce legForce, atrias_msgs::robot_state_leg leg, atrias_msgs::robot_state_location position) {
@@ -3,15 +3,34 @@
 
 /** @file
   * @brief This is the main class for the C++-based simulation connector.
+  *
+  * Normally this runs from a 1 kHz periodic activity, like the robot. With
+  * \a batchCycles set, it instead runs that many cycles in lockstep with
+  * RT Ops and the controller, as fast as they'll go, for sweeping controller
+  * parameters (see scripts/csim_sweep.py).
+  *
+  * By default the motors are simulated alone, optionally with a point-mass
+  * body bouncing on the legs. With \a bipedModel set, the whole planar biped
+  * is simulated instead, by atrias_biped_sim.
   */
 
+#include <stdint.h>
+#include <stdio.h>
+
+#include <string>
+
 // Orocos
 #include <rtt/TaskContext.hpp>
 #include <rtt/Component.hpp>
 #include <rtt/OperationCaller.hpp>
+#include <rtt/OutputPort.hpp>
+#include <rtt/os/Semaphore.hpp>
+#include <rtt/os/TimeService.hpp>
 
+#include <atrias_biped_sim/BipedSim.h>
 #include <atrias_msgs/robot_state.h>
 #include <atrias_msgs/controller_output.h>
+#include <atrias_shared/controller_structs.h>
 #include <atrias_shared/globals.h>
 #include <robot_invariant_defs.h>
 
@@ -40,6 +59,28 @@
   */
 #define LEG_FRICTION_AMPS 5.0
 
+/** @brief The body's height when the stance model starts (meters), by default.
+  */
+#define SIM_INITIAL_HEIGHT 0.9
+
+/** @brief Below this height (meters) the robot is counted as having fallen.
+  */
+#define SIM_FALL_HEIGHT 0.3
+
+/** @brief How long we wait for RT Ops to act on a state change (nanoseconds).
+  */
+#define SIM_STATE_CHANGE_TIMEOUT_NS 1000000000LL
+
+/** @brief How long a batch run waits for the controller's output before
+  * giving up on the run (nanoseconds).
+  */
+#define SIM_OUTPUT_TIMEOUT_NS 1000000000LL
+
+/** @brief The columns of a batch run's summary.
+  */
+#define SIM_SUMMARY_HEADER "cycles,wall_time,touchdowns,min_z,max_z,final_x,final_z,mean_sq_current," \
+                           "fell,rt_ops_state,peak_current,missed_deadlines,steps_to_fall"
+
 namespace atrias {
 
 namespace cSimConn {
@@ -74,7 +115,7 @@ class CSimConn : public RTT::TaskContext {
 
 		/** @brief By calling this, we cycle RT Ops.
 		  */
-		RTT::OperationCaller<void(atrias_msgs::robot_state)>
+		RTT::OperationCaller<void(const atrias_msgs::robot_state&)>
 			newStateCallback;
 
 		/** @brief This stores the current robot state.
@@ -95,7 +136,156 @@ class CSimConn : public RTT::TaskContext {
 		  * @return        The new leg half.
 		  */
 		atrias_msgs::robot_state_legHalf simLegHalf(atrias_msgs::robot_state_legHalf& legHalf, double current, Half half);
-	
+
+		/** @brief Returns the timestamp of the robot state RT Ops is working on.
+		  */
+		RTT::OperationCaller<uint64_t(void)>
+			getTimestamp;
+
+		/** @brief Returns RT Ops's current state.
+		  */
+		RTT::OperationCaller<rtOps::RtOpsState_t(void)>
+			getRtOpsState;
+
+		/** @brief In batch mode, this stands in for the Controller Manager.
+		  */
+		RTT::OutputPort<rtOps::RtOpsState_t> cmDataOut;
+
+		/** @brief The number of cycles to run in batch mode, or 0 to run in
+		  * realtime from a periodic activity. A property.
+		  */
+		int                            batchCycles;
+
+		/** @brief Whether to simulate the body bouncing on the legs. A property.
+		  */
+		bool                           stanceModel;
+
+		/** @brief Whether to simulate the whole biped with atrias_biped_sim,
+		  * in place of the motor and stance models. A property.
+		  */
+		bool                           bipedModel;
+
+		/** @brief The biped model's boom mode: 0 for hopping, 1 for walking,
+		  * 2 for free. A property.
+		  */
+		int                            bipedBoom;
+
+		/** @brief The biped model.
+		  */
+		bipedSim::BipedSim             biped;
+
+		/** @brief The body's starting height (meters) and horizontal speed
+		  * (m/s), for the stance and biped models. Properties.
+		  */
+		double                         initialHeight;
+		double                         initialVelocity;
+
+		/** @brief Whether to end a batch run early once the robot falls. A property.
+		  */
+		bool                           stopOnFall;
+
+		/** @brief How long to wait (seconds) before enabling the controller in
+		  * batch mode, so its GUI input can arrive. A property.
+		  */
+		double                         settleTime;
+
+		/** @brief If set, a one-line summary of each batch run is appended here. A property.
+		  */
+		std::string                    summaryFile;
+
+		/** @brief The body's position and velocity (meters and m/s) in the
+		  * sagittal plane, for the stance model.
+		  */
+		double                         bodyX, bodyZ, bodyDX, bodyDZ;
+
+		/** @brief Which leg is on the ground: 0 for neither, 1 for the left, 2 for the right.
+		  */
+		int                            stanceLeg;
+
+		/** @brief Whether the body has fallen below \a SIM_FALL_HEIGHT.
+		  * Once it has, it stays put.
+		  */
+		bool                           fallen;
+
+		/** @brief The stance leg's toe's horizontal position (meters).
+		  */
+		double                         toeX;
+
+		/** @brief The stance leg's state, relative to its toe.
+		  */
+		SlipState                      slipState;
+
+		/** @brief Signalled when RT Ops sends the output for \a expectedStamp.
+		  */
+		RTT::os::Semaphore             outputReady;
+
+		/** @brief Signalled when a batch run finishes.
+		  */
+		RTT::os::Semaphore             batchDone;
+
+		/** @brief The timestamp of the robot state we're waiting on.
+		  */
+		uint64_t                       expectedStamp;
+
+		/** @brief The number of cycles run in this batch.
+		  */
+		int                            cycle;
+
+		/** @brief Whether a batch run is under way.
+		  */
+		bool                           batchRunning;
+
+		/** @brief Whether the last batch run ended because the controller
+		  * stopped answering.
+		  */
+		bool                           batchFailed;
+
+		/** @brief The state we last asked RT Ops for.
+		  */
+		rtOps::RtOpsState              commandedState;
+
+		/** @brief Batch statistics: touchdowns, the body's lowest and highest
+		  * points, and the sum of the squared motor currents.
+		  */
+		int                            touchdowns;
+		double                         minZ, maxZ;
+		double                         sumSqCurrent;
+
+		/** @brief More batch statistics: the largest leg motor current
+		  * commanded, the cycles RT Ops took longer than a controller period
+		  * to answer, and the touchdowns before the robot fell (-1 if it didn't).
+		  */
+		double                         peakCurrent;
+		int                            missedDeadlines;
+		int                            stepsToFall;
+
+		/** @brief The last batch run's summary line (see SIM_SUMMARY_HEADER).
+		  */
+		std::string                    summary;
+
+		/** @brief When this batch started.
+		  */
+		RTT::os::TimeService::nsecs    startTime;
+
+		/** @brief Puts the robot back in its initial state.
+		  * @return False if the properties are invalid.
+		  */
+		bool resetState();
+
+		/** @brief Simulates the body on the legs for one cycle, and sets the
+		  * stance leg's leg angles from the springs' deflection.
+		  */
+		void simStance();
+
+		/** @brief Asks RT Ops to change states, and waits until it has.
+		  * @param state The new state.
+		  */
+		void commandState(rtOps::RtOpsState state);
+
+		/** @brief Logs this batch's results and appends them to \a summaryFile.
+		  */
+		void report();
+
 	public:
 		/** @brief Initializes the Sim Connector
 		  * @param name The name for this component.
@@ -105,16 +295,36 @@ class CSimConn : public RTT::TaskContext {
 		/** @brief Called by RT Ops w/ update controller torques.
 		  * @param controller_output The new controller output.
 		  */
-		void sendControllerOutput(atrias_msgs::controller_output controller_output);
+		void sendControllerOutput(const atrias_msgs::controller_output& controller_output);
 		
 		/** @brief Configures this component.
 		  * Run by Orocos.
 		  */
 		bool configureHook();
 
+		/** @brief Resets the sim. In batch mode, enables the controller.
+		  * Run by Orocos.
+		  */
+		bool startHook();
+
 		/** @brief Called periodically by Orocos; runs the sim.
+		  * In batch mode, this runs one cycle then triggers itself.
 		  */
 		void updateHook();
+
+		/** @brief Blocks until the batch run finishes.
+		  * Lets a deployer script run a batch to completion.
+		  * @return False if the run failed: the controller stopped answering.
+		  */
+		bool waitForBatch();
+
+		/** @brief Returns the last batch run's summary line.
+		  */
+		std::string getSummary();
+
+		/** @brief Returns the names of the summary's columns.
+		  */
+		std::string getSummaryHeader();
 };
 
 }
@@ -0,0 +1,148 @@
+#!/usr/bin/env python2
+
+# Sweeps a controller's GUI inputs (gains, etc.) through the headless C++ sim.
+#
+# Every combination of the given values is run for a fixed number of cycles
+# with CSimConn in batch mode (see cSimConnBatch.ops). Runs are spread over
+# the CPUs, one deployer pinned to each, and each CPU gets its own ROS master
+# so simultaneous runs can't hear each other's topics. The results of every
+# run are collected into results.csv in the output directory.
+#
+# For large sweeps over the biped model, sweep_runner (src/sweep_runner.cpp)
+# does the same in one process, without a deployer or ROS master per CPU.
+#
+# Example, sweeping ATCSlipRunning's leg force gains:
+#   csim_sweep.py atc_slip_running slip_running.yaml \
+#                 leg_for_kp=500,1000,1500 leg_for_kd=5,10,20
+#
+# slip_running.yaml holds the rest of the controller's input message, e.g.
+#   {main_controller: 1, slip_leg: 0.85, leg_pos_kp: 500, ...}
+
+import argparse
+import itertools
+import multiprocessing
+import os
+import Queue
+import subprocess
+import threading
+import time
+import yaml
+
+parser = argparse.ArgumentParser(description="Sweeps a controller's inputs through the headless C++ sim.")
+parser.add_argument('controller', help="The controller's package, e.g. atc_slip_running")
+parser.add_argument('inputs', help="YAML file holding the controller's input message")
+parser.add_argument('sweep', nargs='*', help="name=value1,value2,... for each input to sweep")
+parser.add_argument('-c', '--cycles', type=int, default=20000, help="Cycles (ms) per run")
+parser.add_argument('-j', '--jobs', type=int, default=multiprocessing.cpu_count(), help="Runs at once")
+parser.add_argument('-o', '--output', default=time.strftime('sweep-%Y%m%d-%H%M%S'), help="Output directory")
+parser.add_argument('--topic', default='/controller_input', help="The controller's input topic")
+parser.add_argument('--no-stance', action='store_true', help="Don't simulate the body")
+parser.add_argument('--biped', choices=['hopping', 'walking', 'free'],
+                    help="Simulate the whole biped (atrias_biped_sim) with this boom mode")
+parser.add_argument('--base-port', type=int, default=11400, help="The first ROS master's port")
+args = parser.parse_args()
+
+def rospackFind(package):
+	return subprocess.check_output(['rospack', 'find', package]).strip()
+
+baseInputs = yaml.load(open(args.inputs)) or {}
+names      = [s.split('=', 1)[0] for s in args.sweep]
+values     = [[float(v) for v in s.split('=', 1)[1].split(',')] for s in args.sweep]
+runs       = list(itertools.product(*values))
+
+connOps  = os.path.join(rospackFind('atrias_csim_conn'), 'cSimConnBatch.ops')
+startOps = os.path.join(rospackFind(args.controller), 'start.ops')
+msgType  = args.controller + '/controller_input'
+
+if not os.path.isdir(args.output):
+	os.makedirs(args.output)
+
+print("%d runs of %d cycles on %d CPUs, into %s" % (len(runs), args.cycles, args.jobs, args.output))
+
+def runOne(num, point, env, cpu):
+	runDir = os.path.join(args.output, 'run%04d' % num)
+	if not os.path.isdir(runDir):
+		os.makedirs(runDir)
+	summary = os.path.join(runDir, 'summary.csv')
+	if os.path.exists(summary):
+		os.remove(summary)
+
+	inputs = dict(baseInputs)
+	inputs.update(zip(names, point))
+
+	runOps = os.path.join(runDir, 'run.ops')
+	with open(runOps, 'w') as f:
+		f.write('atrias_connector.batchCycles = %d\n' % args.cycles)
+		f.write('atrias_connector.stanceModel = %s\n' % ('false' if args.no_stance else 'true'))
+		if args.biped:
+			f.write('atrias_connector.bipedModel = true\n')
+			f.write('atrias_connector.bipedBoom = %d\n' % ['hopping', 'walking', 'free'].index(args.biped))
+		f.write('atrias_connector.summaryFile = "%s"\n' % os.path.abspath(summary))
+		f.write('atrias_connector.configure()\n')
+		f.write('atrias_connector.start()\n')
+		f.write('atrias_connector.waitForBatch()\n')
+
+	# Latched, so the controller gets it as soon as it subscribes.
+	pub = subprocess.Popen(['rostopic', 'pub', '-l', args.topic, msgType,
+	                        yaml.dump(inputs, default_flow_style=True)],
+	                       env=env, stdout=open(os.devnull, 'w'))
+	with open(os.path.join(runDir, 'deployer.log'), 'w') as log:
+		subprocess.call(['taskset', '-c', str(cpu), 'rosrun', 'ocl', 'deployer',
+		                 '-s', connOps, '-s', startOps, '-s', runOps],
+		                env=env, stdin=open(os.devnull), stdout=log, stderr=subprocess.STDOUT)
+	pub.terminate()
+	pub.wait()
+
+	if not os.path.exists(summary):
+		print("[%d/%d] %s: failed, see %s" % (num + 1, len(runs), inputs, runDir))
+		return None
+	lines = open(summary).read().splitlines()
+	print("[%d/%d] %s: done" % (num + 1, len(runs), dict(zip(names, point))))
+	return lines[0], lines[-1]
+
+results = Queue.Queue()
+work    = Queue.Queue()
+for num, point in enumerate(runs):
+	work.put((num, point))
+
+def worker(slot):
+	cpu  = slot % multiprocessing.cpu_count()
+	port = args.base_port + slot
+	env  = dict(os.environ)
+	env['ROS_MASTER_URI'] = 'http://localhost:%d' % port
+
+	master = subprocess.Popen(['rosmaster', '--core', '-p', str(port)],
+	                          env=env, stdout=open(os.devnull, 'w'), stderr=subprocess.STDOUT)
+	time.sleep(1.0)
+	try:
+		while True:
+			try:
+				num, point = work.get_nowait()
+			except Queue.Empty:
+				return
+			results.put((num, point, runOne(num, point, env, cpu)))
+	finally:
+		master.terminate()
+		master.wait()
+
+threads = [threading.Thread(target=worker, args=(slot,)) for slot in range(min(args.jobs, len(runs)))]
+for t in threads:
+	t.start()
+for t in threads:
+	t.join()
+
+# Collect the results, in run order.
+rows   = sorted([results.get() for i in range(results.qsize())])
+header = None
+with open(os.path.join(args.output, 'results.csv'), 'w') as out:
+	for num, point, result in rows:
+		if result is None:
+			continue
+		if header is None:
+			header = result[0]
+			out.write(','.join(['run'] + names) + ',' + header + '\n')
+		out.write(','.join([str(num)] + [repr(v) for v in point]) + ',' + result[1] + '\n')
+
+print("Wrote " + os.path.join(args.output, 'results.csv'))
+
+# vim: noexpandtab
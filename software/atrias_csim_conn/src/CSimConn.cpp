@@ -1,17 +1,96 @@
 #include "atrias_csim_conn/CSimConn.h"
 
+#include <math.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+// Leg geometry, spring stiffness, mass and gravity. Included last, as it
+// defines some short macro names.
+#include <atrias_shared/atrias_parameters.h>
+
 namespace atrias {
 
 namespace cSimConn {
 
+/** @brief The SLIP stance dynamics, as in ASCSlipModel, but with the force of
+  * ATRIAS's rotational springs rather than a linear leg spring.
+  * @param x   The state: r, dr, q, dq.
+  * @param r0  The leg's rest length, set by the motors.
+  * @param dx  Set to the state's derivative.
+  */
+static void slipDerivative(const double x[4], double r0, double dx[4]) {
+	// Each of the two springs deflects by the change in the knee's half-angle.
+	double halfAngle   = acos(x[0] / (L1 + L2));
+	double springForce = 2.0 * KS * (halfAngle - acos(r0 / (L1 + L2))) / ((L1 + L2) * sin(halfAngle));
+
+	dx[0] = x[1];
+	dx[1] = x[3] * x[3] * x[0] - G * sin(x[2]) + springForce / M;
+	dx[2] = x[3];
+	dx[3] = -(2.0 * x[3] * x[1] + G * cos(x[2])) / x[0];
+}
+
 CSimConn::CSimConn(std::string name) :
          RTT::TaskContext(name),
-         newStateCallback("newStateCallback")
+         newStateCallback("newStateCallback"),
+         getTimestamp("getTimestamp"),
+         getRtOpsState("getRtOpsState"),
+         cmDataOut("rt_ops_cm_out"),
+         outputReady(0),
+         batchDone(0)
 {
 	this->provides("connector")
 	    ->addOperation("sendControllerOutput", &CSimConn::sendControllerOutput, this, RTT::ClientThread);
+	this->provides("connector")
+	    ->addOperation("waitForBatch", &CSimConn::waitForBatch, this, RTT::ClientThread)
+	    .doc("Blocks until the batch run finishes. Returns false if it failed.");
+	this->provides("connector")
+	    ->addOperation("getSummary", &CSimConn::getSummary, this, RTT::ClientThread)
+	    .doc("Returns the last batch run's summary line.");
+	this->provides("connector")
+	    ->addOperation("getSummaryHeader", &CSimConn::getSummaryHeader, this, RTT::ClientThread)
+	    .doc("Returns the names of the summary's columns.");
 	this->requires("rtOps")
 	    ->addOperationCaller(newStateCallback);
+	this->requires("rtOps")
+	    ->addOperationCaller(getTimestamp);
+	this->requires("rtOps")
+	    ->addOperationCaller(getRtOpsState);
+
+	addPort(cmDataOut);
+
+	batchCycles = 0;
+	stanceModel = false;
+	bipedModel  = false;
+	bipedBoom   = (int) bipedSim::BoomMode::WALKING;
+	settleTime  = 0.5;
+	stopOnFall  = false;
+	initialHeight   = SIM_INITIAL_HEIGHT;
+	initialVelocity = 0.0;
+	this->addProperty("batchCycles", batchCycles).doc("Cycles to run as fast as possible, or 0 to run in realtime.");
+	this->addProperty("stanceModel", stanceModel).doc("Whether to simulate the body bouncing on the legs.");
+	this->addProperty("bipedModel",  bipedModel).doc("Whether to simulate the whole biped rather than the motors alone.");
+	this->addProperty("bipedBoom",   bipedBoom).doc("The biped model's boom: 0 for hopping, 1 for walking, 2 for free.");
+	this->addProperty("initialHeight",   initialHeight).doc("The body's starting height (m), for the stance and biped models.");
+	this->addProperty("initialVelocity", initialVelocity).doc("The body's starting horizontal speed (m/s), for the stance and biped models.");
+	this->addProperty("stopOnFall",  stopOnFall).doc("Whether to end a batch run early once the robot falls.");
+	this->addProperty("settleTime",  settleTime).doc("Seconds to wait before enabling the controller in batch mode.");
+	this->addProperty("summaryFile", summaryFile).doc("If set, each batch run's results are appended here.");
+
+	resetState();
+	batchRunning = false;
+	batchFailed  = false;
+}
+
+bool CSimConn::resetState() {
+	if (bipedBoom < (int) bipedSim::BoomMode::HOPPING || bipedBoom > (int) bipedSim::BoomMode::FREE) {
+		log(RTT::Error) << "[CSimConn] bipedBoom is " << bipedBoom
+		                << "; it must be 0 (hopping), 1 (walking) or 2 (free)." << RTT::endlog();
+		return false;
+	}
+
+	robotState = atrias_msgs::robot_state();
+	cOut       = atrias_msgs::controller_output();
 
 	// Initialize the state.
 	robotState.lLeg.hip.legBodyAngle = robotState.rLeg.hip.legBodyAngle = 1.5 * M_PI;
@@ -26,6 +105,25 @@ CSimConn::CSimConn(std::string name) :
 	robotState.lLeg.halfB.motorAngle = robotState.rLeg.halfB.motorAngle =
 	robotState.lLeg.halfB.legAngle   = robotState.rLeg.halfB.legAngle   =
 	.75 * M_PI;
+
+	bodyX     = 0.0;
+	bodyZ     = initialHeight;
+	bodyDX    = initialVelocity;
+	bodyDZ    = 0.0;
+	stanceLeg = 0;
+	fallen    = false;
+	robotState.position.zPosition = bodyZ;
+	robotState.position.xVelocity = bodyDX;
+
+	biped.getParams().boomMode        = (bipedSim::BoomMode) bipedBoom;
+	biped.getParams().initialHeight   = initialHeight;
+	biped.getParams().initialVelocity = initialVelocity;
+	biped.getParams().fallHeight      = SIM_FALL_HEIGHT;
+	biped.reset();
+	if (bipedModel)
+		biped.getState(robotState);
+
+	return true;
 }
 
 atrias_msgs::robot_state_hip CSimConn::simHip(atrias_msgs::robot_state_hip& hip, Hip whichHip) {
@@ -92,6 +190,104 @@ atrias_msgs::robot_state_legHalf CSimConn::simLegHalf(atrias_msgs::robot_state_l
 	return out;
 }
 
+void CSimConn::simStance() {
+	double h = ((double) CONTROLLER_LOOP_PERIOD_NS) / ((double) SECOND_IN_NANOSECONDS);
+
+	// The motors set each leg's angle and rest length.
+	atrias_msgs::robot_state_leg* legs[2] = {&robotState.lLeg, &robotState.rLeg};
+	double q[2], r0[2];
+	for (int i = 0; i < 2; i++) {
+		q[i]  = (legs[i]->halfA.motorAngle + legs[i]->halfB.motorAngle) / 2.0;
+		r0[i] = (L1 + L2) * cos((legs[i]->halfB.motorAngle - legs[i]->halfA.motorAngle) / 2.0);
+	}
+
+	if (fallen) {
+		// Lying on the ground.
+	} else if (stanceLeg == 0) {
+		// Flight
+		bodyX  += h * bodyDX;
+		bodyDZ -= h * G;
+		bodyZ  += h * bodyDZ;
+
+		for (int i = 0; i < 2; i++) {
+			if (bodyDZ >= 0.0 || bodyZ - r0[i] * sin(q[i]) > 0.0)
+				continue;
+
+			// Touchdown. Put the toe on the ground, and move into the leg's frame.
+			stanceLeg    = i + 1;
+			slipState.r  = bodyZ / sin(q[i]);
+			slipState.q  = q[i];
+			toeX         = bodyX + slipState.r * cos(q[i]);
+			slipState.dr = -bodyDX * cos(q[i]) + bodyDZ * sin(q[i]);
+			slipState.dq = (bodyDX * sin(q[i]) + bodyDZ * cos(q[i])) / slipState.r;
+			touchdowns++;
+			break;
+		}
+	} else {
+		// Stance: integrate the SLIP model (RK4) about the toe.
+		double rest = r0[stanceLeg - 1];
+		double x[4] = {slipState.r, slipState.dr, slipState.q, slipState.dq};
+		double k1[4], k2[4], k3[4], k4[4], tmp[4];
+
+		slipDerivative(x, rest, k1);
+		for (int j = 0; j < 4; j++)
+			tmp[j] = x[j] + 0.5 * h * k1[j];
+		slipDerivative(tmp, rest, k2);
+		for (int j = 0; j < 4; j++)
+			tmp[j] = x[j] + 0.5 * h * k2[j];
+		slipDerivative(tmp, rest, k3);
+		for (int j = 0; j < 4; j++)
+			tmp[j] = x[j] + h * k3[j];
+		slipDerivative(tmp, rest, k4);
+		for (int j = 0; j < 4; j++)
+			x[j] += h / 6.0 * (k1[j] + 2.0 * k2[j] + 2.0 * k3[j] + k4[j]);
+
+		slipState.r  = x[0];
+		slipState.dr = x[1];
+		slipState.q  = x[2];
+		slipState.dq = x[3];
+
+		bodyX  = toeX - slipState.r * cos(slipState.q);
+		bodyZ  = slipState.r * sin(slipState.q);
+		bodyDX = -slipState.dr * cos(slipState.q) + slipState.r * slipState.dq * sin(slipState.q);
+		bodyDZ =  slipState.dr * sin(slipState.q) + slipState.r * slipState.dq * cos(slipState.q);
+
+		// Liftoff once the spring is back at rest.
+		if (slipState.r >= rest && slipState.dr > 0.0)
+			stanceLeg = 0;
+	}
+
+	if (!fallen && bodyZ < SIM_FALL_HEIGHT) {
+		fallen    = true;
+		stanceLeg = 0;
+		bodyDX    = 0.0;
+		bodyDZ    = 0.0;
+	}
+
+	slipState.isStance = stanceLeg != 0;
+	slipState.isFlight = stanceLeg == 0;
+
+	robotState.position.xPosition = bodyX;
+	robotState.position.zPosition = bodyZ;
+	robotState.position.xVelocity = bodyDX;
+	robotState.position.zVelocity = bodyDZ;
+
+	// The stance leg's angles follow the body; the springs take up the
+	// difference from the motors. The swing leg's springs are relaxed.
+	for (int i = 0; i < 2; i++) {
+		legs[i]->onGround = stanceLeg == i + 1;
+		if (!legs[i]->onGround)
+			continue;
+
+		double halfAngle    = acos(slipState.r / (L1 + L2));
+		double halfAngleVel = -slipState.dr / ((L1 + L2) * sin(halfAngle));
+		legs[i]->halfA.legAngle    = slipState.q - halfAngle;
+		legs[i]->halfB.legAngle    = slipState.q + halfAngle;
+		legs[i]->halfA.legVelocity = slipState.dq - halfAngleVel;
+		legs[i]->halfB.legVelocity = slipState.dq + halfAngleVel;
+	}
+}
+
 bool CSimConn::configureHook() {
 	RTT::TaskContext *peer = this->getPeer("atrias_rt");
 	if (!peer) {
@@ -99,31 +295,205 @@ bool CSimConn::configureHook() {
 		return false;
 	}
 	newStateCallback = peer->provides("rtOps")->getOperation("newStateCallback");
+	getRtOpsState    = peer->provides("rtOps")->getOperation("getRtOpsState");
+	getTimestamp     = peer->provides("timestamps")->getOperation("getTimestamp");
 	log(RTT::Info) << "[CSimConn] Connected to RTOps." << RTT::endlog();
 	log(RTT::Info) << "[CSimConn] configured!" << RTT::endlog();
 	return true;
 }
 
+bool CSimConn::startHook() {
+	if (!resetState())
+		return false;
+
+	if (batchCycles <= 0)
+		return true;
+
+	cycle        = 0;
+	batchRunning = true;
+	batchFailed  = false;
+	touchdowns   = 0;
+	minZ         = bodyZ;
+	maxZ         = bodyZ;
+	sumSqCurrent = 0.0;
+	peakCurrent  = 0.0;
+	missedDeadlines = 0;
+	stepsToFall  = -1;
+	summary.clear();
+
+	// Discard any output that arrived after the last run gave up on it.
+	while (outputReady.trywait()) {}
+
+	// Give the controller's GUI input time to arrive, then do what the
+	// Controller Manager and the GUI would: disable, then enable.
+	usleep((useconds_t) (settleTime * 1e6));
+	commandedState = rtOps::RtOpsState::NO_CONTROLLER_LOADED;
+	commandState(rtOps::RtOpsState::DISABLED);
+	commandState(rtOps::RtOpsState::ENABLED);
+
+	log(RTT::Info) << "[CSimConn] Running " << batchCycles << " cycles." << RTT::endlog();
+	startTime = RTT::os::TimeService::Instance()->getNSecs();
+	return true;
+}
+
+void CSimConn::commandState(rtOps::RtOpsState state) {
+	if (state == commandedState)
+		return;
+	commandedState = state;
+	cmDataOut.write((rtOps::RtOpsState_t) state);
+
+	// RT Ops acts on this from its own thread, so wait for it.
+	RTT::os::TimeService::nsecs deadline =
+		RTT::os::TimeService::Instance()->getNSecs() + SIM_STATE_CHANGE_TIMEOUT_NS;
+	while (getRtOpsState() != (rtOps::RtOpsState_t) state) {
+		if (RTT::os::TimeService::Instance()->getNSecs() > deadline) {
+			log(RTT::Warning) << "[CSimConn] RT Ops did not enter state " << (int) state << RTT::endlog();
+			return;
+		}
+		usleep(100);
+	}
+}
+
+void CSimConn::report() {
+	RTT::os::TimeService::nsecs elapsed = RTT::os::TimeService::Instance()->getNSecs() - startTime;
+	double meanSqCurrent = sumSqCurrent / cycle;
+	bool   bodyModel     = stanceModel || bipedModel;
+	bool   fell          = bodyModel && fallen;
+	int    rtOpsState    = getRtOpsState();
+
+	log(RTT::Info) << "[CSimConn] Ran " << cycle << " cycles (" << cycle / 1000.0 << " s simulated) in "
+	               << elapsed / 1e9 << " s" << RTT::endlog();
+	if (bodyModel) {
+		log(RTT::Info) << "[CSimConn] " << touchdowns << " touchdowns, height " << minZ << " to " << maxZ
+		               << " m, ended at x = " << bodyX << " m" << (fell ? "; fell" : "") << RTT::endlog();
+	}
+
+	if (missedDeadlines)
+		log(RTT::Info) << "[CSimConn] RT Ops missed " << missedDeadlines << " deadlines" << RTT::endlog();
+
+	char line[256];
+	snprintf(line, sizeof(line), "%d,%.6f,%d,%.6f,%.6f,%.6f,%.6f,%.6f,%d,%d,%.6f,%d,%d", cycle, elapsed / 1e9,
+	         touchdowns, minZ, maxZ, bodyX, bodyZ, meanSqCurrent, fell, rtOpsState, peakCurrent,
+	         missedDeadlines, stepsToFall);
+	summary = line;
+
+	if (summaryFile.empty())
+		return;
+
+	FILE* out = fopen(summaryFile.c_str(), "a");
+	if (!out) {
+		log(RTT::Error) << "[CSimConn] Failed to open " << summaryFile << RTT::endlog();
+		return;
+	}
+	if (ftell(out) == 0)
+		fprintf(out, "%s\n", SIM_SUMMARY_HEADER);
+	fprintf(out, "%s\n", summary.c_str());
+	fclose(out);
+}
+
 void CSimConn::updateHook() {
+	if (batchCycles > 0 && !batchRunning)
+		return;
+
 	// Increment the time.
 	robotState.header.stamp.nsec += CONTROLLER_LOOP_PERIOD_NS;
 	robotState.header.stamp.sec  += robotState.header.stamp.nsec / SECOND_IN_NANOSECONDS;
 	robotState.header.stamp.nsec %= SECOND_IN_NANOSECONDS;
 
 	// Run the sim.
-	robotState.lLeg.hip   = simHip(robotState.lLeg.hip, Hip::LEFT);
-	robotState.rLeg.hip   = simHip(robotState.rLeg.hip, Hip::RIGHT);
-	robotState.lLeg.halfA = simLegHalf(robotState.lLeg.halfA, cOut.lLeg.motorCurrentA, Half::A);
-	robotState.lLeg.halfB = simLegHalf(robotState.lLeg.halfB, cOut.lLeg.motorCurrentB, Half::B);
-	robotState.rLeg.halfA = simLegHalf(robotState.rLeg.halfA, cOut.rLeg.motorCurrentA, Half::A);
-	robotState.rLeg.halfB = simLegHalf(robotState.rLeg.halfB, cOut.rLeg.motorCurrentB, Half::B);
+	if (bipedModel) {
+		biped.step(cOut);
+		biped.getState(robotState);
+		bodyX      = biped.getBodyX();
+		bodyZ      = biped.getBodyZ();
+		touchdowns = biped.getTouchdowns();
+		fallen     = biped.hasFallen();
+	} else {
+		robotState.lLeg.hip   = simHip(robotState.lLeg.hip, Hip::LEFT);
+		robotState.rLeg.hip   = simHip(robotState.rLeg.hip, Hip::RIGHT);
+		robotState.lLeg.halfA = simLegHalf(robotState.lLeg.halfA, cOut.lLeg.motorCurrentA, Half::A);
+		robotState.lLeg.halfB = simLegHalf(robotState.lLeg.halfB, cOut.lLeg.motorCurrentB, Half::B);
+		robotState.rLeg.halfA = simLegHalf(robotState.rLeg.halfA, cOut.rLeg.motorCurrentA, Half::A);
+		robotState.rLeg.halfB = simLegHalf(robotState.rLeg.halfB, cOut.rLeg.motorCurrentB, Half::B);
+
+		if (stanceModel)
+			simStance();
+	}
 
+	if (batchCycles <= 0) {
+		newStateCallback(robotState);
+		return;
+	}
+
+	// Batch mode: wait for the controller's response to this state.
+	expectedStamp = SECOND_IN_NANOSECONDS * (uint64_t) robotState.header.stamp.sec + robotState.header.stamp.nsec;
+	RTT::os::TimeService::nsecs sent = RTT::os::TimeService::Instance()->getNSecs();
 	newStateCallback(robotState);
+	if (!outputReady.waitUntil(RTT::nsecs_to_Seconds(sent + SIM_OUTPUT_TIMEOUT_NS))) {
+		log(RTT::Error) << "[CSimConn] No controller output for cycle " << cycle
+		                << "; giving up on the run." << RTT::endlog();
+		batchRunning = false;
+		batchFailed  = true;
+		batchDone.signal();
+		return;
+	}
+
+	// On the robot, an answer this late would have missed its cycle.
+	if (RTT::os::TimeService::Instance()->getNSecs() - sent > CONTROLLER_LOOP_PERIOD_NS)
+		missedDeadlines++;
+
+	cycle++;
+	minZ = std::min(minZ, bodyZ);
+	maxZ = std::max(maxZ, bodyZ);
+	sumSqCurrent += cOut.lLeg.motorCurrentA * cOut.lLeg.motorCurrentA +
+	                cOut.lLeg.motorCurrentB * cOut.lLeg.motorCurrentB +
+	                cOut.rLeg.motorCurrentA * cOut.rLeg.motorCurrentA +
+	                cOut.rLeg.motorCurrentB * cOut.rLeg.motorCurrentB;
+	peakCurrent = std::max(peakCurrent, std::max(
+	              std::max(fabs(cOut.lLeg.motorCurrentA), fabs(cOut.lLeg.motorCurrentB)),
+	              std::max(fabs(cOut.rLeg.motorCurrentA), fabs(cOut.rLeg.motorCurrentB))));
+
+	if (fallen && stepsToFall < 0)
+		stepsToFall = touchdowns;
+
+	if (cycle == batchCycles || (fallen && stopOnFall)) {
+		batchRunning = false;
+		report();
+		batchDone.signal();
+		return;
+	}
+
+	// Run the next cycle right away.
+	this->trigger();
 }
 
-void CSimConn::sendControllerOutput(atrias_msgs::controller_output controller_output) {
+void CSimConn::sendControllerOutput(const atrias_msgs::controller_output& controller_output) {
+	if (batchCycles <= 0) {
+		cOut = controller_output;
+		return;
+	}
+
+	// The controller loop also runs once at startup; only take the output
+	// computed from the state we sent.
+	if (getTimestamp() != expectedStamp)
+		return;
+
 	cOut = controller_output;
-	return;
+	outputReady.signal();
+}
+
+bool CSimConn::waitForBatch() {
+	if (batchCycles > 0)
+		batchDone.wait();
+	return !batchFailed;
+}
+
+std::string CSimConn::getSummary() {
+	return summary;
+}
+
+std::string CSimConn::getSummaryHeader() {
+	return SIM_SUMMARY_HEADER;
 }
 
 ORO_CREATE_COMPONENT(CSimConn)
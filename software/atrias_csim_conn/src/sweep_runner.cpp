@@ -0,0 +1,552 @@
+/** @file
+  * @brief Runs many controller episodes in one process, each in its own RT Ops
+  * + controller + CSimConn stack, and collects their results into a CSV file.
+  *
+  * Every combination of the swept values is run, \a samples times each. A
+  * value may be a list (1,2,3), or a range (lo:hi) drawn uniformly at random
+  * for each run. Swept names that are CSimConn properties (initialHeight,
+  * initialVelocity, bipedBoom, ...) set the connector; the rest set fields of
+  * the controller's GUI input message, whose other fields come from the
+  * inputs file. Each run simulates the whole biped (see atrias_biped_sim) in
+  * batch mode, and ends early if the robot falls.
+  *
+  * One worker thread runs per CPU, by default. Each builds a fresh stack for
+  * each run, with its own component names, ports and peers, and pins the
+  * stack's threads, the controller's slow tasks included, to the worker's
+  * CPU. The stacks do share the process: the component factories, and the
+  * one LogAggregator that every LogPort is drained by. That can't keep up
+  * with many stacks, so LogPorts are disabled (see LOG_DISABLE_ENV); only
+  * the summaries are kept. The controllers' other ROS topics are named
+  * after their components, so they still need a ROS master, but stacks
+  * don't hear each other; run against a private master to keep them off
+  * the robot's.
+  *
+  * A run fails if its controller stops answering (see SIM_OUTPUT_TIMEOUT_NS).
+  *
+  * Only ATC-based controllers built without ATRIAS_RT_ALLOCATOR can be run,
+  * as the GUI input is set through its typekit's fields.
+  *
+  * Example, 10 random leg force gains at each of 3 starting speeds:
+  *   roscore -p 11999 &
+  *   ROS_MASTER_URI=http://localhost:11999 rosrun atrias_csim_conn sweep_runner \
+  *       -n 10 -o walking.csv atc_slip_walking ATCSlipWalking slip_walking.yaml \
+  *       leg_for_kp=500:2000 initialVelocity=0,0.5,1.0
+  *
+  * slip_walking.yaml holds the controller's input message, as for
+  * scripts/csim_sweep.py, e.g. {main_controller: 1, q1: 1.4, ...}
+  */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Orocos
+#include <rtt/Activity.hpp>
+#include <rtt/OperationCaller.hpp>
+#include <rtt/Property.hpp>
+#include <rtt/TaskContext.hpp>
+#include <rtt/base/OutputPortInterface.hpp>
+#include <rtt/deployment/ComponentLoader.hpp>
+#include <rtt/internal/AssignableDataSource.hpp>
+#include <rtt/os/Mutex.hpp>
+#include <rtt/os/MutexLock.hpp>
+#include <rtt/os/startstop.h>
+#include <rtt/types/TypeInfo.hpp>
+
+#include <atrias_control_lib/LogAggregator.hpp>
+#include <atrias_shared/FlightRecorder.h>
+
+/** @brief How long each stack waits for the GUI input to reach its controller (seconds).
+  */
+#define SWEEP_SETTLE_TIME 0.05
+
+/** @brief RT Ops's, the controller's and its slow tasks' CPU masks are 32
+  * bits wide; stacks on higher CPUs aren't pinned.
+  */
+#define SWEEP_MAX_PINNED_CPU 32
+
+/** @brief One swept name, and its values.
+  */
+struct Dimension {
+	std::string         name;
+
+	/** @brief The listed values, if not random.
+	  */
+	std::vector<double> values;
+
+	/** @brief Whether each run draws a value from [lo, hi).
+	  */
+	bool                random;
+	double              lo, hi;
+};
+
+/** @brief A setting for a run: a connector property or a GUI input field.
+  */
+struct Setting {
+	std::string name;
+	double      value;
+};
+
+/** @brief The command line.
+  */
+static std::string            package;
+static std::string            controllerType;
+static int                    cycles     = 20000;
+static int                    jobs       = 0;
+static int                    samples    = 1;
+static long                   seed       = 1;
+static int                    boom       = 1;
+static bool                   stopOnFall = true;
+static std::string            outputName = "sweep.csv";
+
+/** @brief The base GUI input, the sweep, and every run's values for it.
+  */
+static std::vector<Setting>             inputs;
+static std::vector<Dimension>           dimensions;
+static std::vector<std::vector<double>> runs;
+
+/** @brief The next run to be taken by a worker.
+  */
+static std::atomic<size_t>    nextRun(0);
+
+/** @brief The component factories aren't thread-safe, so creating and
+  * destroying components is serialized.
+  */
+static RTT::os::Mutex         loaderLock;
+
+/** @brief Guards the output file and the console.
+  */
+static RTT::os::Mutex         outputLock;
+static FILE*                  output;
+static bool                   headerWritten = false;
+
+static void usage(const char* argv0) {
+	fprintf(stderr,
+	        "Usage: %s [options] <package> <component type> <inputs file> [name=v1,v2,...|name=lo:hi ...]\n"
+	        "  -c cycles   Cycles (ms) per run (default 20000)\n"
+	        "  -j jobs     Runs at once (default: one per CPU)\n"
+	        "  -n samples  Runs per combination of listed values (default 1)\n"
+	        "  -s seed     Seed for the random values (default 1)\n"
+	        "  -b boom     Boom mode: hopping, walking or free (default walking)\n"
+	        "  -k          Keep running after the robot falls\n"
+	        "  -o file     Output CSV (default sweep.csv)\n", argv0);
+}
+
+static std::string trim(const std::string &str) {
+	size_t start = str.find_first_not_of(" \t\r\n");
+	if (start == std::string::npos)
+		return "";
+	return str.substr(start, str.find_last_not_of(" \t\r\n") - start + 1);
+}
+
+static bool parseNumber(const std::string &str, double &value) {
+	char* end;
+	std::string trimmed = trim(str);
+	value = strtod(trimmed.c_str(), &end);
+	return !trimmed.empty() && *end == '\0';
+}
+
+/** @brief Reads a flat message from a file of "name: value" pairs, either
+  * one per line or in YAML's {name: value, ...} form.
+  */
+static bool readInputs(const std::string &fileName) {
+	std::ifstream file(fileName.c_str());
+	if (!file) {
+		fprintf(stderr, "Could not open %s\n", fileName.c_str());
+		return false;
+	}
+
+	std::stringstream contents;
+	contents << file.rdbuf();
+	std::string text = contents.str();
+	for (size_t i = 0; i < text.size(); i++) {
+		if (text[i] == '{' || text[i] == '}' || text[i] == ',')
+			text[i] = '\n';
+	}
+
+	std::istringstream lines(text);
+	std::string        line;
+	while (std::getline(lines, line)) {
+		line = trim(line.substr(0, line.find('#')));
+		if (line.empty())
+			continue;
+
+		size_t  colon = line.find(':');
+		Setting setting;
+		if (colon == std::string::npos || !parseNumber(line.substr(colon + 1), setting.value)) {
+			fprintf(stderr, "Could not read \"%s\" in %s\n", line.c_str(), fileName.c_str());
+			return false;
+		}
+		setting.name = trim(line.substr(0, colon));
+		inputs.push_back(setting);
+	}
+	return true;
+}
+
+/** @brief Parses name=v1,v2,... or name=lo:hi.
+  */
+static bool parseDimension(const std::string &arg) {
+	size_t equals = arg.find('=');
+	if (equals == std::string::npos || equals == 0)
+		return false;
+
+	Dimension   dim;
+	std::string spec = arg.substr(equals + 1);
+	size_t      colon = spec.find(':');
+	dim.name   = arg.substr(0, equals);
+	dim.random = colon != std::string::npos;
+	if (dim.random) {
+		if (!parseNumber(spec.substr(0, colon), dim.lo) || !parseNumber(spec.substr(colon + 1), dim.hi))
+			return false;
+	} else {
+		std::istringstream values(spec);
+		std::string        value;
+		while (std::getline(values, value, ',')) {
+			double number;
+			if (!parseNumber(value, number))
+				return false;
+			dim.values.push_back(number);
+		}
+		if (dim.values.empty())
+			return false;
+	}
+
+	dimensions.push_back(dim);
+	return true;
+}
+
+/** @brief Lists every run's values: each combination of the listed values,
+  * \a samples times, with the random values drawn in run order so a seed
+  * always gives the same sweep.
+  */
+static void buildRuns() {
+	unsigned short state[3] = {0x330e, (unsigned short) seed, (unsigned short) (seed >> 16)};
+
+	std::vector<size_t> index(dimensions.size(), 0);
+	while (true) {
+		for (int sample = 0; sample < samples; sample++) {
+			std::vector<double> values;
+			for (size_t i = 0; i < dimensions.size(); i++) {
+				const Dimension &dim = dimensions[i];
+				values.push_back(dim.random ? dim.lo + (dim.hi - dim.lo) * erand48(state) : dim.values[index[i]]);
+			}
+			runs.push_back(values);
+		}
+
+		// Next combination, odometer style
+		size_t i = 0;
+		for (; i < dimensions.size(); i++) {
+			if (dimensions[i].random)
+				continue;
+			if (++index[i] < dimensions[i].values.size())
+				break;
+			index[i] = 0;
+		}
+		if (i == dimensions.size())
+			return;
+	}
+}
+
+/** @brief Sets a property if it has type T.
+  */
+template <class T>
+static bool setPropertyAs(RTT::base::PropertyBase* property, double value) {
+	RTT::Property<T> typed(property);
+	if (!typed.ready())
+		return false;
+	typed.set((T) value);
+	return true;
+}
+
+/** @brief Sets a numeric or boolean property.
+  */
+static bool setProperty(RTT::TaskContext* component, const std::string &name, double value) {
+	RTT::base::PropertyBase* property = component->properties()->getProperty(name);
+	return property &&
+	       (setPropertyAs<double>(property, value) || setPropertyAs<int>(property, value) ||
+	        setPropertyAs<unsigned int>(property, value) || setPropertyAs<bool>(property, value));
+}
+
+/** @brief Sets a message field if it has type T.
+  */
+template <class T>
+static bool setFieldAs(RTT::base::DataSourceBase::shared_ptr field, double value) {
+	RTT::internal::AssignableDataSource<T>* typed = RTT::internal::AssignableDataSource<T>::narrow(field.get());
+	if (!typed)
+		return false;
+	typed->set((T) value);
+	return true;
+}
+
+/** @brief Sets one of a message's numeric fields.
+  */
+static bool setField(RTT::base::DataSourceBase::shared_ptr msg, const std::string &name, double value) {
+	RTT::base::DataSourceBase::shared_ptr field = msg->getMember(name);
+	return field &&
+	       (setFieldAs<double>(field, value)  || setFieldAs<float>(field, value)    ||
+	        setFieldAs<uint8_t>(field, value) || setFieldAs<int8_t>(field, value)   ||
+	        setFieldAs<uint16_t>(field, value) || setFieldAs<int16_t>(field, value) ||
+	        setFieldAs<uint32_t>(field, value) || setFieldAs<int32_t>(field, value) ||
+	        setFieldAs<uint64_t>(field, value) || setFieldAs<int64_t>(field, value));
+}
+
+/** @brief Gives a component an activity pinned to \a cpu.
+  */
+static void pinActivity(RTT::TaskContext* component, int cpu) {
+	if (cpu >= SWEEP_MAX_PINNED_CPU)
+		return;
+	component->setActivity(new RTT::Activity(ORO_SCHED_OTHER, RTT::os::LowestPriority, 0.0, 1u << cpu, 0,
+	                                         component->getName()));
+}
+
+/** @brief Runs one episode in a new stack.
+  * @param num     The run's number.
+  * @param slot    The worker's number, which names the stack's components.
+  * @param cpu     The CPU to run on.
+  * @param summary Set to the connector's summary of the run.
+  * @param header  Set to the names of the summary's columns.
+  * @return True if the run completed.
+  */
+static bool runOne(size_t num, int slot, int cpu, std::string &summary, std::string &header) {
+	RTT::ComponentLoader::shared_ptr loader = RTT::ComponentLoader::Instance();
+
+	std::ostringstream suffix;
+	suffix << "_sweep" << getpid() << "_" << slot;
+
+	RTT::TaskContext* rt;
+	RTT::TaskContext* conn;
+	RTT::TaskContext* controller;
+	{
+		RTT::os::MutexLock lock(loaderLock);
+		rt         = loader->loadComponent("atrias_rt" + suffix.str(), "RTOps");
+		conn       = loader->loadComponent("atrias_connector" + suffix.str(), "CSimConn");
+		controller = loader->loadComponent(controllerType + suffix.str(), controllerType);
+	}
+
+	bool                              ok     = rt && conn && controller;
+	RTT::base::OutputPortInterface*   guiOut = NULL;
+	RTT::base::DataSourceBase::shared_ptr guiMsg;
+	if (!ok)
+		fprintf(stderr, "Run %zu: could not create the components\n", num);
+
+	if (ok) {
+		rt->addPeer(conn, "atrias_connector");
+		rt->addPeer(controller, "controller");
+		conn->addPeer(rt, "atrias_rt");
+		controller->addPeer(rt, "atrias_rt");
+		conn->ports()->getPort("rt_ops_cm_out")->connectTo(rt->ports()->getPort("controller_manager_data_in"));
+
+		pinActivity(rt, cpu);
+		pinActivity(conn, cpu);
+		pinActivity(controller, cpu);
+
+		// Memory locking is process-wide, so no one stack may own it.
+		setProperty(rt, "lockMemory", false);
+		if (cpu < SWEEP_MAX_PINNED_CPU) {
+			setProperty(rt, "controllerCpuAffinity", 1u << cpu);
+			setProperty(controller, "slowTaskCpuAffinity", 1u << cpu);
+		}
+
+		setProperty(conn, "batchCycles", cycles);
+		setProperty(conn, "bipedModel",  true);
+		setProperty(conn, "bipedBoom",   boom);
+		setProperty(conn, "stopOnFall",  stopOnFall);
+		setProperty(conn, "settleTime",  SWEEP_SETTLE_TIME);
+
+		// The GUI input is written through a port of its own type.
+		RTT::base::PortInterface* guiIn = controller->ports()->getPort("guiInput");
+		if (guiIn) {
+			guiMsg = guiIn->getTypeInfo()->buildValue();
+			guiOut = guiIn->getTypeInfo()->outputPort("sweep_input");
+			ok     = guiMsg && guiOut && guiOut->connectTo(guiIn);
+		}
+
+		std::vector<Setting> settings(inputs);
+		for (size_t i = 0; i < dimensions.size(); i++) {
+			Setting setting = {dimensions[i].name, runs[num][i]};
+			settings.push_back(setting);
+		}
+		for (size_t i = 0; ok && i < settings.size(); i++) {
+			if (setProperty(conn, settings[i].name, settings[i].value))
+				continue;
+			if (!guiMsg || !setField(guiMsg, settings[i].name, settings[i].value)) {
+				fprintf(stderr, "Run %zu: %s is neither a connector property nor a GUI input field\n",
+				        num, settings[i].name.c_str());
+				ok = false;
+			}
+		}
+		if (!ok && guiIn && !guiOut)
+			fprintf(stderr, "Run %zu: could not connect to the controller's GUI input\n", num);
+	}
+
+	if (ok) {
+		ok = rt->configure() && conn->configure() && controller->configure() &&
+		     rt->start() && controller->start();
+		if (!ok)
+			fprintf(stderr, "Run %zu: could not start the stack\n", num);
+	}
+
+	if (ok) {
+		if (guiOut)
+			guiOut->write(guiMsg);
+
+		RTT::OperationCaller<bool(void)>        waitForBatch = conn->provides("connector")->getOperation("waitForBatch");
+		RTT::OperationCaller<std::string(void)> getSummary   = conn->provides("connector")->getOperation("getSummary");
+		RTT::OperationCaller<std::string(void)> getHeader    = conn->provides("connector")->getOperation("getSummaryHeader");
+		ok = conn->start();
+		if (ok && !waitForBatch()) {
+			fprintf(stderr, "Run %zu: the controller stopped answering\n", num);
+			ok = false;
+		}
+		if (ok) {
+			summary = getSummary();
+			header  = getHeader();
+			ok      = !summary.empty();
+		}
+	}
+
+	if (conn)
+		conn->stop();
+	if (controller)
+		controller->stop();
+	if (rt)
+		rt->stop();
+	if (guiOut) {
+		guiOut->disconnect();
+		delete guiOut;
+	}
+
+	RTT::os::MutexLock lock(loaderLock);
+	RTT::TaskContext* components[3] = {controller, conn, rt};
+	for (int i = 0; i < 3; i++) {
+		if (!components[i])
+			continue;
+		components[i]->cleanup();
+		loader->unloadComponent(components[i]);
+	}
+	return ok;
+}
+
+static void* worker(void* arg) {
+	int slot = (int) (intptr_t) arg;
+	int cpu  = slot % sysconf(_SC_NPROCESSORS_ONLN);
+
+	cpu_set_t cpus;
+	CPU_ZERO(&cpus);
+	CPU_SET(cpu, &cpus);
+	pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+
+	size_t num;
+	while ((num = nextRun++) < runs.size()) {
+		std::string summary, header;
+		bool        ok = runOne(num, slot, cpu, summary, header);
+
+		RTT::os::MutexLock lock(outputLock);
+		if (ok && !headerWritten) {
+			fprintf(output, "run");
+			for (size_t i = 0; i < dimensions.size(); i++)
+				fprintf(output, ",%s", dimensions[i].name.c_str());
+			fprintf(output, ",%s\n", header.c_str());
+			headerWritten = true;
+		}
+		if (ok) {
+			fprintf(output, "%zu", num);
+			for (size_t i = 0; i < runs[num].size(); i++)
+				fprintf(output, ",%.9g", runs[num][i]);
+			fprintf(output, ",%s\n", summary.c_str());
+			fflush(output);
+		}
+		printf("[%zu/%zu] %s\n", num + 1, runs.size(), ok ? "done" : "failed");
+		fflush(stdout);
+	}
+	return NULL;
+}
+
+int main(int argc, char **argv) {
+	int opt;
+	while ((opt = getopt(argc, argv, "c:j:n:s:b:ko:h")) != -1) {
+		switch (opt) {
+			case 'c': cycles     = atoi(optarg);        break;
+			case 'j': jobs       = atoi(optarg);        break;
+			case 'n': samples    = atoi(optarg);        break;
+			case 's': seed       = atol(optarg);        break;
+			case 'k': stopOnFall = false;               break;
+			case 'o': outputName = optarg;              break;
+			case 'b':
+				if      (!strcmp(optarg, "hopping")) boom = 0;
+				else if (!strcmp(optarg, "walking")) boom = 1;
+				else if (!strcmp(optarg, "free"))    boom = 2;
+				else {
+					usage(argv[0]);
+					return 1;
+				}
+				break;
+			default:
+				usage(argv[0]);
+				return 1;
+		}
+	}
+	if (argc - optind < 3 || cycles <= 0 || samples <= 0) {
+		usage(argv[0]);
+		return 1;
+	}
+	package        = argv[optind];
+	controllerType = argv[optind + 1];
+	if (!readInputs(argv[optind + 2]))
+		return 1;
+	for (int i = optind + 3; i < argc; i++) {
+		if (!parseDimension(argv[i])) {
+			fprintf(stderr, "Could not read sweep \"%s\"\n", argv[i]);
+			return 1;
+		}
+	}
+	buildRuns();
+	if (jobs <= 0)
+		jobs = sysconf(_SC_NPROCESSORS_ONLN);
+	if ((size_t) jobs > runs.size())
+		jobs = runs.size();
+
+	// Every stack would record to the same files, and drain its logs
+	// through the same aggregator.
+	unsetenv(FLIGHT_RECORDER_DIR_ENV);
+	setenv(LOG_DISABLE_ENV, "1", 1);
+
+	__os_init(argc, argv);
+	RTT::ComponentLoader::shared_ptr loader = RTT::ComponentLoader::Instance();
+	if (!loader->import("atrias_rt_ops", "") || !loader->import("atrias_csim_conn", "") ||
+	    !loader->import(package, "")) {
+		fprintf(stderr, "Could not import the components\n");
+		__os_exit();
+		return 1;
+	}
+
+	output = fopen(outputName.c_str(), "w");
+	if (!output) {
+		fprintf(stderr, "Could not open %s\n", outputName.c_str());
+		__os_exit();
+		return 1;
+	}
+	printf("%zu runs of %d cycles, %d at a time, into %s\n", runs.size(), cycles, jobs, outputName.c_str());
+
+	std::vector<pthread_t> threads(jobs);
+	for (int i = 0; i < jobs; i++)
+		pthread_create(&threads[i], NULL, worker, (void*) (intptr_t) i);
+	for (int i = 0; i < jobs; i++)
+		pthread_join(threads[i], NULL);
+
+	fclose(output);
+	__os_exit();
+	return 0;
+}
+
+// vim: noexpandtab
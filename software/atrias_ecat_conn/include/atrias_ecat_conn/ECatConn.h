@@ -50,13 +50,13 @@ class ECatConn : public RTT::TaskContext {
 		
 		/** @brief By calling this, we cycle RT Ops.
 		  */
-		RTT::OperationCaller<void(atrias_msgs::robot_state)>
+		RTT::OperationCaller<void(const atrias_msgs::robot_state&)>
 			newStateCallback;
 		
 		/** @brief Called by RT Ops w/ updated controller torques.
 		  * @param controller_output The new controller output.
 		  */
-		void sendControllerOutput(atrias_msgs::controller_output controller_output);
+		void sendControllerOutput(const atrias_msgs::controller_output& controller_output);
 		
 		/** @brief Lets us report events, such as a missed deadline.
 		  */
@@ -6,6 +6,7 @@
   */
 
 // Orocos
+#include <rtt/Activity.hpp>
 #include <rtt/os/TimeService.hpp>
 #include <rtt/Logger.hpp>
 
@@ -30,7 +31,27 @@ namespace atrias {
 
 namespace ecatConn {
 
+/** @brief How often the thermistors, voltages, and currents are decoded (seconds).
+  */
+#define MEDULLA_SLOW_DECODE_PERIOD 0.005
+
+/** @brief The CPUs the slow decoding may run on, as a bitmask.
+  * By default any CPU but 0, leaving that core to the realtime threads.
+  * If none of these CPUs are available, it may run on any.
+  */
+#define MEDULLA_SLOW_DECODE_CPUS   (~1u)
+
 class MedullaManager {
+	/** @brief Runs processSlowData() periodically, at a low priority.
+	  */
+	class SlowDecoder : public RTT::Activity {
+		MedullaManager* manager;
+
+		public:
+			SlowDecoder(MedullaManager* manager);
+			void step();
+	};
+
 	// All of our Medullas:
 	medullaDrivers::LegMedulla*  lLegA;
 	medullaDrivers::LegMedulla*  lLegB;
@@ -46,6 +67,15 @@ class MedullaManager {
 	  *       ECat receive thread.
 	  */
 	atrias_msgs::robot_state robotState;
+
+	/** @brief Decodes the slow data off the EtherCAT thread.
+	  */
+	SlowDecoder slowDecoder;
+
+	/** @brief Decodes every Medulla's thermistors, voltages, and currents.
+	  * Runs in slowDecoder's thread.
+	  */
+	void processSlowData();
 	
 	/** @brief Does the slave card-specific init.
 	  */
@@ -115,13 +145,16 @@ class MedullaManager {
 		void start(ec_slavet slaves[], int slavecount);
 		
 		/** @brief Processes our receive data into the robot state.
+		  * This is the time-critical part: positions, velocities, and
+		  * states. The thermistors, voltages, and currents are decoded
+		  * by our slow decoder thread, and the latest values copied in here.
 		  */
 		void processReceiveData();
 		
 		/** @brief Processes controller outputs into SOEM's buffer.
 		  * @param controller_output The controller output.
 		  */
-		void processTransmitData(atrias_msgs::controller_output& controller_output);
+		void processTransmitData(const atrias_msgs::controller_output& controller_output);
 		
 		/** @brief Sets the timestamp in robot state.
 		  * @param timing_info The new timing information
@@ -129,9 +162,9 @@ class MedullaManager {
 		void setTimingInfo(atrias_msgs::robot_state_timing& timing_info);
 
 		/** @brief Allows access to the robot state.
-		  * @return The robot state.
+		  * @return A reference to the robot state. Only valid in the ECat receive thread.
 		  */
-		atrias_msgs::robot_state getRobotState();
+		const atrias_msgs::robot_state& getRobotState() const;
 		
 		/** @brief Lets other classes control the robotConfiguration.
 		  * @param new_robot_configuration The new robot configuration.
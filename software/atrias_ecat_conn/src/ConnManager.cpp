@@ -101,10 +101,15 @@ void ConnManager::loop() {
 		int64_t eCatTime;
 		{
 			RTT::os::MutexLock lock(eCatLock);
-			overshoot = RTT::os::TimeService::Instance()->getNSecs() - targetTime;
+			RTT::os::TimeService::nsecs cycleStart = RTT::os::TimeService::Instance()->getNSecs();
+			overshoot = cycleStart - targetTime;
 			cycleECat();
 			eCatTime = ec_DCtime;
+			RTT::os::TimeService::nsecs receiveStart = RTT::os::TimeService::Instance()->getNSecs();
 			eCatConn->getMedullaManager()->processReceiveData();
+
+			timingInfo.eCatCycleTime = receiveStart - cycleStart;
+			timingInfo.receiveTime   = RTT::os::TimeService::Instance()->getNSecs() - receiveStart;
 		}
 
 		timingInfo.controllerTime = (eCatTime + CONTROLLER_LOOP_OFFSET_NS) -
@@ -151,10 +156,12 @@ void ConnManager::loop() {
 }
 
 void ConnManager::sendControllerOutput(
-                  atrias_msgs::controller_output& controller_output) {
+                  const atrias_msgs::controller_output& controller_output) {
 
 	RTT::os::MutexLock lock(eCatLock);
+	RTT::os::TimeService::nsecs transmitStart = RTT::os::TimeService::Instance()->getNSecs();
 	eCatConn->getMedullaManager()->processTransmitData(controller_output);
+	timingInfo.transmitTime = RTT::os::TimeService::Instance()->getNSecs() - transmitStart;
 	cycleECat();
 	midCycle = false;
 	timingInfo.lastTransmitDCTime = ec_DCtime;
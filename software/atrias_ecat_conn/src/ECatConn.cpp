@@ -56,7 +56,7 @@ void ECatConn::stopHook() {
 	log(RTT::Info) << "[ECatConn] stopped." << RTT::endlog();
 }
 
-void ECatConn::sendControllerOutput(atrias_msgs::controller_output controller_output) {
+void ECatConn::sendControllerOutput(const atrias_msgs::controller_output& controller_output) {
 	connManager->sendControllerOutput(controller_output);
 	return;
 }
@@ -1,9 +1,27 @@
 #include "atrias_ecat_conn/MedullaManager.h"
 
+#include <sched.h>
+
 namespace atrias {
 
 namespace ecatConn {
 
+/** @brief Returns the CPUs the slow decoding may run on: MEDULLA_SLOW_DECODE_CPUS,
+  * or any CPU if we may run on none of those (such as on a single-core machine).
+  */
+static unsigned slowDecodeCpus() {
+	cpu_set_t allowed;
+	CPU_ZERO(&allowed);
+	if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+		for (unsigned cpu = 0; cpu < 8*sizeof(unsigned); cpu++) {
+			if (((MEDULLA_SLOW_DECODE_CPUS >> cpu) & 1u) && CPU_ISSET(cpu, &allowed))
+				return MEDULLA_SLOW_DECODE_CPUS;
+		}
+	}
+
+	return ~0u;
+}
+
 void MedullaManager::InputsConfig(uint8_t* slave_inputs, intptr_t* inputs_array, int num_entries) {
 	for (int i = 0; i < num_entries; i++) {
 		inputs_array[i] = (intptr_t) slave_inputs + i;
@@ -16,7 +34,18 @@ void MedullaManager::OutputsConfig(uint8_t* slave_outputs, intptr_t* outputs_arr
 	}
 }
 
-MedullaManager::MedullaManager() {
+MedullaManager::SlowDecoder::SlowDecoder(MedullaManager* manager) :
+	RTT::Activity(ORO_SCHED_OTHER, 0, MEDULLA_SLOW_DECODE_PERIOD, slowDecodeCpus(), 0, "MedullaSlowDecoder"),
+	manager(manager)
+{}
+
+void MedullaManager::SlowDecoder::step() {
+	manager->processSlowData();
+}
+
+MedullaManager::MedullaManager() :
+	slowDecoder(this)
+{
 	lLegA   = NULL;
 	lLegB   = NULL;
 	rLegA   = NULL;
@@ -28,6 +57,7 @@ MedullaManager::MedullaManager() {
 }
 
 MedullaManager::~MedullaManager() {
+	slowDecoder.stop();
 	delete(lLegA);
 	delete(lLegB);
 	delete(rLegA);
@@ -211,6 +241,7 @@ void MedullaManager::start(ec_slavet slaves[], int slavecount) {
 	} else {
 		log(RTT::Info) << "[ECatConn] Did not identify slave card, configuring for Medulla-based operation." << RTT::endlog();
 		medullasInit(slaves, slavecount);
+		slowDecoder.start();
 	}
 }
 
@@ -233,7 +264,22 @@ void MedullaManager::processReceiveData() {
 		rLegHip->processReceiveData(robotState);
 }
 
-void MedullaManager::processTransmitData(atrias_msgs::controller_output& controller_output) {
+void MedullaManager::processSlowData() {
+	if (lLegA)
+		lLegA->processSlowData();
+	if (lLegB)
+		lLegB->processSlowData();
+	if (rLegA)
+		rLegA->processSlowData();
+	if (rLegB)
+		rLegB->processSlowData();
+	if (lLegHip)
+		lLegHip->processSlowData();
+	if (rLegHip)
+		rLegHip->processSlowData();
+}
+
+void MedullaManager::processTransmitData(const atrias_msgs::controller_output& controller_output) {
 	if (lLegA)
 		lLegA->processTransmitData(controller_output);
 	if (lLegB)
@@ -258,7 +304,7 @@ void MedullaManager::setTimingInfo(atrias_msgs::robot_state_timing& timing_info)
 	robotState.timing            = timing_info;
 }
 
-atrias_msgs::robot_state MedullaManager::getRobotState() {
+const atrias_msgs::robot_state& MedullaManager::getRobotState() const {
 	return robotState;
 }
 
@@ -13,6 +13,8 @@
 #include <robot_invariant_defs.h>
 #include <robot_variant_defs.h>
 #include <gtkmm.h>
+#include <map>
+#include <string>
 #include <atrias_msgs/rt_ops_cycle.h>
 #include <atrias_msgs/robot_state_legHalf.h>
 #include <atrias_msgs/robot_state_hip.h>
@@ -27,11 +29,21 @@ public:
     StatusGui(char *path);
     virtual ~StatusGui();
 
-    void update(rt_ops_cycle);
+    void update(const rt_ops_cycle &rtCycle);
 
 private:
     void update_medulla_errors(uint8_t errorFlags, uint8_t limitSwitches, Gtk::Entry *errorEntry);
-    void update_robot_status(rt_ops_cycle);
+    void update_robot_status(const rt_ops_cycle &rtCycle);
+
+    // Set a widget's contents, unless it's already showing them. Most fields
+    // don't change between frames, and redrawing every widget every frame is
+    // most of the GUI's work.
+    void set_text(Gtk::Entry *entry, const Glib::ustring &text);
+    void set_fraction(Gtk::ProgressBar *bar, double fraction);
+
+    // What each widget is showing
+    std::map<Gtk::Entry*, Glib::ustring> shownText;
+    std::map<Gtk::ProgressBar*, double> shownFraction;
 
     // CPU Usage variables
     uint16_t usage[CPU_USAGE_AVERAGE_TICKS];
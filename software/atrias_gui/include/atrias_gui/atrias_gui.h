@@ -19,10 +19,12 @@
 
 #include <ros/ros.h>
 #include <ros/package.h>
+#include <ros/callback_queue.h>
 
 #include <atrias_shared/globals.h>
 #include <atrias_shared/controller_metadata.h>
 #include <atrias_shared/drl_math.h>
+#include <atrias_shared/Mailbox.h>
 
 #include <atrias_msgs/rt_ops_cycle.h>
 #include <atrias_msgs/gui_input.h>
@@ -33,6 +35,9 @@
 
 #define CONTROLLER_LOAD_PAGE 0
 
+// The default rate at which the leg drawing and status window are redrawn (Hz)
+#define DEFAULT_FRAME_RATE 20.0
+
 using namespace atrias_msgs;
 
 namespace atrias {
@@ -76,9 +81,18 @@ ros::Publisher atrias_gui_logger_output;
 
 gui_input gi;
 gui_output go;
-rt_ops_cycle rtCycle;
 log_request logRequest;
 
+// The robot state is received on its own thread, and only the latest is kept
+// for the next redraw.
+ros::CallbackQueue rtCallbackQueue;
+shared::Mailbox<rt_ops_cycle> rtCycleMailbox;
+double frameRate;
+
+// The leg angles last drawn, so an unchanged drawing isn't redrawn
+double drawnLegAngles[8];
+bool legsDrawn;
+
 StatusGui *statusGui;
 
 Glib::RefPtr<Gtk::ListStore> controllerListStore;
@@ -108,8 +122,6 @@ void (*controllerGetParameters)();
 void (*controllerSetParameters)();
 
 bool controller_loaded;
-bool robotStateInitialized;
-bool newRobotState;
 
 bool load_controller(std::string name, uint16_t controllerID);
 void unload_controller(std::string name);
@@ -120,6 +132,8 @@ void controller_checkbox_toggled(const Gtk::TreeModel::Path& path, const Gtk::Tr
 
 void show_error_dialog(std::string message);
 bool callSpinOnce();
+bool redraw();
+bool drawing_area_exposed(GdkEventExpose *event);
 void changeEstopButtonColor(Gdk::Color newColor);
 void estop_button_clicked();
 void log_chkbox_toggled();
@@ -134,7 +148,7 @@ void takedown_current_controller();
 
 void switch_controllers(GtkNotebookPage *, guint);
 
-void draw_leg();
+void draw_leg(const rt_ops_cycle &rtCycle);
 
 } // namespace gui
 } // namespace atrias
@@ -7,6 +7,8 @@
 
 #include <atrias_gui/StatusGui.h>
 
+#include <math.h>
+
 StatusGui::StatusGui(char *path) {
     // Create the relative path to the Glade file.
     std::string glade_gui_path = std::string(path);
@@ -109,86 +111,105 @@ StatusGui::~StatusGui() {
 
 }
 
-void StatusGui::update(rt_ops_cycle rtCycle) {
+void StatusGui::update(const rt_ops_cycle &rtCycle) {
     update_robot_status(rtCycle);
 }
 
-void StatusGui::update_robot_status(rt_ops_cycle rtCycle) {
+void StatusGui::set_text(Gtk::Entry *entry, const Glib::ustring &text) {
+    std::map<Gtk::Entry*, Glib::ustring>::iterator shown = shownText.find(entry);
+    if (shown != shownText.end() && shown->second == text)
+        return;
+
+    shownText[entry] = text;
+    entry->set_text(text);
+}
+
+void StatusGui::set_fraction(Gtk::ProgressBar *bar, double fraction) {
+    std::map<Gtk::ProgressBar*, double>::iterator shown = shownFraction.find(bar);
+    // A bar's a few hundred pixels wide at most; smaller changes don't show.
+    if (shown != shownFraction.end() && fabs(shown->second - fraction) < 0.002)
+        return;
+
+    shownFraction[bar] = fraction;
+    bar->set_fraction(fraction);
+}
+
+void StatusGui::update_robot_status(const rt_ops_cycle &rtCycle) {
     char buffer[20];
 
     // Boom
     sprintf(buffer, "%0.4f Rad", rtCycle.robotState.position.xAngle);
-    azPosDisplay->set_text(buffer);
+    set_text(azPosDisplay, buffer);
     sprintf(buffer, "%0.4f Rad", rtCycle.robotState.position.boomAngle);
-    elPosDisplay->set_text(buffer);
+    set_text(elPosDisplay, buffer);
     sprintf(buffer, "%0.4f Rad/s", rtCycle.robotState.position.xAngleVelocity);
-    azVelDisplay->set_text(buffer);
+    set_text(azVelDisplay, buffer);
     sprintf(buffer, "%0.4f Rad/s", rtCycle.robotState.position.boomAngleVelocity);
-    elVelDisplay->set_text(buffer);
+    set_text(elVelDisplay, buffer);
 
     // Torso
     sprintf(buffer, "%0.4f m", rtCycle.robotState.position.xPosition);
-    xPosDisplay->set_text(buffer);
+    set_text(xPosDisplay, buffer);
     sprintf(buffer, "%0.4f m", rtCycle.robotState.position.yPosition);
-    yPosDisplay->set_text(buffer);
+    set_text(yPosDisplay, buffer);
     sprintf(buffer, "%0.4f m", rtCycle.robotState.position.zPosition);
-    zPosDisplay->set_text(buffer);
+    set_text(zPosDisplay, buffer);
     sprintf(buffer, "%0.4f m/s", rtCycle.robotState.position.xVelocity);
-    xVelDisplay->set_text(buffer);
+    set_text(xVelDisplay, buffer);
     sprintf(buffer, "%0.4f m/s", rtCycle.robotState.position.yVelocity);
-    yVelDisplay->set_text(buffer);
+    set_text(yVelDisplay, buffer);
     sprintf(buffer, "%0.4f m/s", rtCycle.robotState.position.zVelocity);
-    zVelDisplay->set_text(buffer);
+    set_text(zVelDisplay, buffer);
 
     // Legs
     sprintf(buffer, "%0.4f m", LEG_LENGTH(rtCycle.robotState.lLeg.halfA.legAngle, rtCycle.robotState.lLeg.halfB.legAngle));
-    leftLegLengthDisplay->set_text(buffer);
+    set_text(leftLegLengthDisplay, buffer);
     sprintf(buffer, "%0.4f Rad", LEG_ANGLE(rtCycle.robotState.lLeg.halfA.legAngle, rtCycle.robotState.lLeg.halfB.legAngle));
-    leftLegAngleDisplay->set_text(buffer);
+    set_text(leftLegAngleDisplay, buffer);
     sprintf(buffer, "%0.4f m", LEG_LENGTH(rtCycle.robotState.rLeg.halfA.legAngle, rtCycle.robotState.rLeg.halfB.legAngle));
-    rightLegLengthDisplay->set_text(buffer);
+    set_text(rightLegLengthDisplay, buffer);
     sprintf(buffer, "%0.4f Rad", LEG_ANGLE(rtCycle.robotState.rLeg.halfA.legAngle, rtCycle.robotState.rLeg.halfB.legAngle));
-    rightLegAngleDisplay->set_text(buffer);
+    set_text(rightLegAngleDisplay, buffer);
     sprintf(buffer, "%0.4f Rad", rtCycle.robotState.lLeg.hip.legBodyAngle);
-    leftHipAngleDisplay->set_text(buffer);
+    set_text(leftHipAngleDisplay, buffer);
     sprintf(buffer, "%0.4f Rad", rtCycle.robotState.rLeg.hip.legBodyAngle);
-    rightHipAngleDisplay->set_text(buffer);
+    set_text(rightHipAngleDisplay, buffer);
 
     // Springs
     sprintf(buffer, "%0.4f Rad", rtCycle.robotState.lLeg.halfA.motorAngle - rtCycle.robotState.lLeg.halfA.legAngle);
-    spring_deflection_left_A_entry->set_text(buffer);
+    set_text(spring_deflection_left_A_entry, buffer);
     sprintf(buffer, "%0.4f Rad", rtCycle.robotState.lLeg.halfB.motorAngle - rtCycle.robotState.lLeg.halfB.legAngle);
-    spring_deflection_left_B_entry->set_text(buffer);
+    set_text(spring_deflection_left_B_entry, buffer);
     sprintf(buffer, "%0.4f Rad", rtCycle.robotState.rLeg.halfA.motorAngle - rtCycle.robotState.rLeg.halfA.legAngle);
-    spring_deflection_right_A_entry->set_text(buffer);
+    set_text(spring_deflection_right_A_entry, buffer);
     sprintf(buffer, "%0.4f Rad", rtCycle.robotState.rLeg.halfB.motorAngle - rtCycle.robotState.rLeg.halfB.legAngle);
-    spring_deflection_right_B_entry->set_text(buffer);
+    set_text(spring_deflection_right_B_entry, buffer);
 
     // Motors
     sprintf(buffer, "%0.4f A", rtCycle.commandedOutput.lLeg.motorCurrentA);
-    torqueLeftADisplay->set_text(buffer);
-    motor_torqueLeftA_progress_bar->set_fraction(MIN(ABS(rtCycle.commandedOutput.lLeg.motorCurrentA), MAX_MTR_CURRENT_CMD ) / MAX_MTR_CURRENT_CMD );
+    set_text(torqueLeftADisplay, buffer);
+    set_fraction(motor_torqueLeftA_progress_bar, MIN(ABS(rtCycle.commandedOutput.lLeg.motorCurrentA), MAX_MTR_CURRENT_CMD ) / MAX_MTR_CURRENT_CMD );
     sprintf(buffer, "%0.4f A", rtCycle.commandedOutput.lLeg.motorCurrentB);
-    torqueLeftBDisplay->set_text(buffer);
-    motor_torqueLeftB_progress_bar->set_fraction(MIN(ABS(rtCycle.commandedOutput.lLeg.motorCurrentB), MAX_MTR_CURRENT_CMD ) / MAX_MTR_CURRENT_CMD );
+    set_text(torqueLeftBDisplay, buffer);
+    set_fraction(motor_torqueLeftB_progress_bar, MIN(ABS(rtCycle.commandedOutput.lLeg.motorCurrentB), MAX_MTR_CURRENT_CMD ) / MAX_MTR_CURRENT_CMD );
     sprintf(buffer, "%0.4f A", rtCycle.commandedOutput.lLeg.motorCurrentHip);
-    torqueLeftHipDisplay->set_text(buffer);    
-    motor_torqueLeftHip_progress_bar->set_fraction(MIN(ABS(rtCycle.commandedOutput.lLeg.motorCurrentHip), MAX_MTR_CURRENT_CMD ) / MAX_MTR_CURRENT_CMD );
+    set_text(torqueLeftHipDisplay, buffer);    
+    set_fraction(motor_torqueLeftHip_progress_bar, MIN(ABS(rtCycle.commandedOutput.lLeg.motorCurrentHip), MAX_MTR_CURRENT_CMD ) / MAX_MTR_CURRENT_CMD );
     sprintf(buffer, "%0.4f A", rtCycle.commandedOutput.rLeg.motorCurrentA);
-    torqueRightADisplay->set_text(buffer);
-    motor_torqueRightA_progress_bar->set_fraction(MIN(ABS(rtCycle.commandedOutput.rLeg.motorCurrentA), MAX_MTR_CURRENT_CMD ) / MAX_MTR_CURRENT_CMD );
+    set_text(torqueRightADisplay, buffer);
+    set_fraction(motor_torqueRightA_progress_bar, MIN(ABS(rtCycle.commandedOutput.rLeg.motorCurrentA), MAX_MTR_CURRENT_CMD ) / MAX_MTR_CURRENT_CMD );
     sprintf(buffer, "%0.4f A", rtCycle.commandedOutput.rLeg.motorCurrentB);
-    torqueRightBDisplay->set_text(buffer);
-    motor_torqueRightB_progress_bar->set_fraction(MIN(ABS(rtCycle.commandedOutput.rLeg.motorCurrentB), MAX_MTR_CURRENT_CMD ) / MAX_MTR_CURRENT_CMD );
+    set_text(torqueRightBDisplay, buffer);
+    set_fraction(motor_torqueRightB_progress_bar, MIN(ABS(rtCycle.commandedOutput.rLeg.motorCurrentB), MAX_MTR_CURRENT_CMD ) / MAX_MTR_CURRENT_CMD );
     sprintf(buffer, "%0.4f A", rtCycle.commandedOutput.rLeg.motorCurrentHip);
-    torqueRightHipDisplay->set_text(buffer);
-    motor_torqueRightHip_progress_bar->set_fraction(MIN(ABS(rtCycle.commandedOutput.rLeg.motorCurrentHip), MAX_MTR_CURRENT_CMD ) / MAX_MTR_CURRENT_CMD );
+    set_text(torqueRightHipDisplay, buffer);
+    set_fraction(motor_torqueRightHip_progress_bar, MIN(ABS(rtCycle.commandedOutput.rLeg.motorCurrentHip), MAX_MTR_CURRENT_CMD ) / MAX_MTR_CURRENT_CMD );
 
     // Toes
     sprintf(buffer, "%0.4u --> %0.1u", rtCycle.robotState.lLeg.toeSwitch, rtCycle.robotState.lLeg.onGround);
-    leftToeDisplay->set_text(buffer);
+    set_text(leftToeDisplay, buffer);
     sprintf(buffer, "%0.4u --> %0.1u", rtCycle.robotState.rLeg.toeSwitch, rtCycle.robotState.rLeg.onGround);
-    rightToeDisplay->set_text(buffer);
+    set_text(rightToeDisplay, buffer);
 
     // Medullas
     update_medulla_errors(rtCycle.robotState.lLeg.halfA.errorFlags,rtCycle.robotState.lLeg.halfA.limitSwitches,medullaLAError_entry);
@@ -201,21 +222,21 @@ void StatusGui::update_robot_status(rt_ops_cycle rtCycle) {
 
     // Voltage
     sprintf(buffer, "%0.4f V", rtCycle.robotState.lLeg.halfA.logicVoltage);
-    leftALogicVoltage->set_text(buffer);
+    set_text(leftALogicVoltage, buffer);
     sprintf(buffer, "%0.4f V", rtCycle.robotState.lLeg.halfB.logicVoltage);
-    leftBLogicVoltage->set_text(buffer);
+    set_text(leftBLogicVoltage, buffer);
     sprintf(buffer, "%0.4f V", rtCycle.robotState.rLeg.halfA.logicVoltage);
-    rightALogicVoltage->set_text(buffer);
+    set_text(rightALogicVoltage, buffer);
     sprintf(buffer, "%0.4f V", rtCycle.robotState.rLeg.halfB.logicVoltage);
-    rightBLogicVoltage->set_text(buffer);
+    set_text(rightBLogicVoltage, buffer);
     sprintf(buffer, "%0.4f V", rtCycle.robotState.lLeg.halfA.motorVoltage);
-    leftAMotorVoltage->set_text(buffer);
+    set_text(leftAMotorVoltage, buffer);
     sprintf(buffer, "%0.4f V", rtCycle.robotState.lLeg.halfB.motorVoltage);
-    leftBMotorVoltage->set_text(buffer);
+    set_text(leftBMotorVoltage, buffer);
     sprintf(buffer, "%0.4f V", rtCycle.robotState.rLeg.halfA.motorVoltage);
-    rightAMotorVoltage->set_text(buffer);
+    set_text(rightAMotorVoltage, buffer);
     sprintf(buffer, "%0.4f V", rtCycle.robotState.rLeg.halfB.motorVoltage);
-    rightBMotorVoltage->set_text(buffer);
+    set_text(rightBMotorVoltage, buffer);
     
     //TODO: Fix this
     /*if (usageIndex < CPU_USAGE_AVERAGE_TICKS) {
@@ -270,5 +291,5 @@ void StatusGui::update_medulla_errors(uint8_t errorFlags, uint8_t limitSwitches,
     if (limitSwitches & limit_switch_error_extension)
         error += "Extension limit switch, ";
 
-    errorEntry->set_text(error);
+    set_text(errorEntry, error);
 }
@@ -26,7 +26,14 @@ int main (int argc, char **argv) {
 
     //atrias_client = nh.serviceClient<atrias_controllers::atrias_srv>("gui_interface_srv");
     atrias_gui_cm_input = nh.subscribe("gui_input", 0, controllerManagerCallback/*, ros::TransportHints().udp()*/);
-    atrias_gui_rt_input = nh.subscribe("gui_robot_state_in", 0, rtOpsCallback);
+
+    // Receive the robot state on its own thread, so a backlog of messages
+    // never holds up the GUI; the GUI just draws the latest at its frame rate.
+    ros::NodeHandle rt_nh;
+    rt_nh.setCallbackQueue(&rtCallbackQueue);
+    atrias_gui_rt_input = rt_nh.subscribe("gui_robot_state_in", 1, rtOpsCallback);
+    ros::AsyncSpinner rtSpinner(1, &rtCallbackQueue);
+
     atrias_gui_cm_output = nh.advertise<atrias_msgs::gui_output>("gui_output", 0);
     atrias_gui_logger_output = nh.advertise<atrias_msgs::log_request>("atrias_log_request", 0);
 
@@ -35,8 +42,13 @@ int main (int argc, char **argv) {
     //"none" is a special keyword that means keep the torques at 0 until we load an actual controller
 
     controller_loaded = false;
-    robotStateInitialized = false;
-    newRobotState = false;
+    legsDrawn = false;
+
+    ros::NodeHandle("~").param("frame_rate", frameRate, DEFAULT_FRAME_RATE);
+    if (frameRate <= 0.0 || frameRate > 1000.0) {
+        ROS_WARN("GUI: Invalid frame rate %f, using %f Hz.", frameRate, DEFAULT_FRAME_RATE);
+        frameRate = DEFAULT_FRAME_RATE;
+    }
 
     Gtk::Main gtk(argc, argv);
 
@@ -130,11 +142,15 @@ int main (int argc, char **argv) {
     save_parameters_button->signal_clicked().connect(sigc::ptr_fun((void(*)())save_parameters));
     load_parameters_button->signal_clicked().connect(sigc::ptr_fun((void(*)())load_parameters));
     controller_notebook->signal_switch_page().connect(sigc::ptr_fun((void(*)(GtkNotebookPage*, guint))switch_controllers));
-    sigc::connection conn = Glib::signal_timeout().connect(sigc::ptr_fun(callSpinOnce), 20); // 100 is the timeout in milliseconds
+    drawing_area->signal_expose_event().connect(sigc::ptr_fun(drawing_area_exposed));
+    sigc::connection conn = Glib::signal_timeout().connect(sigc::ptr_fun(callSpinOnce), 20); // 20 is the timeout in milliseconds
+    sigc::connection redrawConn = Glib::signal_timeout().connect(sigc::ptr_fun(redraw), (unsigned int) (1000.0 / frameRate));
 
     statusGui = new StatusGui(argv[0]);
+    rtSpinner.start();
 
     gtk.run(*controller_window); //When this exits the GUI has been closed
+    rtSpinner.stop();
 
     //Now we want to disable and unload the controller before we close out
     disable_motors();
@@ -150,19 +166,40 @@ bool callSpinOnce() {
     ros::spinOnce();
     if (controller_loaded)
         controllerUpdate();
-    if (newRobotState) {
-        statusGui->update(rtCycle);
-        newRobotState = false;
+    return true;
+}
+
+//! @brief Redraws the legs and status window with the latest robot state, if
+//! one has arrived since the last frame. Intermediate states are skipped.
+bool redraw() {
+    if (!rtCycleMailbox.update())
+        return true;
+
+    const rt_ops_cycle &cycle = rtCycleMailbox.read();
+    const robot_state_legHalf *halves[4] = {&cycle.robotState.lLeg.halfA, &cycle.robotState.lLeg.halfB,
+                                            &cycle.robotState.rLeg.halfA, &cycle.robotState.rLeg.halfB};
+    bool legsChanged = !legsDrawn;
+    for (int i = 0; i < 4; i++) {
+        if (halves[i]->legAngle != drawnLegAngles[2*i] || halves[i]->motorAngle != drawnLegAngles[2*i + 1])
+            legsChanged = true;
     }
+    if (legsChanged)
+        draw_leg(cycle);
+
+    statusGui->update(cycle);
+    return true;
+}
+
+//! @brief Redraws the legs when the drawing area has been uncovered.
+bool drawing_area_exposed(GdkEventExpose *event) {
+    if (rtCycleMailbox.hasValue())
+        draw_leg(rtCycleMailbox.read());
     return true;
 }
 
+//! @brief Runs on the robot state thread; hands the state to the GUI thread.
 void rtOpsCallback(const rt_ops_cycle &cycle) {
-    rtCycle = cycle;
-    robotStateInitialized = true;
-    draw_leg();
-    statusGui->update(rtCycle);
-    newRobotState = true;
+    rtCycleMailbox.post(cycle);
 }
 
 //! \brief Update visualization data.
@@ -480,7 +517,7 @@ void show_error_dialog(std::string message) {
 }
 
 //! @brief Draws the four legs of Atrias in the simulation (the carrot).
-void draw_leg () {
+void draw_leg(const rt_ops_cycle &rtCycle) {
     float segment_length = 115.;
     float short_segment_length = 90.;
     float motor_radius = 60.;
@@ -499,6 +536,14 @@ void draw_leg () {
     double legBKneeX;
     double legBKneeY;
 
+    const robot_state_legHalf *halves[4] = {&rtCycle.robotState.lLeg.halfA, &rtCycle.robotState.lLeg.halfB,
+                                            &rtCycle.robotState.rLeg.halfA, &rtCycle.robotState.rLeg.halfB};
+    for (int i = 0; i < 4; i++) {
+        drawnLegAngles[2*i]     = halves[i]->legAngle;
+        drawnLegAngles[2*i + 1] = halves[i]->motorAngle;
+    }
+    legsDrawn = true;
+
     drawing_area->get_window()->clear();
     cc = drawing_area->get_window()->create_cairo_context();
 
@@ -128,7 +128,7 @@ class BoomMedulla : public Medulla {
 		
 		/** @brief Tells this medulla to read in data for transmission.
 		  */
-		void processTransmitData(atrias_msgs::controller_output& controller_output);
+		void processTransmitData(const atrias_msgs::controller_output& controller_output);
 		
 		/** @brief Tells this Medulla to update the robot state.
 		  */
@@ -12,6 +12,7 @@
 #include <robot_invariant_defs.h>
 #include <robot_variant_defs.h>
 #include <atrias_shared/globals.h>
+#include <atrias_shared/Mailbox.h>
 #include "atrias_medulla_drivers/Medulla.h"
 
 namespace atrias {
@@ -77,7 +78,7 @@ class HipMedulla : public Medulla {
 	  * the current command.
 	  * @return The motor current command value.
 	  */
-	int32_t calcMotorCurrentOut(atrias_msgs::controller_output& controllerOutput);
+	int32_t calcMotorCurrentOut(const atrias_msgs::controller_output& controllerOutput);
 	
 	/** @brief Updates the limit switch values in robotState w/ the
 	  * new values from the Medulla.
@@ -97,6 +98,45 @@ class HipMedulla : public Medulla {
 	/** @brief The PDOEntryDatas array.
 	  */
 	PDOEntryData pdoEntryDatas[MEDULLA_HIP_TX_PDO_COUNT+MEDULLA_HIP_RX_PDO_COUNT];
+
+	/** @brief The raw readings that are decoded off the EtherCAT thread.
+	  */
+	struct SlowInputs {
+		uint16_t thermistors[3];
+		uint16_t motorVoltage;
+		uint16_t logicVoltage;
+		int16_t  ampCurrent;
+		uint16_t currentPositive;
+		uint16_t currentNegative;
+	};
+
+	/** @brief Their decoded values.
+	  */
+	struct SlowOutputs {
+		double   thermistors[3];
+		double   motorVoltage;
+		double   logicVoltage;
+		double   ampCurrent;
+		double   currentPositive;
+		double   currentNegative;
+	};
+
+	/** @brief Passes the raw readings to processSlowData().
+	  */
+	shared::Mailbox<SlowInputs>  slowInputs;
+
+	/** @brief Passes the decoded values back.
+	  */
+	shared::Mailbox<SlowOutputs> slowOutputs;
+
+
+	/** @brief Copies the thermistor, voltage, and current readings for processSlowData().
+	  */
+	void    captureSlowInputs();
+
+	/** @brief Stores the latest values from processSlowData() in the robot state.
+	  */
+	void    applySlowOutputs(atrias_msgs::robot_state& robotState);
 	
 	public:
 		/** @brief Does the slave-specific init.
@@ -119,11 +159,19 @@ class HipMedulla : public Medulla {
 		
 		/** @brief Tells this medulla to read in data for transmission.
 		  */
-		void processTransmitData(atrias_msgs::controller_output& controller_output);
+		void processTransmitData(const atrias_msgs::controller_output& controller_output);
 		
 		/** @brief Tells this Medulla to update the robot state.
+		  * Only the positions, velocities, and states are decoded here; the
+		  * thermistors, voltages, and currents are handed to processSlowData(),
+		  * and its latest results stored.
 		  */
 		void processReceiveData(atrias_msgs::robot_state& robot_state);
+
+		/** @brief Decodes the thermistors, voltages, and currents.
+		  * Call this from a lower-priority thread than processReceiveData().
+		  */
+		void processSlowData();
 };
 
 }
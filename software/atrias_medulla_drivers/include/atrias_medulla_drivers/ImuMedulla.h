@@ -84,7 +84,7 @@ class ImuMedulla : public Medulla {
 
 		/** @brief Tells this medulla to read in data for transmission.
 		  */
-		void processTransmitData(atrias_msgs::controller_output& controller_output);
+		void processTransmitData(const atrias_msgs::controller_output& controller_output);
 
 		/** @brief Tells this Medulla to update the robot state.
 		  */
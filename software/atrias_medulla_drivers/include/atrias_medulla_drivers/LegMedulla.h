@@ -14,6 +14,7 @@
 #include <atrias_msgs/controller_output.h>
 #include <atrias_msgs/robot_state.h>
 #include <atrias_shared/globals.h>
+#include <atrias_shared/Mailbox.h>
 #include "robot_invariant_defs.h"
 #include "robot_variant_defs.h"
 #include "atrias_medulla_drivers/Medulla.h"
@@ -93,6 +94,35 @@ class LegMedulla : public Medulla {
 	/** @brief The PDOEntryDatas array.
 	  */
 	PDOEntryData pdoEntryDatas[MEDULLA_LEG_TX_PDO_COUNT+MEDULLA_LEG_RX_PDO_COUNT];
+
+	/** @brief The raw readings that are decoded off the EtherCAT thread.
+	  */
+	struct SlowInputs {
+		uint16_t thermistors[6];
+		uint16_t motorVoltage;
+		uint16_t logicVoltage;
+		int16_t  amp1Current;
+		int16_t  amp2Current;
+	};
+
+	/** @brief Their decoded values.
+	  */
+	struct SlowOutputs {
+		double   thermistors[6];
+		double   motorVoltage;
+		double   logicVoltage;
+		double   amp1Current;
+		double   amp2Current;
+	};
+
+	/** @brief Passes the raw readings to processSlowData().
+	  */
+	shared::Mailbox<SlowInputs>  slowInputs;
+
+	/** @brief Passes the decoded values back.
+	  */
+	shared::Mailbox<SlowOutputs> slowOutputs;
+
 	
 	/** @brief Check for spikes in the encoder data.
 	  */
@@ -101,7 +131,7 @@ class LegMedulla : public Medulla {
 	/** @brief Calculates the current command to send to the Medulla.
 	  * @return The value that should be sent to this Medulla.
 	  */
-	int32_t      calcMotorCurrentOut(atrias_msgs::controller_output& controllerOutput);
+	int32_t      calcMotorCurrentOut(const atrias_msgs::controller_output& controllerOutput);
 	
 	/** @brief  Converts encoder ticks to radians.
 	  * @param  ticks The encoder's reported position.
@@ -120,10 +150,6 @@ class LegMedulla : public Medulla {
 	  */
 	void         processVelocities(RTT::os::TimeService::nsecs deltaTime, atrias_msgs::robot_state& robotState);
 	
-	/** @brief Process all the thermistor values.
-	  */
-	void         processThermistors(atrias_msgs::robot_state& robotState);
-	
 	/** @brief Reads in all the limit switches and updates robotState.
 	  * @param robotState The robot_state in which to store the new values.
 	  * @param reset Whether or not to reset the limit switch values.
@@ -135,13 +161,13 @@ class LegMedulla : public Medulla {
 	  */
 	void         processStrainGauges(atrias_msgs::robot_state&  robotState);
 	
-	/** @brief Processes the motor and logic voltages.
+	/** @brief Copies the thermistor, voltage, and current readings for processSlowData().
 	  */
-	void         processVoltages(atrias_msgs::robot_state& robotState);
-	
-	/** @brief Processes the motor currents and updates the motor states.
+	void         captureSlowInputs();
+
+	/** @brief Stores the latest values from processSlowData() in the robot state.
 	  */
-	void         processCurrents(atrias_msgs::robot_state& robotState);
+	void         applySlowOutputs(atrias_msgs::robot_state& robotState);
 	
 	/** @brief Does the processing for the motor's internal incremental encoders.
 	  * @param deltaTime The time between the DC clock signals for the last and this cycle.
@@ -173,11 +199,19 @@ class LegMedulla : public Medulla {
 		
 		/** @brief Tells this medulla to read in data for transmission.
 		  */
-		void processTransmitData(atrias_msgs::controller_output& controller_output);
+		void processTransmitData(const atrias_msgs::controller_output& controller_output);
 		
 		/** @brief Tells this Medulla to update the robot state.
+		  * Only the positions, velocities, and states are decoded here; the
+		  * thermistors, voltages, and currents are handed to processSlowData(),
+		  * and its latest results stored.
 		  */
 		void processReceiveData(atrias_msgs::robot_state& robot_state);
+
+		/** @brief Decodes the thermistors, voltages, and currents.
+		  * Call this from a lower-priority thread than processReceiveData().
+		  */
+		void processSlowData();
 		
 		/** @brief Gets the ID of this medulla
 		  * @return The medulla's ID.
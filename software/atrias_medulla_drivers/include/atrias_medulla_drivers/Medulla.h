@@ -10,6 +10,10 @@
 
 #include "robot_invariant_defs.h"
 
+/** @brief The number of distinct ADC readings; the ADCs are 12 bits.
+  */
+#define MEDULLA_ADC_VALUES 4096
+
 namespace atrias {
 
 namespace medullaDrivers {
@@ -47,18 +51,43 @@ struct PDORegData {
 
 
 class Medulla {
+	/** @brief The decoded value of every ADC reading, for each conversion.
+	  * Shared by all Medullas; filled by the first one constructed.
+	  */
+	static double   thermistorTable[MEDULLA_ADC_VALUES];
+	static double   logicVoltageTable[MEDULLA_ADC_VALUES];
+	static double   motorVoltageTable[MEDULLA_ADC_VALUES];
+	static bool     tablesBuilt;
+
+	/** @brief Fills the tables. Not realtime safe.
+	  */
+	static void     buildTables();
+
 	protected:
 		/** @brief Holds the counter value for feeding the master watchdog.
 		  */
 		uint16_t        local_counter;
+
+		/** @brief Computes a thermistor's temperature from its ADC reading.
+		  * The tables are built with this and the other compute functions.
+		  */
+		static double   computeThermistorValue(uint16_t adc_value);
+
+		/** @brief Computes a logic voltage from its ADC reading.
+		  */
+		static double   computeLogicVoltage(uint16_t adc_value);
+
+		/** @brief Computes a motor voltage from its ADC reading.
+		  */
+		static double   computeMotorVoltage(uint16_t adc_value);
 			
-		/** @brief Decodes a logic voltage.
+		/** @brief Decodes a logic voltage, by table lookup.
 		  * @param adc_value The voltage value from the ADC.
 		  * @return The logic voltage for this Medulla
 		  */
 		double decodeLogicVoltage(uint16_t adc_value);
 		
-		/** @brief Decodes a motor voltage.
+		/** @brief Decodes a motor voltage, by table lookup.
 		  * @param adc_value The voltage value from the ADC.
 		  * @return The motor voltage for this Medulla
 		  */
@@ -70,7 +99,7 @@ class Medulla {
 		  */
 		double processADCValue(uint16_t adc_value);
 		
-		/** @brief Process an ADC value into a temperature (for thermistors).
+		/** @brief Process an ADC value into a temperature (for thermistors), by table lookup.
 		  * @param adc_value The ADC value reported by the Medulla
 		  * @return The temperature of this thermistor.
 		  */
@@ -84,6 +113,7 @@ class Medulla {
 		
 	public:
 		/** @brief Does a bit of initialization.
+		  * The first Medulla also builds the decoding tables.
 		  */
 		Medulla();
 };
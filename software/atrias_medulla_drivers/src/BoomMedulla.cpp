@@ -180,7 +180,7 @@ void BoomMedulla::processZEncoder(RTT::os::TimeService::nsecs deltaTime, atrias_
     robotState.position.zEncoderRaw = *zEncoder;
 }
 
-void BoomMedulla::processTransmitData(atrias_msgs::controller_output& controller_output) {
+void BoomMedulla::processTransmitData(const atrias_msgs::controller_output& controller_output) {
     *counter = ++local_counter;
     *command = controller_output.command;
 }
@@ -57,7 +57,7 @@ void HipMedulla::postOpInit() {
 	incrementalEncoderInitialized    = false;
 }
 
-int32_t HipMedulla::calcMotorCurrentOut(atrias_msgs::controller_output& controllerOutput) {
+int32_t HipMedulla::calcMotorCurrentOut(const atrias_msgs::controller_output& controllerOutput) {
         // If the ID isn't recognized, command 0 torque.
         double torqueCmd = 0.0;
         
@@ -126,7 +126,7 @@ uint8_t HipMedulla::getID() {
 	return *id;
 }
 
-void HipMedulla::processTransmitData(atrias_msgs::controller_output& controller_output) {
+void HipMedulla::processTransmitData(const atrias_msgs::controller_output& controller_output) {
 	*counter      = ++local_counter;
 	*command      = controller_output.command;
 	*motorCurrent = calcMotorCurrentOut(controller_output);
@@ -134,6 +134,9 @@ void HipMedulla::processTransmitData(atrias_msgs::controller_output& controller_
 
 void HipMedulla::processReceiveData(atrias_msgs::robot_state& robot_state) {
     //log(RTT::Info) << "ID: " << (int) *id << " Counts: " << *hipEncoder << RTT::endlog();
+	// Store whatever processSlowData() has finished
+	applySlowOutputs(robot_state);
+
 	// If we don't have new data, don't run. It's pointless, and results in
 	// NaN velocities.
 	if (*timingCounter == timingCounterValue)
@@ -149,8 +152,6 @@ void HipMedulla::processReceiveData(atrias_msgs::robot_state& robot_state) {
 	switch(*id) {
 		case MEDULLA_LEFT_HIP_ID:
 			hip_ptr = &(robot_state.lLeg.hip);
-			robot_state.currentPositive = ((double)(*currentPositive - ROBOT_CURRENT_POS_50A_OFFSET))*ROBOT_CURRENT_50A_GAIN;
-			robot_state.currentNegative = ((double)(*currentNegative - ROBOT_CURRENT_NEG_50A_OFFSET))*ROBOT_CURRENT_50A_GAIN;
 			break;
 		case MEDULLA_RIGHT_HIP_ID:
 			hip_ptr = &(robot_state.rLeg.hip);
@@ -166,12 +167,7 @@ void HipMedulla::processReceiveData(atrias_msgs::robot_state& robot_state) {
 	
 	hip.medullaState = *state;
 	hip.errorFlags   = *errorFlags;
-	hip.motorVoltage = decodeMotorVoltage(*motorVoltage);
-	hip.logicVoltage = decodeLogicVoltage(*logicVoltage);
-	hip.motorThermA  = processThermistorValue(*thermistor0);
-	hip.motorThermB  = processThermistorValue(*thermistor1);
-	hip.motorThermC  = processThermistorValue(*thermistor2);
-	hip.motorCurrent = processAmplifierCurrent(*ampMeasuredCurrent);
+	captureSlowInputs();
 	/*hip.accelX       = *accelX;
 	hip.accelY       = *accelY;
 	hip.accelZ       = *accelZ;
@@ -190,6 +186,63 @@ void HipMedulla::processReceiveData(atrias_msgs::robot_state& robot_state) {
 	hip.IMUTimer     = *timer;*/
 }
 
+void HipMedulla::captureSlowInputs() {
+	SlowInputs &inputs = slowInputs.writeSlot();
+	inputs.thermistors[0]  = *thermistor0;
+	inputs.thermistors[1]  = *thermistor1;
+	inputs.thermistors[2]  = *thermistor2;
+	inputs.motorVoltage    = *motorVoltage;
+	inputs.logicVoltage    = *logicVoltage;
+	inputs.ampCurrent      = *ampMeasuredCurrent;
+	inputs.currentPositive = *currentPositive;
+	inputs.currentNegative = *currentNegative;
+	slowInputs.publish();
+}
+
+void HipMedulla::processSlowData() {
+	if (!slowInputs.update())
+		return;
+
+	const SlowInputs &inputs = slowInputs.read();
+	SlowOutputs decoded;
+	for (int i = 0; i < 3; i++)
+		decoded.thermistors[i] = processThermistorValue(inputs.thermistors[i]);
+	decoded.motorVoltage    = decodeMotorVoltage(inputs.motorVoltage);
+	decoded.logicVoltage    = decodeLogicVoltage(inputs.logicVoltage);
+	decoded.ampCurrent      = processAmplifierCurrent(inputs.ampCurrent);
+	decoded.currentPositive = ((double)(inputs.currentPositive - ROBOT_CURRENT_POS_50A_OFFSET))*ROBOT_CURRENT_50A_GAIN;
+	decoded.currentNegative = ((double)(inputs.currentNegative - ROBOT_CURRENT_NEG_50A_OFFSET))*ROBOT_CURRENT_50A_GAIN;
+	slowOutputs.post(decoded);
+}
+
+void HipMedulla::applySlowOutputs(atrias_msgs::robot_state& robotState) {
+	if (!slowOutputs.update())
+		return;
+
+	const SlowOutputs &outputs = slowOutputs.read();
+	atrias_msgs::robot_state_hip* hip;
+	switch (*id) {
+		case MEDULLA_LEFT_HIP_ID:
+			hip = &(robotState.lLeg.hip);
+			// The robot's total currents are measured by the left hip
+			robotState.currentPositive = outputs.currentPositive;
+			robotState.currentNegative = outputs.currentNegative;
+			break;
+		case MEDULLA_RIGHT_HIP_ID:
+			hip = &(robotState.rLeg.hip);
+			break;
+		default:
+			return;
+	}
+
+	hip->motorVoltage = outputs.motorVoltage;
+	hip->logicVoltage = outputs.logicVoltage;
+	hip->motorThermA  = outputs.thermistors[0];
+	hip->motorThermB  = outputs.thermistors[1];
+	hip->motorThermC  = outputs.thermistors[2];
+	hip->motorCurrent = outputs.ampCurrent;
+}
+
 }
 
 }
@@ -53,7 +53,7 @@ void ImuMedulla::processIMU(RTT::os::TimeService::nsecs deltaTime, atrias_msgs::
 	robotState.position.imuPitchVelocity = pitch / (((double) deltaTime) / ((double) SECOND_IN_NANOSECONDS));
 }
 
-void ImuMedulla::processTransmitData(atrias_msgs::controller_output& controller_output) {
+void ImuMedulla::processTransmitData(const atrias_msgs::controller_output& controller_output) {
     *counter = ++local_counter;
     *command = controller_output.command;
 }
@@ -165,6 +165,9 @@ void LegMedulla::processIncrementalEncoders(RTT::os::TimeService::nsecs deltaTim
 }
 
 void LegMedulla::processReceiveData(atrias_msgs::robot_state& robot_state) {
+	// Store whatever processSlowData() has finished
+	applySlowOutputs(robot_state);
+
 	// If we don't have new data, don't run. It's pointless, and results in
 	// NaN velocities.
 	if (*timingCounter == timingCounterValue)
@@ -181,11 +184,9 @@ void LegMedulla::processReceiveData(atrias_msgs::robot_state& robot_state) {
 	processPositions(robot_state);
 	processVelocities(deltaTime, robot_state);
 	processIncrementalEncoders(deltaTime, robot_state);
-	processThermistors(robot_state);
 	processLimitSwitches(robot_state, *state == medulla_state_idle);
-	processVoltages(robot_state);
-	processCurrents(robot_state);
 	processStrainGauges(robot_state);
+	captureSlowInputs();
 	switch (*id) {
 		case MEDULLA_LEFT_LEG_A_ID:
 			robot_state.lLeg.halfA.medullaState = *state;
@@ -210,7 +211,7 @@ void LegMedulla::processReceiveData(atrias_msgs::robot_state& robot_state) {
 	}
 }
 
-int32_t LegMedulla::calcMotorCurrentOut(atrias_msgs::controller_output& controllerOutput) {
+int32_t LegMedulla::calcMotorCurrentOut(const atrias_msgs::controller_output& controllerOutput) {
 	// Don't command any amount of torque if we're not enabled.
 	if (controllerOutput.command != medulla_state_run) return 0;
 	
@@ -358,70 +359,6 @@ void LegMedulla::processVelocities(RTT::os::TimeService::nsecs deltaTime, atrias
 	}
 }
 
-void LegMedulla::processThermistors(atrias_msgs::robot_state& robotState) {
-	switch (*id) {
-		case MEDULLA_LEFT_LEG_A_ID:
-			robotState.lLeg.halfA.motorTherms[0] = processThermistorValue(*thermistor0);
-			robotState.lLeg.halfA.motorTherms[1] = processThermistorValue(*thermistor1);
-			robotState.lLeg.halfA.motorTherms[2] = processThermistorValue(*thermistor2);
-			robotState.lLeg.halfA.motorTherms[3] = processThermistorValue(*thermistor3);
-			robotState.lLeg.halfA.motorTherms[4] = processThermistorValue(*thermistor4);
-			robotState.lLeg.halfA.motorTherms[5] = processThermistorValue(*thermistor5);
-			break;
-		case MEDULLA_LEFT_LEG_B_ID:
-			robotState.lLeg.halfB.motorTherms[0] = processThermistorValue(*thermistor0);
-			robotState.lLeg.halfB.motorTherms[1] = processThermistorValue(*thermistor1);
-			robotState.lLeg.halfB.motorTherms[2] = processThermistorValue(*thermistor2);
-			robotState.lLeg.halfB.motorTherms[3] = processThermistorValue(*thermistor3);
-			robotState.lLeg.halfB.motorTherms[4] = processThermistorValue(*thermistor4);
-			robotState.lLeg.halfB.motorTherms[5] = processThermistorValue(*thermistor5);
-			break;
-		case MEDULLA_RIGHT_LEG_A_ID:
-			robotState.rLeg.halfA.motorTherms[0] = processThermistorValue(*thermistor0);
-			robotState.rLeg.halfA.motorTherms[1] = processThermistorValue(*thermistor1);
-			robotState.rLeg.halfA.motorTherms[2] = processThermistorValue(*thermistor2);
-			robotState.rLeg.halfA.motorTherms[3] = processThermistorValue(*thermistor3);
-			robotState.rLeg.halfA.motorTherms[4] = processThermistorValue(*thermistor4);
-			robotState.rLeg.halfA.motorTherms[5] = processThermistorValue(*thermistor5);
-			break;
-		case MEDULLA_RIGHT_LEG_B_ID:
-			robotState.rLeg.halfB.motorTherms[0] = processThermistorValue(*thermistor0);
-			robotState.rLeg.halfB.motorTherms[1] = processThermistorValue(*thermistor1);
-			robotState.rLeg.halfB.motorTherms[2] = processThermistorValue(*thermistor2);
-			robotState.rLeg.halfB.motorTherms[3] = processThermistorValue(*thermistor3);
-			robotState.rLeg.halfB.motorTherms[4] = processThermistorValue(*thermistor4);
-			robotState.rLeg.halfB.motorTherms[5] = processThermistorValue(*thermistor5);
-			break;
-	}
-}
-
-void LegMedulla::processCurrents(atrias_msgs::robot_state& robotState) {
-	double current1 = processAmplifierCurrent(*amp1MeasuredCurrent);
-	double current2 = processAmplifierCurrent(*amp2MeasuredCurrent);
-	switch (*id) {
-		case MEDULLA_LEFT_LEG_A_ID:
-			robotState.lLeg.halfA.amp1Current  = current1;
-			robotState.lLeg.halfA.amp2Current  = current2;
-			robotState.lLeg.halfA.motorCurrent = current1 + current2;
-			break;
-		case MEDULLA_LEFT_LEG_B_ID:
-			robotState.lLeg.halfB.amp1Current  = current1;
-			robotState.lLeg.halfB.amp2Current  = current2;
-			robotState.lLeg.halfB.motorCurrent = current1 + current2;
-			break;
-		case MEDULLA_RIGHT_LEG_A_ID:
-			robotState.rLeg.halfA.amp1Current  = current1;
-			robotState.rLeg.halfA.amp2Current  = current2;
-			robotState.rLeg.halfA.motorCurrent = current1 + current2;
-			break;
-		case MEDULLA_RIGHT_LEG_B_ID:
-			robotState.rLeg.halfB.amp1Current  = current1;
-			robotState.rLeg.halfB.amp2Current  = current2;
-			robotState.rLeg.halfB.motorCurrent = current1 + current2;
-			break;
-	}
-}
-
 void LegMedulla::processLimitSwitches(atrias_msgs::robot_state& robotState, bool reset) {
 	atrias_msgs::robot_state_leg* leg;
 	switch (*id) {
@@ -499,28 +436,69 @@ void LegMedulla::processStrainGauges(atrias_msgs::robot_state& robotState) {
 	}
 }
 
-void LegMedulla::processVoltages(atrias_msgs::robot_state& robotState) {
+void LegMedulla::captureSlowInputs() {
+	SlowInputs &inputs = slowInputs.writeSlot();
+	inputs.thermistors[0] = *thermistor0;
+	inputs.thermistors[1] = *thermistor1;
+	inputs.thermistors[2] = *thermistor2;
+	inputs.thermistors[3] = *thermistor3;
+	inputs.thermistors[4] = *thermistor4;
+	inputs.thermistors[5] = *thermistor5;
+	inputs.motorVoltage   = *motorVoltage;
+	inputs.logicVoltage   = *logicVoltage;
+	inputs.amp1Current    = *amp1MeasuredCurrent;
+	inputs.amp2Current    = *amp2MeasuredCurrent;
+	slowInputs.publish();
+}
+
+void LegMedulla::processSlowData() {
+	if (!slowInputs.update())
+		return;
+
+	const SlowInputs &inputs = slowInputs.read();
+	SlowOutputs decoded;
+	for (int i = 0; i < 6; i++)
+		decoded.thermistors[i] = processThermistorValue(inputs.thermistors[i]);
+	decoded.motorVoltage = decodeMotorVoltage(inputs.motorVoltage);
+	decoded.logicVoltage = decodeLogicVoltage(inputs.logicVoltage);
+	decoded.amp1Current = processAmplifierCurrent(inputs.amp1Current);
+	decoded.amp2Current = processAmplifierCurrent(inputs.amp2Current);
+	slowOutputs.post(decoded);
+}
+
+void LegMedulla::applySlowOutputs(atrias_msgs::robot_state& robotState) {
+	if (!slowOutputs.update())
+		return;
+
+	atrias_msgs::robot_state_legHalf* half;
 	switch (*id) {
 		case MEDULLA_LEFT_LEG_A_ID:
-			robotState.lLeg.halfA.motorVoltage = decodeMotorVoltage(*motorVoltage);
-			robotState.lLeg.halfA.logicVoltage = processADCValue(*logicVoltage) *  6.0;
+			half = &(robotState.lLeg.halfA);
 			break;
 		case MEDULLA_LEFT_LEG_B_ID:
-			robotState.lLeg.halfB.motorVoltage = decodeMotorVoltage(*motorVoltage);
-			robotState.lLeg.halfB.logicVoltage = processADCValue(*logicVoltage) *  6.0;
+			half = &(robotState.lLeg.halfB);
 			break;
 		case MEDULLA_RIGHT_LEG_A_ID:
-			robotState.rLeg.halfA.motorVoltage = decodeMotorVoltage(*motorVoltage);
-			robotState.rLeg.halfA.logicVoltage = processADCValue(*logicVoltage) *  6.0;
+			half = &(robotState.rLeg.halfA);
 			break;
 		case MEDULLA_RIGHT_LEG_B_ID:
-			robotState.rLeg.halfB.motorVoltage = decodeMotorVoltage(*motorVoltage);
-			robotState.rLeg.halfB.logicVoltage = processADCValue(*logicVoltage) *  6.0;
+			half = &(robotState.rLeg.halfB);
 			break;
+		default:
+			return;
 	}
+
+	const SlowOutputs &outputs = slowOutputs.read();
+	for (int i = 0; i < 6; i++)
+		half->motorTherms[i] = outputs.thermistors[i];
+	half->motorVoltage = outputs.motorVoltage;
+	half->logicVoltage = outputs.logicVoltage;
+	half->amp1Current  = outputs.amp1Current;
+	half->amp2Current  = outputs.amp2Current;
+	half->motorCurrent = outputs.amp1Current + outputs.amp2Current;
 }
 
-void LegMedulla::processTransmitData(atrias_msgs::controller_output& controller_output) {
+void LegMedulla::processTransmitData(const atrias_msgs::controller_output& controller_output) {
 	*counter      = ++local_counter;
 	*command      = controller_output.command;
 	*motorCurrent = calcMotorCurrentOut(controller_output);
@@ -4,16 +4,55 @@ namespace atrias {
 
 namespace medullaDrivers {
 
+double Medulla::thermistorTable[MEDULLA_ADC_VALUES];
+double Medulla::logicVoltageTable[MEDULLA_ADC_VALUES];
+double Medulla::motorVoltageTable[MEDULLA_ADC_VALUES];
+bool   Medulla::tablesBuilt = false;
+
 Medulla::Medulla() {
 	local_counter = 0;
+
+	// Medullas are constructed by the connector's init, before any
+	// decoding starts.
+	if (!tablesBuilt)
+		buildTables();
+}
+
+void Medulla::buildTables() {
+	for (int i = 0; i < MEDULLA_ADC_VALUES; i++) {
+		thermistorTable[i]   = computeThermistorValue(i);
+		logicVoltageTable[i] = computeLogicVoltage(i);
+		motorVoltageTable[i] = computeMotorVoltage(i);
+	}
+	tablesBuilt = true;
+}
+
+double Medulla::computeLogicVoltage(uint16_t adc_value) {
+	return ((double) adc_value - MEDULLA_ADC_OFFSET_COUNTS) * (MEDULLA_ADC_MAX_VOLTS/(4095.0)) * 6.0;
+}
+
+double Medulla::computeMotorVoltage(uint16_t adc_value) {
+	return (adc_value-MOTOR_VOLTAGE_C_OFFSET)*MOTOR_VOLTAGE_V_CAL/(MOTOR_VOLTAGE_C_CAL-MOTOR_VOLTAGE_C_OFFSET);
+}
+
+double Medulla::computeThermistorValue(uint16_t adc_value) {
+	// Whoa...
+	// (Copied directly from the old ucontroller.h).
+	double volts = ((double) adc_value - MEDULLA_ADC_OFFSET_COUNTS) * (MEDULLA_ADC_MAX_VOLTS/(4095.0));
+	return ((1.0/( (1.0/298.15) + (1.0/3988.0)*log(4700.0/((3.26/volts) - 1.0)/10000))) - 273.15);
 }
 
 double Medulla::decodeLogicVoltage(uint16_t adc_value) {
-	return processADCValue(adc_value) * 6.0;
+	// Readings past 12 bits shouldn't happen, but compute them rather than overrun.
+	if (adc_value >= MEDULLA_ADC_VALUES)
+		return computeLogicVoltage(adc_value);
+	return logicVoltageTable[adc_value];
 }
 
 double Medulla::decodeMotorVoltage(uint16_t adc_value) {
-	return (adc_value-MOTOR_VOLTAGE_C_OFFSET)*MOTOR_VOLTAGE_V_CAL/(MOTOR_VOLTAGE_C_CAL-MOTOR_VOLTAGE_C_OFFSET);
+	if (adc_value >= MEDULLA_ADC_VALUES)
+		return computeMotorVoltage(adc_value);
+	return motorVoltageTable[adc_value];
 }
 
 double Medulla::processADCValue(uint16_t adc_value) {
@@ -21,9 +60,9 @@ double Medulla::processADCValue(uint16_t adc_value) {
 }
 
 double Medulla::processThermistorValue(uint16_t adc_value) {
-	// Whoa...
-	// (Copied directly from the old ucontroller.h).
-	return ((1.0/( (1.0/298.15) + (1.0/3988.0)*log(4700.0/((3.26/processADCValue(adc_value)) - 1.0)/10000))) - 273.15);
+	if (adc_value >= MEDULLA_ADC_VALUES)
+		return computeThermistorValue(adc_value);
+	return thermistorTable[adc_value];
 }
 
 double Medulla::processAmplifierCurrent(int16_t value) {
@@ -0,0 +1,189 @@
+/** @file
+  * @brief Times the per-cycle decoding of the Medullas' slow ADC readings:
+  * computing or looking up every reading, and computing or looking up only
+  * the readings that changed since the last cycle.
+  *
+  * The readings are simulated for the whole robot (four leg and two hip
+  * Medullas: 30 thermistors, 6 motor and 6 logic voltages). Each cycle the
+  * firmware updates one thermistor per Medulla, and the voltages wander by
+  * an ADC count or so.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "atrias_medulla_drivers/Medulla.h"
+
+using namespace atrias::medullaDrivers;
+
+#define BENCH_MEDULLAS     6
+#define BENCH_THERMISTORS 30
+#define BENCH_CYCLES      10000
+#define BENCH_REPEATS     20
+
+// The raw readings for one cycle.
+struct Readings {
+	uint16_t thermistors[BENCH_THERMISTORS];
+	uint16_t motorVoltages[BENCH_MEDULLAS];
+	uint16_t logicVoltages[BENCH_MEDULLAS];
+};
+
+// Their decoded values.
+struct Decoded {
+	double   thermistors[BENCH_THERMISTORS];
+	double   motorVoltages[BENCH_MEDULLAS];
+	double   logicVoltages[BENCH_MEDULLAS];
+};
+
+// Exposes Medulla's decoding functions.
+class BenchMedulla : public Medulla {
+	public:
+		void compute(const Readings &in, Decoded &out) {
+			for (int i = 0; i < BENCH_THERMISTORS; i++)
+				out.thermistors[i] = computeThermistorValue(in.thermistors[i]);
+			for (int i = 0; i < BENCH_MEDULLAS; i++) {
+				out.motorVoltages[i] = computeMotorVoltage(in.motorVoltages[i]);
+				out.logicVoltages[i] = computeLogicVoltage(in.logicVoltages[i]);
+			}
+		}
+
+		void computeChanged(const Readings &in, const Readings &last, Decoded &out) {
+			for (int i = 0; i < BENCH_THERMISTORS; i++) {
+				if (in.thermistors[i] != last.thermistors[i])
+					out.thermistors[i] = computeThermistorValue(in.thermistors[i]);
+			}
+			for (int i = 0; i < BENCH_MEDULLAS; i++) {
+				if (in.motorVoltages[i] != last.motorVoltages[i])
+					out.motorVoltages[i] = computeMotorVoltage(in.motorVoltages[i]);
+				if (in.logicVoltages[i] != last.logicVoltages[i])
+					out.logicVoltages[i] = computeLogicVoltage(in.logicVoltages[i]);
+			}
+		}
+
+		void lookUp(const Readings &in, Decoded &out) {
+			for (int i = 0; i < BENCH_THERMISTORS; i++)
+				out.thermistors[i] = processThermistorValue(in.thermistors[i]);
+			for (int i = 0; i < BENCH_MEDULLAS; i++) {
+				out.motorVoltages[i] = decodeMotorVoltage(in.motorVoltages[i]);
+				out.logicVoltages[i] = decodeLogicVoltage(in.logicVoltages[i]);
+			}
+		}
+
+		void lookUpChanged(const Readings &in, const Readings &last, Decoded &out) {
+			for (int i = 0; i < BENCH_THERMISTORS; i++) {
+				if (in.thermistors[i] != last.thermistors[i])
+					out.thermistors[i] = processThermistorValue(in.thermistors[i]);
+			}
+			for (int i = 0; i < BENCH_MEDULLAS; i++) {
+				if (in.motorVoltages[i] != last.motorVoltages[i])
+					out.motorVoltages[i] = decodeMotorVoltage(in.motorVoltages[i]);
+				if (in.logicVoltages[i] != last.logicVoltages[i])
+					out.logicVoltages[i] = decodeLogicVoltage(in.logicVoltages[i]);
+			}
+		}
+};
+
+static Readings readings[BENCH_CYCLES];
+
+static double now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint16_t wander(uint16_t value) {
+	return value + rand() % 3 - 1;
+}
+
+static void simulateReadings() {
+	Readings current;
+	for (int i = 0; i < BENCH_THERMISTORS; i++)
+		current.thermistors[i] = 2000 + rand() % 200;
+	for (int i = 0; i < BENCH_MEDULLAS; i++) {
+		current.motorVoltages[i] = 3000;
+		current.logicVoltages[i] = 1500;
+	}
+
+	for (int cycle = 0; cycle < BENCH_CYCLES; cycle++) {
+		// One thermistor per Medulla (5 each, on average) updates per cycle
+		for (int medulla = 0; medulla < BENCH_MEDULLAS; medulla++) {
+			int i = medulla * 5 + cycle % 5;
+			current.thermistors[i] = wander(current.thermistors[i]);
+		}
+		for (int i = 0; i < BENCH_MEDULLAS; i++) {
+			current.motorVoltages[i] = wander(current.motorVoltages[i]);
+			current.logicVoltages[i] = wander(current.logicVoltages[i]);
+		}
+		readings[cycle] = current;
+	}
+}
+
+int main() {
+	BenchMedulla medulla;
+	Decoded      decoded;
+	Decoded      reference;
+	double       start;
+
+	simulateReadings();
+
+	// The tables must match the formulas exactly.
+	for (int cycle = 0; cycle < BENCH_CYCLES; cycle++) {
+		medulla.compute(readings[cycle], reference);
+		medulla.lookUp(readings[cycle], decoded);
+		for (int i = 0; i < BENCH_THERMISTORS; i++) {
+			if (decoded.thermistors[i] != reference.thermistors[i]) {
+				printf("Thermistor table mismatch at ADC value %u\n", readings[cycle].thermistors[i]);
+				return 1;
+			}
+		}
+		for (int i = 0; i < BENCH_MEDULLAS; i++) {
+			if (decoded.motorVoltages[i] != reference.motorVoltages[i] ||
+			    decoded.logicVoltages[i] != reference.logicVoltages[i]) {
+				printf("Voltage table mismatch in cycle %d\n", cycle);
+				return 1;
+			}
+		}
+	}
+
+	start = now();
+	for (int repeat = 0; repeat < BENCH_REPEATS; repeat++) {
+		for (int cycle = 0; cycle < BENCH_CYCLES; cycle++)
+			medulla.compute(readings[cycle], decoded);
+	}
+	double computeTime = (now() - start) / (BENCH_REPEATS * BENCH_CYCLES);
+
+	start = now();
+	for (int repeat = 0; repeat < BENCH_REPEATS; repeat++) {
+		medulla.compute(readings[0], decoded);
+		for (int cycle = 1; cycle < BENCH_CYCLES; cycle++)
+			medulla.computeChanged(readings[cycle], readings[cycle - 1], decoded);
+	}
+	double computeChangedTime = (now() - start) / (BENCH_REPEATS * BENCH_CYCLES);
+
+	start = now();
+	for (int repeat = 0; repeat < BENCH_REPEATS; repeat++) {
+		for (int cycle = 0; cycle < BENCH_CYCLES; cycle++)
+			medulla.lookUp(readings[cycle], decoded);
+	}
+	double lookUpTime = (now() - start) / (BENCH_REPEATS * BENCH_CYCLES);
+
+	start = now();
+	for (int repeat = 0; repeat < BENCH_REPEATS; repeat++) {
+		medulla.lookUp(readings[0], decoded);
+		for (int cycle = 1; cycle < BENCH_CYCLES; cycle++)
+			medulla.lookUpChanged(readings[cycle], readings[cycle - 1], decoded);
+	}
+	double changedTime = (now() - start) / (BENCH_REPEATS * BENCH_CYCLES);
+
+	printf("Per cycle, for %d thermistors and %d voltages:\n", BENCH_THERMISTORS, 2 * BENCH_MEDULLAS);
+	printf("  computed:               %8.1f ns\n", computeTime * 1e9);
+	printf("  computed when changed:  %8.1f ns\n", computeChangedTime * 1e9);
+	printf("  looked up:              %8.1f ns\n", lookUpTime * 1e9);
+	printf("  looked up when changed: %8.1f ns\n", changedTime * 1e9);
+
+	return 0;
+}
+
+// vim: noexpandtab
@@ -0,0 +1,192 @@
+/** @file
+  * @brief Times the leg and hip Medullas' per-cycle decoding:
+  * processReceiveData(), which runs on the EtherCAT thread under eCatLock,
+  * and processSlowData(), which MedullaManager's slow decoder runs on its own
+  * thread. Before the slow readings were moved off the EtherCAT thread, it
+  * did the work of both.
+  *
+  * The Medullas' PDOs are simulated in memory. Each cycle the timing
+  * counters tick, the encoders move a few counts, the firmware updates one
+  * thermistor per Medulla, and the voltages and currents wander by an ADC
+  * count or so.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include <algorithm>
+
+#include <atrias_msgs/robot_state.h>
+
+#include "atrias_medulla_drivers/LegMedulla.h"
+#include "atrias_medulla_drivers/HipMedulla.h"
+
+using namespace atrias::medullaDrivers;
+
+#define BENCH_LEGS    4
+#define BENCH_HIPS    2
+#define BENCH_CYCLES  100000
+
+// Where each reading is in LegMedulla's and HipMedulla's PDO entry lists.
+#define LEG_ID            3
+#define LEG_TIMING        5
+#define LEG_MOTOR_ENC     9
+#define LEG_LEG_ENC      11
+#define LEG_INC_ENC      13
+#define LEG_MOTOR_VOLT   15
+#define LEG_LOGIC_VOLT   16
+#define LEG_THERM0       17
+#define LEG_AMP1         23
+#define LEG_AMP2         24
+#define HIP_ID            3
+#define HIP_TIMING        5
+#define HIP_ENC           8
+#define HIP_MOTOR_VOLT   10
+#define HIP_LOGIC_VOLT   11
+#define HIP_THERM0       12
+#define HIP_AMP          15
+#define HIP_INC_ENC      16
+
+// Enough for the largest Medulla's PDOs.
+#define PDO_BYTES 128
+
+// One simulated Medulla's PDO memory.
+struct SimPDOs {
+	uint8_t memory[PDO_BYTES];
+	void*   entries[PDO_BYTES];
+
+	void map(PDORegData reg) {
+		size_t offset = 0;
+		for (int i = 0; i < reg.inputs + reg.outputs; i++) {
+			*reg.pdoEntryDatas[i].data = entries[i] = memory + offset;
+			offset += reg.pdoEntryDatas[i].size;
+		}
+	}
+
+	template <class T>
+	T& at(int entry) {
+		return *((T*) entries[entry]);
+	}
+};
+
+// Each cycle's times, for the percentiles.
+static double receiveTimes[BENCH_CYCLES];
+static double slowTimes[BENCH_CYCLES];
+static double bothTimes[BENCH_CYCLES];
+
+static double now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void wander(uint16_t &value) {
+	value += rand() % 3 - 1;
+}
+
+static void report(const char* name, double* times) {
+	double total = 0.0;
+	for (int i = 0; i < BENCH_CYCLES; i++)
+		total += times[i];
+	std::sort(times, times + BENCH_CYCLES);
+	printf("  %-24s %8.2f %8.2f %8.2f us\n", name, total / BENCH_CYCLES * 1e6,
+	       times[BENCH_CYCLES * 999 / 1000] * 1e6, times[BENCH_CYCLES - 1] * 1e6);
+}
+
+int main() {
+	LegMedulla legs[BENCH_LEGS];
+	HipMedulla hips[BENCH_HIPS];
+	SimPDOs    legPDOs[BENCH_LEGS];
+	SimPDOs    hipPDOs[BENCH_HIPS];
+	atrias_msgs::robot_state robotState;
+
+	// Start each leg's encoders at their calibration values, so the leg
+	// position offsets are 0.
+	const uint8_t  legIDs[BENCH_LEGS]       = {MEDULLA_LEFT_LEG_A_ID, MEDULLA_LEFT_LEG_B_ID,
+	                                           MEDULLA_RIGHT_LEG_A_ID, MEDULLA_RIGHT_LEG_B_ID};
+	const uint32_t motorCalibs[BENCH_LEGS]  = {LEFT_TRAN_A_CALIB_VAL, LEFT_TRAN_B_CALIB_VAL,
+	                                           RIGHT_TRAN_A_CALIB_VAL, RIGHT_TRAN_B_CALIB_VAL};
+	const uint32_t legCalibs[BENCH_LEGS]    = {LEFT_LEG_A_CALIB_VAL, LEFT_LEG_B_CALIB_VAL,
+	                                           RIGHT_LEG_A_CALIB_VAL, RIGHT_LEG_B_CALIB_VAL};
+	const uint8_t  hipIDs[BENCH_HIPS]       = {MEDULLA_LEFT_HIP_ID, MEDULLA_RIGHT_HIP_ID};
+	const uint32_t hipCalibs[BENCH_HIPS]    = {LEFT_HIP_CALIB_VAL, RIGHT_HIP_CALIB_VAL};
+
+	for (int i = 0; i < BENCH_LEGS; i++) {
+		SimPDOs &pdos = legPDOs[i];
+		memset(pdos.memory, 0, PDO_BYTES);
+		pdos.map(legs[i].getPDORegData());
+		pdos.at<uint8_t>(LEG_ID)          = legIDs[i];
+		pdos.at<uint32_t>(LEG_MOTOR_ENC)  = motorCalibs[i];
+		pdos.at<uint32_t>(LEG_LEG_ENC)    = legCalibs[i];
+		pdos.at<uint16_t>(LEG_MOTOR_VOLT) = 3000;
+		pdos.at<uint16_t>(LEG_LOGIC_VOLT) = 1500;
+		for (int t = 0; t < 6; t++)
+			pdos.at<uint16_t>(LEG_THERM0 + t) = 2000 + rand() % 200;
+		legs[i].postOpInit();
+	}
+	for (int i = 0; i < BENCH_HIPS; i++) {
+		SimPDOs &pdos = hipPDOs[i];
+		memset(pdos.memory, 0, PDO_BYTES);
+		pdos.map(hips[i].getPDORegData());
+		pdos.at<uint8_t>(HIP_ID)          = hipIDs[i];
+		pdos.at<uint32_t>(HIP_ENC)        = hipCalibs[i];
+		pdos.at<uint16_t>(HIP_MOTOR_VOLT) = 3000;
+		pdos.at<uint16_t>(HIP_LOGIC_VOLT) = 1500;
+		for (int t = 0; t < 3; t++)
+			pdos.at<uint16_t>(HIP_THERM0 + t) = 2000 + rand() % 200;
+		hips[i].postOpInit();
+	}
+
+	for (int cycle = 0; cycle < BENCH_CYCLES; cycle++) {
+		for (int i = 0; i < BENCH_LEGS; i++) {
+			SimPDOs &pdos = legPDOs[i];
+			pdos.at<uint8_t>(LEG_TIMING)++;
+			pdos.at<uint32_t>(LEG_MOTOR_ENC) += rand() % 5 - 2;
+			pdos.at<uint32_t>(LEG_LEG_ENC)   += rand() % 5 - 2;
+			pdos.at<uint16_t>(LEG_INC_ENC)   += rand() % 21 - 10;
+			wander(pdos.at<uint16_t>(LEG_THERM0 + cycle % 6));
+			wander(pdos.at<uint16_t>(LEG_MOTOR_VOLT));
+			wander(pdos.at<uint16_t>(LEG_LOGIC_VOLT));
+			pdos.at<int16_t>(LEG_AMP1) = rand() % 200 - 100;
+			pdos.at<int16_t>(LEG_AMP2) = rand() % 200 - 100;
+		}
+		for (int i = 0; i < BENCH_HIPS; i++) {
+			SimPDOs &pdos = hipPDOs[i];
+			pdos.at<uint8_t>(HIP_TIMING)++;
+			pdos.at<uint32_t>(HIP_ENC)       += rand() % 5 - 2;
+			pdos.at<uint16_t>(HIP_INC_ENC)   += rand() % 21 - 10;
+			wander(pdos.at<uint16_t>(HIP_THERM0 + cycle % 3));
+			wander(pdos.at<uint16_t>(HIP_MOTOR_VOLT));
+			wander(pdos.at<uint16_t>(HIP_LOGIC_VOLT));
+			pdos.at<int16_t>(HIP_AMP) = rand() % 200 - 100;
+		}
+
+		double start = now();
+		for (int i = 0; i < BENCH_LEGS; i++)
+			legs[i].processReceiveData(robotState);
+		for (int i = 0; i < BENCH_HIPS; i++)
+			hips[i].processReceiveData(robotState);
+		receiveTimes[cycle] = now() - start;
+
+		start = now();
+		for (int i = 0; i < BENCH_LEGS; i++)
+			legs[i].processSlowData();
+		for (int i = 0; i < BENCH_HIPS; i++)
+			hips[i].processSlowData();
+		slowTimes[cycle] = now() - start;
+		bothTimes[cycle] = receiveTimes[cycle] + slowTimes[cycle];
+	}
+
+	printf("Per cycle, for %d leg and %d hip Medullas:\n", BENCH_LEGS, BENCH_HIPS);
+	printf("  %-24s %8s %8s %8s\n", "", "mean", "99.9%", "max");
+	report("processReceiveData()", receiveTimes);
+	report("processSlowData()", slowTimes);
+	report("both, on one thread", bothTimes);
+
+	return 0;
+}
+
+// vim: noexpandtab
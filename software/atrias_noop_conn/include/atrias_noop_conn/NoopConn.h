@@ -27,7 +27,7 @@ class NoopConn : public RTT::TaskContext {
 	private:
 		/** @brief By calling this, we cycle RT Ops.
 		  */
-		RTT::OperationCaller<void(atrias_msgs::robot_state)>
+		RTT::OperationCaller<void(const atrias_msgs::robot_state&)>
 			newStateCallback;
 		
 		/** @brief Lets us report events, such as a missed deadline.
@@ -52,7 +52,7 @@ class NoopConn : public RTT::TaskContext {
 		/** @brief Called by RT Ops w/ update controller torques.
 		  * @param controller_output The new controller output.
 		  */
-		void sendControllerOutput(atrias_msgs::controller_output controller_output);
+		void sendControllerOutput(const atrias_msgs::controller_output& controller_output);
 		
 		/** @brief Configures this component.
 		  * Run by Orocos.
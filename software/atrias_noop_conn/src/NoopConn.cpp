@@ -29,7 +29,7 @@ bool NoopConn::configureHook() {
 	return true;
 }
 
-void NoopConn::sendControllerOutput(atrias_msgs::controller_output controller_output) {
+void NoopConn::sendControllerOutput(const atrias_msgs::controller_output& controller_output) {
 	waitingForResponse = false;
 	return;
 }
@@ -0,0 +1,196 @@
+#ifndef REPLAYCONN_H
+#define REPLAYCONN_H
+
+/** @file
+  * @brief This is the main class for the replay connector.
+  * This feeds recorded robot states through RT Ops and the loaded controller
+  * as fast as they'll run, and compares the controller's outputs with the
+  * recorded outputs.
+  */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+// Orocos
+#include <rtt/TaskContext.hpp>
+#include <rtt/Component.hpp>
+#include <rtt/OperationCaller.hpp>
+#include <rtt/OutputPort.hpp>
+#include <rtt/os/Semaphore.hpp>
+#include <rtt/os/TimeService.hpp>
+
+#include <atrias_msgs/robot_state.h>
+#include <atrias_msgs/controller_output.h>
+#include <atrias_shared/globals.h>
+#include <robot_invariant_defs.h>
+
+/** @brief How long we wait for RT Ops to act on a state change (nanoseconds).
+  */
+#define REPLAY_STATE_CHANGE_TIMEOUT_NS 1000000000LL
+
+/** @brief How long we wait for RT Ops to answer a robot state (nanoseconds).
+  * If it doesn't answer in this time, the replay is stopped.
+  */
+#define REPLAY_OUTPUT_TIMEOUT_NS 1000000000LL
+
+namespace atrias {
+
+namespace replayConn {
+
+class ReplayConn : public RTT::TaskContext {
+	private:
+		/** @brief By calling this, we cycle RT Ops.
+		  */
+		RTT::OperationCaller<void(const atrias_msgs::robot_state&)>
+			newStateCallback;
+
+		/** @brief Returns the timestamp of the robot state RT Ops is working on.
+		  */
+		RTT::OperationCaller<uint64_t(void)>
+			getTimestamp;
+
+		/** @brief Returns RT Ops's current state.
+		  */
+		RTT::OperationCaller<rtOps::RtOpsState_t(void)>
+			getRtOpsState;
+
+		/** @brief Stands in for the Controller Manager, enabling and disabling
+		  * the controller as the recording did.
+		  */
+		RTT::OutputPort<rtOps::RtOpsState_t> cmDataOut;
+
+		/** @brief The bag to be replayed. A property.
+		  */
+		std::string                                 bagFile;
+
+		/** @brief The topic to be replayed (atrias_msgs/rt_ops_cycle or
+		  * atrias_msgs/log_data). A property; if empty, the first topic
+		  * of either type in the bag is used.
+		  */
+		std::string                                 topic;
+
+		/** @brief If set, each cycle's expected and actual outputs are written
+		  * to this file, as CSV. A property.
+		  */
+		std::string                                 diffFile;
+
+		/** @brief The largest difference (amps) not counted as a mismatch. A property.
+		  */
+		double                                      tolerance;
+
+		/** @brief The recorded robot states.
+		  */
+		std::vector<atrias_msgs::robot_state>       states;
+
+		/** @brief The recorded outputs, as they would have been sent to the robot.
+		  */
+		std::vector<atrias_msgs::controller_output> expected;
+
+		/** @brief The output RT Ops sent for the current cycle.
+		  */
+		atrias_msgs::controller_output              output;
+
+		/** @brief Signalled when \a output arrives.
+		  */
+		RTT::os::Semaphore                          outputReady;
+
+		/** @brief The timestamp of the robot state we're waiting on.
+		  */
+		uint64_t                                    expectedStamp;
+
+		/** @brief The next cycle to be replayed.
+		  */
+		size_t                                      cycle;
+
+		/** @brief The state we last asked RT Ops for.
+		  */
+		rtOps::RtOpsState                           commandedState;
+
+		/** @brief The number of cycles whose outputs differed from the recording.
+		  */
+		size_t                                      mismatches;
+
+		/** @brief The first cycle that differed.
+		  */
+		size_t                                      firstMismatch;
+
+		/** @brief The largest difference seen on each output (amps).
+		  * In the order lA, lB, lHip, rA, rB, rHip.
+		  */
+		double                                      maxError[6];
+
+		/** @brief The total and largest time from sending a state to receiving
+		  * the output (nanoseconds).
+		  */
+		RTT::os::TimeService::nsecs                 totalCycleTime;
+		RTT::os::TimeService::nsecs                 maxCycleTime;
+
+		/** @brief When the replay started.
+		  */
+		RTT::os::TimeService::nsecs                 startTime;
+
+		/** @brief The open \a diffFile, or NULL.
+		  */
+		FILE*                                       diffOut;
+
+		/** @brief Loads \a states and \a expected from \a bagFile.
+		  * @return True if successful, false otherwise.
+		  */
+		bool loadBag();
+
+		/** @brief Asks RT Ops to change states, and waits until it has.
+		  * @param state The new state.
+		  */
+		void commandState(rtOps::RtOpsState state);
+
+		/** @brief Compares \a output with this cycle's recorded output.
+		  */
+		void compareOutput();
+
+		/** @brief Logs the results of the replay.
+		  */
+		void report();
+
+	public:
+		/** @brief Initializes the Replay Connector
+		  * @param name The name for this component.
+		  */
+		ReplayConn(std::string name);
+
+		/** @brief Called by RT Ops w/ update controller torques.
+		  * @param controller_output The new controller output.
+		  */
+		void sendControllerOutput(const atrias_msgs::controller_output& controller_output);
+
+		/** @brief Connects to RT Ops and loads the bag.
+		  * Run by Orocos.
+		  */
+		bool configureHook();
+
+		/** @brief Rewinds to the start of the recording.
+		  * Run by Orocos.
+		  */
+		bool startHook();
+
+		/** @brief Replays one cycle, then triggers itself to replay the next.
+		  * Stops the replay if RT Ops doesn't answer within
+		  * \a REPLAY_OUTPUT_TIMEOUT_NS.
+		  */
+		void updateHook();
+
+		/** @brief Closes the diff file.
+		  * Run by Orocos.
+		  */
+		void stopHook();
+};
+
+}
+
+}
+
+#endif // REPLAYCONN_H
+
+// vim: noexpandtab
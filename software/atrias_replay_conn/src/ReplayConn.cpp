@@ -0,0 +1,308 @@
+#include "atrias_replay_conn/ReplayConn.h"
+
+#include <math.h>
+#include <unistd.h>
+
+// ROS
+#include <rosbag/bag.h>
+#include <rosbag/view.h>
+
+#include <atrias_msgs/log_data.h>
+#include <atrias_msgs/rt_ops_cycle.h>
+
+// Generated by RT Ops from log_data.msg
+#include <atrias_rt_ops/LogRecordPacker.h>
+
+namespace atrias {
+
+namespace replayConn {
+
+ReplayConn::ReplayConn(std::string name) :
+            RTT::TaskContext(name),
+            newStateCallback("newStateCallback"),
+            getTimestamp("getTimestamp"),
+            getRtOpsState("getRtOpsState"),
+            cmDataOut("rt_ops_cm_out"),
+            outputReady(0)
+{
+	this->provides("connector")
+	    ->addOperation("sendControllerOutput", &ReplayConn::sendControllerOutput, this, RTT::ClientThread);
+	this->requires("atrias_rt")
+	    ->addOperationCaller(newStateCallback);
+	this->requires("atrias_rt")
+	    ->addOperationCaller(getTimestamp);
+	this->requires("atrias_rt")
+	    ->addOperationCaller(getRtOpsState);
+
+	addPort(cmDataOut);
+
+	tolerance = 1e-6;
+	this->addProperty("bagFile",   bagFile).doc("The bag to be replayed.");
+	this->addProperty("topic",     topic).doc("The rt_ops_cycle or log_data topic to replay. Defaults to the first one found.");
+	this->addProperty("diffFile",  diffFile).doc("If set, per-cycle expected and actual outputs are written here (CSV).");
+	this->addProperty("tolerance", tolerance).doc("The largest output difference (amps) not counted as a mismatch.");
+
+	diffOut = NULL;
+}
+
+bool ReplayConn::loadBag() {
+	states.clear();
+	expected.clear();
+
+	rosbag::Bag bag;
+	try {
+		bag.open(bagFile, rosbag::bagmode::Read);
+	} catch (rosbag::BagException &e) {
+		log(RTT::Error) << "[ReplayConn] Failed to open " << bagFile << ": " << e.what() << RTT::endlog();
+		return false;
+	}
+
+	// Find the topic to replay.
+	std::string cycleType = ros::message_traits::datatype<atrias_msgs::rt_ops_cycle>();
+	std::string logType   = ros::message_traits::datatype<atrias_msgs::log_data>();
+	rosbag::View all(bag);
+	std::vector<const rosbag::ConnectionInfo*> conns = all.getConnections();
+	std::string replayType;
+	for (size_t i = 0; i < conns.size(); i++) {
+		if (!topic.empty() && conns[i]->topic != topic)
+			continue;
+		if (conns[i]->datatype == cycleType || conns[i]->datatype == logType) {
+			topic      = conns[i]->topic;
+			replayType = conns[i]->datatype;
+			break;
+		}
+	}
+	if (replayType.empty()) {
+		log(RTT::Error) << "[ReplayConn] " << bagFile << " has no rt_ops_cycle or log_data topic "
+		                << topic << RTT::endlog();
+		return false;
+	}
+
+	rosbag::View view(bag, rosbag::TopicQuery(topic));
+	states.reserve(view.size());
+	expected.reserve(view.size());
+	for (rosbag::View::iterator it = view.begin(); it != view.end(); it++) {
+		atrias_msgs::robot_state       state;
+		atrias_msgs::controller_output raw;
+		atrias_msgs::controller_output clamped;
+		bool                           running;
+
+		if (replayType == cycleType) {
+			atrias_msgs::rt_ops_cycle::ConstPtr msg = it->instantiate<atrias_msgs::rt_ops_cycle>();
+			state   = msg->robotState;
+			clamped = msg->commandedOutput;
+			running = clamped.command == medulla_state_run;
+		} else {
+			atrias_msgs::log_data::ConstPtr msg = it->instantiate<atrias_msgs::log_data>();
+			rtOps::unpackLogRecord(*msg, state, raw, clamped);
+			running = state.rtOpsState == (rtOps::RtOpsState_t) rtOps::RtOpsState::ENABLED;
+		}
+
+		// RT Ops zeroes the currents it sends whenever the robot isn't running.
+		if (!running) {
+			clamped.lLeg.motorCurrentA   = 0.0;
+			clamped.lLeg.motorCurrentB   = 0.0;
+			clamped.lLeg.motorCurrentHip = 0.0;
+			clamped.rLeg.motorCurrentA   = 0.0;
+			clamped.rLeg.motorCurrentB   = 0.0;
+			clamped.rLeg.motorCurrentHip = 0.0;
+		}
+
+		states.push_back(state);
+		expected.push_back(clamped);
+	}
+
+	log(RTT::Info) << "[ReplayConn] Loaded " << states.size() << " cycles of " << topic
+	               << " (" << replayType << ") from " << bagFile << RTT::endlog();
+	return !states.empty();
+}
+
+bool ReplayConn::configureHook() {
+	RTT::TaskContext *peer = this->getPeer("atrias_rt");
+	if (!peer) {
+		log(RTT::Error) << "[ReplayConn] Failed to connect to RTOps!" << RTT::endlog();
+		return false;
+	}
+	newStateCallback = peer->provides("rtOps")->getOperation("newStateCallback");
+	getRtOpsState    = peer->provides("rtOps")->getOperation("getRtOpsState");
+	getTimestamp     = peer->provides("timestamps")->getOperation("getTimestamp");
+
+	if (!loadBag())
+		return false;
+
+	log(RTT::Info) << "[ReplayConn] configured!" << RTT::endlog();
+	return true;
+}
+
+bool ReplayConn::startHook() {
+	cycle          = 0;
+	mismatches     = 0;
+	firstMismatch  = 0;
+	totalCycleTime = 0;
+	maxCycleTime   = 0;
+	for (int i = 0; i < 6; i++)
+		maxError[i] = 0.0;
+
+	// Drop any output that arrived after a previous replay gave up on it.
+	while (outputReady.trywait()) {}
+
+	if (!diffFile.empty()) {
+		diffOut = fopen(diffFile.c_str(), "w");
+		if (!diffOut) {
+			log(RTT::Error) << "[ReplayConn] Failed to open " << diffFile << RTT::endlog();
+			return false;
+		}
+		fprintf(diffOut, "cycle,stamp,lA,lB,lHip,rA,rB,rHip,lAActual,lBActual,lHipActual,rAActual,rBActual,rHipActual\n");
+	}
+
+	// The controller has been loaded by now; this is what the Controller
+	// Manager does after loading one.
+	commandedState = rtOps::RtOpsState::NO_CONTROLLER_LOADED;
+	commandState(rtOps::RtOpsState::DISABLED);
+
+	startTime = RTT::os::TimeService::Instance()->getNSecs();
+	return true;
+}
+
+void ReplayConn::commandState(rtOps::RtOpsState state) {
+	if (state == commandedState)
+		return;
+	commandedState = state;
+	cmDataOut.write((rtOps::RtOpsState_t) state);
+
+	// RT Ops acts on this from its own thread, so wait for it.
+	RTT::os::TimeService::nsecs deadline =
+		RTT::os::TimeService::Instance()->getNSecs() + REPLAY_STATE_CHANGE_TIMEOUT_NS;
+	while (getRtOpsState() != (rtOps::RtOpsState_t) state) {
+		if (RTT::os::TimeService::Instance()->getNSecs() > deadline) {
+			log(RTT::Warning) << "[ReplayConn] RT Ops did not enter state " << (int) state
+			                  << " at cycle " << cycle << RTT::endlog();
+			return;
+		}
+		usleep(100);
+	}
+}
+
+void ReplayConn::sendControllerOutput(const atrias_msgs::controller_output& controller_output) {
+	// The controller loop also runs once at startup; only take the output
+	// computed from the state we sent.
+	if (getTimestamp() != expectedStamp)
+		return;
+
+	output = controller_output;
+	outputReady.signal();
+}
+
+void ReplayConn::compareOutput() {
+	const atrias_msgs::controller_output &exp = expected[cycle];
+	double expVals[6] = {exp.lLeg.motorCurrentA,    exp.lLeg.motorCurrentB,    exp.lLeg.motorCurrentHip,
+	                     exp.rLeg.motorCurrentA,    exp.rLeg.motorCurrentB,    exp.rLeg.motorCurrentHip};
+	double actVals[6] = {output.lLeg.motorCurrentA, output.lLeg.motorCurrentB, output.lLeg.motorCurrentHip,
+	                     output.rLeg.motorCurrentA, output.rLeg.motorCurrentB, output.rLeg.motorCurrentHip};
+
+	bool mismatch = false;
+	for (int i = 0; i < 6; i++) {
+		double err = fabs(actVals[i] - expVals[i]);
+		if (err > maxError[i])
+			maxError[i] = err;
+		if (err > tolerance)
+			mismatch = true;
+	}
+
+	if (mismatch) {
+		if (!mismatches)
+			firstMismatch = cycle;
+		mismatches++;
+	}
+
+	if (diffOut) {
+		fprintf(diffOut, "%zu,%llu", cycle, (unsigned long long) expectedStamp);
+		for (int i = 0; i < 6; i++)
+			fprintf(diffOut, ",%.9g", expVals[i]);
+		for (int i = 0; i < 6; i++)
+			fprintf(diffOut, ",%.9g", actVals[i]);
+		fprintf(diffOut, "\n");
+	}
+}
+
+void ReplayConn::report() {
+	RTT::os::TimeService::nsecs elapsed = RTT::os::TimeService::Instance()->getNSecs() - startTime;
+
+	log(RTT::Info) << "[ReplayConn] Replayed " << cycle << " cycles in " << elapsed / 1e9 << " s ("
+	               << cycle / (elapsed / 1e9) << " cycles/s)" << RTT::endlog();
+	log(RTT::Info) << "[ReplayConn] Cycle time: mean " << totalCycleTime / cycle << " ns, max "
+	               << maxCycleTime << " ns" << RTT::endlog();
+	log(RTT::Info) << "[ReplayConn] Max output error (A): lA " << maxError[0] << ", lB " << maxError[1]
+	               << ", lHip " << maxError[2] << ", rA " << maxError[3] << ", rB " << maxError[4]
+	               << ", rHip " << maxError[5] << RTT::endlog();
+
+	if (mismatches) {
+		log(RTT::Warning) << "[ReplayConn] " << mismatches << " cycles differed from the recording; the first was cycle "
+		                  << firstMismatch << RTT::endlog();
+	} else {
+		log(RTT::Info) << "[ReplayConn] All outputs matched the recording." << RTT::endlog();
+	}
+}
+
+void ReplayConn::updateHook() {
+	if (cycle >= states.size())
+		return;
+
+	const atrias_msgs::robot_state &state = states[cycle];
+
+	// Follow the recording's enables and disables.
+	if (state.rtOpsState == (rtOps::RtOpsState_t) rtOps::RtOpsState::ENABLED)
+		commandState(rtOps::RtOpsState::ENABLED);
+	else if (state.rtOpsState == (rtOps::RtOpsState_t) rtOps::RtOpsState::DISABLED)
+		commandState(rtOps::RtOpsState::DISABLED);
+
+	expectedStamp = SECOND_IN_NANOSECONDS * state.header.stamp.sec + state.header.stamp.nsec;
+
+	RTT::os::TimeService::nsecs sendTime = RTT::os::TimeService::Instance()->getNSecs();
+	newStateCallback(state);
+	if (!outputReady.waitUntil(RTT::nsecs_to_Seconds(sendTime + REPLAY_OUTPUT_TIMEOUT_NS))) {
+		log(RTT::Error) << "[ReplayConn] No output from RT Ops for cycle " << cycle << " (stamp "
+		                << expectedStamp << "); stopping the replay." << RTT::endlog();
+		report();
+		if (diffOut) {
+			fclose(diffOut);
+			diffOut = NULL;
+		}
+		return;
+	}
+	RTT::os::TimeService::nsecs cycleTime = RTT::os::TimeService::Instance()->getNSecs() - sendTime;
+
+	totalCycleTime += cycleTime;
+	if (cycleTime > maxCycleTime)
+		maxCycleTime = cycleTime;
+
+	compareOutput();
+	cycle++;
+
+	if (cycle == states.size()) {
+		report();
+		if (diffOut) {
+			fclose(diffOut);
+			diffOut = NULL;
+		}
+		return;
+	}
+
+	// Run the next cycle right away.
+	this->trigger();
+}
+
+void ReplayConn::stopHook() {
+	if (diffOut) {
+		fclose(diffOut);
+		diffOut = NULL;
+	}
+}
+
+ORO_CREATE_COMPONENT(ReplayConn)
+
+}
+
+}
+
+// vim: noexpandtab
@@ -13,6 +13,7 @@ class ControllerLoop;
 #include <rtt/os/Mutex.hpp>
 #include <rtt/os/MutexLock.hpp>
 #include <rtt/Logger.hpp>
+#include <rtt/os/TimeService.hpp>
 
 // ATRIAS
 #include <robot_invariant_defs.h>
@@ -53,12 +54,21 @@ class ControllerLoop : public RTT::Activity {
 	  */
 	volatile bool      controllerLoaded;
 	
-	/** @brief Clamps the controller output.
-	  * @param controller_output The un-clamped outputs.
-	  * @return The clamped outputs.
+	/** @brief This cycle's controller output.
+	  * Preallocated and modified in place, so the loop never constructs or
+	  * copies a controller_output message.
 	  */
-	atrias_msgs::controller_output
-		clampControllerOutput(atrias_msgs::controller_output controller_output);
+	atrias_msgs::controller_output controllerOutput;
+	
+	/** @brief Clamps the controller output (in place).
+	  * @param controller_output The outputs to be clamped.
+	  */
+	void clampControllerOutput(atrias_msgs::controller_output &controller_output);
+	
+	/** @brief Zeroes the controller output's commands and currents (in place).
+	  * @param controller_output The outputs to be reset.
+	  */
+	void resetControllerOutput(atrias_msgs::controller_output &controller_output);
 	
 	public:
 		/** @brief Initializes this ControllerLoop.
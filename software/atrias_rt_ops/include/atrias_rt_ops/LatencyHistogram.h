@@ -0,0 +1,92 @@
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+/** @file
+  * @brief A realtime-safe latency histogram with logarithmic buckets.
+  */
+
+#include <stdint.h>
+
+#include <atomic>
+
+#include <atrias_msgs/latency_stats.h>
+
+namespace atrias {
+
+namespace rtOps {
+
+/** @brief The number of bits of precision within each power of two.
+  * 5 bits gives 32 buckets per octave, or about 3% relative error.
+  */
+#define LATENCY_HIST_SUB_BITS    5
+
+/** @brief The number of buckets in each power of two.
+  */
+#define LATENCY_HIST_SUB_COUNT   (1 << LATENCY_HIST_SUB_BITS)
+
+/** @brief The largest value that may be recorded (nanoseconds).
+  * Larger samples are clamped to this. This is a little over 4 seconds.
+  */
+#define LATENCY_HIST_MAX_VALUE   0xFFFFFFFFLL
+
+/** @brief The total number of buckets needed to cover 0 through LATENCY_HIST_MAX_VALUE.
+  */
+#define LATENCY_HIST_NUM_BUCKETS ((32 - LATENCY_HIST_SUB_BITS + 1) * LATENCY_HIST_SUB_COUNT)
+
+class LatencyHistogram {
+	/** @brief The number of samples in each bucket.
+	  * These only ever count up, so the reader can compute the histogram for a
+	  * period by differencing.
+	  */
+	std::atomic<uint32_t> counts[LATENCY_HIST_NUM_BUCKETS];
+
+	/** @brief The bucket counts at the end of the last period.
+	  * Only accessed by the reader.
+	  */
+	uint32_t              lastCounts[LATENCY_HIST_NUM_BUCKETS];
+
+	/** @brief The largest sample since the last period ended.
+	  * \a endPeriod() takes and resets it with an exchange, so \a sample()
+	  * raises it with a compare-and-swap.
+	  */
+	std::atomic<int64_t>  periodMax;
+
+	/** @brief Computes the bucket for a value.
+	  * @param value The value (nanoseconds). Must be within [0, LATENCY_HIST_MAX_VALUE].
+	  * @return The index of its bucket.
+	  */
+	static int            bucketIndex(uint64_t value);
+
+	/** @brief Computes the largest value that falls in a bucket.
+	  * @param index The bucket's index.
+	  * @return Its highest value (nanoseconds).
+	  */
+	static int64_t        bucketValue(int index);
+
+	public:
+		/** @brief Initializes an empty histogram.
+		  */
+		LatencyHistogram();
+
+		/** @brief Records one sample. Realtime-safe and lock-free.
+		  * @param value The sample (nanoseconds). Negative values are recorded as 0.
+		  * Only one thread may sample a given histogram.
+		  */
+		void sample(int64_t value);
+
+		/** @brief Computes statistics for the period since the last call, then
+		  * starts a new period.
+		  * @param stats The message in which to store the statistics.
+		  * This may run concurrently with \a sample(), but only from one thread.
+		  * It is not realtime safe (it walks every bucket).
+		  */
+		void endPeriod(atrias_msgs::latency_stats &stats);
+};
+
+}
+
+}
+
+#endif // LATENCYHISTOGRAM_H
+
+// vim: noexpandtab
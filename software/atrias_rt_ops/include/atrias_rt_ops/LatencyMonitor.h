@@ -0,0 +1,106 @@
+#ifndef LATENCYMONITOR_H
+#define LATENCYMONITOR_H
+
+/** @file
+  * @brief Collects per-stage latency histograms for the RT Ops cycle.
+  */
+
+namespace atrias {
+namespace rtOps {
+class LatencyMonitor;
+}
+}
+
+#include <stdint.h>
+
+// Orocos
+#include <rtt/OperationCaller.hpp>
+#include <rtt/OutputPort.hpp>
+
+#include <atrias_msgs/robot_state_timing.h>
+#include <atrias_msgs/rt_ops_latency.h>
+#include <atrias_shared/GuiPublishTimer.h>
+
+#include "atrias_rt_ops/LatencyHistogram.h"
+#include "atrias_rt_ops/RTOps.h"
+
+namespace atrias {
+
+namespace rtOps {
+
+/** @brief The type for \a LatencyStage.
+  */
+typedef uint8_t LatencyStage_t;
+
+/** @brief The stages of the cycle for which we keep latency histograms.
+  */
+enum class LatencyStage: LatencyStage_t {
+	ECAT_CYCLE = 0, // The connector's EtherCAT frame
+	RECEIVE,        // The connector decoding the robot state
+	CONTROLLER,     // The controller
+	SAFETY,         // The state machine and safeties
+	TRANSMIT,       // The connector encoding the controller output
+	OVERSHOOT,      // How late the connector woke up
+	NUM_STAGES      // Not a stage; the number of stages
+};
+
+/** @brief How often the latency statistics are published (milliseconds).
+  */
+#define LATENCY_PUBLISH_PERIOD_MS 1000
+
+class LatencyMonitor {
+	/** @brief One histogram per stage.
+	  * The connector stages are sampled from the connector's thread, the
+	  * controller and safety stages from the controller loop.
+	  */
+	LatencyHistogram                               histograms[(LatencyStage_t) LatencyStage::NUM_STAGES];
+
+	/** @brief The port on which we publish our statistics.
+	  */
+	RTT::OutputPort<atrias_msgs::rt_ops_latency>*  latencyOut;
+
+	/** @brief Holds the statistics being published.
+	  */
+	atrias_msgs::rt_ops_latency                    latencyMsg;
+
+	/** @brief Times the publishing of the statistics.
+	  */
+	shared::GuiPublishTimer                        publishTimer;
+
+	/** @brief Lets us run \a publishBackend() outside the RT thread.
+	  */
+	RTT::OperationCaller<void(void)>               publishCaller;
+
+	/** @brief Computes the statistics and publishes them.
+	  * Runs in RT Ops's own (non-realtime) thread.
+	  */
+	void publishBackend();
+
+	public:
+		/** @brief Initializes the LatencyMonitor.
+		  * @param rt_ops      A pointer to RT Ops, for registering our operation.
+		  * @param latency_out The port on which to publish statistics.
+		  */
+		LatencyMonitor(RTOps* rt_ops, RTT::OutputPort<atrias_msgs::rt_ops_latency>* latency_out);
+
+		/** @brief Records how long a stage took. Realtime-safe.
+		  * @param stage    The stage.
+		  * @param duration The duration of this stage (nanoseconds).
+		  */
+		void sample(LatencyStage stage, int64_t duration);
+
+		/** @brief Records the connector's stage durations from a robot state.
+		  * @param timing The new robot state's timing information.
+		  * This also requests publishing of the statistics, when it's time.
+		  * Call this once per cycle from the connector's thread.
+		  */
+		void sampleTiming(const atrias_msgs::robot_state_timing &timing);
+};
+
+}
+
+}
+
+#endif // LATENCYMONITOR_H
+
+// vim: noexpandtab
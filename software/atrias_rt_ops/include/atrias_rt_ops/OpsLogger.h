@@ -7,17 +7,24 @@
 
 #include <stdint.h>
 
+#include <string>
+
 // Orocos
 #include <rtt/OutputPort.hpp>
 #include <rtt/os/TimeService.hpp>
 
 #include <atrias_shared/globals.h>
+#include <atrias_shared/FlightRecorder.h>
 #include <atrias_shared/GuiPublishTimer.h>
 #include <atrias_msgs/log_data.h>
 #include <atrias_msgs/robot_state.h>
 #include <atrias_msgs/rt_ops_cycle.h>
 #include <atrias_msgs/rt_ops_event.h>
 
+// Generated from log_data.msg by scripts/gen_log_record.py
+#include "atrias_rt_ops/LogRecord.h"
+#include "atrias_rt_ops/LogRecordPacker.h"
+
 namespace atrias {
 
 namespace rtOps {
@@ -42,14 +49,23 @@ class OpsLogger {
 	/** @brief Stores this cycle's RT Ops Cycle message.
 	  */
 	atrias_msgs::rt_ops_cycle                   rtOpsCycle;
+	
+	/** @brief The log message, reused every cycle.
+	  */
+	atrias_msgs::log_data                       logData;
+
+	/** @brief Records the log data to disk, when enabled.
+	  * This replaces \a logCyclicOut.
+	  */
+	shared::FlightRecorder                      flightRecorder;
 
-	/**
-	  * @brief Stuffs the robot state data into a log_data message.
-	  * The messages are passed by reference to avoid copies
-	  * (to improve performance).
+	/** @brief Stuffs the last cycle's robot state and controller outputs
+	  * into a log_data message or log record.
+	  * The field mapping is generated from the comments in log_data.msg.
 	  * @param log_data    The log data into which to stuff the data.
 	  */
-	void packLogData(atrias_msgs::log_data &log_data);
+	template <class LogType>
+	void packLogData(LogType &log_data);
 	
 	public:
 		/** @brief Initializes the OpsLogger.
@@ -60,6 +76,17 @@ class OpsLogger {
 		          RTT::OutputPort<atrias_msgs::rt_ops_cycle> *gui_cyclic_out,
 		          RTT::OutputPort<atrias_msgs::rt_ops_event> *event_out);
 		
+		/** @brief Starts recording the log data into a flight recorder file.
+		  * @param dir The directory in which to create the file.
+		  * @return True if successful, false otherwise.
+		  * Not realtime safe; call this before the robot starts running.
+		  */
+		bool openFlightRecorder(const std::string &dir);
+
+		/** @brief Stops the flight recorder, if it's running.
+		  */
+		void closeFlightRecorder();
+
 		/** @brief Begins a new cycle. This will send out the rt ops cycle message.
 		  */
 		void beginCycle();
@@ -70,15 +97,15 @@ class OpsLogger {
 		
 		/** @brief Logs the new robot state.
 		  */
-		void logRobotState(atrias_msgs::robot_state& state);
+		void logRobotState(const atrias_msgs::robot_state& state);
 		
 		/** @brief Logs the commanded controller output.
 		  */
-		void logControllerOutput(atrias_msgs::controller_output& output);
+		void logControllerOutput(const atrias_msgs::controller_output& output);
 		
 		/** @brief Logs the clamped controller output.
 		  */
-		void logClampedControllerOutput(atrias_msgs::controller_output& clamped_output);
+		void logClampedControllerOutput(const atrias_msgs::controller_output& clamped_output);
 		
 		/** @brief Send out an RT Ops event.
 		  * @param error    The specific event to be reported.
@@ -26,6 +26,7 @@ class RTOps;
 #include <atrias_msgs/log_data.h>
 #include <atrias_msgs/robot_state.h>
 #include <atrias_msgs/rt_ops_event.h>
+#include <atrias_msgs/rt_ops_latency.h>
 #include <atrias_shared/globals.h>
 
 // This component (RT Ops)'s includes
@@ -37,6 +38,7 @@ class RTOps;
 #include "atrias_rt_ops/StateMachine.h"
 #include "atrias_rt_ops/RTHandler.h"
 #include "atrias_rt_ops/Safety.h"
+#include "atrias_rt_ops/LatencyMonitor.h"
 
 namespace atrias {
 
@@ -58,6 +60,10 @@ class RTOps : public RTT::TaskContext {
 		/** @brief This is the port over which events are sent.
 		  */
 		RTT::OutputPort<atrias_msgs::rt_ops_event>  eventOut;
+		
+		/** @brief This is our low-rate latency statistics output.
+		  */
+		RTT::OutputPort<atrias_msgs::rt_ops_latency> latencyOut;
 
 		/** @brief This prints out diagnostic information when estops occur
 		  */
@@ -90,6 +96,21 @@ class RTOps : public RTT::TaskContext {
 		/** @brief Implements our safety features.
 		  */
 		Safety*                                     safety;
+		
+		/** @brief Keeps latency histograms for each stage of the cycle.
+		  */
+		LatencyMonitor*                             latencyMonitor;
+
+		/** @brief Whether to lock our memory while running. Locking is
+		  * process-wide, so a process running several RT Ops (such as the
+		  * sweep runner) clears this. A property.
+		  */
+		bool                                        lockMemory;
+
+		/** @brief If nonzero, the CPUs (a bitmask) to which the controller
+		  * loop is pinned when started. A property.
+		  */
+		unsigned int                                controllerCpuAffinity;
 
 	public:
 		// Constructor
@@ -100,12 +121,12 @@ class RTOps : public RTT::TaskContext {
 		
 		/** @brief Lets us run the controllers.
 		  */
-		RTT::OperationCaller<atrias_msgs::controller_output&(atrias_msgs::robot_state&)>
+		RTT::OperationCaller<atrias_msgs::controller_output&(const atrias_msgs::robot_state&)>
 			runController;
 		
 		/** @brief Lets us send the new controller outputs to the Connector.
 		  */
-		RTT::OperationCaller<void(atrias_msgs::controller_output)>
+		RTT::OperationCaller<void(const atrias_msgs::controller_output&)>
 			sendControllerOutput;
 		
 		/** @brief Connects \a runController w/ the top level controller.
@@ -125,8 +146,9 @@ class RTOps : public RTT::TaskContext {
 		  * @param newRobotState The new robot state.
 		  * This is called by the communicator when a new robot state is available
 		  * The communicator controls the timing of the system through this function.
+		  * The state is copied once, into RT Ops's preallocated state buffers.
 		  */
-		void               newStateCallback(atrias_msgs::robot_state);
+		void               newStateCallback(const atrias_msgs::robot_state &newRobotState);
 
 		/** @brief Returns a pointer to the EStopDiags instance
 		  * @return A pointer to the main EStopDiags instance
@@ -163,6 +185,16 @@ class RTOps : public RTT::TaskContext {
 		  */
 		Safety*            getSafety();
 		
+		/** @brief Allows access to the LatencyMonitor.
+		  * @return A pointer to the LatencyMonitor
+		  */
+		LatencyMonitor*    getLatencyMonitor();
+		
+		/** @brief Lets other components see RT Ops's state.
+		  * @return The current RtOpsState.
+		  */
+		RtOpsState_t       getRtOpsState();
+		
 		/** @brief Lets Connectors report RT Ops Events.
 		  * @param event    The event to be reported.
 		  * @param metadata The metadata for this event
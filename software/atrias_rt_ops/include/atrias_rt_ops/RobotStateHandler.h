@@ -7,9 +7,7 @@
 
 class RobotStateHandler;
 
-// Orocos
-#include <rtt/os/Mutex.hpp>
-#include <rtt/os/MutexLock.hpp>
+#include <atomic>
 
 #include <atrias_msgs/robot_state.h>
 #include <robot_invariant_defs.h>
@@ -20,38 +18,99 @@ namespace atrias {
 
 namespace rtOps {
 
+/** @brief The maximum number of threads that may hold a \a RobotStateHandler::Snapshot
+  * at the same time. Currently the controller loop and the controller manager command
+  * path (\a StateMachine::newCMState()).
+  */
+#define ROBOT_STATE_MAX_READERS 2
+
 class RobotStateHandler {
+	/** @brief The number of robot state buffers.
+	  * One holds the latest state, one is free to be written, and each
+	  * reader may pin one more.
+	  */
+	static const int         NUM_BUFFERS = ROBOT_STATE_MAX_READERS + 2;
+
 	/** @brief Holds a pointer to the main RTOps class.
 	  */
 	RTOps*                   rtOps;
-	
-	/** @brief Holds the current robot state.
+
+	/** @brief The robot state buffers.
+	  */
+	atrias_msgs::robot_state robotStates[NUM_BUFFERS];
+
+	/** @brief The number of readers currently pinning each buffer.
+	  * A buffer is never written while its count is nonzero.
 	  */
-	atrias_msgs::robot_state robotState;
-	
-	/** @brief Protects access to \a robotState. For thread safety.
+	std::atomic<int>         readers[NUM_BUFFERS];
+
+	/** @brief The index of the most recently published robot state.
 	  */
-	RTT::os::Mutex           robotStateLock;
-	
+	std::atomic<int>         latest;
+
 	/** @brief Checks if any Medullas are in error.
 	  */
 	void                     checkForNewErrors(atrias_msgs::robot_state &state);
-	
+
+	/** @brief Pins the latest robot state so it won't be overwritten.
+	  * @return The index of the pinned buffer.
+	  * This is lock-free; it only retries if a new state is published
+	  * between reading \a latest and pinning the buffer.
+	  */
+	int                      pin();
+
+	/** @brief Releases a buffer pinned by \a pin().
+	  * @param index The buffer's index.
+	  */
+	void                     unpin(int index);
+
 	public:
+		/** @brief A read-only view of the robot state.
+		  * The referenced state is not modified while this exists, so hold it
+		  * for at most one cycle. Construct one of these rather than copying
+		  * the robot state.
+		  */
+		class Snapshot {
+			/** @brief The handler this snapshot was taken from.
+			  */
+			RobotStateHandler* handler;
+
+			/** @brief Which buffer we've pinned.
+			  */
+			int                index;
+
+			// Snapshots pin a buffer, so they may not be copied.
+			Snapshot(const Snapshot&);
+			Snapshot& operator=(const Snapshot&);
+
+			public:
+				/** @brief Pins the latest robot state.
+				  * @param robot_state_handler The RobotStateHandler to read from.
+				  */
+				Snapshot(RobotStateHandler* robot_state_handler);
+
+				/** @brief Releases the robot state.
+				  */
+				~Snapshot();
+
+				/** @brief Accesses the pinned robot state.
+				  * @return The robot state.
+				  */
+				const atrias_msgs::robot_state& get() const;
+		};
+
 		/** @brief Initializes the RobotStateHandler.
 		  * @param rt_ops A pointer to the main RT Ops class.
 		  */
 		RobotStateHandler(RTOps* rt_ops);
-		
-		/** @brief Returns the current robot state (threadsafe).
-		  * @return The current robot state.
-		  */
-		atrias_msgs::robot_state getRobotState();
-		
-		/** @brief Sets the robot state (threadsafe).
+
+		/** @brief Sets the robot state (wait-free).
 		  * @param newState The new robot state.
+		  * @return The published state, including RT Ops's state. This remains
+		  *         valid until the next call to \a setRobotState().
+		  * Only one thread (the connector's) may call this.
 		  */
-		void setRobotState(atrias_msgs::robot_state &newState);
+		const atrias_msgs::robot_state& setRobotState(const atrias_msgs::robot_state &newState);
 };
 
 }
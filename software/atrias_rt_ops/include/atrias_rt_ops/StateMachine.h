@@ -15,6 +15,7 @@ class StateMachine;
 #include <atrias_shared/globals.h>
 #include <robot_invariant_defs.h>
 #include <atrias_msgs/controller_output.h>
+#include <atrias_msgs/robot_state.h>
 
 #include "atrias_rt_ops/RTOps.h"
 
@@ -66,9 +67,12 @@ class StateMachine {
 		void eStop(RtOpsEvent event);
 		
 		/** @brief Computes a new state.
+		  * @param robotState       This cycle's robot state.
+		  * @param controllerOutput The controller's output for this cycle.
 		  * @return The new desired Medulla state.
 		  */
-		medulla_state_t calcState(atrias_msgs::controller_output controllerOutput);
+		medulla_state_t calcState(const atrias_msgs::robot_state     &robotState,
+		                          const atrias_msgs::controller_output &controllerOutput);
 		
 		/** @brief Sets a new state for the state machine.
 		  * @param new_state The new state.
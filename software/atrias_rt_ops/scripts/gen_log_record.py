@@ -0,0 +1,272 @@
+#!/usr/bin/env python2
+
+# Generates, from a fixed-size message:
+#
+#  - [StructName].h, a packed C++ struct whose memory layout matches the
+#    message's ROS wire encoding. RT Ops fills these in place inside the
+#    flight recorder's mapped file, so nothing needs to be serialized in the
+#    realtime thread. The struct's fields have the same names as the
+#    message's, so the same code can fill either one.
+#
+#  - [StructName]Packer.h, a function filling either one from its sources,
+#    and one copying a message back into its sources (for replaying logs).
+#    Each field of the message names its source in a trailing comment,
+#    "# <- source.path.to.field", where each source is given on the command
+#    line as name=package/message. Every source path is checked against the
+#    source's message definition, and every field must have exactly one
+#    source used by no other field, so a field can't be left out or copied
+#    from the wrong place.
+
+import os
+import re
+import sys
+
+if (len(sys.argv) < 4):
+	print("Usage: " + sys.argv[0] + " [message.msg] [StructName] [output dir] [name=package/message]...")
+	exit(1)
+
+msgFile    = sys.argv[1]
+structName = sys.argv[2]
+outDir     = sys.argv[3]
+sources    = [arg.split('=', 1) for arg in sys.argv[4:]]
+
+msgDir  = os.path.dirname(os.path.abspath(msgFile))
+msgName = os.path.splitext(os.path.basename(msgFile))[0]
+pkgName = os.path.basename(os.path.dirname(msgDir))
+
+# ROS primitive type -> (C++ type, size in bytes)
+primitives = {
+	'bool':    ('uint8_t',  1),
+	'byte':    ('int8_t',   1),
+	'char':    ('uint8_t',  1),
+	'int8':    ('int8_t',   1),
+	'uint8':   ('uint8_t',  1),
+	'int16':   ('int16_t',  2),
+	'uint16':  ('uint16_t', 2),
+	'int32':   ('int32_t',  4),
+	'uint32':  ('uint32_t', 4),
+	'int64':   ('int64_t',  8),
+	'uint64':  ('uint64_t', 8),
+	'float32': ('float',    4),
+	'float64': ('double',   8),
+}
+
+# The serialized Header: seq, stamp.sec, stamp.nsec, and the frame ID's length.
+HEADER_SIZE = 16
+
+def fail(where, msg):
+	sys.exit(where + ": " + msg)
+
+def isHeader(msgType):
+	return msgType in ('Header', 'std_msgs/Header')
+
+def parseMsg(filename):
+	"""Returns [(type, name, comment, line number)] for each field."""
+	fields = []
+	for lineNum, line in enumerate(open(filename), 1):
+		parts   = line.split('#', 1)
+		line    = parts[0].strip()
+		comment = parts[1].strip() if len(parts) > 1 else ''
+		if not line or '=' in line:
+			# Blank, comment, or constant.
+			continue
+		msgType, name = line.split()
+		fields.append((msgType, name, comment, lineNum))
+	return fields
+
+_msgCache = {}
+def lookupMsg(msgType):
+	"""Returns {name: type} for a message in this package."""
+	msgType = msgType.split('/')[-1]
+	if msgType not in _msgCache:
+		filename = os.path.join(msgDir, msgType + '.msg')
+		if not os.path.exists(filename):
+			return None
+		_msgCache[msgType] = dict([(f[1], f[0]) for f in parseMsg(filename)])
+	return _msgCache[msgType]
+
+def resolve(where, path):
+	"""Checks a source path. Returns its ROS type."""
+	parts = path.split('.')
+	srcTypes = dict(sources)
+	if parts[0] not in srcTypes:
+		fail(where, "unknown source " + parts[0])
+	msgType = srcTypes[parts[0]]
+	for part in parts[1:]:
+		fields = lookupMsg(msgType)
+		if fields is None:
+			if isHeader(msgType):
+				fail(where, "only whole Headers may be copied")
+			fail(where, msgType + " has no field " + part)
+
+		m = re.match(r'^(\w+)(?:\[(\d+)\])?$', part)
+		if not m or m.group(1) not in fields:
+			fail(where, msgType + " has no field " + part)
+		msgType = fields[m.group(1)]
+
+		arr = re.match(r'^(\w+(?:/\w+)?)\[(\d*)\]$', msgType)
+		if m.group(2) is not None:
+			if not arr:
+				fail(where, part + " is not an array")
+			if arr.group(2) and int(m.group(2)) >= int(arr.group(2)):
+				fail(where, part + " is out of bounds")
+			msgType = arr.group(1)
+		elif arr:
+			fail(where, part + " is an array; copy one element")
+	return msgType
+
+fields = []
+size   = 0
+for msgType, name, comment, lineNum in parseMsg(msgFile):
+	where = msgFile + ":" + str(lineNum)
+	if isHeader(msgType):
+		if fields:
+			fail(where, "the Header must be the first field")
+		size += HEADER_SIZE
+	elif msgType in primitives:
+		size += primitives[msgType][1]
+	else:
+		fail(where, msgType + " is not a fixed-size primitive")
+
+	source = None
+	if sources:
+		if not comment.startswith('<-'):
+			fail(where, name + " has no source")
+		source  = comment[2:].strip()
+		srcType = resolve(where, source)
+		if isHeader(msgType) != isHeader(srcType) or (not isHeader(srcType) and srcType not in primitives):
+			fail(where, source + " (" + srcType + ") can't be copied into " + msgType)
+		for other in fields:
+			if other[2] == source:
+				fail(where, name + " has the same source as " + other[1])
+
+	fields.append((msgType, name, source))
+
+def writeFile(filename, lines):
+	if not os.path.isdir(os.path.dirname(filename)):
+		os.makedirs(os.path.dirname(filename))
+	open(filename, 'w').write("\n".join(lines))
+
+def fileHeader(guard, brief):
+	return [
+		"#ifndef " + guard,
+		"#define " + guard,
+		"",
+		"/** @file",
+		"  * @brief " + brief,
+		"  * Generated by gen_log_record.py from " + msgName + ".msg; do not edit.",
+		"  */",
+		"",
+	]
+
+def fileFooter(guard):
+	return ["}", "", "}", "", "#endif // " + guard, ""]
+
+# The record
+guard = structName.upper() + "_H"
+out = fileHeader(guard, "A packed record with the same layout as a serialized " + msgName + " message.")
+out.append("#include <stdint.h>")
+out.append("")
+out.append("namespace atrias {")
+out.append("")
+out.append("namespace rtOps {")
+out.append("")
+out.append("#pragma pack(push, 1)")
+out.append("")
+if fields and isHeader(fields[0][0]):
+	out.append("/** @brief A serialized Header with an empty frame ID.")
+	out.append("  */")
+	out.append("struct " + structName + "Header {")
+	out.append("\tuint32_t seq;")
+	out.append("\tuint32_t stampSec;")
+	out.append("\tuint32_t stampNsec;")
+	out.append("\tuint32_t frameIdLength; // The frame ID is not recorded.")
+	out.append("")
+	out.append("\ttemplate <class HeaderType>")
+	out.append("\t" + structName + "Header& operator=(const HeaderType &header) {")
+	out.append("\t\tseq           = header.seq;")
+	out.append("\t\tstampSec      = header.stamp.sec;")
+	out.append("\t\tstampNsec     = header.stamp.nsec;")
+	out.append("\t\tframeIdLength = 0;")
+	out.append("\t\treturn *this;")
+	out.append("\t}")
+	out.append("};")
+	out.append("")
+
+width = max([len(primitives[t][0]) for t, n, s in fields if t in primitives] + [len(structName) + 6])
+out.append("struct " + structName + " {")
+for msgType, name, source in fields:
+	if isHeader(msgType):
+		cType = structName + "Header"
+	else:
+		cType = primitives[msgType][0]
+	out.append("\t" + cType.ljust(width) + " " + name + ";")
+out.append("};")
+out.append("")
+out.append("#pragma pack(pop)")
+out.append("")
+out.append("static_assert(sizeof(" + structName + ") == " + str(size) + ", \"" + structName + " is not packed\");")
+out.append("")
+out.append("/** @brief Applies X to each field's name, in order, except the Header's.")
+out.append("  */")
+out.append("#define " + structName.upper() + "_FIELDS(X) \\")
+out += ["\tX(" + name + ") \\" for msgType, name, source in fields if not isHeader(msgType)]
+out.append("")
+out += fileFooter(guard)
+writeFile(os.path.join(outDir, structName + ".h"), out)
+
+# The packer
+if sources:
+	guard = structName.upper() + "PACKER_H"
+	out = fileHeader(guard, "Fills a " + structName + " or " + msgName + " message from its sources.")
+	for srcType in sorted(set([t for n, t in sources])):
+		if '/' not in srcType:
+			srcType = pkgName + '/' + srcType
+		out.append("#include <" + srcType + ".h>")
+	out.append("")
+	out.append("#include \"atrias_rt_ops/" + structName + ".h\"")
+	out.append("")
+	out.append("namespace atrias {")
+	out.append("")
+	out.append("namespace rtOps {")
+	out.append("")
+	out.append("/** @brief Fills in every field of a " + structName + " or " + msgName + " message.")
+	out.append("  * @param out The record or message to fill.")
+	for name, srcType in sources:
+		out.append("  * @param " + name + " The " + srcType.split('/')[-1] + " source.")
+	out.append("  */")
+	params = ["LogType &out"]
+	for name, srcType in sources:
+		if '/' not in srcType:
+			srcType = pkgName + '/' + srcType
+		params.append("const " + srcType.replace('/', '::') + " &" + name)
+	out.append("template <class LogType>")
+	out.append("inline void pack" + structName + "(" + (",\n" + " " * len("inline void pack" + structName + "(")).join(params) + ") {")
+	width = max([len(n) for t, n, s in fields])
+	for msgType, name, source in fields:
+		out.append("\tout." + name.ljust(width) + " = " + source + ";")
+	out.append("}")
+	out.append("")
+
+	# And the reverse, for replaying logs. Sources' fields that aren't logged are left alone.
+	out.append("/** @brief Copies a " + msgName + " message's fields back into their sources.")
+	out.append("  * @param in The message to unpack.")
+	for name, srcType in sources:
+		out.append("  * @param " + name + " The " + srcType.split('/')[-1] + " to fill.")
+	out.append("  */")
+	params = ["const LogType &in"]
+	for name, srcType in sources:
+		if '/' not in srcType:
+			srcType = pkgName + '/' + srcType
+		params.append(srcType.replace('/', '::') + " &" + name)
+	out.append("template <class LogType>")
+	out.append("inline void unpack" + structName + "(" + (",\n" + " " * len("inline void unpack" + structName + "(")).join(params) + ") {")
+	width = max([len(s) for t, n, s in fields])
+	for msgType, name, source in fields:
+		out.append("\t" + source.ljust(width) + " = in." + name + ";")
+	out.append("}")
+	out.append("")
+	out += fileFooter(guard)
+	writeFile(os.path.join(outDir, structName + "Packer.h"), out)
+
+# vim: noexpandtab
@@ -32,9 +32,8 @@ void ControllerLoop::setControllerUnloaded() {
 	rtOps->disconnectController();
 }
 
-atrias_msgs::controller_output
-	ControllerLoop::clampControllerOutput(
-	atrias_msgs::controller_output controller_output) {
+void ControllerLoop::clampControllerOutput(
+	atrias_msgs::controller_output &controller_output) {
 	
 	controller_output.lLeg.motorCurrentA =
 		CLAMP(controller_output.lLeg.motorCurrentA, MIN_MTR_CURRENT_CMD, MAX_MTR_CURRENT_CMD);
@@ -49,28 +48,47 @@ atrias_msgs::controller_output
 		CLAMP(controller_output.rLeg.motorCurrentB, MIN_MTR_CURRENT_CMD, MAX_MTR_CURRENT_CMD);
 	controller_output.rLeg.motorCurrentHip =
 		CLAMP(controller_output.rLeg.motorCurrentHip, MIN_HIP_MTR_CURRENT_CMD, MAX_HIP_MTR_CURRENT_CMD);
+}
+
+void ControllerLoop::resetControllerOutput(
+	atrias_msgs::controller_output &controller_output) {
 	
-	return controller_output;
+	controller_output.command              = 0;
+	controller_output.lLeg.motorCurrentA   = 0.0;
+	controller_output.lLeg.motorCurrentB   = 0.0;
+	controller_output.lLeg.motorCurrentHip = 0.0;
+	controller_output.rLeg.motorCurrentA   = 0.0;
+	controller_output.rLeg.motorCurrentB   = 0.0;
+	controller_output.rLeg.motorCurrentHip = 0.0;
 }
 
 void ControllerLoop::loop() {
 	while (!done) {
-		atrias_msgs::robot_state robotState = rtOps->getRobotStateHandler()->getRobotState();
-		rtOps->getTimestampHandler()->setTimestamp(robotState.header);
-		
-		atrias_msgs::controller_output controllerOutput;
-		
+		resetControllerOutput(controllerOutput);
+
 		{
-			RTT::os::MutexLock lock(controllerLock);
-			if (controllerLoaded) {
-				controllerOutput = rtOps->runController(robotState);
+			// Pins this cycle's robot state; released before we wait for the next one.
+			RobotStateHandler::Snapshot robotState(rtOps->getRobotStateHandler());
+			rtOps->getTimestampHandler()->setTimestamp(robotState.get().header);
+
+			RTT::os::TimeService::nsecs controllerStart = RTT::os::TimeService::Instance()->getNSecs();
+			{
+				RTT::os::MutexLock lock(controllerLock);
+				if (controllerLoaded) {
+					controllerOutput = rtOps->runController(robotState.get());
+				}
 			}
+
+			RTT::os::TimeService::nsecs safetyStart = RTT::os::TimeService::Instance()->getNSecs();
+			controllerOutput.command = rtOps->getStateMachine()->calcState(robotState.get(), controllerOutput);
+			RTT::os::TimeService::nsecs safetyEnd   = RTT::os::TimeService::Instance()->getNSecs();
+
+			rtOps->getLatencyMonitor()->sample(LatencyStage::CONTROLLER, safetyStart - controllerStart);
+			rtOps->getLatencyMonitor()->sample(LatencyStage::SAFETY,     safetyEnd   - safetyStart);
 		}
 		
-		controllerOutput.command = rtOps->getStateMachine()->calcState(controllerOutput);
-		
 		rtOps->getOpsLogger()->logControllerOutput(controllerOutput);
-		controllerOutput = clampControllerOutput(controllerOutput);
+		clampControllerOutput(controllerOutput);
 		rtOps->getOpsLogger()->logClampedControllerOutput(controllerOutput);
 		
 		if (controllerOutput.command != medulla_state_run) {
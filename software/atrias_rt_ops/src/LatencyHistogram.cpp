@@ -0,0 +1,115 @@
+#include "atrias_rt_ops/LatencyHistogram.h"
+
+#include <algorithm>
+
+namespace atrias {
+
+namespace rtOps {
+
+LatencyHistogram::LatencyHistogram() {
+	for (int i = 0; i < LATENCY_HIST_NUM_BUCKETS; i++) {
+		counts[i]     = 0;
+		lastCounts[i] = 0;
+	}
+	periodMax = 0;
+}
+
+int LatencyHistogram::bucketIndex(uint64_t value) {
+	// Small values each get their own bucket.
+	if (value < LATENCY_HIST_SUB_COUNT)
+		return value;
+
+	// Above that, each power of two is split into LATENCY_HIST_SUB_COUNT buckets.
+	int msb   = 63 - __builtin_clzll(value);
+	int shift = msb - LATENCY_HIST_SUB_BITS;
+	return (shift + 1) * LATENCY_HIST_SUB_COUNT + (int) ((value >> shift) - LATENCY_HIST_SUB_COUNT);
+}
+
+int64_t LatencyHistogram::bucketValue(int index) {
+	if (index < LATENCY_HIST_SUB_COUNT)
+		return index;
+
+	int shift = index / LATENCY_HIST_SUB_COUNT - 1;
+	int64_t sub = index % LATENCY_HIST_SUB_COUNT + LATENCY_HIST_SUB_COUNT;
+	return ((sub + 1) << shift) - 1;
+}
+
+void LatencyHistogram::sample(int64_t value) {
+	if (value < 0)
+		value = 0;
+	if (value > LATENCY_HIST_MAX_VALUE)
+		value = LATENCY_HIST_MAX_VALUE;
+
+	// endPeriod() resets the maximum, so raise it with a compare-and-swap; a
+	// plain store could overwrite the reset with the last period's maximum.
+	int64_t max = periodMax.load(std::memory_order_relaxed);
+	while (value > max && !periodMax.compare_exchange_weak(max, value, std::memory_order_relaxed))
+		;
+
+	// We're the only writer of the counts, so this needn't be an atomic
+	// read-modify-write.
+	std::atomic<uint32_t> &count = counts[bucketIndex(value)];
+	count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void LatencyHistogram::endPeriod(atrias_msgs::latency_stats &stats) {
+	// Take this period's counts. A sample landing while we're copying is
+	// simply counted in the next period.
+	uint32_t periodCounts[LATENCY_HIST_NUM_BUCKETS];
+	uint32_t total = 0;
+	for (int i = 0; i < LATENCY_HIST_NUM_BUCKETS; i++) {
+		uint32_t cur    = counts[i].load(std::memory_order_relaxed);
+		periodCounts[i] = cur - lastCounts[i];
+		lastCounts[i]   = cur;
+		total          += periodCounts[i];
+	}
+
+	stats.count = total;
+	stats.max   = periodMax.exchange(0, std::memory_order_relaxed);
+	stats.p50   = 0;
+	stats.p99   = 0;
+	stats.p999  = 0;
+	if (!total)
+		return;
+
+	// A sample may be counted in one period and raise the maximum in the
+	// other, so don't report a maximum below the highest bucket counted.
+	int highest = LATENCY_HIST_NUM_BUCKETS - 1;
+	while (!periodCounts[highest])
+		highest--;
+	if (highest > 0)
+		stats.max = std::max(stats.max, bucketValue(highest - 1) + 1);
+
+	// The number of samples at or below each percentile (rounded up).
+	uint64_t p50Rank  = (total *  500ULL + 999) / 1000;
+	uint64_t p99Rank  = (total *  990ULL + 999) / 1000;
+	uint64_t p999Rank = (total *  999ULL + 999) / 1000;
+
+	uint64_t seen = 0;
+	for (int i = 0; i < LATENCY_HIST_NUM_BUCKETS; i++) {
+		if (!periodCounts[i])
+			continue;
+
+		uint64_t prev = seen;
+		seen += periodCounts[i];
+		if (prev < p50Rank  && seen >= p50Rank)
+			stats.p50  = bucketValue(i);
+		if (prev < p99Rank  && seen >= p99Rank)
+			stats.p99  = bucketValue(i);
+		if (seen >= p999Rank) {
+			stats.p999 = bucketValue(i);
+			break;
+		}
+	}
+
+	// Bucket values are rounded up; don't report a percentile above the maximum.
+	stats.p50  = std::min(stats.p50,  stats.max);
+	stats.p99  = std::min(stats.p99,  stats.max);
+	stats.p999 = std::min(stats.p999, stats.max);
+}
+
+}
+
+}
+
+// vim: noexpandtab
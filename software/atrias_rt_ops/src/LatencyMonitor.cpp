@@ -0,0 +1,57 @@
+#include "atrias_rt_ops/LatencyMonitor.h"
+
+namespace atrias {
+
+namespace rtOps {
+
+LatencyMonitor::LatencyMonitor(RTOps* rt_ops, RTT::OutputPort<atrias_msgs::rt_ops_latency>* latency_out) :
+                publishTimer(LATENCY_PUBLISH_PERIOD_MS) {
+	latencyOut = latency_out;
+
+	// Computing the percentiles walks every bucket, so do it in RT Ops's
+	// own thread rather than the cycle.
+	rt_ops->addOperation("publishLatency", &LatencyMonitor::publishBackend, this, RTT::OwnThread)
+		.doc("Publish the latency statistics.");
+	publishCaller = rt_ops->getOperation("publishLatency");
+}
+
+void LatencyMonitor::sample(LatencyStage stage, int64_t duration) {
+	histograms[(LatencyStage_t) stage].sample(duration);
+}
+
+void LatencyMonitor::sampleTiming(const atrias_msgs::robot_state_timing &timing) {
+	// Connectors leave the stages they don't measure at zero (only the
+	// EtherCAT connector measures any); don't count those as samples.
+	if (timing.eCatCycleTime)
+		sample(LatencyStage::ECAT_CYCLE, timing.eCatCycleTime);
+	if (timing.receiveTime)
+		sample(LatencyStage::RECEIVE,    timing.receiveTime);
+	if (timing.transmitTime)
+		sample(LatencyStage::TRANSMIT,   timing.transmitTime);
+	if (timing.overshoot)
+		sample(LatencyStage::OVERSHOOT,  timing.overshoot);
+
+	if (publishTimer.readyToSend())
+		publishCaller.send();
+}
+
+void LatencyMonitor::publishBackend() {
+	RTT::os::TimeService::nsecs now = RTT::os::TimeService::Instance()->getNSecs();
+	latencyMsg.header.stamp.sec  = now / SECOND_IN_NANOSECONDS;
+	latencyMsg.header.stamp.nsec = now % SECOND_IN_NANOSECONDS;
+
+	histograms[(LatencyStage_t) LatencyStage::ECAT_CYCLE].endPeriod(latencyMsg.eCatCycle);
+	histograms[(LatencyStage_t) LatencyStage::RECEIVE   ].endPeriod(latencyMsg.receive);
+	histograms[(LatencyStage_t) LatencyStage::CONTROLLER].endPeriod(latencyMsg.controller);
+	histograms[(LatencyStage_t) LatencyStage::SAFETY    ].endPeriod(latencyMsg.safety);
+	histograms[(LatencyStage_t) LatencyStage::TRANSMIT  ].endPeriod(latencyMsg.transmit);
+	histograms[(LatencyStage_t) LatencyStage::OVERSHOOT ].endPeriod(latencyMsg.overshoot);
+
+	latencyOut->write(latencyMsg);
+}
+
+}
+
+}
+
+// vim: noexpandtab
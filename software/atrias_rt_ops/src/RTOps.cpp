@@ -10,6 +10,7 @@ RTOps::RTOps(std::string name) :
        logCyclicOut("rt_ops_log_out"),
        guiCyclicOut("rt_ops_gui_out"),
        eventOut("rt_ops_event_out"),
+       latencyOut("rt_ops_latency_out"),
        timestampHandler(),
        opsLogger(&logCyclicOut, &guiCyclicOut, &eventOut),
        rtHandler(),
@@ -29,17 +30,26 @@ RTOps::RTOps(std::string name) :
 	    ->addOperationCaller(sendControllerOutput);
 	this->provides("rtOps")
 	    ->addOperation("sendEvent", &RTOps::sendEvent, this, RTT::ClientThread);
+	this->provides("rtOps")
+	    ->addOperation("getRtOpsState", &RTOps::getRtOpsState, this, RTT::ClientThread);
 	    
 	addEventPort(cManagerDataIn);
 	addPort(logCyclicOut);
 	addPort(guiCyclicOut);
 	addPort(eventOut);
+	addPort(latencyOut);
 
 	eStopDiags        = new EStopDiags(this);
 	controllerLoop    = new ControllerLoop(this);
 	stateMachine      = new StateMachine(this);
 	robotStateHandler = new RobotStateHandler(this);
 	safety            = new Safety(this);
+	latencyMonitor    = new LatencyMonitor(this, &latencyOut);
+
+	lockMemory            = true;
+	controllerCpuAffinity = 0;
+	this->addProperty("lockMemory", lockMemory).doc("Whether to lock the process's memory while running.");
+	this->addProperty("controllerCpuAffinity", controllerCpuAffinity).doc("If nonzero, the CPUs (a bitmask) for the controller loop.");
 
 	log(RTT::Info) << "[RTOps] constructed!" << RTT::endlog();
 }
@@ -74,9 +84,10 @@ std_msgs::Header RTOps::getROSHeader() {
 	return timestampHandler.getTimestampHeader();
 }
 
-void RTOps::newStateCallback(atrias_msgs::robot_state state) {
+void RTOps::newStateCallback(const atrias_msgs::robot_state &newRobotState) {
 	opsLogger.beginCycle();
-	robotStateHandler->setRobotState(state);
+	latencyMonitor->sampleTiming(newRobotState.timing);
+	const atrias_msgs::robot_state &state = robotStateHandler->setRobotState(newRobotState);
 	
 	controllerLoop->cycleLoop();
 	
@@ -111,12 +122,21 @@ Safety* RTOps::getSafety() {
 	return safety;
 }
 
+LatencyMonitor* RTOps::getLatencyMonitor() {
+	return latencyMonitor;
+}
+
+RtOpsState_t RTOps::getRtOpsState() {
+	return (RtOpsState_t) stateMachine->getRtOpsState();
+}
+
 void RTOps::sendEvent(RtOpsEvent event, RtOpsEventMetadata_t metadata) {
 	opsLogger.sendEvent(event, metadata);
 }
 
 bool RTOps::configureHook() {
-	rtHandler.beginRT();
+	if (lockMemory)
+		rtHandler.beginRT();
 	
 	// Connect with the connector.
 	RTT::TaskContext *peer = this->getPeer("atrias_connector");
@@ -126,11 +146,18 @@ bool RTOps::configureHook() {
 	}
 	sendControllerOutput = peer->provides("connector")->getOperation("sendControllerOutput");
 	
+	// Record the 1 kHz log data to disk rather than sending it over ROS, if requested.
+	const char* recorderDir = shared::FlightRecorder::getDirectory();
+	if (recorderDir && !opsLogger.openFlightRecorder(recorderDir))
+		log(RTT::Warning) << "[RTOps] Flight recorder failed to start; logging over ROS." << RTT::endlog();
+	
 	return true;
 }
 
 bool RTOps::startHook() {
 	// Start the main control loop.
+	if (controllerCpuAffinity)
+		controllerLoop->setCpuAffinity(controllerCpuAffinity);
 	if (!controllerLoop->start()) {
 		log(RTT::Error) << "[RTOps] Controller loop failed to start!" << RTT::endlog();
 		return false;
@@ -151,12 +178,14 @@ void RTOps::stopHook() {
 	if (!controllerLoop->stop())
 		log(RTT::Error) << "[RTOps] Controller loop failed to stop! Continuing shutdown" << RTT::endlog();
 	
-	rtHandler.endRT();
+	if (lockMemory)
+		rtHandler.endRT();
 
 	log(RTT::Info) << "[RTOps] stopped!" << RTT::endlog();
 }
 
 void RTOps::cleanupHook() {
+	opsLogger.closeFlightRecorder();
 	log(RTT::Info) << "[RTOps] cleaned up!" << RTT::endlog();
 }
 
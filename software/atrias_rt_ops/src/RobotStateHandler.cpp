@@ -6,20 +6,50 @@ namespace rtOps {
 
 RobotStateHandler::RobotStateHandler(RTOps* rt_ops) {
 	rtOps = rt_ops;
+
+	for (int i = 0; i < NUM_BUFFERS; i++)
+		readers[i] = 0;
+	latest = 0;
 }
 
-atrias_msgs::robot_state RobotStateHandler::getRobotState() {
-	RTT::os::MutexLock lock(robotStateLock);
-	return robotState;
+int RobotStateHandler::pin() {
+	while (true) {
+		int index = latest.load();
+		readers[index]++;
+
+		// If a new state was published before we pinned this one, the
+		// writer may already be refilling it. Try again.
+		if (latest.load() == index)
+			return index;
+
+		readers[index]--;
+	}
 }
 
-void RobotStateHandler::setRobotState(atrias_msgs::robot_state &newState) {
-	newState.rtOpsState =
-		(RtOpsState_t) rtOps->getStateMachine()->getRtOpsState();
-	checkForNewErrors(newState);
-	
-	RTT::os::MutexLock lock(robotStateLock);
-	robotState = newState;
+void RobotStateHandler::unpin(int index) {
+	readers[index]--;
+}
+
+const atrias_msgs::robot_state& RobotStateHandler::setRobotState(const atrias_msgs::robot_state &newState) {
+	// Find a buffer that is neither the latest state nor in use by a reader.
+	// With at most ROBOT_STATE_MAX_READERS readers one always exists.
+	// We're the only writer, so the latest buffer won't change underneath us.
+	int cur = latest.load();
+	for (int i = 0; i < NUM_BUFFERS; i++) {
+		if (i == cur || readers[i].load() != 0)
+			continue;
+
+		atrias_msgs::robot_state &state = robotStates[i];
+		state            = newState;
+		state.rtOpsState =
+			(RtOpsState_t) rtOps->getStateMachine()->getRtOpsState();
+		checkForNewErrors(state);
+
+		latest.store(i);
+		return state;
+	}
+
+	return robotStates[cur];
 }
 
 void RobotStateHandler::checkForNewErrors(atrias_msgs::robot_state &state) {
@@ -28,7 +58,7 @@ void RobotStateHandler::checkForNewErrors(atrias_msgs::robot_state &state) {
 	if (cur_state == RtOpsState::E_STOP ||
 	    cur_state == RtOpsState::RESET)
 		return;
-	
+
 	// Go through each Medulla, checking for the reset state:
 	if (state.boomMedullaState        == medulla_state_error ||
 	    state.lLeg.hip.medullaState   == medulla_state_error ||
@@ -37,12 +67,25 @@ void RobotStateHandler::checkForNewErrors(atrias_msgs::robot_state &state) {
 	    state.rLeg.hip.medullaState   == medulla_state_error ||
 	    state.rLeg.halfA.medullaState == medulla_state_error ||
 	    state.rLeg.halfB.medullaState == medulla_state_error) {
-		
+
 		// Send an event... and eStop too (even though that'll happen anyway...)
 		rtOps->getStateMachine()->eStop(RtOpsEvent::MEDULLA_ESTOP);
 	}
 }
 
+RobotStateHandler::Snapshot::Snapshot(RobotStateHandler* robot_state_handler) {
+	handler = robot_state_handler;
+	index   = handler->pin();
+}
+
+RobotStateHandler::Snapshot::~Snapshot() {
+	handler->unpin(index);
+}
+
+const atrias_msgs::robot_state& RobotStateHandler::Snapshot::get() const {
+	return handler->robotStates[index];
+}
+
 }
 
 }
@@ -32,9 +32,7 @@ double Safety::predictStop(double pos, double vel) {
 	return pos + vel * abs(vel) / (2.0 * ACCEL_PER_AMP * AVAIL_HALT_AMPS);
 }
 
-bool Safety::shouldEStop(atrias_msgs::controller_output &co) {
-	atrias_msgs::robot_state robotState = rtOps->getRobotStateHandler()->getRobotState();
-
+bool Safety::shouldEStop(const atrias_msgs::robot_state &robotState, const atrias_msgs::controller_output &co) {
 	// Check if there are any NaN or Inf values in co. If so, estop
 	if (!std::isfinite(co.lLeg.motorCurrentA)   ||
 	    !std::isfinite(co.lLeg.motorCurrentB)   ||
@@ -79,9 +77,7 @@ bool Safety::shouldEStop(atrias_msgs::controller_output &co) {
 	       motorHaltCheck(robotState.rLeg.halfB.rotorVelocity, rBMinVel, rBMaxVel);
 }
 
-bool Safety::shouldHalt() {
-	atrias_msgs::robot_state robotState = rtOps->getRobotStateHandler()->getRobotState();
-	
+bool Safety::shouldHalt(const atrias_msgs::robot_state &robotState) {
 	// Check for medullas in halt state.
 	if (robotState.boomMedullaState        == medulla_state_halt) {
 		rtOps->getOpsLogger()->sendEvent(RtOpsEvent::SAFETY, (RtOpsEventMetadata_t) RtOpsEventSafetyMetadata::BOOM_MEDULLA_HALT);
@@ -131,7 +127,7 @@ bool Safety::shouldHalt() {
 	double rLegBPred = predictStop(robotState.rLeg.halfB.motorAngle, robotState.rLeg.halfB.rotorVelocity);
 
 	// Check for a collision given this combination of sensor input
-	if (checkCollision(lLegAPred, lLegBPred, rLegAPred, rLegBPred))
+	if (checkCollision(robotState, lLegAPred, lLegBPred, rLegAPred, rLegBPred))
 		return true;
 
 	// Let's also check based purely off the (more reliable) rotor encoders
@@ -140,16 +136,15 @@ bool Safety::shouldHalt() {
 	rLegAPred = predictStop(robotState.rLeg.halfA.rotorAngle, robotState.rLeg.halfA.rotorVelocity);
 	rLegBPred = predictStop(robotState.rLeg.halfB.rotorAngle, robotState.rLeg.halfB.rotorVelocity);
 
-	if (checkCollision(lLegAPred, lLegBPred, rLegAPred, rLegBPred))
+	if (checkCollision(robotState, lLegAPred, lLegBPred, rLegAPred, rLegBPred))
 		return true;
 
 	// If we've made it this far, then we're fine
 	return false;
 }
 
-bool Safety::checkCollision(double lLegAPred, double lLegBPred, double rLegAPred, double rLegBPred) {
-	atrias_msgs::robot_state robotState = rtOps->getRobotStateHandler()->getRobotState();
-
+bool Safety::checkCollision(const atrias_msgs::robot_state &robotState,
+                            double lLegAPred, double lLegBPred, double rLegAPred, double rLegBPred) {
 	// Check if a single motor has exceeded its limits.
 	if (lLegAPred < LEG_A_MOTOR_MIN_LOC + LEG_LOC_SAFETY_DISTANCE) {
 		rtOps->getOpsLogger()->sendEvent(RtOpsEvent::SAFETY, (RtOpsEventMetadata_t) RtOpsEventSafetyMetadata::LEFT_LEG_A_TOO_SMALL);
@@ -63,7 +63,8 @@ void StateMachine::ackCMState(RtOpsState state) {
 	}
 }
 
-medulla_state_t StateMachine::calcState(atrias_msgs::controller_output controllerOutput) {
+medulla_state_t StateMachine::calcState(const atrias_msgs::robot_state     &robotState,
+                                        const atrias_msgs::controller_output &controllerOutput) {
 	switch (getRtOpsState()) {
 		case RtOpsState::E_STOP:
 			return medulla_state_error;
@@ -87,7 +88,7 @@ medulla_state_t StateMachine::calcState(atrias_msgs::controller_output controlle
 			if (controllerOutput.command == medulla_state_error)
 				eStop(RtOpsEvent::CONTROLLER_ESTOP);
 
-			if (rtOps->getSafety()->shouldEStop(controllerOutput)) {
+			if (rtOps->getSafety()->shouldEStop(robotState, controllerOutput)) {
 				// This is a bit of a kludge -- send the MEDULLA_ESTOP event to tell the GUI and CM that
 				// it's enterinng ESTOP state.
 				eStop(RtOpsEvent::MEDULLA_ESTOP);
@@ -95,7 +96,7 @@ medulla_state_t StateMachine::calcState(atrias_msgs::controller_output controlle
 				return medulla_state_error;
 			}
 			
-			if (rtOps->getSafety()->shouldHalt()) {
+			if (rtOps->getSafety()->shouldHalt(robotState)) {
 				setState(RtOpsState::HALT);
 				printf("Software safety halt\n");
 				return medulla_state_halt;
@@ -122,13 +123,15 @@ void StateMachine::newCMState(RtOpsState new_state) {
 			rtOps->getControllerLoop()->setControllerLoaded();
 			break;
 			
-		case RtOpsState::ENABLED:
-			if (rtOps->getSafety()->shouldHalt()) {
+		case RtOpsState::ENABLED: {
+			RobotStateHandler::Snapshot robotState(rtOps->getRobotStateHandler());
+			if (rtOps->getSafety()->shouldHalt(robotState.get())) {
 				new_state = RtOpsState::DISABLED;
 				printf("Software safety halt\n");
 			}
 			
 			break;
+		}
 			
 		case RtOpsState::RESET:
 			rtOps->getControllerLoop()->setControllerUnloaded();
@@ -0,0 +1,249 @@
+/** @file
+  * @brief Checks the log_data packing gen_log_record.py generates from
+  * log_data.msg against the hand-written packing it replaced.
+  *
+  * For each field in turn, a log_data message with only that field set is
+  * unpacked into its sources with unpackLogRecord(), then packed again both
+  * by packLogRecord() and by the hand-written mapping. Both must give back
+  * the message they started from, so every field must come from the same
+  * source the hand-written code used, and no two fields may share one.
+  *
+  * It also checks that a LogRecord packed from the same sources has exactly
+  * the bytes of the serialized message, which the flight recorder relies on.
+  *
+  * Exits with a nonzero status if a check fails.
+  */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <vector>
+
+#include <atrias_msgs/log_data.h>
+#include <ros/serialization.h>
+
+#include "atrias_rt_ops/LogRecordPacker.h"
+
+using namespace atrias::rtOps;
+
+// The value the field being checked is set to; it fits every field's type.
+#define FIELD_VALUE 7
+
+/** @brief The hand-written mapping from OpsLogger::packLogData(), before it
+  * was generated, with rLegBodyVelocity taken from the right leg.
+  */
+static void goldenPack(atrias_msgs::log_data &ld, const atrias_msgs::robot_state &rs,
+                       const atrias_msgs::controller_output &co_raw,
+                       const atrias_msgs::controller_output &co_clamped)
+{
+	ld.header            = rs.header;
+
+	ld.currentPositive   = rs.currentPositive;
+	ld.currentNegative   = rs.currentNegative;
+
+	ld.lAClampedCmd      = co_clamped.lLeg.motorCurrentA;
+	ld.lBClampedCmd      = co_clamped.lLeg.motorCurrentB;
+	ld.lHipClampedCmd    = co_clamped.lLeg.motorCurrentHip;
+	ld.rAClampedCmd      = co_clamped.rLeg.motorCurrentA;
+	ld.rBClampedCmd      = co_clamped.rLeg.motorCurrentB;
+	ld.rHipClampedCmd    = co_clamped.rLeg.motorCurrentHip;
+
+	ld.lARawCmd          = co_raw.lLeg.motorCurrentA;
+	ld.lBRawCmd          = co_raw.lLeg.motorCurrentB;
+	ld.lHipRawCmd        = co_raw.lLeg.motorCurrentHip;
+	ld.rARawCmd          = co_raw.rLeg.motorCurrentA;
+	ld.rBRawCmd          = co_raw.rLeg.motorCurrentB;
+	ld.rHipRawCmd        = co_raw.rLeg.motorCurrentHip;
+
+	ld.lKneeForce        = rs.lLeg.kneeForce;
+	ld.rKneeForce        = rs.rLeg.kneeForce;
+
+	ld.lALegAngle        = rs.lLeg.halfA.legAngle;
+	ld.lBLegAngle        = rs.lLeg.halfB.legAngle;
+	ld.rALegAngle        = rs.rLeg.halfA.legAngle;
+	ld.rBLegAngle        = rs.rLeg.halfB.legAngle;
+
+	ld.lALegVelocity     = rs.lLeg.halfA.legVelocity;
+	ld.lBLegVelocity     = rs.lLeg.halfB.legVelocity;
+	ld.rALegVelocity     = rs.rLeg.halfA.legVelocity;
+	ld.rBLegVelocity     = rs.rLeg.halfB.legVelocity;
+
+	ld.lAMotorAngle      = rs.lLeg.halfA.motorAngle;
+	ld.lBMotorAngle      = rs.lLeg.halfB.motorAngle;
+	ld.rAMotorAngle      = rs.rLeg.halfA.motorAngle;
+	ld.rBMotorAngle      = rs.rLeg.halfB.motorAngle;
+
+	ld.lAMotorVelocity   = rs.lLeg.halfA.motorVelocity;
+	ld.lBMotorVelocity   = rs.lLeg.halfB.motorVelocity;
+	ld.rAMotorVelocity   = rs.rLeg.halfA.motorVelocity;
+	ld.rBMotorVelocity   = rs.rLeg.halfB.motorVelocity;
+
+	ld.lARotorAngle      = rs.lLeg.halfA.rotorAngle;
+	ld.lBRotorAngle      = rs.lLeg.halfB.rotorAngle;
+	ld.rARotorAngle      = rs.rLeg.halfA.rotorAngle;
+	ld.rBRotorAngle      = rs.rLeg.halfB.rotorAngle;
+
+	ld.lARotorVelocity   = rs.lLeg.halfA.rotorVelocity;
+	ld.lBRotorVelocity   = rs.lLeg.halfB.rotorVelocity;
+	ld.rARotorVelocity   = rs.rLeg.halfA.rotorVelocity;
+	ld.rBRotorVelocity   = rs.rLeg.halfB.rotorVelocity;
+
+	ld.lLegBodyAngle     = rs.lLeg.hip.legBodyAngle;
+	ld.rLegBodyAngle     = rs.rLeg.hip.legBodyAngle;
+
+	ld.lLegBodyVelocity  = rs.lLeg.hip.legBodyVelocity;
+	ld.rLegBodyVelocity  = rs.rLeg.hip.legBodyVelocity;
+
+	ld.xPosition         = rs.position.xPosition;
+	ld.xVelocity         = rs.position.xVelocity;
+	ld.yPosition         = rs.position.yPosition;
+	ld.yVelocity         = rs.position.yVelocity;
+	ld.zPosition         = rs.position.zPosition;
+	ld.zVelocity         = rs.position.zVelocity;
+	ld.xAngle            = rs.position.xAngle;
+	ld.xAngleVelocity    = rs.position.xAngleVelocity;
+
+	ld.bodyPitch         = rs.position.bodyPitch;
+	ld.bodyPitchVelocity = rs.position.bodyPitchVelocity;
+
+	ld.boomAngle         = rs.position.boomAngle;
+	ld.boomAngleVelocity = rs.position.boomAngleVelocity;
+
+	ld.lToeSwitch        = rs.lLeg.toeSwitch;
+	ld.rToeSwitch        = rs.rLeg.toeSwitch;
+
+	ld.rtOpsState        = rs.rtOpsState;
+
+	ld.controllerTime    = rs.timing.controllerTime;
+
+	ld.lAMotorTherm0     = rs.lLeg.halfA.motorTherms[0];
+	ld.lAMotorTherm1     = rs.lLeg.halfA.motorTherms[1];
+	ld.lAMotorTherm2     = rs.lLeg.halfA.motorTherms[2];
+	ld.lAMotorTherm3     = rs.lLeg.halfA.motorTherms[3];
+	ld.lAMotorTherm4     = rs.lLeg.halfA.motorTherms[4];
+	ld.lAMotorTherm5     = rs.lLeg.halfA.motorTherms[5];
+	ld.lBMotorTherm0     = rs.lLeg.halfB.motorTherms[0];
+	ld.lBMotorTherm1     = rs.lLeg.halfB.motorTherms[1];
+	ld.lBMotorTherm2     = rs.lLeg.halfB.motorTherms[2];
+	ld.lBMotorTherm3     = rs.lLeg.halfB.motorTherms[3];
+	ld.lBMotorTherm4     = rs.lLeg.halfB.motorTherms[4];
+	ld.lBMotorTherm5     = rs.lLeg.halfB.motorTherms[5];
+	ld.rAMotorTherm0     = rs.rLeg.halfA.motorTherms[0];
+	ld.rAMotorTherm1     = rs.rLeg.halfA.motorTherms[1];
+	ld.rAMotorTherm2     = rs.rLeg.halfA.motorTherms[2];
+	ld.rAMotorTherm3     = rs.rLeg.halfA.motorTherms[3];
+	ld.rAMotorTherm4     = rs.rLeg.halfA.motorTherms[4];
+	ld.rAMotorTherm5     = rs.rLeg.halfA.motorTherms[5];
+	ld.rBMotorTherm0     = rs.rLeg.halfB.motorTherms[0];
+	ld.rBMotorTherm1     = rs.rLeg.halfB.motorTherms[1];
+	ld.rBMotorTherm2     = rs.rLeg.halfB.motorTherms[2];
+	ld.rBMotorTherm3     = rs.rLeg.halfB.motorTherms[3];
+	ld.rBMotorTherm4     = rs.rLeg.halfB.motorTherms[4];
+	ld.rBMotorTherm5     = rs.rLeg.halfB.motorTherms[5];
+
+	ld.lAMotorVoltage    = rs.lLeg.halfA.motorVoltage;
+	ld.lBMotorVoltage    = rs.lLeg.halfB.motorVoltage;
+	ld.lHipMotorVoltage  = rs.lLeg.hip.motorVoltage;
+	ld.rAMotorVoltage    = rs.rLeg.halfA.motorVoltage;
+	ld.rBMotorVoltage    = rs.rLeg.halfB.motorVoltage;
+	ld.rHipMotorVoltage  = rs.rLeg.hip.motorVoltage;
+}
+
+/** @brief Makes a message with one field set, the rest zero, and a header.
+  * @param index The field to set, counting from 0 after the header.
+  */
+static atrias_msgs::log_data makeMessage(int index) {
+	atrias_msgs::log_data ld;
+	ld.header.seq        = index + 1;
+	ld.header.stamp.sec  = 1000 + index;
+	ld.header.stamp.nsec = 2000 + index;
+
+	int i = 0;
+#define SET_FIELD(name) ld.name = (i++ == index) ? FIELD_VALUE : 0;
+	LOGRECORD_FIELDS(SET_FIELD)
+#undef SET_FIELD
+	return ld;
+}
+
+/** @brief Checks two messages' headers and fields match.
+  * @param what What's being checked, for the failure messages.
+  * @return The number of fields that differ.
+  */
+static int compare(const char* what, const atrias_msgs::log_data &expected, const atrias_msgs::log_data &actual) {
+	int failures = 0;
+	if (expected.header.seq != actual.header.seq || expected.header.stamp.sec != actual.header.stamp.sec ||
+	    expected.header.stamp.nsec != actual.header.stamp.nsec)
+	{
+		printf("FAIL: %s: header differs\n", what);
+		failures++;
+	}
+
+#define COMPARE_FIELD(name) \
+	if (expected.name != actual.name) { \
+		printf("FAIL: %s: " #name " is %g, expected %g\n", what, (double) actual.name, (double) expected.name); \
+		failures++; \
+	}
+	LOGRECORD_FIELDS(COMPARE_FIELD)
+#undef COMPARE_FIELD
+	return failures;
+}
+
+int main() {
+	int fields = 0;
+#define COUNT_FIELD(name) fields++;
+	LOGRECORD_FIELDS(COUNT_FIELD)
+#undef COUNT_FIELD
+
+	int failures = 0;
+	for (int index = 0; index < fields; index++) {
+		atrias_msgs::log_data in = makeMessage(index);
+
+		atrias_msgs::robot_state state;
+		atrias_msgs::controller_output raw, clamped;
+		unpackLogRecord(in, state, raw, clamped);
+
+		atrias_msgs::log_data golden, generated;
+		goldenPack(golden, state, raw, clamped);
+		packLogRecord(generated, state, raw, clamped);
+
+		failures += compare("hand-written packing", in, golden);
+		failures += compare("generated packing", in, generated);
+	}
+
+	// Every field set at once, to distinct values, for the record's layout
+	atrias_msgs::log_data in;
+	int i = 0;
+#define SET_FIELD(name) in.name = ++i;
+	LOGRECORD_FIELDS(SET_FIELD)
+#undef SET_FIELD
+	in.header.seq = 1;
+
+	atrias_msgs::robot_state state;
+	atrias_msgs::controller_output raw, clamped;
+	unpackLogRecord(in, state, raw, clamped);
+
+	LogRecord record;
+	packLogRecord(record, state, raw, clamped);
+
+	uint32_t length = ros::serialization::serializationLength(in);
+	std::vector<uint8_t> buffer(length);
+	ros::serialization::OStream stream(&buffer[0], length);
+	ros::serialization::serialize(stream, in);
+
+	if (length != sizeof(LogRecord) || memcmp(&buffer[0], &record, length)) {
+		printf("FAIL: a LogRecord (%zu bytes) doesn't match the serialized message (%u bytes)\n",
+		       sizeof(LogRecord), length);
+		failures++;
+	}
+
+	printf("Checked %d fields and a %zu byte record\n", fields, sizeof(LogRecord));
+	if (failures) {
+		printf("%d failures\n", failures);
+		return 1;
+	}
+
+	printf("All passed\n");
+	return 0;
+}
+
+// vim: noexpandtab
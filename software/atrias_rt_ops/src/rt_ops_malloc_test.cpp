@@ -0,0 +1,355 @@
+/** @file
+  * @brief Checks that RT Ops's cycle never allocates memory once it's
+  * running: from the Connector's newStateCallback() through the controller,
+  * the state machine and safeties, clamping and logging, to the Connector's
+  * sendControllerOutput().
+  *
+  * RT Ops is loaded as it is on the robot, with a Connector and a controller
+  * (defined here) as its peers. The controller is loaded and enabled through
+  * the controller manager port, then the Connector's side runs cycles at
+  * 1 kHz, long enough for the 50 Hz GUI and 1 Hz latency publishing to
+  * happen too. Every malloc(), calloc() and realloc() made on the two
+  * threads the cycle runs on, the Connector's and the controller loop's, is
+  * counted. After the first cycle, none may be made.
+  *
+  * The log data goes out over RT Ops's port unless ATRIAS_FLIGHT_RECORDER_DIR
+  * is set, in which case the flight recorder's path is checked instead.
+  *
+  * Exits with a nonzero status if a check fails.
+  */
+
+#include <math.h>
+#include <semaphore.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+
+// Orocos
+#include <rtt/OperationCaller.hpp>
+#include <rtt/OutputPort.hpp>
+#include <rtt/TaskContext.hpp>
+#include <rtt/deployment/ComponentLoader.hpp>
+#include <rtt/os/startstop.h>
+
+// ATRIAS
+#include <robot_invariant_defs.h>
+#include <robot_variant_defs.h>
+#include <atrias_msgs/controller_output.h>
+#include <atrias_msgs/robot_state.h>
+#include <atrias_shared/globals.h>
+
+using namespace atrias;
+
+// The cycles run, and how many at the start may allocate
+#define TEST_CYCLES   3000
+#define WARMUP_CYCLES 1
+
+// How long to wait for a cycle or a state change, in seconds
+#define TEST_TIMEOUT  1
+
+// The controller's commanded currents swing past the clamps by this much
+#define CURRENT_SWING 2.0
+
+/** @brief Whether allocations are being counted.
+  */
+static std::atomic<bool> counting(false);
+
+/** @brief The allocations counted.
+  */
+static std::atomic<long> allocations(0);
+
+/** @brief Whether this thread runs part of the cycle.
+  */
+static __thread bool cycleThread = false;
+
+static void countAllocation() {
+	if (cycleThread && counting.load())
+		allocations++;
+}
+
+// Everything else in the process, Orocos and RT Ops included, allocates
+// through these.
+extern "C" {
+
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void  __libc_free(void* ptr);
+
+void* malloc(size_t size) __THROW {
+	countAllocation();
+	return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) __THROW {
+	countAllocation();
+	return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) __THROW {
+	countAllocation();
+	return __libc_realloc(ptr, size);
+}
+
+void free(void* ptr) __THROW {
+	__libc_free(ptr);
+}
+
+}
+
+/** @brief Waits for a semaphore for up to TEST_TIMEOUT.
+  * @return False if it timed out.
+  */
+static bool waitFor(sem_t* sem) {
+	struct timespec deadline;
+	clock_gettime(CLOCK_REALTIME, &deadline);
+	deadline.tv_sec += TEST_TIMEOUT;
+	return sem_timedwait(sem, &deadline) == 0;
+}
+
+/** @brief Stands in for a Connector: takes RT Ops's controller outputs.
+  */
+class TestConnector : public RTT::TaskContext {
+	public:
+		/** @brief The last controller output sent.
+		  */
+		atrias_msgs::controller_output output;
+
+		/** @brief Posted for each controller output.
+		  */
+		sem_t                          outputSent;
+
+		TestConnector(std::string name) : RTT::TaskContext(name) {
+			this->provides("connector")
+			    ->addOperation("sendControllerOutput", &TestConnector::sendControllerOutput, this, RTT::ClientThread);
+			sem_init(&outputSent, 0, 0);
+		}
+
+		~TestConnector() {
+			sem_destroy(&outputSent);
+		}
+
+		void sendControllerOutput(const atrias_msgs::controller_output &controller_output) {
+			cycleThread = true;
+			output      = controller_output;
+			sem_post(&outputSent);
+		}
+};
+
+/** @brief Stands in for a controller: asks for currents on either side of
+  * the clamps, so they're always at work.
+  */
+class TestController : public RTT::TaskContext {
+	atrias_msgs::controller_output output;
+
+	public:
+		TestController(std::string name) : RTT::TaskContext(name) {
+			this->provides("atc")
+			    ->addOperation("runController", &TestController::runController, this, RTT::ClientThread);
+		}
+
+		atrias_msgs::controller_output& runController(const atrias_msgs::robot_state &robotState) {
+			cycleThread = true;
+			double swing = (robotState.header.seq % 2) ? CURRENT_SWING : -CURRENT_SWING;
+			output.command              = medulla_state_run;
+			output.lLeg.motorCurrentA   = swing * MAX_MTR_CURRENT_CMD;
+			output.lLeg.motorCurrentB   = swing * MAX_MTR_CURRENT_CMD;
+			output.lLeg.motorCurrentHip = swing * MAX_HIP_MTR_CURRENT_CMD;
+			output.rLeg.motorCurrentA   = swing * MAX_MTR_CURRENT_CMD;
+			output.rLeg.motorCurrentB   = swing * MAX_MTR_CURRENT_CMD;
+			output.rLeg.motorCurrentHip = swing * MAX_HIP_MTR_CURRENT_CMD;
+			return output;
+		}
+};
+
+/** @brief Fills in a robot state well inside the safeties' limits, with
+  * the legs swinging a little from cycle to cycle. The frame ID is left
+  * alone, so refilling the state doesn't allocate.
+  */
+static void makeRobotState(atrias_msgs::robot_state &state, uint32_t cycle) {
+	double swing = 0.1 * sin(cycle * 0.01);
+
+	state.header.seq         = cycle;
+	state.header.stamp.sec   = cycle / 1000;
+	state.header.stamp.nsec  = (cycle % 1000) * 1000000;
+	state.robotConfiguration = (RobotConfiguration_t) RobotConfiguration::BIPED_FULL;
+
+	atrias_msgs::robot_state_leg* legs[2] = {&state.lLeg, &state.rLeg};
+	for (int i = 0; i < 2; i++) {
+		legs[i]->halfA.motorAngle    = legs[i]->halfA.rotorAngle = legs[i]->halfA.legAngle = 0.5 + swing;
+		legs[i]->halfB.motorAngle    = legs[i]->halfB.rotorAngle = legs[i]->halfB.legAngle = 2.0 + swing;
+		legs[i]->halfA.medullaState  = medulla_state_run;
+		legs[i]->halfB.medullaState  = medulla_state_run;
+		legs[i]->hip.medullaState    = medulla_state_run;
+	}
+	state.boomMedullaState = medulla_state_run;
+}
+
+/** @brief Sends RT Ops a command from the controller manager and waits for
+  * it to take effect.
+  * @return False if it didn't in time.
+  */
+static bool commandState(RTT::OutputPort<uint8_t> &cmOut, RTT::OperationCaller<RtOpsState_t(void)> &getRtOpsState,
+                         RtOpsState state)
+{
+	cmOut.write((uint8_t) state);
+	for (int i = 0; i < 1000 * TEST_TIMEOUT; i++) {
+		if (getRtOpsState() == (RtOpsState_t) state)
+			return true;
+		usleep(1000);
+	}
+	return false;
+}
+
+/** @brief Checks that a controller output was clamped and sent as the
+  * controller asked.
+  * @return The number of failures.
+  */
+static int checkOutput(const atrias_msgs::controller_output &output, uint32_t cycle) {
+	double current    = (cycle % 2) ? MAX_MTR_CURRENT_CMD     : MIN_MTR_CURRENT_CMD;
+	double hipCurrent = (cycle % 2) ? MAX_HIP_MTR_CURRENT_CMD : MIN_HIP_MTR_CURRENT_CMD;
+	if (output.command != medulla_state_run ||
+	    output.lLeg.motorCurrentA != current    || output.lLeg.motorCurrentB != current ||
+	    output.rLeg.motorCurrentA != current    || output.rLeg.motorCurrentB != current ||
+	    output.lLeg.motorCurrentHip != hipCurrent || output.rLeg.motorCurrentHip != hipCurrent)
+	{
+		printf("FAIL: cycle %u's output wasn't clamped and sent\n", cycle);
+		return 1;
+	}
+	return 0;
+}
+
+/** @brief Runs the cycles, counting each one's allocations.
+  * @return The number of failures.
+  */
+static int runCycles(RTT::TaskContext* rt, TestConnector &connector) {
+	RTT::OperationCaller<void(const atrias_msgs::robot_state&)> newStateCallback =
+		rt->provides("rtOps")->getOperation("newStateCallback");
+	RTT::OperationCaller<RtOpsState_t(void)> getRtOpsState =
+		rt->provides("rtOps")->getOperation("getRtOpsState");
+
+	RTT::OutputPort<uint8_t> cmOut("cm_out");
+	if (!cmOut.connectTo(rt->ports()->getPort("controller_manager_data_in"))) {
+		printf("FAIL: could not connect to RT Ops's controller manager port\n");
+		return 1;
+	}
+
+	// The controller loop runs once as it starts.
+	if (!waitFor(&connector.outputSent)) {
+		printf("FAIL: RT Ops's controller loop didn't start\n");
+		return 1;
+	}
+
+	atrias_msgs::robot_state state;
+	state.header.frame_id = "/atrias";
+	uint32_t cycle = 0;
+	makeRobotState(state, cycle++);
+	newStateCallback(state);
+	waitFor(&connector.outputSent);
+
+	if (!commandState(cmOut, getRtOpsState, RtOpsState::DISABLED) ||
+	    !commandState(cmOut, getRtOpsState, RtOpsState::ENABLED))
+	{
+		printf("FAIL: RT Ops couldn't be enabled\n");
+		return 1;
+	}
+
+	int    failures          = 0;
+	int    allocatingCycles  = 0;
+	long   mostAllocations   = 0;
+	struct timespec next;
+	clock_gettime(CLOCK_MONOTONIC, &next);
+
+	cycleThread = true;
+	counting    = true;
+	for (int i = 0; i < TEST_CYCLES; i++, cycle++) {
+		makeRobotState(state, cycle);
+
+		long before = allocations.load();
+		newStateCallback(state);
+		if (!waitFor(&connector.outputSent)) {
+			printf("FAIL: cycle %u timed out\n", cycle);
+			failures++;
+			break;
+		}
+		long made = allocations.load() - before;
+
+		if (i >= WARMUP_CYCLES && made) {
+			if (allocatingCycles < 10)
+				printf("FAIL: cycle %d made %ld allocations\n", i, made);
+			allocatingCycles++;
+			mostAllocations = std::max(mostAllocations, made);
+		}
+		if (i >= WARMUP_CYCLES && failures < 10)
+			failures += checkOutput(connector.output, cycle);
+
+		next.tv_nsec += CONTROLLER_LOOP_PERIOD_NS;
+		if (next.tv_nsec >= SECOND_IN_NANOSECONDS) {
+			next.tv_sec++;
+			next.tv_nsec -= SECOND_IN_NANOSECONDS;
+		}
+		clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+	}
+	counting = false;
+
+	if (getRtOpsState() != (RtOpsState_t) RtOpsState::ENABLED) {
+		printf("FAIL: RT Ops left the enabled state (now %d)\n", getRtOpsState());
+		failures++;
+	}
+
+	printf("%d cycles after the first %d; %d allocated, at most %ld allocations each\n",
+	       TEST_CYCLES - WARMUP_CYCLES, WARMUP_CYCLES, allocatingCycles, mostAllocations);
+	cmOut.disconnect();
+	return failures + allocatingCycles;
+}
+
+int main(int argc, char **argv) {
+	__os_init(argc, argv);
+
+	RTT::ComponentLoader::shared_ptr loader = RTT::ComponentLoader::Instance();
+	RTT::TaskContext* rt = NULL;
+	if (loader->import("atrias_rt_ops", ""))
+		rt = loader->loadComponent("atrias_rt", "RTOps");
+	if (!rt) {
+		printf("FAIL: could not load RT Ops\n");
+		__os_exit();
+		return 1;
+	}
+
+	TestConnector  connector("atrias_connector");
+	TestController controller("controller");
+	rt->addPeer(&connector, "atrias_connector");
+	rt->addPeer(&controller, "controller");
+
+	// Locking memory needs privileges we may not have; it doesn't change
+	// whether anything allocates.
+	rt->properties()->getPropertyType<bool>("lockMemory")->set(false);
+
+	int failures;
+	if (rt->configure() && rt->start()) {
+		failures = runCycles(rt, connector);
+		rt->stop();
+	} else {
+		printf("FAIL: could not start RT Ops\n");
+		failures = 1;
+	}
+	rt->cleanup();
+	rt->removePeer("atrias_connector");
+	rt->removePeer("controller");
+	loader->unloadComponent(rt);
+	__os_exit();
+
+	if (failures) {
+		printf("%d failures\n", failures);
+		return 1;
+	}
+
+	printf("All passed\n");
+	return 0;
+}
+
+// vim: noexpandtab
@@ -0,0 +1,293 @@
+#ifndef FILTERS_H
+#define FILTERS_H
+
+/** @file
+  * @brief Small fixed-size filters for sensor data.
+  *
+  * Every filter's history is sized at compile time and stored inline, so
+  * none of them allocate, and each update touches one contiguous block of
+  * memory. They're all realtime safe and header-only, so both controllers
+  * and the medulla drivers may use them.
+  */
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace atrias {
+
+namespace shared {
+
+/** @brief A fixed-size history of samples, newest first.
+  * Pushing overwrites the oldest sample.
+  */
+template <class T, size_t N>
+class Ring {
+	/** @brief The samples. \a head is the newest.
+	  */
+	T      samples[N];
+
+	/** @brief The index of the newest sample.
+	  */
+	size_t head;
+
+	public:
+		/** @brief Fills the history with a value.
+		  * @param value The value to fill with.
+		  */
+		Ring(const T &value = T()) {
+			fill(value);
+		}
+
+		/** @brief Sets every sample to a value.
+		  */
+		void fill(const T &value) {
+			for (size_t i = 0; i < N; i++)
+				samples[i] = value;
+			head = 0;
+		}
+
+		/** @brief Adds a sample, dropping the oldest.
+		  */
+		void push(const T &value) {
+			head = (head == 0) ? N - 1 : head - 1;
+			samples[head] = value;
+		}
+
+		/** @brief Returns a sample by age: 0 is the newest, N - 1 the oldest.
+		  */
+		const T& operator[](size_t age) const {
+			size_t i = head + age;
+			return samples[(i < N) ? i : i - N];
+		}
+
+		/** @brief Returns the newest sample.
+		  */
+		const T& newest() const {
+			return samples[head];
+		}
+
+		/** @brief Returns the oldest sample.
+		  */
+		const T& oldest() const {
+			return (*this)[N - 1];
+		}
+
+		/** @brief Returns the sum of a run of samples.
+		  * @param first The age of the newest sample to include.
+		  * @param count The number of samples.
+		  */
+		T sum(size_t first, size_t count) const {
+			// The run is at most two contiguous pieces.
+			T total = T();
+			size_t i = head + first;
+			if (i >= N)
+				i -= N;
+			size_t run = (count < N - i) ? count : N - i;
+			for (size_t j = 0; j < run; j++)
+				total += samples[i + j];
+			for (size_t j = 0; j < count - run; j++)
+				total += samples[j];
+			return total;
+		}
+
+		/** @brief Returns the number of samples held.
+		  */
+		static size_t size() {
+			return N;
+		}
+};
+
+/** @brief The mean of the last N samples, kept as a running sum.
+  */
+template <size_t N>
+class MovingAverage {
+	Ring<double, N> history;
+	double          total;
+
+	public:
+		/** @brief Starts with a history full of one value.
+		  */
+		MovingAverage(double value = 0.0) {
+			reset(value);
+		}
+
+		/** @brief Refills the history with one value.
+		  */
+		void reset(double value) {
+			history.fill(value);
+			total = value*N;
+		}
+
+		/** @brief Adds a sample and returns the new mean.
+		  */
+		double operator()(double value) {
+			total += value - history.oldest();
+			history.push(value);
+			return this->value();
+		}
+
+		/** @brief Returns the current mean.
+		  */
+		double value() const {
+			return total/N;
+		}
+};
+
+/** @brief The median of the last N samples, to reject single outliers.
+  * N should be small and odd.
+  */
+template <size_t N>
+class MedianFilter {
+	Ring<double, N> history;
+
+	public:
+		/** @brief Starts with a history full of one value.
+		  */
+		MedianFilter(double value = 0.0) :
+			history(value)
+		{}
+
+		/** @brief Adds a sample and returns the new median.
+		  */
+		double operator()(double value) {
+			history.push(value);
+			return this->value();
+		}
+
+		/** @brief Returns the current median.
+		  */
+		double value() const {
+			// Insertion sort a copy; fast for the small N this is meant for.
+			double sorted[N];
+			for (size_t i = 0; i < N; i++) {
+				double x = history[i];
+				size_t j = i;
+				for (; j > 0 && sorted[j - 1] > x; j--)
+					sorted[j] = sorted[j - 1];
+				sorted[j] = x;
+			}
+			return sorted[N/2];
+		}
+};
+
+/** @brief Returns whether a 12-bit ADC reading is at either rail, which
+  * our ADCs report for bad samples.
+  */
+inline bool adcSaturated(uint16_t value, uint16_t max = 4095) {
+	return value == 0 || value >= max;
+}
+
+/** @brief Holds the last good ADC reading, rejecting rail values and jumps.
+  */
+class AdcOutlierFilter {
+	double last;
+	double maxJump;
+	bool   primed;
+
+	public:
+		/** @brief Initializes the filter.
+		  * @param maxJump The largest change accepted between samples. The
+		  *                first good sample is always accepted.
+		  */
+		AdcOutlierFilter(double maxJump = INFINITY) :
+			last(0.0),
+			maxJump(maxJump),
+			primed(false)
+		{}
+
+		/** @brief Filters a sample.
+		  * @param value The raw reading.
+		  * @return The reading, or the last good reading if this one is bad.
+		  */
+		double operator()(uint16_t value) {
+			if (adcSaturated(value))
+				return last;
+			if (primed && fabs(value - last) > maxJump)
+				return last;
+
+			last = value;
+			primed = true;
+			return last;
+		}
+};
+
+/** @brief A second-order IIR section, in transposed direct form II.
+  * Coefficients are normalized so a0 = 1.
+  */
+class Biquad {
+	double b0, b1, b2, a1, a2;
+	double z1, z2;
+	double y;
+
+	public:
+		/** @brief Initializes the filter as a pass-through.
+		  */
+		Biquad() :
+			b0(1.0), b1(0.0), b2(0.0), a1(0.0), a2(0.0),
+			z1(0.0), z2(0.0), y(0.0)
+		{}
+
+		/** @brief Sets the coefficients. The state is kept.
+		  */
+		void setCoefficients(double b0, double b1, double b2, double a1, double a2) {
+			this->b0 = b0;
+			this->b1 = b1;
+			this->b2 = b2;
+			this->a1 = a1;
+			this->a2 = a2;
+		}
+
+		/** @brief Makes this a first-order low pass: y += gain*(x - y).
+		  */
+		void setFirstOrder(double gain) {
+			setCoefficients(gain, 0.0, 0.0, gain - 1.0, 0.0);
+		}
+
+		/** @brief Makes this a second-order Butterworth-style low pass.
+		  * @param cutoff     The cutoff frequency (Hz).
+		  * @param sampleRate The sample rate (Hz).
+		  * @param q          The quality factor; 1/sqrt(2) is Butterworth.
+		  */
+		void setLowPass(double cutoff, double sampleRate, double q = M_SQRT1_2) {
+			double w = 2.0*M_PI*cutoff/sampleRate;
+			double alpha = sin(w)/(2.0*q);
+			double c = cos(w);
+			double a0 = 1.0 + alpha;
+			setCoefficients((1.0 - c)/2.0/a0, (1.0 - c)/a0, (1.0 - c)/2.0/a0,
+			                -2.0*c/a0, (1.0 - alpha)/a0);
+		}
+
+		/** @brief Sets the state as if the input had always been a value.
+		  */
+		void reset(double value) {
+			// The DC gain is (b0 + b1 + b2)/(1 + a1 + a2).
+			y = value*(b0 + b1 + b2)/(1.0 + a1 + a2);
+			z1 = y - b0*value;
+			z2 = b2*value - a2*y;
+		}
+
+		/** @brief Filters a sample.
+		  * @return The new output.
+		  */
+		double operator()(double x) {
+			y = b0*x + z1;
+			z1 = b1*x - a1*y + z2;
+			z2 = b2*x - a2*y;
+			return y;
+		}
+
+		/** @brief Returns the latest output.
+		  */
+		double value() const {
+			return y;
+		}
+};
+
+}
+
+}
+
+#endif // FILTERS_H
+
+// vim: noexpandtab
@@ -0,0 +1,511 @@
+#ifndef FLIGHTRECORDER_H
+#define FLIGHTRECORDER_H
+
+/** @file
+  * @brief A realtime-safe recorder writing fixed-size records into a
+  * memory-mapped ring file.
+  *
+  * The file starts with a header (see \a FlightRecorderFileHeader), then a
+  * table of up to FLIGHT_RECORDER_MAX_TOPICS topics (see
+  * \a FlightRecorderTopic), each with its ROS datatype, md5sum and full message
+  * definition, then \a capacity slots of \a recordSize bytes. Each slot holds
+  * a uint32 length and a uint32 topic index, followed by one message in ROS's
+  * wire encoding, so atrias/scripts/flight2bag.py can turn the file into a bag
+  * without knowing the message types. Once the ring is full the oldest
+  * records are overwritten.
+  *
+  * The file is preallocated and mapped when it is opened; recording a message
+  * is a copy into the mapping. One low-priority thread per process writes every
+  * recorder's mapping back to disk, and whatever it hasn't flushed the kernel
+  * still writes back if the process dies.
+  */
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// Orocos
+#include <rtt/Activity.hpp>
+#include <rtt/Logger.hpp>
+#include <rtt/os/Mutex.hpp>
+#include <rtt/os/MutexLock.hpp>
+
+// ROS
+#include <ros/message_traits.h>
+#include <ros/serialization.h>
+
+namespace atrias {
+
+namespace shared {
+
+/** @brief Identifies a flight recorder file.
+  */
+#define FLIGHT_RECORDER_MAGIC       "ATRFLT01"
+
+/** @brief The file format version.
+  */
+#define FLIGHT_RECORDER_VERSION     2
+
+/** @brief The default number of records per file (5 minutes at 1 kHz).
+  */
+#define FLIGHT_RECORDER_CAPACITY    300000
+
+/** @brief The most topics one file may hold.
+  */
+#define FLIGHT_RECORDER_MAX_TOPICS  64
+
+/** @brief The space reserved for the topics' message definitions (bytes).
+  */
+#define FLIGHT_RECORDER_DEFINITIONS_SIZE (256 * 1024)
+
+/** @brief How often the flushing thread writes the files back (seconds).
+  */
+#define FLIGHT_RECORDER_FLUSH_PERIOD 1.0
+
+/** @brief If this environment variable is set, RT Ops and the controllers'
+  * log ports record into files in the directory it names instead of logging
+  * over ROS.
+  */
+#define FLIGHT_RECORDER_DIR_ENV     "ATRIAS_FLIGHT_RECORDER_DIR"
+
+/** @brief The header at the start of each flight recorder file.
+  * The topic table follows it, then the message definitions, and the records
+  * start at \a headerSize.
+  */
+struct FlightRecorderFileHeader {
+	char     magic[8];
+	uint32_t version;
+	uint32_t headerSize;
+	uint32_t recordSize;
+	uint32_t topicCount; // The number of topics in the table
+	uint64_t capacity;
+	uint64_t writeCount; // The number of records ever written
+	uint64_t dropCount;  // The number of messages too large for a slot
+};
+
+/** @brief One entry in a flight recorder file's topic table.
+  */
+struct FlightRecorderTopic {
+	char     topic[128];
+	char     datatype[128];
+	char     md5sum[40];
+	uint32_t definitionOffset; // From the start of the file
+	uint32_t definitionSize;
+};
+
+class FlightRecorder;
+
+/** @brief Flushes every open flight recorder in the process periodically.
+  */
+class FlightRecorderFlusher : public RTT::Activity {
+	std::vector<FlightRecorder*> recorders;
+
+	/** @brief Protects \a recorders. Never taken by a recorder's writer.
+	  */
+	RTT::os::Mutex               recordersLock;
+
+	FlightRecorderFlusher() :
+		RTT::Activity(ORO_SCHED_OTHER, 0, FLIGHT_RECORDER_FLUSH_PERIOD, 0, "FlightRecorderFlusher")
+	{}
+
+	public:
+		/** @brief Returns the process's flusher.
+		  * It's never destroyed, so recorders may be closed during exit.
+		  */
+		static FlightRecorderFlusher& instance() {
+			static FlightRecorderFlusher* flusher = new FlightRecorderFlusher();
+			return *flusher;
+		}
+
+		/** @brief Starts flushing a recorder, starting our thread if needed.
+		  */
+		void add(FlightRecorder* recorder) {
+			{
+				RTT::os::MutexLock lock(recordersLock);
+				recorders.push_back(recorder);
+			}
+			if (!isActive())
+				start();
+		}
+
+		/** @brief Stops flushing a recorder, stopping our thread with the last.
+		  */
+		void remove(FlightRecorder* recorder) {
+			bool empty;
+			{
+				RTT::os::MutexLock lock(recordersLock);
+				recorders.erase(std::remove(recorders.begin(), recorders.end(), recorder), recorders.end());
+				empty = recorders.empty();
+			}
+			if (empty)
+				stop();
+		}
+
+		/** @brief Flushes every recorder. Run periodically by our thread.
+		  */
+		void step();
+};
+
+class FlightRecorder {
+	/** @brief The mapped file, or NULL if we're not recording.
+	  */
+	uint8_t*                  mapping;
+
+	/** @brief The size of \a mapping.
+	  */
+	size_t                    mappingSize;
+
+	/** @brief The start of \a mapping, as a header.
+	  */
+	volatile FlightRecorderFileHeader* header;
+
+	/** @brief The topic table.
+	  */
+	FlightRecorderTopic*      topics;
+
+	/** @brief The first slot.
+	  */
+	uint8_t*                  records;
+
+	/** @brief Our copies of the header's sizes, so the RT side never reads
+	  * the mapping.
+	  */
+	uint32_t                  recordSize;
+	uint64_t                  capacity;
+
+	/** @brief The number of records written. Only modified by the writer.
+	  */
+	uint64_t                  writeCount;
+
+	/** @brief \a writeCount as of the last flush. Only used by the flusher.
+	  */
+	uint64_t                  flushedCount;
+
+	/** @brief The number of topics, and the definition space they've used.
+	  * Only modified by \a addTopic().
+	  */
+	uint32_t                  topicCount;
+	uint32_t                  definitionsUsed;
+
+	/** @brief Serializes \a addTopic(), which may be called from any thread.
+	  */
+	RTT::os::Mutex            topicsLock;
+
+	/** @brief Synchronizes a range of the mapping with the file.
+	  */
+	void syncRange(size_t start, size_t end) {
+		size_t page = sysconf(_SC_PAGESIZE);
+		start -= start % page;
+		msync(mapping + start, end - start, MS_SYNC);
+	}
+
+	public:
+		FlightRecorder() {
+			mapping         = NULL;
+			mappingSize     = 0;
+			header          = NULL;
+			topics          = NULL;
+			records         = NULL;
+			recordSize      = 0;
+			capacity        = 0;
+			writeCount      = 0;
+			flushedCount    = 0;
+			topicCount      = 0;
+			definitionsUsed = 0;
+		}
+
+		~FlightRecorder() {
+			close();
+		}
+
+		/** @brief Returns the directory in which to record, or NULL if recording is disabled.
+		  */
+		static const char* getDirectory() {
+			const char* dir = getenv(FLIGHT_RECORDER_DIR_ENV);
+			if (!dir || !dir[0])
+				return NULL;
+			return dir;
+		}
+
+		/** @brief Builds the name of a new recorder file.
+		  * @param dir  The directory in which to create the file.
+		  * @param name What's recorded, such as a topic. The file is named
+		  *             after it and the current time.
+		  */
+		static std::string makePath(const std::string &dir, const std::string &name) {
+			char stamp[32];
+			time_t now = time(NULL);
+			strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", localtime(&now));
+
+			std::string base = name;
+			if (!base.empty() && base[0] == '/')
+				base.erase(0, 1);
+			for (size_t i = 0; i < base.size(); i++) {
+				if (base[i] == '/')
+					base[i] = '_';
+			}
+
+			return dir + "/" + base + "-" + stamp + ".flight";
+		}
+
+		/** @brief Creates and maps a new flight recorder file, with no topics
+		  * yet. Not realtime safe.
+		  * @param path        The file to create. It is overwritten if it exists.
+		  * @param max_length  The largest message (bytes) that will be recorded.
+		  * @param num_records How many records the ring holds.
+		  * @return True if successful, false otherwise.
+		  */
+		bool open(const std::string &path, uint32_t max_length,
+		          uint64_t num_records = FLIGHT_RECORDER_CAPACITY)
+		{
+			close();
+
+			size_t page   = sysconf(_SC_PAGESIZE);
+			size_t hdrLen = sizeof(FlightRecorderFileHeader) +
+			                FLIGHT_RECORDER_MAX_TOPICS * sizeof(FlightRecorderTopic) +
+			                FLIGHT_RECORDER_DEFINITIONS_SIZE;
+			hdrLen        = (hdrLen + page - 1) / page * page;
+
+			// Keep the slots 8-byte aligned.
+			recordSize    = (2 * sizeof(uint32_t) + max_length + 7) / 8 * 8;
+			capacity      = num_records;
+			mappingSize   = hdrLen + recordSize * capacity;
+
+			int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+			if (fd == -1) {
+				log(RTT::Error) << "[FlightRecorder] Failed to create " << path << RTT::endlog();
+				return false;
+			}
+
+			// Allocate the disk blocks now so the writer never waits on the filesystem.
+			if (posix_fallocate(fd, 0, mappingSize)) {
+				log(RTT::Error) << "[FlightRecorder] Failed to allocate " << mappingSize
+				                << " bytes for " << path << RTT::endlog();
+				::close(fd);
+				return false;
+			}
+
+			void* addr = mmap(NULL, mappingSize, PROT_READ | PROT_WRITE,
+			                  MAP_SHARED | MAP_POPULATE, fd, 0);
+			::close(fd);
+			if (addr == MAP_FAILED) {
+				log(RTT::Error) << "[FlightRecorder] Failed to map " << path << RTT::endlog();
+				return false;
+			}
+			mapping = (uint8_t*) addr;
+			topics  = (FlightRecorderTopic*) (mapping + sizeof(FlightRecorderFileHeader));
+			records = mapping + hdrLen;
+
+			// Touch every page so the first pass through the ring doesn't page fault.
+			memset(mapping, 0, mappingSize);
+
+			FlightRecorderFileHeader* hdr = (FlightRecorderFileHeader*) mapping;
+			memcpy(hdr->magic, FLIGHT_RECORDER_MAGIC, sizeof(hdr->magic));
+			hdr->version        = FLIGHT_RECORDER_VERSION;
+			hdr->headerSize     = hdrLen;
+			hdr->recordSize     = recordSize;
+			hdr->capacity       = capacity;
+			header = hdr;
+
+			writeCount      = 0;
+			flushedCount    = 0;
+			topicCount      = 0;
+			definitionsUsed = 0;
+			syncRange(0, hdrLen);
+
+			FlightRecorderFlusher::instance().add(this);
+
+			log(RTT::Info) << "[FlightRecorder] Recording to " << path << RTT::endlog();
+			return true;
+		}
+
+		/** @brief Adds a topic to the file. Not realtime safe, but may be
+		  * called while another thread records.
+		  * @param topic      The topic under which its records should be converted.
+		  * @param datatype   The records' ROS datatype.
+		  * @param md5sum     The records' ROS md5sum.
+		  * @param definition The records' full ROS message definition.
+		  * @return The topic's index, for recording, or -1 if the file is full.
+		  */
+		int addTopic(const std::string &topic, const std::string &datatype,
+		             const std::string &md5sum, const std::string &definition)
+		{
+			RTT::os::MutexLock lock(topicsLock);
+			if (!mapping)
+				return -1;
+
+			size_t definitionsStart = sizeof(FlightRecorderFileHeader) +
+			                          FLIGHT_RECORDER_MAX_TOPICS * sizeof(FlightRecorderTopic);
+			if (topicCount >= FLIGHT_RECORDER_MAX_TOPICS ||
+			    definitionsUsed + definition.size() > FLIGHT_RECORDER_DEFINITIONS_SIZE)
+			{
+				log(RTT::Error) << "[FlightRecorder] No room to record " << topic << RTT::endlog();
+				return -1;
+			}
+
+			FlightRecorderTopic* entry = &topics[topicCount];
+			strncpy(entry->topic,    topic.c_str(),    sizeof(entry->topic)    - 1);
+			strncpy(entry->datatype, datatype.c_str(), sizeof(entry->datatype) - 1);
+			strncpy(entry->md5sum,   md5sum.c_str(),   sizeof(entry->md5sum)   - 1);
+			entry->definitionOffset = definitionsStart + definitionsUsed;
+			entry->definitionSize   = definition.size();
+			memcpy(mapping + entry->definitionOffset, definition.data(), definition.size());
+			definitionsUsed += definition.size();
+
+			// The entry must be in place before a reader can see it counted.
+			__sync_synchronize();
+			header->topicCount = ++topicCount;
+			syncRange(0, records - mapping);
+
+			log(RTT::Info) << "[FlightRecorder] Recording " << topic << RTT::endlog();
+			return topicCount - 1;
+		}
+
+		/** @brief Adds a topic for ROS messages of type \a MsgType.
+		  * Not realtime safe. See \a addTopic().
+		  */
+		template <class MsgType>
+		int addTopicForMessage(const std::string &topic) {
+			return addTopic(topic,
+			                ros::message_traits::datatype<MsgType>(),
+			                ros::message_traits::md5sum<MsgType>(),
+			                ros::message_traits::definition<MsgType>());
+		}
+
+		/** @brief Opens a file for recording ROS messages of type \a MsgType
+		  * on one topic, which is topic 0. Not realtime safe.
+		  * @param dir    The directory in which to create the file.
+		  * @param topic  The topic. The file is named after it and the current time.
+		  * @param sample A message as large as any that will be recorded.
+		  * @return True if successful, false otherwise.
+		  */
+		template <class MsgType>
+		bool openForMessage(const std::string &dir, const std::string &topic, const MsgType &sample) {
+			if (!open(makePath(dir, topic), ros::serialization::serializationLength(sample)))
+				return false;
+
+			if (addTopicForMessage<MsgType>(topic) < 0) {
+				close();
+				return false;
+			}
+			return true;
+		}
+
+		/** @brief Stops recording and unmaps the file. Not realtime safe.
+		  */
+		void close() {
+			if (!mapping)
+				return;
+
+			FlightRecorderFlusher::instance().remove(this);
+			flush();
+
+			RTT::os::MutexLock lock(topicsLock);
+			munmap(mapping, mappingSize);
+			mapping = NULL;
+			header  = NULL;
+			topics  = NULL;
+		}
+
+		/** @brief Checks whether we're recording.
+		  */
+		bool isOpen() const {
+			return mapping != NULL;
+		}
+
+		/** @brief Returns the largest message that fits in a slot.
+		  */
+		uint32_t getMaxLength() const {
+			return recordSize - 2 * sizeof(uint32_t);
+		}
+
+		/** @brief Returns the slot into which the next message should be written.
+		  * Realtime safe. Write at most \a getMaxLength() bytes, then call
+		  * \a commitRecord(). Only one thread may write.
+		  */
+		uint8_t* nextRecord() {
+			return records + (writeCount % capacity) * recordSize + 2 * sizeof(uint32_t);
+		}
+
+		/** @brief Finishes the record begun with \a nextRecord(). Realtime safe.
+		  * @param length The number of bytes written.
+		  * @param topic  The topic's index, from \a addTopic().
+		  */
+		void commitRecord(uint32_t length, uint32_t topic = 0) {
+			uint8_t* slot = records + (writeCount % capacity) * recordSize;
+			memcpy(slot, &length, sizeof(length));
+			memcpy(slot + sizeof(length), &topic, sizeof(topic));
+
+			// The record must be in place before a reader can see it counted.
+			writeCount++;
+			__sync_synchronize();
+			header->writeCount = writeCount;
+		}
+
+		/** @brief Serializes a ROS message into the next slot. Realtime safe
+		  * for messages without variable-length fields.
+		  * @param msg   The message to record.
+		  * @param topic The topic's index, from \a addTopic().
+		  */
+		template <class MsgType>
+		void record(const MsgType &msg, uint32_t topic = 0) {
+			uint32_t length = ros::serialization::serializationLength(msg);
+			if (length > getMaxLength()) {
+				header->dropCount = header->dropCount + 1;
+				return;
+			}
+
+			ros::serialization::OStream stream(nextRecord(), length);
+			ros::serialization::serialize(stream, msg);
+			commitRecord(length, topic);
+		}
+
+		/** @brief Writes the records since the last flush back to the file.
+		  * Called by the flusher's thread; blocks on disk I/O.
+		  */
+		void flush() {
+			if (!mapping)
+				return;
+
+			uint64_t count = header->writeCount;
+			size_t   hdrLen = records - mapping;
+			if (count - flushedCount >= capacity) {
+				syncRange(0, mappingSize);
+			} else if (count != flushedCount) {
+				size_t start = (flushedCount % capacity) * recordSize;
+				size_t end   = (count        % capacity) * recordSize;
+				if (end > start) {
+					syncRange(hdrLen + start, hdrLen + end);
+				} else {
+					// We wrapped around.
+					syncRange(hdrLen + start, mappingSize);
+					syncRange(hdrLen, hdrLen + end);
+				}
+				syncRange(0, hdrLen);
+			}
+			flushedCount = count;
+		}
+};
+
+inline void FlightRecorderFlusher::step() {
+	RTT::os::MutexLock lock(recordersLock);
+	for (size_t i = 0; i < recorders.size(); i++)
+		recorders[i]->flush();
+}
+
+}
+
+}
+
+#endif // FLIGHTRECORDER_H
+
+// vim: noexpandtab
@@ -0,0 +1,304 @@
+#ifndef LOCKSTEPCHANNEL_H
+#define LOCKSTEPCHANNEL_H
+
+/** @file
+  * @brief Runs a simulator and the controllers in lockstep through shared
+  * memory.
+  *
+  * Each physics step, the simulator posts the robot state and blocks until
+  * the connector posts the controller output computed from that state, which
+  * it then applies in the same step. Every step therefore sees exactly one
+  * controller cycle, so runs are deterministic and go as fast as the
+  * simulator and controller can.
+  *
+  * Messages are copied into the shared block in ROS's wire encoding, so
+  * either side can be restarted independently. The sides wait on futexes in
+  * the block. The simulator only waits while a connector is attached; if the
+  * connector stops answering, the simulator gives up after a timeout and runs
+  * freely until the connector answers again.
+  */
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <string>
+
+// ROS
+#include <ros/serialization.h>
+
+namespace atrias {
+
+namespace shared {
+
+/** @brief The lockstep block's format version. A block with another version
+  * is refused.
+  */
+#define LOCKSTEP_VERSION     1
+
+/** @brief The largest message (bytes) either side may post.
+  */
+#define LOCKSTEP_MAX_MESSAGE 4096
+
+/** @brief The block shared by the simulator and the connector.
+  */
+struct LockstepBlock {
+	/** @brief LOCKSTEP_VERSION once initialized; a new block is all zeros.
+	  */
+	std::atomic<uint32_t> version;
+
+	/** @brief Nonzero while a connector is answering states.
+	  */
+	std::atomic<uint32_t> attached;
+
+	/** @brief Incremented by the simulator for each state it posts.
+	  */
+	std::atomic<uint32_t> stateSeq;
+
+	/** @brief The \a stateSeq of the state \a output was computed from.
+	  */
+	std::atomic<uint32_t> outputSeq;
+
+	uint32_t              stateLength;
+	uint32_t              outputLength;
+	uint8_t               state[LOCKSTEP_MAX_MESSAGE];
+	uint8_t               output[LOCKSTEP_MAX_MESSAGE];
+};
+
+class LockstepChannel {
+	/** @brief The mapped block, or NULL if we're not open.
+	  */
+	LockstepBlock* block;
+
+	/** @brief Whether we're the connector, and attached.
+	  */
+	bool           connector;
+
+	/** @brief The \a stateSeq of the last state the connector read.
+	  */
+	uint32_t       lastStateSeq;
+
+	/** @brief Blocks until \a word no longer holds \a value, or the timeout passes.
+	  * @return True if the value changed, false on timeout.
+	  */
+	static bool waitWhile(std::atomic<uint32_t> &word, uint32_t value, double timeout) {
+		struct timespec now, deadline, remaining;
+		clock_gettime(CLOCK_MONOTONIC, &deadline);
+		deadline.tv_sec  += (time_t) timeout;
+		deadline.tv_nsec += (long) ((timeout - (time_t) timeout) * 1e9);
+		if (deadline.tv_nsec >= 1000000000L) {
+			deadline.tv_sec++;
+			deadline.tv_nsec -= 1000000000L;
+		}
+
+		while (word.load(std::memory_order_acquire) == value) {
+			clock_gettime(CLOCK_MONOTONIC, &now);
+			remaining.tv_sec  = deadline.tv_sec  - now.tv_sec;
+			remaining.tv_nsec = deadline.tv_nsec - now.tv_nsec;
+			if (remaining.tv_nsec < 0) {
+				remaining.tv_sec--;
+				remaining.tv_nsec += 1000000000L;
+			}
+			if (remaining.tv_sec < 0)
+				return false;
+
+			// The block is shared between processes, so this can't be a private futex.
+			syscall(SYS_futex, (uint32_t*) &word, FUTEX_WAIT, value, &remaining, NULL, 0);
+		}
+		return true;
+	}
+
+	/** @brief Wakes anyone waiting on \a word.
+	  */
+	static void wake(std::atomic<uint32_t> &word) {
+		syscall(SYS_futex, (uint32_t*) &word, FUTEX_WAKE, INT32_MAX, NULL, NULL, 0);
+	}
+
+	/** @brief Serializes a message into one of the block's buffers.
+	  * @return False if it doesn't fit.
+	  */
+	template <class MsgType>
+	static bool pack(const MsgType &msg, uint8_t* buffer, uint32_t &length) {
+		length = ros::serialization::serializationLength(msg);
+		if (length > LOCKSTEP_MAX_MESSAGE)
+			return false;
+
+		ros::serialization::OStream stream(buffer, length);
+		ros::serialization::serialize(stream, msg);
+		return true;
+	}
+
+	/** @brief Deserializes a message from one of the block's buffers.
+	  */
+	template <class MsgType>
+	static void unpack(MsgType &msg, uint8_t* buffer, uint32_t length) {
+		ros::serialization::IStream stream(buffer, length);
+		ros::serialization::deserialize(stream, msg);
+	}
+
+	public:
+		LockstepChannel() {
+			block        = NULL;
+			connector    = false;
+			lastStateSeq = 0;
+		}
+
+		~LockstepChannel() {
+			close();
+		}
+
+		/** @brief Opens the shared block, creating it if the other side hasn't.
+		  * Not realtime safe.
+		  * @param name The shared memory object's name, such as "/atrias_lockstep".
+		  * @return True if successful, false otherwise.
+		  */
+		bool open(const std::string &name) {
+			close();
+
+			int fd = shm_open(name.c_str(), O_RDWR | O_CREAT, 0666);
+			if (fd == -1)
+				return false;
+
+			// A new object is empty; either side may be first to size it.
+			if (ftruncate(fd, sizeof(LockstepBlock))) {
+				::close(fd);
+				return false;
+			}
+
+			void* addr = mmap(NULL, sizeof(LockstepBlock), PROT_READ | PROT_WRITE,
+			                  MAP_SHARED | MAP_POPULATE, fd, 0);
+			::close(fd);
+			if (addr == MAP_FAILED)
+				return false;
+			block = (LockstepBlock*) addr;
+
+			uint32_t version = 0;
+			if (!block->version.compare_exchange_strong(version, LOCKSTEP_VERSION) &&
+			    version != LOCKSTEP_VERSION) {
+				close();
+				return false;
+			}
+			return true;
+		}
+
+		/** @brief Stops answering states, leaving the block mapped. Called by
+		  * the connector; the simulator stops waiting for it. The connector
+		  * attaches again when it next waits for a state.
+		  */
+		void detach() {
+			if (!block || !connector)
+				return;
+
+			block->attached.store(0, std::memory_order_release);
+			connector = false;
+		}
+
+		/** @brief Unmaps the block, detaching first if we're the connector.
+		  * Nothing else may be using the channel.
+		  */
+		void close() {
+			if (!block)
+				return;
+
+			detach();
+			munmap(block, sizeof(LockstepBlock));
+			block = NULL;
+		}
+
+		/** @brief Checks whether the block is open.
+		  */
+		bool isOpen() const {
+			return block != NULL;
+		}
+
+		/** @brief Checks whether a connector is answering states.
+		  */
+		bool connectorAttached() const {
+			return block->attached.load(std::memory_order_acquire);
+		}
+
+		/** @brief Posts a new state. Called by the simulator.
+		  * @return False if the state is too large to post.
+		  */
+		template <class MsgType>
+		bool postState(const MsgType &state) {
+			if (!pack(state, block->state, block->stateLength))
+				return false;
+
+			block->stateSeq.fetch_add(1, std::memory_order_release);
+			wake(block->stateSeq);
+			return true;
+		}
+
+		/** @brief Waits for the output for the last posted state. Called by the simulator.
+		  * If it doesn't come in time, the connector is taken to be gone
+		  * until it next waits for a state.
+		  * @param output  Set to the controller's output.
+		  * @param timeout How long to wait (seconds).
+		  * @return True if the output arrived, false on timeout.
+		  */
+		template <class MsgType>
+		bool waitForOutput(MsgType &output, double timeout) {
+			uint32_t seq = block->stateSeq.load(std::memory_order_relaxed);
+			uint32_t answered;
+			while ((answered = block->outputSeq.load(std::memory_order_acquire)) != seq) {
+				if (!waitWhile(block->outputSeq, answered, timeout)) {
+					block->attached.store(0, std::memory_order_release);
+					return false;
+				}
+			}
+
+			unpack(output, block->output, block->outputLength);
+			return true;
+		}
+
+		/** @brief Waits for a new state. Called by the connector, which this attaches.
+		  * @param state   Set to the new state.
+		  * @param timeout How long to wait (seconds).
+		  * @return True if a state arrived, false on timeout.
+		  */
+		template <class MsgType>
+		bool waitForState(MsgType &state, double timeout) {
+			connector = true;
+			block->attached.store(1, std::memory_order_release);
+
+			if (!waitWhile(block->stateSeq, lastStateSeq, timeout))
+				return false;
+
+			// The simulator only overwrites a state we haven't answered once it
+			// has timed out on us, but then it may do so while we read.
+			do {
+				lastStateSeq = block->stateSeq.load(std::memory_order_acquire);
+				unpack(state, block->state, block->stateLength);
+			} while (block->stateSeq.load(std::memory_order_acquire) != lastStateSeq);
+			return true;
+		}
+
+		/** @brief Answers the state last returned by \a waitForState(). Called by the connector.
+		  * @return False if the output is too large to post.
+		  */
+		template <class MsgType>
+		bool postOutput(const MsgType &output) {
+			if (!pack(output, block->output, block->outputLength))
+				return false;
+
+			block->outputSeq.store(lastStateSeq, std::memory_order_release);
+			wake(block->outputSeq);
+			return true;
+		}
+};
+
+}
+
+}
+
+#endif // LOCKSTEPCHANNEL_H
+
+// vim: noexpandtab
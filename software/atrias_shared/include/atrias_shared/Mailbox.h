@@ -0,0 +1,116 @@
+#ifndef MAILBOX_H
+#define MAILBOX_H
+
+/** @file
+  * @brief A lock-free mailbox holding the latest value passed from one thread
+  * to another.
+  *
+  * Unlike SpscRing, older values are simply overwritten: the reader only
+  * ever sees the newest one. It's a triple buffer, so the writer and reader
+  * each own a buffer while a third holds the latest published value. Neither
+  * side ever blocks, allocates or makes a system call, so either side may be
+  * a realtime thread.
+  */
+
+#include <atomic>
+
+namespace atrias {
+
+namespace shared {
+
+template <class T>
+class Mailbox {
+	/** @brief Set in \a middle when it holds a value the reader hasn't taken.
+	  */
+	static const unsigned FRESH = 4;
+
+	/** @brief The buffers. Each side owns one, and \a middle the third.
+	  */
+	T                     buffers[3];
+
+	/** @brief The index of the buffer between the two sides, plus FRESH.
+	  */
+	std::atomic<unsigned> middle;
+
+	/** @brief The writer's buffer. Only used by the writer.
+	  */
+	unsigned              writeIndex;
+
+	/** @brief The reader's buffer. Only used by the reader.
+	  */
+	unsigned              readIndex;
+
+	/** @brief Whether the reader has ever taken a value.
+	  */
+	bool                  received;
+
+	public:
+		/** @brief Initializes the mailbox, empty.
+		  * @param prototype Each buffer starts as a copy of this, so values
+		  *                  with variable-length fields can be preallocated.
+		  */
+		Mailbox(const T &prototype = T()) :
+			middle(1),
+			writeIndex(0),
+			readIndex(2),
+			received(false)
+		{
+			for (int i = 0; i < 3; i++)
+				buffers[i] = prototype;
+		}
+
+		/** @brief Returns the buffer to fill before \a publish().
+		  * Only call this from the writing thread.
+		  */
+		T& writeSlot() {
+			return buffers[writeIndex];
+		}
+
+		/** @brief Makes the buffer from \a writeSlot() the latest value.
+		  */
+		void publish() {
+			unsigned old = middle.exchange(writeIndex | FRESH, std::memory_order_acq_rel);
+			writeIndex = old & ~FRESH;
+		}
+
+		/** @brief Copies a value in and publishes it.
+		  */
+		void post(const T &value) {
+			writeSlot() = value;
+			publish();
+		}
+
+		/** @brief Takes the latest value, if one was published since the last call.
+		  * Only call this from the reading thread.
+		  * @return True if there was a new value.
+		  */
+		bool update() {
+			if (!(middle.load(std::memory_order_relaxed) & FRESH))
+				return false;
+
+			unsigned old = middle.exchange(readIndex, std::memory_order_acq_rel);
+			readIndex = old & ~FRESH;
+			received = true;
+			return true;
+		}
+
+		/** @brief Returns whether \a update() has ever taken a value.
+		  */
+		bool hasValue() const {
+			return received;
+		}
+
+		/** @brief Returns the value last taken by \a update().
+		  */
+		const T& read() const {
+			return buffers[readIndex];
+		}
+};
+
+}
+
+}
+
+#endif // MAILBOX_H
+
+// vim: noexpandtab
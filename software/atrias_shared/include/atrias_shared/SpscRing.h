@@ -0,0 +1,103 @@
+#ifndef SPSCRING_H
+#define SPSCRING_H
+
+/** @file
+  * @brief A lock-free, fixed-size ring for passing items from one thread to
+  * another.
+  *
+  * All the items are allocated when the ring is constructed. The writer fills
+  * a slot in place and then commits it; the reader reads a slot in place and
+  * then releases it. Neither side ever blocks, allocates or makes a system
+  * call, so either side may be a realtime thread.
+  */
+
+#include <stddef.h>
+
+#include <atomic>
+#include <vector>
+
+namespace atrias {
+
+namespace shared {
+
+template <class T>
+class SpscRing {
+	/** @brief The slots. The size is a power of two.
+	  */
+	std::vector<T>      slots;
+
+	/** @brief \a slots.size() - 1, for wrapping indices.
+	  */
+	size_t              mask;
+
+	/** @brief The number of items ever committed. Only written by the writer.
+	  */
+	std::atomic<size_t> head;
+
+	/** @brief The number of items ever released. Only written by the reader.
+	  */
+	std::atomic<size_t> tail;
+
+	public:
+		/** @brief Allocates the ring. Not realtime safe.
+		  * @param capacity The number of items it holds. Rounded up to a power of two.
+		  * @param prototype Each slot starts as a copy of this, so items with
+		  *                  variable-length fields can be preallocated.
+		  */
+		SpscRing(size_t capacity, const T &prototype = T()) :
+			head(0),
+			tail(0)
+		{
+			size_t size = 1;
+			while (size < capacity)
+				size *= 2;
+			slots.assign(size, prototype);
+			mask = size - 1;
+		}
+
+		/** @brief Returns the number of items the ring holds.
+		  */
+		size_t capacity() const {
+			return slots.size();
+		}
+
+		/** @brief Returns the next slot to be written, or NULL if the ring is full.
+		  * Only call this from the writing thread.
+		  */
+		T* writeSlot() {
+			size_t h = head.load(std::memory_order_relaxed);
+			if (h - tail.load(std::memory_order_acquire) >= slots.size())
+				return NULL;
+			return &slots[h & mask];
+		}
+
+		/** @brief Makes the slot from \a writeSlot() visible to the reader.
+		  */
+		void commit() {
+			head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+		}
+
+		/** @brief Returns the oldest unread item, or NULL if the ring is empty.
+		  * Only call this from the reading thread.
+		  */
+		T* readSlot() {
+			size_t t = tail.load(std::memory_order_relaxed);
+			if (t == head.load(std::memory_order_acquire))
+				return NULL;
+			return &slots[t & mask];
+		}
+
+		/** @brief Returns the slot from \a readSlot() to the writer.
+		  */
+		void release() {
+			tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+		}
+};
+
+}
+
+}
+
+#endif // SPSCRING_H
+
+// vim: noexpandtab
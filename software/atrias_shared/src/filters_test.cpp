@@ -0,0 +1,272 @@
+/** @file
+  * @brief Checks the filters in Filters.h against straightforward versions
+  * built on std::deque, and times the toe filter both ways.
+  *
+  * The toe filter is ATCSlipWalking's updateToeFilter() and detectStance(),
+  * as they were with a std::deque history and as they are with a Ring. Both
+  * are fed the same readings: a noisy baseline with touchdowns, and the
+  * occasional rail value and spike. Their histories and stance decisions
+  * must match exactly.
+  *
+  * Exits with a nonzero status if a check fails.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#include <algorithm>
+#include <deque>
+#include <numeric>
+#include <vector>
+
+#include "atrias_shared/Filters.h"
+
+using namespace atrias::shared;
+
+// The samples each filter is checked over
+#define TEST_SAMPLES 200000
+
+// How far the running sums may drift from summing the history afresh
+#define SUM_TOLERANCE 1e-6
+
+// ATCSlipWalking's toe history
+#define TOE_HISTORY 120
+typedef Ring<double, TOE_HISTORY> ToeHistory;
+
+// The old updateToeFilter() and detectStance(), with a std::deque history
+static void dequeUpdateToeFilter(uint16_t newToe, std::deque<double> *filteredToe) {
+	double toe = (double) newToe;
+
+	double prevToe = filteredToe->front();
+	if ((newToe == 4095) || (newToe == 0))
+		toe = prevToe;
+
+	if ((fabs(prevToe - toe) > 1500.0) && (filteredToe->back() != 5000.0))
+		toe = prevToe;
+
+	filteredToe->pop_back();
+	int nSamples = 3;
+	double average = (std::accumulate(filteredToe->begin(), filteredToe->begin()+nSamples-1, 0.0) + toe)/((double)nSamples);
+	filteredToe->push_front(average);
+}
+
+static bool dequeDetectStance(uint16_t toeSwitch, std::deque<double> *filteredToe) {
+	double baseline = std::accumulate(filteredToe->begin()+20.0, filteredToe->end(), 0.0)/(filteredToe->size()-20.0);
+	return ((double) toeSwitch) > 600.0 + baseline;
+}
+
+// The current updateToeFilter() and detectStance(), with a Ring
+static void ringUpdateToeFilter(uint16_t newToe, ToeHistory *filteredToe) {
+	double toe = (double) newToe;
+
+	double prevToe = filteredToe->newest();
+	if (adcSaturated(newToe))
+		toe = prevToe;
+
+	if ((fabs(prevToe - toe) > 1500.0) && (filteredToe->oldest() != 5000.0))
+		toe = prevToe;
+
+	int nSamples = 3;
+	double average = (filteredToe->sum(0, nSamples-1) + toe)/((double)nSamples);
+	filteredToe->push(average);
+}
+
+static bool ringDetectStance(uint16_t toeSwitch, ToeHistory *filteredToe) {
+	double baseline = filteredToe->sum(20, filteredToe->size()-20)/(filteredToe->size()-20.0);
+	return ((double) toeSwitch) > 600.0 + baseline;
+}
+
+/** @brief Makes up toe readings: a noisy baseline, with a touchdown every
+  * so often, and the occasional rail value or spike.
+  */
+static void makeToeReadings(std::vector<uint16_t> &readings) {
+	srand(1);
+	for (size_t i = 0; i < readings.size(); i++) {
+		int value = 1800 + rand() % 60;
+		if ((i / 400) % 2)
+			value += 1200;
+		if (rand() % 100 == 0)
+			value = (rand() % 2) ? 0 : 4095;
+		else if (rand() % 200 == 0)
+			value = rand() % 4096;
+		readings[i] = value;
+	}
+}
+
+static double now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/** @brief Runs the toe filter both ways over the readings, checking they agree.
+  * @return The number of failures.
+  */
+static int checkToeFilter(const std::vector<uint16_t> &readings) {
+	std::deque<double> deque(TOE_HISTORY, 5000.0);
+	ToeHistory ring(5000.0);
+
+	int failures = 0;
+	int stances = 0;
+	for (size_t i = 0; i < readings.size(); i++) {
+		dequeUpdateToeFilter(readings[i], &deque);
+		ringUpdateToeFilter(readings[i], &ring);
+
+		bool dequeStance = dequeDetectStance(readings[i], &deque);
+		bool ringStance = ringDetectStance(readings[i], &ring);
+		stances += ringStance;
+
+		bool same = dequeStance == ringStance;
+		for (size_t age = 0; age < TOE_HISTORY; age++)
+			same = same && deque[age] == ring[age];
+		if (!same) {
+			printf("FAIL: toe filter differs after sample %zu\n", i);
+			if (++failures >= 10)
+				break;
+		}
+	}
+
+	printf("Toe filter: %zu samples, %d in stance\n", readings.size(), stances);
+	return failures;
+}
+
+/** @brief Times the toe filter both ways over the readings.
+  */
+static void benchToeFilter(const std::vector<uint16_t> &readings) {
+	std::deque<double> deque(TOE_HISTORY, 5000.0);
+	ToeHistory ring(5000.0);
+	int stances = 0;
+
+	double start = now();
+	for (size_t i = 0; i < readings.size(); i++) {
+		dequeUpdateToeFilter(readings[i], &deque);
+		stances += dequeDetectStance(readings[i], &deque);
+	}
+	double dequeTime = (now() - start)/readings.size();
+
+	start = now();
+	for (size_t i = 0; i < readings.size(); i++) {
+		ringUpdateToeFilter(readings[i], &ring);
+		stances -= ringDetectStance(readings[i], &ring);
+	}
+	double ringTime = (now() - start)/readings.size();
+
+	printf("Toe filter, per sample (%s):\n", stances ? "results differ" : "same results");
+	printf("  std::deque: %.1f ns\n", dequeTime*1e9);
+	printf("  Ring:       %.1f ns\n", ringTime*1e9);
+}
+
+/** @brief Checks MovingAverage and MedianFilter against a std::deque history.
+  * @return The number of failures.
+  */
+static int checkAverages() {
+	const size_t N = 5;
+	MovingAverage<N> average(2.0);
+	MedianFilter<N> median(2.0);
+	std::deque<double> history(N, 2.0);
+
+	int failures = 0;
+	double maxSumError = 0.0;
+	srand48(2);
+	for (int i = 0; i < TEST_SAMPLES; i++) {
+		double x = (drand48() < 0.01) ? 1000.0 : drand48();
+		history.pop_back();
+		history.push_front(x);
+
+		std::vector<double> sorted(history.begin(), history.end());
+		std::sort(sorted.begin(), sorted.end());
+		double expectedMean = std::accumulate(history.begin(), history.end(), 0.0)/N;
+
+		double sumError = fabs(average(x) - expectedMean);
+		maxSumError = std::max(maxSumError, sumError);
+		if (sumError > SUM_TOLERANCE || median(x) != sorted[N/2]) {
+			printf("FAIL: sample %d: mean %g (expected %g), median %g (expected %g)\n",
+			       i, average.value(), expectedMean, median.value(), sorted[N/2]);
+			if (++failures >= 10)
+				break;
+		}
+	}
+
+	printf("MovingAverage and MedianFilter: %d samples, largest mean drift %.2e\n", TEST_SAMPLES, maxSumError);
+	return failures;
+}
+
+/** @brief Checks AdcOutlierFilter holds the last good reading.
+  * @return The number of failures.
+  */
+static int checkOutliers() {
+	AdcOutlierFilter filter(100.0);
+	const uint16_t readings[] = {0, 2000, 2050, 4095, 2500, 2100, 0, 2150};
+	const double   expected[] = {0, 2000, 2050, 2050, 2050, 2100, 2100, 2150};
+
+	int failures = 0;
+	for (size_t i = 0; i < sizeof(readings)/sizeof(readings[0]); i++) {
+		double value = filter(readings[i]);
+		if (value != expected[i]) {
+			printf("FAIL: AdcOutlierFilter gave %g for %d (expected %g)\n", value, readings[i], expected[i]);
+			failures++;
+		}
+	}
+	return failures;
+}
+
+/** @brief Checks Biquad against ASCToeDecode's old first-order filter, and
+  * that its low pass settles where reset() starts it.
+  * @return The number of failures.
+  */
+static int checkBiquad() {
+	const double gain = 0.1;
+	Biquad firstOrder;
+	firstOrder.setFirstOrder(gain);
+	double old = 0.0;
+
+	double maxError = 0.0;
+	srand48(3);
+	for (int i = 0; i < TEST_SAMPLES; i++) {
+		double x = 4095.0*drand48();
+		old += gain*(x - old);
+		maxError = std::max(maxError, fabs(firstOrder(x) - old));
+	}
+
+	Biquad lowPass;
+	lowPass.setLowPass(10.0, 1000.0);
+	lowPass.reset(3.0);
+	double settled = 0.0;
+	for (int i = 0; i < 1000; i++)
+		settled = std::max(settled, fabs(lowPass(3.0) - 3.0));
+
+	printf("Biquad: largest difference from the old filter %.2e, from a settled input %.2e\n", maxError, settled);
+	int failures = 0;
+	if (maxError > SUM_TOLERANCE) {
+		printf("FAIL: the first-order Biquad differs from the old filter\n");
+		failures++;
+	}
+	if (settled > SUM_TOLERANCE) {
+		printf("FAIL: the low pass doesn't start settled after reset()\n");
+		failures++;
+	}
+	return failures;
+}
+
+int main() {
+	std::vector<uint16_t> readings(TEST_SAMPLES);
+	makeToeReadings(readings);
+
+	int failures = checkToeFilter(readings);
+	failures += checkAverages();
+	failures += checkOutliers();
+	failures += checkBiquad();
+	benchToeFilter(readings);
+
+	if (failures) {
+		printf("%d failures\n", failures);
+		return 1;
+	}
+
+	printf("All passed\n");
+	return 0;
+}
+
+// vim: noexpandtab
@@ -14,9 +14,12 @@
 #include <ros/ros.h>
 
 #include <atrias_shared/globals.h>
+#include <atrias_shared/LockstepChannel.h>
 #include <atrias_msgs/robot_state.h>  // controller input
 #include <atrias_msgs/controller_output.h>
 
+#include <atrias_sim/leg_dynamics.h>
+
 namespace gazebo
 {
 class GazeboControllerConnector : public WorldPlugin
@@ -37,7 +40,6 @@ class GazeboControllerConnector : public WorldPlugin
     private:
         // Function variables
         std::string tempModelName;
-        double theta;
 
         // Pointer to the update event connection
         event::ConnectionPtr updateConnection;
@@ -48,11 +50,6 @@ class GazeboControllerConnector : public WorldPlugin
         std::string rightLegName;
 
         // Link names
-        std::string bodyName;
-        std::string motorAName;
-        std::string motorBName;
-        std::string legAName;
-        std::string legBName;
         std::string toeName;
         std::string hipBodyName;
         std::string hipCenterName;
@@ -70,15 +67,11 @@ class GazeboControllerConnector : public WorldPlugin
         // Model pointer
         physics::ModelPtr model;
 
+        // Legs, including their springs
+        LegDynamics leftLeg, rightLeg;
+
         // Link pointers
-        struct LegLinks {
-            physics::LinkPtr body;
-            physics::LinkPtr motorA;
-            physics::LinkPtr motorB;
-            physics::LinkPtr legA;
-            physics::LinkPtr legB;
-            physics::LinkPtr toe;
-        } leftLegLinks, rightLegLinks;
+        physics::LinkPtr leftToe, rightToe;
 
         struct HipLinks {
             physics::LinkPtr body;
@@ -89,10 +82,10 @@ class GazeboControllerConnector : public WorldPlugin
             physics::LinkPtr rightMotorAttachment;
         } hipLinks;
 
-        double angle, toePosZ;
+        double angle;
         double legMotorGearRatio, hipGearRatio, legTorqueConstant, hipTorqueConstant;
         double prevLeftLegAngle, prevRightLegAngle;
-        math::Vector3 axis, bodyForce;
+        math::Vector3 axis, centerPos, centerVel;
         math::Quaternion hipRot, motorRot;
         common::Time simTime;
         double simTimeTotal, prevTime, timestep;
@@ -104,6 +97,11 @@ class GazeboControllerConnector : public WorldPlugin
         atrias_msgs::robot_state ciso;  // Controller in, simulation out
         atrias_msgs::controller_output cosi;  // Controller out, simulation in
 
+        // Shared memory channel for running in lockstep with the controller
+        atrias::shared::LockstepChannel lockstep;
+        double lockstepTimeout;
+        bool lockstepTimedOut;
+
 };
 }
 
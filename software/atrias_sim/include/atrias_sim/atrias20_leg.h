@@ -17,6 +17,8 @@
 #include <atrias_msgs/robot_state.h>  // controller input
 #include <atrias_msgs/controller_output.h>
 
+#include <atrias_sim/leg_dynamics.h>
+
 namespace gazebo
 {
     class ControllerWrapper : public WorldPlugin
@@ -30,7 +32,6 @@ namespace gazebo
             virtual void Load(physics::WorldPtr _parent, sdf::ElementPtr _sdf);
             void OnUpdate();
             void atrias_controller_callback(const atrias_msgs::controller_output &temp_cosi);
-            double wrap_angle(double newTheta);
 
         private: 
             // Pointer to the update event connection
@@ -43,19 +44,14 @@ namespace gazebo
 
             physics::LinkPtr body;
             std::string bodyName;
-            physics::LinkPtr motorA;
-            std::string motorAName;
-            physics::LinkPtr motorB;
-            std::string motorBName;
-            physics::LinkPtr legA;
-            std::string legAName;
-            physics::LinkPtr legB;
-            std::string legBName;
             physics::LinkPtr toe;
             std::string toeName;
 
-            double angle, theta, toePosZ, gearRatio, legTorqueConstant, hipTorqueConstant;
-            math::Vector3 axis, bodyForce;
+            // The leg, including its springs
+            LegDynamics leg;
+
+            double toePosZ, gearRatio, legTorqueConstant, hipTorqueConstant;
+            math::Vector3 bodyPos, bodyVel;
             common::Time simTime;
 
             boost::mutex lock;
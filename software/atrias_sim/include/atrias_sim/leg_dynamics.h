@@ -0,0 +1,64 @@
+// Reads an ATRIAS leg's state and applies its motor and spring torques.
+//
+// Each leg half is a motor driving the leg segment through a series-elastic
+// rotational spring. The angles come straight from the body-to-motor and
+// body-to-leg joints, which are looked up once when loaded, rather than being
+// recovered from each link's pose. The spring and motor torques on each link
+// are summed and applied in one call per link.
+
+#ifndef __LEG_DYNAMICS_H__
+#define __LEG_DYNAMICS_H__
+
+#include <string>
+
+#include "physics/physics.h"
+
+#include <atrias_msgs/robot_state_leg.h>
+
+namespace gazebo
+{
+class LegDynamics
+{
+    public:
+        LegDynamics();
+
+        // Finds the leg's links and joints. The element names are the same
+        // for every leg; prefix scopes them to one leg's model, if any.
+        bool Load(physics::ModelPtr model, const std::string &prefix, sdf::ElementPtr sdf);
+
+        // Reads both halves' angles and velocities into the robot state
+        void Update(atrias_msgs::robot_state_leg &leg);
+
+        // Applies the motor currents, and the spring torques for the state
+        // last read by Update()
+        void ApplyTorques(double currentA, double currentB, double torquePerAmp);
+
+    private:
+        struct Half {
+            physics::LinkPtr motor;
+            physics::LinkPtr leg;
+            physics::JointPtr motorJoint;
+            physics::JointPtr legJoint;
+
+            // Joint angle to robot_state angle, found when loaded
+            double motorOffset;
+            double legOffset;
+
+            // The spring's deflection as of the last update
+            double deflection;
+        };
+
+        bool LoadHalf(Half &half, physics::ModelPtr model, const std::string &prefix,
+            sdf::ElementPtr sdf, const std::string &side, double offset);
+        void UpdateHalf(Half &half, atrias_msgs::robot_state_legHalf &state);
+        std::string GetName(sdf::ElementPtr sdf, const std::string &element);
+
+        physics::LinkPtr body;
+        Half halfA, halfB;
+
+        // N*m/rad
+        double springStiffness;
+};
+}
+
+#endif
@@ -15,6 +15,8 @@ GazeboControllerConnector::GazeboControllerConnector()
     prevLeftLegAngle = 0.0;
     prevRightLegAngle = 0.0;
     prevTime = 0.0;
+    lockstepTimeout = 1.0;
+    lockstepTimedOut = false;
 }
 
 // Destructor
@@ -39,11 +41,6 @@ void GazeboControllerConnector::Load(physics::WorldPtr _parent, sdf::ElementPtr
     this->hipName = GazeboControllerConnector::getName("hipName");
 
     // Link names
-    this->bodyName = GazeboControllerConnector::getName("bodyName");
-    this->motorAName = GazeboControllerConnector::getName("motorAName");
-    this->motorBName = GazeboControllerConnector::getName("motorBName");
-    this->legAName = GazeboControllerConnector::getName("legAName");
-    this->legBName = GazeboControllerConnector::getName("legBName");
     this->toeName = GazeboControllerConnector::getName("toeName");
 
     this->hipBodyName = GazeboControllerConnector::getName("hipBodyName");
@@ -53,21 +50,13 @@ void GazeboControllerConnector::Load(physics::WorldPtr _parent, sdf::ElementPtr
     this->hipRightMotorName = GazeboControllerConnector::getName("hipRightMotorName");
     this->hipRightMotorAttachmentName = GazeboControllerConnector::getName("hipRightMotorAttachmentName");
 
-    // Left leg link pointers
-    leftLegLinks.body = this->model->GetLink(this->leftLegName + "::" + this->bodyName);
-    leftLegLinks.motorA = this->model->GetLink(this->leftLegName + "::" + this->motorAName);
-    leftLegLinks.motorB = this->model->GetLink(this->leftLegName + "::" + this->motorBName);
-    leftLegLinks.legA = this->model->GetLink(this->leftLegName + "::" + this->legAName);
-    leftLegLinks.legB = this->model->GetLink(this->leftLegName + "::" + this->legBName);
-    leftLegLinks.toe = this->model->GetLink(this->leftLegName + "::" + this->toeName);
-
-    // Right leg link pointers
-    rightLegLinks.body = this->model->GetLink(this->rightLegName + "::" + this->bodyName);
-    rightLegLinks.motorA = this->model->GetLink(this->rightLegName + "::" + this->motorAName);
-    rightLegLinks.motorB = this->model->GetLink(this->rightLegName + "::" + this->motorBName);
-    rightLegLinks.legA = this->model->GetLink(this->rightLegName + "::" + this->legAName);
-    rightLegLinks.legB = this->model->GetLink(this->rightLegName + "::" + this->legBName);
-    rightLegLinks.toe = this->model->GetLink(this->rightLegName + "::" + this->toeName);
+    // Legs: joints, links and springs
+    if (!this->leftLeg.Load(this->model, this->leftLegName + "::", this->sdf))
+        gzerr << "Gazebo controller wrapper plugin failed to load the left leg\n";
+    if (!this->rightLeg.Load(this->model, this->rightLegName + "::", this->sdf))
+        gzerr << "Gazebo controller wrapper plugin failed to load the right leg\n";
+    leftToe = this->model->GetLink(this->leftLegName + "::" + this->toeName);
+    rightToe = this->model->GetLink(this->rightLegName + "::" + this->toeName);
 
     // Hip link pointers
     hipLinks.body = this->model->GetLink(this->hipName + "::" + this->hipBodyName);
@@ -94,6 +83,18 @@ void GazeboControllerConnector::Load(physics::WorldPtr _parent, sdf::ElementPtr
 
     atrias_sim_sub = nh.subscribe("atrias_controller_requests", 0, &GazeboControllerConnector::atrias_controller_callback, this);
     atrias_sim_pub = nh.advertise<atrias_msgs::robot_state>("atrias_sim_data", 10);
+
+    // Optionally run in lockstep with the controller through shared memory.
+    // While no connector is attached we fall back to ROS.
+    if (this->sdf->HasElement("lockstepChannel"))
+    {
+        std::string channel = this->sdf->GetElement("lockstepChannel")->GetValueString();
+        if (this->sdf->HasElement("lockstepTimeout"))
+            this->lockstepTimeout = this->sdf->GetElement("lockstepTimeout")->GetValueDouble();
+
+        if (!this->lockstep.open(channel))
+            gzerr << "Gazebo controller wrapper plugin failed to open lockstep channel: " << channel << "\n";
+    }
 }
 
 
@@ -110,78 +111,16 @@ void GazeboControllerConnector::OnUpdate()
     ciso.header.stamp.sec = (uint32_t) simTime.sec;
     ciso.header.stamp.nsec = (uint32_t) simTime.nsec;
 
-    // Left Leg
-    // A-side (shin)
-    this->leftLegLinks.motorA->GetRelativePose().rot.GetAsAxis(axis, angle);
-    angle = angle*axis.y + M_PI/4.0;
-    angle = wrap_angle(angle);
-    ciso.lLeg.halfA.motorAngle = angle;
-    ciso.lLeg.halfA.rotorAngle = angle;
-    ciso.lLeg.halfA.motorVelocity = this->leftLegLinks.motorA->GetRelativeAngularVel().y;
-    ciso.lLeg.halfA.rotorVelocity = this->leftLegLinks.motorA->GetRelativeAngularVel().y;
-
-    this->leftLegLinks.legA->GetRelativePose().rot.GetAsAxis(axis, angle);
-    angle = angle*axis.y + M_PI/4.0;
-    angle = wrap_angle(angle);
-    ciso.lLeg.halfA.legAngle = angle;
-    ciso.lLeg.halfA.legVelocity = this->leftLegLinks.legA->GetRelativeAngularVel().y;
-
-    // B-side (thigh)
-    this->leftLegLinks.motorB->GetRelativePose().rot.GetAsAxis(axis, angle);
-    angle = angle*axis.y + 3.0*M_PI/4.0;
-    angle = wrap_angle(angle);
-    ciso.lLeg.halfB.motorAngle = angle;
-    ciso.lLeg.halfB.rotorAngle = angle;
-    ciso.lLeg.halfB.motorVelocity = this->leftLegLinks.motorB->GetRelativeAngularVel().y;
-    ciso.lLeg.halfB.rotorVelocity = this->leftLegLinks.motorB->GetRelativeAngularVel().y;
+    // Legs
+    this->leftLeg.Update(ciso.lLeg);
+    this->rightLeg.Update(ciso.rLeg);
 
-    this->leftLegLinks.legB->GetRelativePose().rot.GetAsAxis(axis, angle);
-    angle = angle*axis.y + 3.0*M_PI/4.0;
-    angle = wrap_angle(angle);
-    ciso.lLeg.halfB.legAngle = angle;
-    ciso.lLeg.halfB.legVelocity = this->leftLegLinks.legB->GetRelativeAngularVel().y;
-
-    // Toe
-    toePosZ = this->leftLegLinks.toe->GetWorldPose().pos.z;
-    if (toePosZ <= 0.021)
+    // Toes
+    if (this->leftToe->GetWorldPose().pos.z <= 0.021)
         ciso.lLeg.toeSwitch = 1.0;
     else
         ciso.lLeg.toeSwitch = 0;
-
-    // Right Leg
-    // A-side (shin)
-    this->rightLegLinks.motorA->GetRelativePose().rot.GetAsAxis(axis, angle);
-    angle = angle*axis.y + M_PI/4.0;
-    angle = wrap_angle(angle);
-    ciso.rLeg.halfA.motorAngle = angle;
-    ciso.rLeg.halfA.rotorAngle = angle;
-    ciso.rLeg.halfA.motorVelocity = this->rightLegLinks.motorA->GetRelativeAngularVel().y;
-    ciso.rLeg.halfA.rotorVelocity = this->rightLegLinks.motorA->GetRelativeAngularVel().y;
-
-    this->rightLegLinks.legA->GetRelativePose().rot.GetAsAxis(axis, angle);
-    angle = angle*axis.y + M_PI/4.0;
-    angle = wrap_angle(angle);
-    ciso.rLeg.halfA.legAngle = angle;
-    ciso.rLeg.halfA.legVelocity = this->rightLegLinks.legA->GetRelativeAngularVel().y;
-
-    // B-side (thigh)
-    this->rightLegLinks.motorB->GetRelativePose().rot.GetAsAxis(axis, angle);
-    angle = angle*axis.y + 3.0*M_PI/4.0;
-    angle = wrap_angle(angle);
-    ciso.rLeg.halfB.motorAngle = angle;
-    ciso.rLeg.halfB.rotorAngle = angle;
-    ciso.rLeg.halfB.motorVelocity = this->rightLegLinks.motorB->GetRelativeAngularVel().y;
-    ciso.rLeg.halfB.rotorVelocity = this->rightLegLinks.motorB->GetRelativeAngularVel().y;
-
-    this->rightLegLinks.legB->GetRelativePose().rot.GetAsAxis(axis, angle);
-    angle = angle*axis.y + 3.0*M_PI/4.0;
-    angle = wrap_angle(angle);
-    ciso.rLeg.halfB.legAngle = angle;
-    ciso.rLeg.halfB.legVelocity = this->rightLegLinks.legB->GetRelativeAngularVel().y;
-
-    // Toe
-    toePosZ = this->rightLegLinks.toe->GetWorldPose().pos.z;
-    if (toePosZ <= 0.021)
+    if (this->rightToe->GetWorldPose().pos.z <= 0.021)
         ciso.rLeg.toeSwitch = 1.0;
     else
         ciso.rLeg.toeSwitch = 0;
@@ -189,12 +128,14 @@ void GazeboControllerConnector::OnUpdate()
     // Hip
     // Body
     // Note: GetWorldPose returns the pose of the link's center of mass
-    ciso.position.xPosition = this->hipLinks.center->GetWorldPose().pos.x;
-    ciso.position.yPosition = this->hipLinks.center->GetWorldPose().pos.y;
-    ciso.position.zPosition = this->hipLinks.center->GetWorldPose().pos.z;
-    ciso.position.xVelocity = this->hipLinks.center->GetWorldLinearVel().x;
-    ciso.position.yVelocity = this->hipLinks.center->GetWorldLinearVel().y;
-    ciso.position.zVelocity = this->hipLinks.center->GetWorldLinearVel().z;
+    centerPos = this->hipLinks.center->GetWorldPose().pos;
+    centerVel = this->hipLinks.center->GetWorldLinearVel();
+    ciso.position.xPosition = centerPos.x;
+    ciso.position.yPosition = centerPos.y;
+    ciso.position.zPosition = centerPos.z;
+    ciso.position.xVelocity = centerVel.x;
+    ciso.position.yVelocity = centerVel.y;
+    ciso.position.zVelocity = centerVel.z;
     // Hacks for a fixed body position
     // TODO: make this reference hipLinks.center appropriately
     ciso.position.boomAngle = 3.05;
@@ -220,18 +161,26 @@ void GazeboControllerConnector::OnUpdate()
     ciso.rLeg.hip.legBodyVelocity = (angle - prevRightLegAngle) / timestep; 
     prevRightLegAngle = angle;
 
+    // In lockstep, wait for the controller's output for this state, and
+    // apply it in this step
+    bool inLockstep = this->lockstep.isOpen() && this->lockstep.connectorAttached();
+    if (inLockstep)
+    {
+        if (!this->lockstep.postState(ciso))
+            gzerr << "Robot state too large for the lockstep channel\n";
+        else if (this->lockstep.waitForOutput(cosi, this->lockstepTimeout))
+            this->lockstepTimedOut = false;
+        else if (!this->lockstepTimedOut)
+        {
+            gzerr << "Controller stopped answering; running without it\n";
+            this->lockstepTimedOut = true;
+        }
+    }
+
     // Add the torques to the simulation
-    // Left Leg
-    this->leftLegLinks.motorA->AddRelativeTorque(math::Vector3(0., cosi.lLeg.motorCurrentA * legTorqueConstant * legMotorGearRatio, 0.));
-    this->leftLegLinks.body->AddRelativeTorque(math::Vector3(0., -1. * cosi.lLeg.motorCurrentA * legTorqueConstant * legMotorGearRatio, 0.));
-    this->leftLegLinks.motorB->AddRelativeTorque(math::Vector3(0., cosi.lLeg.motorCurrentB * legTorqueConstant * legMotorGearRatio, 0.));
-    this->leftLegLinks.body->AddRelativeTorque(math::Vector3(0., -1. * cosi.lLeg.motorCurrentB * legTorqueConstant * legMotorGearRatio, 0.));
-
-    // Right Leg
-    this->rightLegLinks.motorA->AddRelativeTorque(math::Vector3(0., cosi.rLeg.motorCurrentA * legTorqueConstant * legMotorGearRatio, 0.));
-    this->rightLegLinks.body->AddRelativeTorque(math::Vector3(0., -1. * cosi.rLeg.motorCurrentA * legTorqueConstant * legMotorGearRatio, 0.));
-    this->rightLegLinks.motorB->AddRelativeTorque(math::Vector3(0., cosi.rLeg.motorCurrentB * legTorqueConstant * legMotorGearRatio, 0.));
-    this->rightLegLinks.body->AddRelativeTorque(math::Vector3(0., -1. * cosi.rLeg.motorCurrentB * legTorqueConstant * legMotorGearRatio, 0.));
+    // Legs, including their springs
+    this->leftLeg.ApplyTorques(cosi.lLeg.motorCurrentA, cosi.lLeg.motorCurrentB, legTorqueConstant * legMotorGearRatio);
+    this->rightLeg.ApplyTorques(cosi.rLeg.motorCurrentA, cosi.rLeg.motorCurrentB, legTorqueConstant * legMotorGearRatio);
 
     // Hip
     this->hipLinks.rightMotor->AddRelativeTorque(math::Vector3(cosi.rLeg.motorCurrentHip * hipTorqueConstant * hipGearRatio, 0., 0.));
@@ -241,6 +190,9 @@ void GazeboControllerConnector::OnUpdate()
 
     this->lock.unlock();
 
+    if (inLockstep)
+        return;
+
     // Put the robot state in the publishing queue
     atrias_sim_pub.publish(ciso);
 
@@ -259,14 +211,9 @@ void GazeboControllerConnector::atrias_controller_callback(const atrias_msgs::co
 double GazeboControllerConnector::wrap_angle(double newTheta)
 {
     // Keep the angle between 2*M_PI and -2*M_PI
-    if (newTheta < 0)
-        theta = -1.0*fmod(-1.0*newTheta, 2*M_PI);
-    else if (theta > 0)
-        theta = fmod(newTheta, 2*M_PI);
-    else
-        theta = newTheta;
-
-    return theta;
+    if (newTheta >= 2*M_PI || newTheta <= -2*M_PI)
+        return fmod(newTheta, 2*M_PI);
+    return newTheta;
 }
 
 physics::ModelPtr GazeboControllerConnector::getModel(std::string requestedModelName)
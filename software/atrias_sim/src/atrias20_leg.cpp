@@ -39,37 +39,9 @@ void ControllerWrapper::Load(physics::WorldPtr _parent, sdf::ElementPtr _sdf)
     else
         gzerr << "Gazebo controller wrapper plugin missing valid bodyName\n";
 
-    if (_sdf->HasElement("motorAName"))
-    {
-        this->motorAName = _sdf->GetElement("motorAName")->GetValueString();
-        this->motorA = this->model->GetLink(this->motorAName);
-    }
-    else
-        gzerr << "Gazebo controller wrapper plugin missing valid motorAName\n";
-
-    if (_sdf->HasElement("motorBName"))
-    {
-        this->motorBName = _sdf->GetElement("motorBName")->GetValueString();
-        this->motorB = this->model->GetLink(this->motorBName);
-    }
-    else
-        gzerr << "Gazebo controller wrapper plugin missing valid motorBName\n";
-
-    if (_sdf->HasElement("legAName"))
-    {
-        this->legAName = _sdf->GetElement("legAName")->GetValueString();
-        this->legA = this->model->GetLink(this->legAName);
-    }
-    else
-        gzerr << "Gazebo controller wrapper plugin missing valid legAName\n";
-
-    if (_sdf->HasElement("legBName"))
-    {
-        this->legBName = _sdf->GetElement("legBName")->GetValueString();
-        this->legB = this->model->GetLink(this->legBName);
-    }
-    else
-        gzerr << "Gazebo controller wrapper plugin missing valid legBName\n";
+    // Leg joints, links and springs
+    if (!this->leg.Load(this->model, "", _sdf))
+        gzerr << "Gazebo controller wrapper plugin failed to load the leg\n";
 
     if (_sdf->HasElement("toeName"))
     {
@@ -108,42 +80,17 @@ void ControllerWrapper::OnUpdate()
     ciso.header.stamp.sec = (uint32_t) simTime.sec;
     ciso.header.stamp.nsec = (uint32_t) simTime.nsec;
 
-    // A-side (shin)
-    this->motorA->GetRelativePose().rot.GetAsAxis(axis, angle);
-    angle = angle*axis.y + M_PI/4.0;
-    angle = wrap_angle(angle);
-    ciso.lLeg.halfA.motorAngle = angle;
-    ciso.lLeg.halfA.rotorAngle = angle;
-    ciso.lLeg.halfA.motorVelocity = this->motorA->GetRelativeAngularVel().y;
-    ciso.lLeg.halfA.rotorVelocity = this->motorA->GetRelativeAngularVel().y;
-
-    this->legA->GetRelativePose().rot.GetAsAxis(axis, angle);
-    angle = angle*axis.y + M_PI/4.0;
-    angle = wrap_angle(angle);
-    ciso.lLeg.halfA.legAngle = angle;
-    ciso.lLeg.halfA.legVelocity = this->legA->GetRelativeAngularVel().y;
-
-    // B-side (thigh)
-    this->motorB->GetRelativePose().rot.GetAsAxis(axis, angle);
-    angle = angle*axis.y + 3.0*M_PI/4.0;
-    angle = wrap_angle(angle);
-    ciso.lLeg.halfB.motorAngle = angle;
-    ciso.lLeg.halfB.rotorAngle = angle;
-    ciso.lLeg.halfB.motorVelocity = this->motorB->GetRelativeAngularVel().y;
-    ciso.lLeg.halfB.rotorVelocity = this->motorB->GetRelativeAngularVel().y;
-
-    this->legB->GetRelativePose().rot.GetAsAxis(axis, angle);
-    angle = angle*axis.y + 3.0*M_PI/4.0;
-    angle = wrap_angle(angle);
-    ciso.lLeg.halfB.legAngle = angle;
-    ciso.lLeg.halfB.legVelocity = this->legB->GetRelativeAngularVel().y;
-
-    ciso.position.xPosition = this->body->GetWorldPose().pos.x;
-    ciso.position.yPosition = this->body->GetWorldPose().pos.y;
-    ciso.position.zPosition = this->body->GetWorldPose().pos.z;
-    ciso.position.xVelocity = this->body->GetWorldLinearVel().x;
-    ciso.position.yVelocity = this->body->GetWorldLinearVel().y;
-    ciso.position.zVelocity = this->body->GetWorldLinearVel().z;
+    // Leg
+    this->leg.Update(ciso.lLeg);
+
+    bodyPos = this->body->GetWorldPose().pos;
+    bodyVel = this->body->GetWorldLinearVel();
+    ciso.position.xPosition = bodyPos.x;
+    ciso.position.yPosition = bodyPos.y;
+    ciso.position.zPosition = bodyPos.z;
+    ciso.position.xVelocity = bodyVel.x;
+    ciso.position.yVelocity = bodyVel.y;
+    ciso.position.zVelocity = bodyVel.z;
 
     toePosZ = this->toe->GetWorldPose().pos.z;
     if (toePosZ <= 0.021)
@@ -151,11 +98,8 @@ void ControllerWrapper::OnUpdate()
     else
         ciso.lLeg.toeSwitch = 0;
 
-    // Add the torques to the simulation
-    this->motorA->AddRelativeTorque(math::Vector3(0., cosi.lLeg.motorCurrentA * legTorqueConstant * gearRatio, 0.));
-    this->body->AddRelativeTorque(math::Vector3(0., -1. * cosi.lLeg.motorCurrentA * legTorqueConstant * gearRatio, 0.));
-    this->motorB->AddRelativeTorque(math::Vector3(0., cosi.lLeg.motorCurrentB * legTorqueConstant * gearRatio, 0.));
-    this->body->AddRelativeTorque(math::Vector3(0., -1. * cosi.lLeg.motorCurrentB * legTorqueConstant * gearRatio, 0.));
+    // Add the torques to the simulation, including the springs
+    this->leg.ApplyTorques(cosi.lLeg.motorCurrentA, cosi.lLeg.motorCurrentB, legTorqueConstant * gearRatio);
 
     this->lock.unlock();
 
@@ -173,16 +117,3 @@ void ControllerWrapper::atrias_controller_callback(const atrias_msgs::controller
     cosi = temp_cosi;
 }
 
-
-double ControllerWrapper::wrap_angle(double newTheta)
-{
-    // Keep the angle between 2*M_PI and -2*M_PI
-    if (newTheta < 0)
-        theta = -1.0*fmod(-1.0*newTheta, 2*M_PI);
-    else if (theta > 0)
-        theta = fmod(newTheta, 2*M_PI);
-    else
-        theta = newTheta;
-
-    return theta;
-}
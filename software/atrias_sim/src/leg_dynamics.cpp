@@ -0,0 +1,112 @@
+#include <atrias_sim/leg_dynamics.h>
+
+using namespace gazebo;
+
+// Keeps an angle between -2*M_PI and 2*M_PI. Joint angles rarely leave
+// that range, so skip the fmod when they don't.
+static double wrapAngle(double angle)
+{
+    if (angle >= 2*M_PI || angle <= -2*M_PI)
+        return fmod(angle, 2*M_PI);
+    return angle;
+}
+
+LegDynamics::LegDynamics()
+{
+    springStiffness = 4118; // N*m/rad
+}
+
+bool LegDynamics::Load(physics::ModelPtr model, const std::string &prefix, sdf::ElementPtr sdf)
+{
+    this->body = model->GetLink(prefix + GetName(sdf, "bodyName"));
+    if (!this->body)
+    {
+        gzerr << "Leg dynamics could not find the body link\n";
+        return false;
+    }
+
+    if (sdf->HasElement("springStiffness"))
+        this->springStiffness = sdf->GetElement("springStiffness")->GetValueDouble();
+
+    // A-side (shin) and B-side (thigh)
+    return LoadHalf(this->halfA, model, prefix, sdf, "A", M_PI/4.0) &&
+           LoadHalf(this->halfB, model, prefix, sdf, "B", 3.0*M_PI/4.0);
+}
+
+bool LegDynamics::LoadHalf(Half &half, physics::ModelPtr model, const std::string &prefix,
+    sdf::ElementPtr sdf, const std::string &side, double offset)
+{
+    half.motor = model->GetLink(prefix + GetName(sdf, "motor" + side + "Name"));
+    half.leg = model->GetLink(prefix + GetName(sdf, "leg" + side + "Name"));
+    half.motorJoint = model->GetJoint(prefix + GetName(sdf, "motor" + side + "JointName"));
+    half.legJoint = model->GetJoint(prefix + GetName(sdf, "leg" + side + "JointName"));
+    if (!half.motor || !half.leg || !half.motorJoint || !half.legJoint)
+    {
+        gzerr << "Leg dynamics could not find the links and joints for half " << side << "\n";
+        return false;
+    }
+
+    // The controllers' angles are measured from the links' starting poses,
+    // so find what to add to each joint's angle to get them.
+    math::Vector3 axis;
+    double angle;
+    half.motor->GetRelativePose().rot.GetAsAxis(axis, angle);
+    half.motorOffset = angle*axis.y + offset - half.motorJoint->GetAngle(0).GetAsRadian();
+    half.leg->GetRelativePose().rot.GetAsAxis(axis, angle);
+    half.legOffset = angle*axis.y + offset - half.legJoint->GetAngle(0).GetAsRadian();
+
+    half.deflection = 0.0;
+    return true;
+}
+
+void LegDynamics::Update(atrias_msgs::robot_state_leg &leg)
+{
+    UpdateHalf(this->halfA, leg.halfA);
+    UpdateHalf(this->halfB, leg.halfB);
+}
+
+void LegDynamics::UpdateHalf(Half &half, atrias_msgs::robot_state_legHalf &state)
+{
+    double motorAngle = half.motorJoint->GetAngle(0).GetAsRadian() + half.motorOffset;
+    double legAngle = half.legJoint->GetAngle(0).GetAsRadian() + half.legOffset;
+
+    state.motorAngle = wrapAngle(motorAngle);
+    state.rotorAngle = state.motorAngle;
+    state.motorVelocity = half.motorJoint->GetVelocity(0);
+    state.rotorVelocity = state.motorVelocity;
+    state.legAngle = wrapAngle(legAngle);
+    state.legVelocity = half.legJoint->GetVelocity(0);
+
+    // The spring's deflection, between -M_PI and M_PI
+    half.deflection = legAngle - motorAngle;
+    if (half.deflection < -M_PI)
+        half.deflection += 2*M_PI;
+    else if (half.deflection > M_PI)
+        half.deflection -= 2*M_PI;
+}
+
+void LegDynamics::ApplyTorques(double currentA, double currentB, double torquePerAmp)
+{
+    double motorTorqueA = currentA * torquePerAmp;
+    double motorTorqueB = currentB * torquePerAmp;
+    double springTorqueA = this->halfA.deflection * this->springStiffness;
+    double springTorqueB = this->halfB.deflection * this->springStiffness;
+
+    // The motors push against the body, and the springs between the motors
+    // and the leg segments
+    this->body->AddRelativeTorque(math::Vector3(0., -motorTorqueA - motorTorqueB, 0.));
+    this->halfA.motor->AddRelativeTorque(math::Vector3(0., motorTorqueA + springTorqueA, 0.));
+    this->halfA.leg->AddRelativeTorque(math::Vector3(0., -springTorqueA, 0.));
+    this->halfB.motor->AddRelativeTorque(math::Vector3(0., motorTorqueB + springTorqueB, 0.));
+    this->halfB.leg->AddRelativeTorque(math::Vector3(0., -springTorqueB, 0.));
+}
+
+std::string LegDynamics::GetName(sdf::ElementPtr sdf, const std::string &element)
+{
+    if (!sdf->HasElement(element))
+    {
+        gzerr << "Leg dynamics missing valid name: " << element << "\n";
+        return "";
+    }
+    return sdf->GetElement(element)->GetValueString();
+}
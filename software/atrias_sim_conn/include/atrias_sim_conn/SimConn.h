@@ -3,8 +3,17 @@
 
 /** @file
   * @brief This is the main class for the simulation connector.
+  *
+  * By default it exchanges states and outputs with Gazebo over ROS streams.
+  * With \a lockstepChannel set, it instead answers each physics step through
+  * shared memory, and Gazebo waits for the answer (see
+  * atrias_shared/LockstepChannel.h and simConnLockstep.ops).
   */
 
+#include <stdint.h>
+
+#include <string>
+
 // Orocos
 #include <rtt/TaskContext.hpp>
 #include <rtt/Component.hpp>
@@ -15,6 +24,12 @@
 #include <atrias_msgs/robot_state.h>
 #include <atrias_msgs/controller_output.h>
 #include <atrias_shared/globals.h>
+#include <atrias_shared/LockstepChannel.h>
+
+/** @brief How long the lockstep connector waits for a state before checking
+  * whether it's been stopped (seconds).
+  */
+#define SIM_LOCKSTEP_POLL_TIMEOUT 0.1
 
 namespace atrias {
 
@@ -24,9 +39,14 @@ class SimConn : public RTT::TaskContext {
 	private:
 	/** @brief By calling this, we cycle RT Ops.
 	  */
-	RTT::OperationCaller<void(atrias_msgs::robot_state)>
+	RTT::OperationCaller<void(const atrias_msgs::robot_state&)>
 		newStateCallback;
 	
+	/** @brief Returns the timestamp of the robot state RT Ops is working on.
+	  */
+	RTT::OperationCaller<uint64_t(void)>
+		getTimestamp;
+	
 	/** @brief Lets us receive data from Gazebo.
 	  */
 	RTT::InputPort<atrias_msgs::robot_state>        gazeboDataIn;
@@ -35,6 +55,24 @@ class SimConn : public RTT::TaskContext {
 	  */
 	RTT::OutputPort<atrias_msgs::controller_output> gazeboDataOut;
 	
+	/** @brief Receives the robot state from Gazebo.
+	  * Preallocated so \a updateHook() doesn't construct one every cycle.
+	  */
+	atrias_msgs::robot_state                        robotState;
+	
+	/** @brief The shared memory object to run in lockstep through, or empty
+	  * to use the ROS streams.
+	  */
+	std::string                                     lockstepChannel;
+	
+	/** @brief Our end of the lockstep channel.
+	  */
+	shared::LockstepChannel                         lockstep;
+	
+	/** @brief The timestamp of the state being answered in lockstep.
+	  */
+	uint64_t                                        expectedStamp;
+	
 	public:
 		/** @brief Initializes the Sim Connector
 		  * @param name The name for this component.
@@ -44,14 +82,30 @@ class SimConn : public RTT::TaskContext {
 		/** @brief Called by RT Ops w/ update controller torques.
 		  * @param controller_output The new controller output.
 		  */
-		void sendControllerOutput(atrias_msgs::controller_output controller_output);
+		void sendControllerOutput(const atrias_msgs::controller_output& controller_output);
 		
 		/** @brief Configures this component.
 		  * Run by Orocos.
 		  */
 		bool configureHook();
 		
-		/** @brief Run by Orocos when an Event port receives.
+		/** @brief Opens the lockstep channel, if configured.
+		  * Run by Orocos.
+		  */
+		bool startHook();
+		
+		/** @brief Detaches from the lockstep channel, leaving it open, since
+		  * RT Ops may still be sending us an output.
+		  * Run by Orocos.
+		  */
+		void stopHook();
+		
+		/** @brief Closes the lockstep channel.
+		  * Run by Orocos.
+		  */
+		void cleanupHook();
+		
+		/** @brief Run by Orocos periodically, or in lockstep mode, continuously.
 		  */
 		void updateHook();
 };
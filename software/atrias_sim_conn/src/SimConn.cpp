@@ -7,15 +7,22 @@ namespace simConn {
 SimConn::SimConn(std::string name) :
          RTT::TaskContext(name),
          newStateCallback("newStateCallback"),
+         getTimestamp("getTimestamp"),
          gazeboDataIn("gazebo_data_in"),
          gazeboDataOut("gazebo_data_out") {
 	this->provides("connector")
 	    ->addOperation("sendControllerOutput", &SimConn::sendControllerOutput, this, RTT::ClientThread);
 	this->requires("rtOps")
 	    ->addOperationCaller(newStateCallback);
+	this->requires("rtOps")
+	    ->addOperationCaller(getTimestamp);
 	
 	addPort(gazeboDataIn);
 	addPort(gazeboDataOut);
+	
+	expectedStamp = 0;
+	this->addProperty("lockstepChannel", lockstepChannel)
+	    .doc("Shared memory object through which to run in lockstep with Gazebo, or empty to use ROS.");
 }
 
 bool SimConn::configureHook() {
@@ -25,21 +32,68 @@ bool SimConn::configureHook() {
 		return false;
 	}
 	newStateCallback = peer->provides("rtOps")->getOperation("newStateCallback");
+	getTimestamp     = peer->provides("timestamps")->getOperation("getTimestamp");
 	log(RTT::Info) << "[SimConn] Connected to RTOps." << RTT::endlog();
 	log(RTT::Info) << "[SimConn] configured!" << RTT::endlog();
 	return true;
 }
 
-void SimConn::sendControllerOutput(atrias_msgs::controller_output controller_output) {
-	gazeboDataOut.write(controller_output);
-	return;
+bool SimConn::startHook() {
+	if (lockstepChannel.empty())
+		return true;
+
+	// We may have been stopped and restarted without being cleaned up, in
+	// which case it's still open.
+	if (!lockstep.isOpen() && !lockstep.open(lockstepChannel)) {
+		log(RTT::Error) << "[SimConn] Failed to open lockstep channel " << lockstepChannel << RTT::endlog();
+		return false;
+	}
+	log(RTT::Info) << "[SimConn] Running in lockstep through " << lockstepChannel << RTT::endlog();
+	return true;
+}
+
+void SimConn::stopHook() {
+	// Gazebo stops waiting for us once we've detached. RT Ops may still be
+	// in sendControllerOutput(), so the block stays mapped until cleanup.
+	lockstep.detach();
+}
+
+void SimConn::cleanupHook() {
+	lockstep.close();
+}
+
+void SimConn::sendControllerOutput(const atrias_msgs::controller_output& controller_output) {
+	if (!lockstep.isOpen()) {
+		gazeboDataOut.write(controller_output);
+		return;
+	}
+
+	// The controller loop also runs once at startup; only answer with the
+	// output computed from the state Gazebo is waiting on.
+	if (getTimestamp() != expectedStamp)
+		return;
+
+	if (!lockstep.postOutput(controller_output))
+		log(RTT::Error) << "[SimConn] Controller output too large for the lockstep channel!" << RTT::endlog();
 }
 
 void SimConn::updateHook() {
-	atrias_msgs::robot_state state;
-	if (RTT::NewData == gazeboDataIn.read(state)) {
-		newStateCallback(state);
+	if (!lockstep.isOpen()) {
+		if (RTT::NewData == gazeboDataIn.read(robotState)) {
+			newStateCallback(robotState);
+		}
+		return;
+	}
+
+	// Lockstep: Gazebo doesn't step again until we've answered, so there's
+	// at most one state to handle.
+	if (lockstep.waitForState(robotState, SIM_LOCKSTEP_POLL_TIMEOUT)) {
+		expectedStamp = SECOND_IN_NANOSECONDS * (uint64_t) robotState.header.stamp.sec + robotState.header.stamp.nsec;
+		newStateCallback(robotState);
 	}
+
+	// Wait for the next one right away.
+	this->trigger();
 }
 
 ORO_CREATE_COMPONENT(SimConn)